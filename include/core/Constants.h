@@ -31,8 +31,14 @@ namespace Constants {
     constexpr int ALL_RED_DURATION = 2000; // 2 seconds
     constexpr int GREEN_DURATION_BASE = 3000;   // 3 seconds
 
+    // Network settings
+    constexpr float LINK_SPEED = 13.9f;         // Travel speed between junctions (m/s, ~50 km/h)
+    constexpr float QUEUE_DELAY_PER_VEHICLE = 2.0f; // Route cost of each queued vehicle (s)
+    constexpr int ROUTE_UPDATE_INTERVAL = 5000; // Link costs refreshed from queues every 5 seconds
+
     // Queue settings
     constexpr int MAX_QUEUE_SIZE = 100;
+    constexpr int VEHICLE_CHUNK = 512;          // Vehicles per parallel update work item
 
     // Priority settings
     constexpr int PRIORITY_THRESHOLD_HIGH = 10; // Enter priority mode when > 10 vehicles
@@ -0,0 +1,62 @@
+// FILE: include/core/GlowTextures.h
+#ifndef GLOW_TEXTURES_H
+#define GLOW_TEXTURES_H
+
+#include <SDL3/SDL.h>
+#include <map>
+#include "visualization/RenderBackend.h"
+
+// Glow and light effects baked once per render backend into small textures.
+//
+// The textures are white with premultiplied alpha: each pixel holds the
+// result of the stacked, stepped-alpha primitives the effect used to draw
+// every frame. One textured quad tinted with setTextureColorMod then
+// gives the same image in any color, and per-frame flicker is a change of
+// the modulation instead of a redraw.
+class GlowTextures {
+public:
+    // Textures for a backend, baked on first use
+    static GlowTextures* forBackend(RenderBackend* backend);
+
+    // Destroy a backend's textures; call before destroying the backend
+    static void release(RenderBackend* backend);
+
+    // Five one-pixel outlines around a rectangle, fading outwards
+    // (neon sign glow)
+    void drawFrameGlow(const SDL_FRect& rect, SDL_Color color);
+
+    // Hexagon of the given radius around (x, y): five faint scaled outlines,
+    // a half-bright fill and a solid border (lane marker)
+    void drawHexagon(int x, int y, float radius, SDL_Color color);
+
+    // Square light of the given size centred on (x, y): inner fill inset by
+    // two pixels and three fading outlines outside it, dimmed by flicker
+    // (0..1) like the traffic light hologram
+    void drawLight(int x, int y, int size, SDL_Color color, float flicker);
+
+    // Four-pixel vehicle light centred on (x, y) with `rings` filled glow
+    // squares around it (3 for head and turn lights, 2 for taillights)
+    void drawVehicleLight(float x, float y, int rings, SDL_Color color);
+
+private:
+    explicit GlowTextures(RenderBackend* backend);
+    ~GlowTextures();
+
+    GlowTextures(const GlowTextures&) = delete;
+    GlowTextures& operator=(const GlowTextures&) = delete;
+
+    typedef RenderBackend::TextureId TextureId;
+
+    RenderBackend* backend;
+    TextureId frameGlow;
+    std::map<int, TextureId> hexagons;          // By radius in tenths of a pixel
+    std::map<int, TextureId> lights;            // By size
+    std::map<int, TextureId> vehicleLights;     // By ring count
+
+    static std::map<RenderBackend*, GlowTextures*> instances;
+
+    // Draw a texture tinted with color at its natural size
+    void drawTinted(TextureId texture, float x, float y, SDL_Color color);
+};
+
+#endif // GLOW_TEXTURES_H
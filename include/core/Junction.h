@@ -0,0 +1,149 @@
+// FILE: include/core/Junction.h
+#ifndef JUNCTION_H
+#define JUNCTION_H
+
+#include <array>
+#include <cstdint>
+#include <vector>
+
+#include "core/Kinematics.h"
+#include "core/Lane.h"
+#include "core/RoadNetwork.h"
+#include "core/TrafficLight.h"
+
+// Junction kernel for a topology fixed at compile time: Roads approaches
+// ('A', 'B', ...) with LanesPerRoad lanes each, stored road-major like the
+// network lane table. The movement, light and turn rules are constexpr tables
+// indexed by array slot, so the per-tick loops have constant trip counts and
+// never compare lane ids. Junctions of any other shape take the generic
+// std::vector<Lane*> path in TrafficManager.
+template<int Roads, int LanesPerRoad>
+class Junction {
+    static_assert(Roads >= 1 && Roads <= 4, "TrafficLight has one green phase per road, A-D");
+    static_assert(LanesPerRoad >= 2, "Lane 2 carries the light-controlled traffic");
+
+public:
+    static constexpr int LANE_COUNT = Roads * LanesPerRoad;
+    static constexpr int FREE_LANE = 3;        // Lane number that ignores the light
+    static constexpr int STATE_COUNT = 5;      // TrafficLight::State values
+
+    static_assert(LANE_COUNT <= 32, "Moving lanes are kept in a 32-bit mask");
+
+    // Array slot of a road (0 = 'A') and 1-based lane number
+    static constexpr int slot(int road, int laneNumber) { return road * LanesPerRoad + laneNumber - 1; }
+
+    // Priority lane A2
+    static constexpr int PRIORITY_SLOT = 1;
+
+    // Allowed movements per slot (RoadNetwork::defaultMovements)
+    static constexpr std::array<uint8_t, LANE_COUNT> MOVEMENTS = [] {
+        std::array<uint8_t, LANE_COUNT> table{};
+        for (int s = 0; s < LANE_COUNT; s++) {
+            table[s] = RoadNetwork::defaultMovements(s % LanesPerRoad + 1);
+        }
+        return table;
+    }();
+
+    // Slots allowed to move in each light state, one bit per slot: the green
+    // road's lanes plus every free lane
+    static constexpr std::array<uint32_t, STATE_COUNT> MOVING = [] {
+        std::array<uint32_t, STATE_COUNT> table{};
+        for (int state = 0; state < STATE_COUNT; state++) {
+            for (int s = 0; s < LANE_COUNT; s++) {
+                bool greenRoad = s / LanesPerRoad == state - 1;   // A_GREEN = 1
+                bool freeLane = s % LanesPerRoad + 1 == FREE_LANE;
+                if (greenRoad || freeLane) table[state] |= 1u << s;
+            }
+        }
+        return table;
+    }();
+
+    // Approach lane and turn for each (exit - entry) road offset. Lane 2
+    // straight crosses over, lane 3 turns to the next road and lane 2 left
+    // turns to the road before the entry; other offsets are not modelled.
+    struct Route {
+        uint8_t laneNumber;   // 0 if the turn is not possible
+        Destination destination;
+    };
+
+    static constexpr std::array<Route, Roads> ROUTES = [] {
+        std::array<Route, Roads> table{};
+        for (int turn = 0; turn < Roads; turn++) {
+            table[turn] = Route{0, Destination::STRAIGHT};
+            if (turn == 0) continue;   // U-turn
+            if (Roads % 2 == 0 && turn == Roads / 2) table[turn] = Route{2, Destination::STRAIGHT};
+            else if (turn == 1 && LanesPerRoad >= FREE_LANE) table[turn] = Route{FREE_LANE, Destination::LEFT};
+            else if (turn == Roads - 1) table[turn] = Route{2, Destination::LEFT};
+        }
+        return table;
+    }();
+
+    Junction() { lanes.fill(nullptr); }
+
+    // Take the junction's lanes in road-major order; false if the count doesn't match
+    bool bind(const std::vector<Lane*>& junctionLanes) {
+        if (junctionLanes.size() != static_cast<size_t>(LANE_COUNT)) return false;
+        for (int s = 0; s < LANE_COUNT; s++) {
+            lanes[s] = junctionLanes[s];
+        }
+        return true;
+    }
+
+    Lane* lane(int road, int laneNumber) const { return lanes[slot(road, laneNumber)]; }
+    Lane* priorityLane() const { return lanes[PRIORITY_SLOT]; }
+
+    // Whether vehicles in a slot may move in a light state
+    static constexpr bool isMoving(TrafficLight::State state, int s) {
+        return (MOVING[static_cast<int>(state)] >> s) & 1u;
+    }
+
+    // Update every vehicle for the current light state
+    template<typename Kinematics = FloatKinematics>
+    void moveVehicles(uint32_t delta, TrafficLight::State state) const {
+        moveVehicles<Kinematics>(delta, state, [](int, Vehicle*) {});
+    }
+
+    // Same, calling afterStep(slot, vehicle) for every entry of every lane
+    // queue (null ones too), in order, right after the vehicle's step
+    template<typename Kinematics, typename AfterStep>
+    void moveVehicles(uint32_t delta, TrafficLight::State state, AfterStep afterStep) const {
+        const uint32_t moving = MOVING[static_cast<int>(state)];
+        for (int s = 0; s < LANE_COUNT; s++) {
+            const bool isGreenLight = (moving >> s) & 1u;
+            const auto& vehicles = lanes[s]->getVehicles();
+            for (size_t i = 0; i < vehicles.size(); i++) {
+                if (vehicles[i]) {
+                    vehicles[i]->setQueuePosition(static_cast<int>(i));
+                    vehicles[i]->template step<Kinematics>(delta, isGreenLight);
+                }
+                afterStep(s, vehicles[i]);
+            }
+        }
+    }
+
+    // Advance the light from the lane-2 load, without scanning for A2
+    void updateLight(TrafficLight& light, uint32_t currentTime) const {
+        int laneTwoVehicles = 0;
+        for (int r = 0; r < Roads; r++) {
+            laneTwoVehicles += lanes[slot(r, 2)]->getVehicleCount();
+        }
+        light.update(lanes[PRIORITY_SLOT], Roads, laneTwoVehicles, currentTime);
+    }
+
+    // Approach lane and turn that take a vehicle from entryRoad onto exitRoad
+    static bool approachFor(char entryRoad, char exitRoad, int& laneNumber, Destination& destination) {
+        const Route& route = ROUTES[((exitRoad - entryRoad) % Roads + Roads) % Roads];
+        if (route.laneNumber == 0) return false;
+        laneNumber = route.laneNumber;
+        destination = route.destination;
+        return true;
+    }
+
+private:
+    std::array<Lane*, LANE_COUNT> lanes;
+};
+
+// The standard four-way junction, three lanes per road
+typedef Junction<4, 3> StandardJunction;
+
+#endif // JUNCTION_H
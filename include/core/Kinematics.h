@@ -0,0 +1,50 @@
+// FILE: include/core/Kinematics.h
+#ifndef KINEMATICS_H
+#define KINEMATICS_H
+
+#include <cmath>
+#include <cstdint>
+#include "utils/FixedPoint.h"
+
+// Number types for the vehicle step, passed as the template parameter of
+// Vehicle::step. Positions are stored as float either way (the renderer reads
+// them); the kinematics type decides how each step's arithmetic is done.
+
+// Native float math: fastest, but results can change with compiler flags
+// (FMA contraction, -ffast-math) and so between builds
+struct FloatKinematics {
+    typedef float Scalar;
+
+    static Scalar fromFloat(float value) { return value; }
+    static Scalar fromInt(int64_t value) { return static_cast<float>(value); }
+    static float toFloat(Scalar value) { return value; }
+    static Scalar sqrt(Scalar value) { return std::sqrt(value); }
+
+    // Move (x, y) by speed along (dx, dy), whose length is distance
+    static void moveAlong(Scalar& x, Scalar& y, Scalar dx, Scalar dy, Scalar distance, Scalar speed) {
+        dx /= distance;
+        dy /= distance;
+        x += dx * speed;
+        y += dy * speed;
+    }
+};
+
+// Q47.16 fixed point: bit-identical trajectories across builds, platforms
+// and thread counts
+struct FixedKinematics {
+    typedef Fixed Scalar;
+
+    static Scalar fromFloat(float value) { return Fixed::fromFloat(value); }
+    static Scalar fromInt(int64_t value) { return Fixed::fromInt(value); }
+    static float toFloat(Scalar value) { return value.toFloat(); }
+    static Scalar sqrt(Scalar value) { return Fixed::sqrt(value); }
+
+    // One division per step: integer division dominates the fixed-point cost
+    static void moveAlong(Scalar& x, Scalar& y, Scalar dx, Scalar dy, Scalar distance, Scalar speed) {
+        Scalar scale = speed / distance;
+        x = x + dx * scale;
+        y = y + dy * scale;
+    }
+};
+
+#endif // KINEMATICS_H
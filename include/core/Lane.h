@@ -2,6 +2,7 @@
 #ifndef LANE_H
 #define LANE_H
 
+#include <cstdint>
 #include <vector>
 #include <string>
 #include "core/Vehicle.h"
@@ -22,6 +23,11 @@ public:
     // Priority related operations
     int getPriority() const;
     void updatePriority();
+
+    // Put back a priority saved in a checkpoint. Priority has hysteresis
+    // (on above 10 vehicles, off below 5), so it can't be derived from
+    // the restored queue length.
+    void setPriority(int value) { priority = value; }
     bool isPriorityLane() const;
 
     // Lane identification
@@ -32,12 +38,17 @@ public:
     // For iteration through vehicles (for rendering)
     const std::vector<Vehicle*>& getVehicles() const;
 
+    // Bumped by every enqueue and dequeue, so checkpoints can tell which
+    // queues changed since they last looked
+    uint64_t getVersion() const { return version; }
+
 private:
     char laneId;               // A, B, C, or D
     int laneNumber;            // 1, 2, or 3
     bool isPriority;           // Is this a priority lane (AL2)
     int priority;              // Current priority (higher means served first)
     Queue<Vehicle*> vehicleQueue; // Queue for vehicles in the lane
+    uint64_t version;          // Queue changes so far
 };
 
 #endif // LANE_H
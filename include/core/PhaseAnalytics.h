@@ -0,0 +1,105 @@
+// FILE: include/core/PhaseAnalytics.h
+#ifndef PHASE_ANALYTICS_H
+#define PHASE_ANALYTICS_H
+
+#include <cstdint>
+#include <deque>
+#include <vector>
+#include "core/Lane.h"
+#include "core/TrafficLight.h"
+
+// How well one junction's light uses its green time, measured step by step.
+//
+// A green phase serves the lanes of its road except the free lane 3, which
+// moves on any light. Vehicles in those lanes wait until they pass the stop
+// line; a step of green counts as wasted when none was waiting and none
+// passed it, otherwise it is used. Discharged vehicles are those that passed
+// the stop line during the green, and the residual queue is what was still
+// waiting when the green ended. A cycle runs from the start of one A green
+// to the next (in priority mode that is one A green and one ALL_RED).
+//
+// Crossings are found by counting the vehicles past the stop line in each
+// road's served lanes every step, so the manager reports the ones that
+// leave those lanes (onExit()) to keep the counts right.
+class PhaseAnalytics {
+public:
+    // Green phases A-D
+    static constexpr int PHASE_COUNT = 4;
+
+    // Completed cycles kept for getRecentCycles()
+    static constexpr size_t RECENT_CYCLES = 64;
+
+    // One green phase, summed over its greens
+    struct Figures {
+        uint64_t greenMs;
+        uint64_t wastedMs;          // Green with nothing to serve
+        uint64_t discharged;
+        uint64_t greens;            // Greens that have ended
+        uint64_t residual;          // Vehicles left at the ends of those greens
+
+        void add(const Figures& other);
+
+        uint64_t getUsedMs() const { return greenMs - wastedMs; }
+        double getWastedShare() const { return greenMs ? static_cast<double>(wastedMs) / greenMs : 0.0; }
+        double getDischargeRate() const {
+            return greenMs ? static_cast<double>(discharged) * 1000.0 / greenMs : 0.0;
+        }
+        double getMeanResidual() const { return greens ? static_cast<double>(residual) / greens : 0.0; }
+    };
+
+    // Phases and ALL_RED time over a span: one cycle, or everything
+    struct Summary {
+        uint64_t startMs;
+        uint64_t totalMs;
+        uint64_t allRedMs;
+        uint64_t cycles;            // Completed cycles in the span
+        Figures phases[PHASE_COUNT];
+
+        void add(const Summary& other);
+
+        // All phases together
+        Figures getGreen() const;
+        double getAllRedShare() const { return totalMs ? static_cast<double>(allRedMs) / totalMs : 0.0; }
+    };
+
+    PhaseAnalytics();
+
+    // Account one simulation step of delta ms that ran in light state
+    // state and ended at time now, with the light already updated to
+    // nextState and the junction's lanes as they are after the step. True
+    // if the step completed a cycle (see getLastCycle()).
+    bool step(TrafficLight::State state, TrafficLight::State nextState, uint32_t delta, uint64_t now,
+              const std::vector<Lane*>& lanes);
+
+    // A vehicle past the stop line was removed from one of the junction's
+    // lanes since the last step
+    void onExit(const Lane& lane);
+
+    // Everything since construction or reset()
+    const Summary& getTotals() const { return totals; }
+
+    // Completed cycles, oldest first (at most RECENT_CYCLES)
+    const std::deque<Summary>& getRecentCycles() const { return recentCycles; }
+    const Summary& getLastCycle() const { return recentCycles.back(); }
+
+    void reset();
+
+    // Phase of a green light state, or -1 for ALL_RED
+    static int phaseOf(TrafficLight::State state);
+
+    // Phase serving a lane, or -1 for the free lane 3
+    static int phaseServing(const Lane& lane);
+
+private:
+    Summary totals;
+    Summary cycle;                  // Current cycle
+    bool inCycle;                   // False until the first A green
+    std::deque<Summary> recentCycles;
+
+    // Per phase: vehicles past the stop line in its served lanes after the
+    // last step, and those removed from them since
+    uint32_t passed[PHASE_COUNT];
+    uint32_t exited[PHASE_COUNT];
+};
+
+#endif // PHASE_ANALYTICS_H
@@ -0,0 +1,141 @@
+// FILE: include/core/RoadNetwork.h
+#ifndef ROAD_NETWORK_H
+#define ROAD_NETWORK_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <unordered_map>
+
+// Road network description: junctions, their approaches and lanes, allowed
+// movements and the links between junctions. Everything is stored in flat,
+// index-based tables so lane lookup is pure arithmetic.
+//
+// File format (one record per line, '#' starts a comment):
+//   junction <id> <x> <y> [approaches] [lanesPerApproach]
+//   link     <fromId> <exitRoad> <toId> <entryRoad> <lengthMeters>
+//   movement <junctionId> <road><lane> <STRAIGHT|LEFT|RIGHT>[,...]
+//
+// Roads are named 'A', 'B', 'C', ... in approach order (A=North, B=East,
+// C=South, D=West for the standard junction). A link means vehicles leaving
+// junction fromId on exitRoad arrive at junction toId on entryRoad.
+//
+// Junction indices do not follow file order: by default junctions are
+// numbered along a Hilbert curve over their coordinates, so neighbouring
+// junctions (and their lanes, which are stored per junction) sit next to
+// each other in memory. Use findJunction() to map file ids to indices.
+class RoadNetwork {
+public:
+    static constexpr uint32_t INVALID_INDEX = 0xFFFFFFFF;
+
+    // Movement bits for LaneInfo::movements
+    enum Movement : uint8_t {
+        MOVE_STRAIGHT = 0x01,
+        MOVE_LEFT = 0x02,
+        MOVE_RIGHT = 0x04
+    };
+
+    struct Junction {
+        uint32_t id;               // Id used in the network file
+        float x;                   // Map coordinates (meters)
+        float y;
+        uint32_t firstLane;        // Index of the junction's first lane
+        uint32_t firstApproach;    // Index into the approach tables
+        uint16_t approachCount;
+        uint16_t lanesPerApproach;
+    };
+
+    struct LaneInfo {
+        uint32_t junction;         // Owning junction index
+        char road;                 // 'A', 'B', ...
+        uint8_t laneNumber;        // 1-based
+        uint8_t movements;         // Movement bits
+    };
+
+    struct Link {
+        uint32_t fromJunction;
+        uint32_t toJunction;
+        char exitRoad;
+        char entryRoad;
+        float length;              // Meters
+    };
+
+    RoadNetwork();
+
+    // Load a network description file; replaces any current contents.
+    // With hilbertOrder false junctions keep their file order.
+    bool loadFromFile(const std::string& path, bool hilbertOrder = true);
+
+    // Build the standard single four-way junction (A-D, three lanes each)
+    void buildDefault();
+
+    // Table sizes
+    size_t getJunctionCount() const { return junctions.size(); }
+    size_t getLaneCount() const { return lanes.size(); }
+    size_t getLinkCount() const { return links.size(); }
+
+    // Table access
+    const Junction& getJunction(size_t index) const { return junctions[index]; }
+    const LaneInfo& getLane(size_t index) const { return lanes[index]; }
+    const Link& getLink(size_t index) const { return links[index]; }
+
+    // Lane index for a junction/road/lane triple (INVALID_INDEX if out of range)
+    uint32_t laneIndex(uint32_t junction, char road, int laneNumber) const {
+        if (junction >= junctions.size()) return INVALID_INDEX;
+        const Junction& j = junctions[junction];
+        int approach = road - 'A';
+        if (approach < 0 || approach >= j.approachCount ||
+            laneNumber < 1 || laneNumber > j.lanesPerApproach) {
+            return INVALID_INDEX;
+        }
+        return j.firstLane + approach * j.lanesPerApproach + (laneNumber - 1);
+    }
+
+    // Link leaving a junction on the given road (INVALID_INDEX at network edges)
+    uint32_t exitLink(uint32_t junction, char road) const {
+        if (junction >= junctions.size()) return INVALID_INDEX;
+        const Junction& j = junctions[junction];
+        int approach = road - 'A';
+        if (approach < 0 || approach >= j.approachCount) return INVALID_INDEX;
+        return approachExitLinks[j.firstApproach + approach];
+    }
+
+    // Junction index for a file id (INVALID_INDEX if unknown)
+    uint32_t findJunction(uint32_t id) const;
+
+    // Index of the first junction in the file; external arrivals enter here
+    uint32_t getEntryJunction() const { return entryJunction; }
+
+    // Split junctions into contiguous index ranges with roughly equal lane
+    // counts. Returns parts + 1 boundaries; range i is [b[i], b[i + 1]).
+    std::vector<uint32_t> partitionJunctions(size_t parts) const;
+
+    // Default movement bits for a lane number (L1 incoming, L2 straight/left, L3 left)
+    static constexpr uint8_t defaultMovements(int laneNumber) {
+        return laneNumber == 2 ? (MOVE_STRAIGHT | MOVE_LEFT)   // L2: straight or left
+             : laneNumber == 3 ? MOVE_LEFT                     // L3: free left turn
+             : 0;                                              // L1: incoming only
+    }
+
+    // Position of a point on a Hilbert curve over a 65536 x 65536 grid
+    static uint64_t hilbertIndex(uint32_t x, uint32_t y);
+
+    // Description of the last load failure
+    const std::string& getLastError() const { return lastError; }
+
+private:
+    std::vector<Junction> junctions;
+    std::vector<LaneInfo> lanes;
+    std::vector<Link> links;
+    std::vector<uint32_t> approachExitLinks;     // Per approach: outgoing link index
+    std::unordered_map<uint32_t, uint32_t> junctionById;
+    uint32_t entryJunction;
+    std::string lastError;
+
+    // Append a junction and its lane rows
+    uint32_t addJunction(uint32_t id, float x, float y, int approachCount, int lanesPerApproach);
+
+    void clear();
+};
+
+#endif // ROAD_NETWORK_H
@@ -0,0 +1,105 @@
+// FILE: include/core/RoutingTable.h
+#ifndef ROUTING_TABLE_H
+#define ROUTING_TABLE_H
+
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+#include "core/RoadNetwork.h"
+
+class ThreadPool;
+
+// All-pairs next-hop routing for a RoadNetwork.
+//
+// For every destination junction a shortest-path tree is computed with
+// Dijkstra on the reversed link graph. The result is kept as a 16-bit exit
+// approach per junction x destination, so a routing decision is one table
+// lookup. Link costs can be changed later (e.g. from observed congestion);
+// only destinations whose trees are affected are recomputed.
+class RoutingTable {
+public:
+    static constexpr uint16_t NO_ROUTE = 0xFFFF;
+
+    RoutingTable();
+
+    // Compute tables for a network using link length / Constants::LINK_SPEED
+    // as the initial cost (seconds)
+    void build(const RoadNetwork& network);
+
+    // Pool that builds and cost updates spread destinations over (not owned;
+    // nullptr computes on the calling thread)
+    void setThreadPool(ThreadPool* pool) { threadPool = pool; }
+
+    // Exit approach (0 = road 'A') to take at a junction to reach a destination,
+    // NO_ROUTE if unreachable or already there
+    uint16_t nextHop(uint32_t junction, uint32_t destination) const {
+        return hops[static_cast<size_t>(destination) * junctionCount + junction];
+    }
+
+    // Exit road to take at a junction ('\0' if there is no route)
+    char nextRoad(uint32_t junction, uint32_t destination) const {
+        uint16_t hop = nextHop(junction, destination);
+        return hop == NO_ROUTE ? '\0' : static_cast<char>('A' + hop);
+    }
+
+    // Travel cost (seconds) from a junction to a destination, infinity if unreachable
+    float getDistance(uint32_t junction, uint32_t destination) const {
+        return distances[static_cast<size_t>(destination) * junctionCount + junction];
+    }
+
+    // Current cost of a link
+    float getLinkCost(uint32_t link) const { return linkCosts[link]; }
+
+    // Change one link cost; returns the number of destinations recomputed
+    size_t updateLinkCost(uint32_t link, float cost);
+
+    // Change several link costs at once; affected destinations are recomputed
+    // once. The result only depends on the costs, not the order they came in.
+    size_t updateLinkCosts(const std::vector<std::pair<uint32_t, float>>& changes);
+
+    // Change link costs but leave the affected destinations stale until
+    // recomputeStale(), so a run of changes (e.g. a checkpoint chain being
+    // restored) recomputes each destination once. Stale rows must not be read.
+    void deferLinkCosts(const std::vector<std::pair<uint32_t, float>>& changes);
+
+    // Recompute the destinations deferred changes left stale; returns how many
+    size_t recomputeStale();
+
+    bool hasStaleRoutes() const { return staleCount > 0; }
+
+    size_t getJunctionCount() const { return junctionCount; }
+
+    // Bytes held by the tables and link arrays
+    size_t getMemoryBytes() const;
+
+private:
+    size_t junctionCount;
+    ThreadPool* threadPool;
+
+    // Link endpoints and costs, copied from the network
+    std::vector<uint32_t> linkFrom;
+    std::vector<uint32_t> linkTo;
+    std::vector<uint16_t> linkApproach;
+    std::vector<float> linkCosts;
+
+    // Reverse adjacency (CSR): links arriving at each junction
+    std::vector<uint32_t> incomingStart;
+    std::vector<uint32_t> incomingLinks;
+
+    // Destination-major tables: [destination * junctionCount + junction]
+    std::vector<uint16_t> hops;
+    std::vector<float> distances;
+
+    // Destinations whose rows wait for recomputeStale()
+    std::vector<char> stale;
+    size_t staleCount;
+
+    // Recompute the shortest-path tree towards one destination
+    void computeDestination(uint32_t destination);
+
+    // Recompute a set of destinations across the pool's threads
+    void computeDestinations(const std::vector<uint32_t>& destinations);
+};
+
+#endif // ROUTING_TABLE_H
@@ -8,6 +8,8 @@
 #include <SDL3/SDL.h>
 #include "core/Lane.h"
 
+class RenderBackend;
+
 class TrafficLight {
 public:
     enum class State {
@@ -24,8 +26,18 @@ public:
     // Updates the traffic light state based on lane priorities
     void update(const std::vector<Lane*>& lanes);
 
+    // Same, timed by the caller's clock (e.g. simulation time) instead of SDL ticks
+    void update(const std::vector<Lane*>& lanes, uint32_t currentTime);
+
+    // Same, from figures the caller already has: the priority lane (may be
+    // null) and the number of lane-2 lanes and vehicles on them
+    void update(Lane* al2Lane, int laneTwoCount, int laneTwoVehicles, uint32_t currentTime);
+
+    // Start a fresh cycle (ALL_RED, then A) at the given clock time
+    void restart(uint32_t currentTime);
+
     // Renders the traffic lights
-    void render(SDL_Renderer* renderer);
+    void render(RenderBackend* backend);
 
     // Returns the current traffic light state
     State getCurrentState() const { return currentState; }
@@ -39,12 +51,52 @@ public:
     // Checks if the specific lane gets green light
     bool isGreen(char lane) const;
 
+    // Clock time of the last state change
+    uint32_t getLastStateChangeTime() const { return lastStateChangeTime; }
+
+    // Check if AL2 is being served in priority mode
+    bool isInPriorityMode() const { return isPriorityMode; }
+
+    // Milliseconds from currentTime until the state can next change. Green
+    // phases grow with the queues, so this is the earliest possible change.
+    uint32_t getTimeToNextChange(uint32_t currentTime) const;
+
+    // Controller state as stored in checkpoints: the states, the time of
+    // the last change and the priority mode flags
+    struct Snapshot {
+        uint32_t lastStateChangeTime;
+        uint32_t priorityModeStartTime;
+        uint8_t currentState;       // State values
+        uint8_t nextState;
+        uint8_t isPriorityMode;
+        uint8_t shouldResumeNormalMode;
+        uint8_t forceAGreen;
+        uint8_t reserved[3];
+
+        bool operator==(const Snapshot& other) const {
+            return lastStateChangeTime == other.lastStateChangeTime &&
+                   priorityModeStartTime == other.priorityModeStartTime &&
+                   currentState == other.currentState && nextState == other.nextState &&
+                   isPriorityMode == other.isPriorityMode &&
+                   shouldResumeNormalMode == other.shouldResumeNormalMode &&
+                   forceAGreen == other.forceAGreen;
+        }
+        bool operator!=(const Snapshot& other) const { return !(*this == other); }
+    };
+
+    Snapshot getSnapshot() const;
+
+    // Continue from a saved state instead of restarting the cycle
+    void restore(const Snapshot& snapshot);
+
 private:
     State currentState;
     State nextState;
 
     // Timing for the green and red states
     const int allRedDuration = 2000; // 2 seconds for all red
+    const int minGreenDuration = 3000; // Green with empty queues
+    const int priorityGreenDuration = 6000; // A green in priority mode
 
     // Last state change time in milliseconds
     uint32_t lastStateChangeTime;
@@ -56,15 +108,15 @@ private:
     uint32_t priorityModeStartTime;
 
     // Helper function to calculate average vehicle count
-    float calculateAverageVehicleCount(const std::vector<Lane*>& lanes);
+    float calculateAverageVehicleCount(Lane* al2Lane, int laneTwoCount, int laneTwoVehicles);
 
     // Modern UI drawing functions
-    void drawTrafficControlCenter(SDL_Renderer* renderer);
-    void drawJunctionLight(SDL_Renderer* renderer, int x, int y, char roadId, bool isGreen);
-    void drawStateTimer(SDL_Renderer* renderer);
-    void drawHolographicLight(SDL_Renderer* renderer, int x, int y, int size, bool isActive);
-    void drawPanelText(SDL_Renderer* renderer, const char* text, int x, int y);
-    void drawPanelChar(SDL_Renderer* renderer, char c, int x, int y);
+    void drawTrafficControlCenter(RenderBackend* backend);
+    void drawJunctionLight(RenderBackend* backend, int x, int y, char roadId, bool isGreen);
+    void drawStateTimer(RenderBackend* backend);
+    void drawHolographicLight(RenderBackend* backend, int x, int y, int size, bool isActive);
+    void drawPanelText(RenderBackend* backend, const char* text, int x, int y);
+    void drawPanelChar(RenderBackend* backend, char c, int x, int y);
 };
 
 #endif // TRAFFIC_LIGHT_H
@@ -2,12 +2,15 @@
 #ifndef VEHICLE_H
 #define VEHICLE_H
 
+#include <atomic>
+#include <cstdint>
 #include <string>
 #include <SDL3/SDL.h>
 #include <ctime>
 #include <vector>
 #include <sstream>
 #include "utils/DebugLogger.h"
+#include "visualization/RenderBackend.h"
 
 // Define all enums here instead of just forward declaring them
 enum class Destination {
@@ -41,8 +44,15 @@ public:
     Vehicle(const std::string& id, char lane, int laneNumber, bool isEmergency = false);
     ~Vehicle();
 
+    // Vehicle objects currently allocated, for leak tracking
+    static int64_t getLiveCount() { return liveCount.load(std::memory_order_relaxed); }
+
     // Getters and setters
     std::string getId() const;
+
+    // Number given at construction, unique among live vehicles of the
+    // process (wraps after 2^32 vehicles)
+    uint32_t getSerial() const { return serial; }
     char getLane() const;
     void setLane(char lane);
     int getLaneNumber() const;
@@ -52,7 +62,29 @@ public:
 
     // Destination control
     void setDestination(Destination dest);
-    Destination getDestination() const;
+    Destination getDestination() const { return destination; }
+
+    // Target junction index for multi-junction routing (0xFFFFFFFF if unassigned)
+    uint32_t getRouteTarget() const { return routeTarget; }
+    void setRouteTarget(uint32_t target) { routeTarget = target; }
+
+    // Simulation time (ms) the vehicle joined its current lane queue
+    uint64_t getQueuedAt() const { return queuedAt; }
+    void setQueuedAt(uint64_t time) { queuedAt = time; }
+
+    // Fuel and emissions so far, up to the previous step (maintained by
+    // EmissionsBatch, see core/Emissions.h)
+    struct Energy {
+        float lastX;            // Position at the last step
+        float lastY;
+        float speed;            // m/s
+        float fuelMl;
+        float energyKj;
+        float co2G;
+        uint32_t batchIndex;    // Entry in the last step's batch
+    };
+    const Energy& getEnergy() const { return energy; }
+    Energy& getEnergy() { return energy; }
 
     // Animation related
     float getAnimationPos() const;
@@ -61,16 +93,24 @@ public:
     void setTurning(bool turning);
     float getTurnProgress() const;
     void setTurnProgress(float progress);
-    float getTurnPosX() const;
+    float getTurnPosX() const { return turnPosX; }
     void setTurnPosX(float x);
-    float getTurnPosY() const;
+    float getTurnPosY() const { return turnPosY; }
     void setTurnPosY(float y);
 
     // Update vehicle position
     void update(uint32_t delta, bool isGreenLight, float targetPos);
 
+    // Same, with the step's arithmetic done in a Kinematics number type
+    // (FloatKinematics or FixedKinematics, see core/Kinematics.h)
+    template<typename Kinematics>
+    void step(uint32_t delta, bool isGreenLight);
+
+    // Position in the lane queue (0 = front); sets the red-light stop spacing
+    void setQueuePosition(int position) { queuePos = position; }
+
     // Render vehicle
-    void render(SDL_Renderer* renderer, SDL_Texture* vehicleTexture, int queuePos);
+    void render(RenderBackend* backend, RenderBackend::TextureId vehicleTexture, int queuePos);
 
     // Calculate turn path
     void calculateTurnPath(float startX, float startY, float controlX, float controlY,
@@ -82,8 +122,43 @@ public:
     // Check if vehicle has exited the screen
     bool hasExited() const { return state == VehicleState::EXITED; }
 
+    // Past the stop line (waypoint 1) and through or out of the junction
+    bool hasPassedStopLine() const { return currentWaypoint > 1; }
+
+    // Where the vehicle is on its path: everything step() moves on except
+    // the queue position, which is set again before every step. Checkpoints
+    // save it so restored vehicles carry on instead of starting over.
+    struct Motion {
+        float posX;
+        float posY;
+        float animPos;
+        float turnProgress;
+        uint32_t waypoint;
+        char lane;              // Exit road once through the junction
+        uint8_t laneNumber;
+        uint8_t direction;      // Direction value
+        uint8_t state;          // VehicleState value
+        uint8_t turning;
+        uint8_t reserved[3];
+    };
+
+    Motion getMotion() const;
+
+    // Continue from a saved Motion. The path must be the one the vehicle
+    // was saved on, i.e. same construction lane and destination.
+    void setMotion(const Motion& motion);
+
+    // Set by step() whenever it moves the vehicle, until cleared; delta
+    // checkpoints use it to write only the vehicles that moved
+    bool hasMotionChanged() const { return motionChanged; }
+    void clearMotionChanged() { motionChanged = false; }
+
 private:
+    static std::atomic<int64_t> liveCount;
+    static std::atomic<uint32_t> nextSerial;
+
     std::string id;
+    uint32_t serial;
     char lane;
     int laneNumber;
     bool isEmergency;
@@ -99,12 +174,16 @@ private:
 
     // Destination (where the vehicle is heading)
     Destination destination;
+    uint32_t routeTarget;
+    uint64_t queuedAt;
+    Energy energy;
 
     // Current direction of travel
     Direction currentDirection;
 
     // Vehicle state
     VehicleState state;
+    bool motionChanged;
 
     // Waypoints for movement
     std::vector<Point> waypoints;
@@ -114,7 +193,7 @@ private:
     float easeInOutQuad(float t) const;
 
     // Helper for drawing triangles (SDL3 compatible)
-    void SDL_RenderFillTriangleF(SDL_Renderer* renderer, float x1, float y1, float x2, float y2, float x3, float y3);
+    void fillTriangle(RenderBackend* backend, float x1, float y1, float x2, float y2, float x3, float y3);
 };
 
 #endif // VEHICLE_H
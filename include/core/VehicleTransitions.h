@@ -0,0 +1,46 @@
+// FILE: include/core/VehicleTransitions.h
+#ifndef VEHICLE_TRANSITIONS_H
+#define VEHICLE_TRANSITIONS_H
+
+#include <cstddef>
+#include <cstdint>
+#include "core/Vehicle.h"
+
+// Transition table for a vehicle crossing the standard four-way junction.
+//
+// A vehicle's route is fixed by its entry road, lane number and destination;
+// the only event is reaching the next waypoint of that route. The table maps
+// (road, movement, waypoint) to the actions to take and the state to enter,
+// so Vehicle::update does one lookup per waypoint instead of walking nested
+// conditions. It is generated at compile time from the junction's turn
+// routes (StandardJunction::ROUTES); adding a movement means adding a route
+// there and a path below, not another branch in the update.
+class VehicleTransitions {
+public:
+    static constexpr int ROADS = 4;
+    static constexpr int MOVEMENTS = 3;        // L2 straight, L2 left, L3 left
+    static constexpr int MAX_WAYPOINTS = 8;
+
+    // Action bits
+    enum Action : uint8_t {
+        ACTION_NONE = 0x00,
+        ACTION_START_TURN = 0x01,              // Enter the turn, turnProgress restarts
+        ACTION_EXIT = 0x02                     // Leave the junction onto exitRoad lane 1
+    };
+
+    struct Transition {
+        uint8_t actions;
+        VehicleState nextState;                // Only meaningful when actions != 0
+        char exitRoad;
+        Direction exitDirection;
+    };
+
+    // Transition for a vehicle on road/laneNumber heading for destination
+    // that has just reached the given waypoint (no actions if none applies)
+    static const Transition& onWaypoint(char road, int laneNumber, Destination destination, size_t waypoint);
+
+    // Direction of travel for vehicles on a road ('A' moves down, 'B' left, ...)
+    static Direction directionForRoad(char road);
+};
+
+#endif // VEHICLE_TRANSITIONS_H
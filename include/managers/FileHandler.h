@@ -5,7 +5,11 @@
 #include <string>
 #include <vector>
 #include <mutex>
+#include <atomic>
+#include <thread>
+#include <functional>
 #include "core/Vehicle.h"
+#include "utils/AsyncFileIO.h"
 
 class FileHandler {
 public:
@@ -15,24 +19,55 @@ public:
     // Read vehicles from lane files
     std::vector<Vehicle*> readVehiclesFromFiles();
 
-    // Write lane status to file (for debugging/monitoring)
+    // Queue a lane status line (for debugging/monitoring)
     void writeLaneStatus(char laneId, int laneNumber, int vehicleCount, bool isPriority);
 
+    // Write queued status lines in one batch
+    void flushStatus();
+
     // Check if files exist/are readable
     bool checkFilesExist();
 
     // Create directories and empty files if they don't exist
     bool initializeFiles();
 
+    // Watch the lane files and call onChange, on a watcher thread, whenever
+    // one is written. Returns false where change notification isn't
+    // available (non-Linux); hasChanges() then always reports true.
+    bool startWatching(std::function<void()> onChange);
+
+    // Stop the watcher thread
+    void stopWatching();
+
+    // Check if the lane files may have new vehicles since the last takeChanges()
+    bool hasChanges() const;
+
+    // Same, and clear the flag before the files are read
+    bool takeChanges();
+
 private:
     std::string dataPath;
     std::mutex mutex;
 
+    // Change notification (inotify) state
+    int watchFd;
+    int stopFd;
+    std::thread watcher;
+    std::atomic<bool> changed;
+    std::function<void()> changeCallback;
+
+    // Batched reads of the lane files and appends to the status file
+    AsyncFileIO io;
+    int statusFile;
+
+    // Wait for lane file writes until stopped
+    void watchLoop();
+
     // Lane file paths
     std::string getLaneFilePath(char laneId) const;
 
-    // Read vehicles from a specific lane file
-    std::vector<Vehicle*> readVehiclesFromFile(char laneId);
+    // Parse the contents of a lane file and empty it
+    std::vector<Vehicle*> takeVehiclesFromFile(char laneId, const std::string& content);
 
     // Parse a vehicle line from the file
     Vehicle* parseVehicleLine(const std::string& line);
@@ -0,0 +1,135 @@
+// FILE: include/managers/LiveStatus.h
+#ifndef LIVE_STATUS_H
+#define LIVE_STATUS_H
+
+#include <atomic>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "utils/SharedMemory.h"
+
+class TrafficManager;
+
+// Lane counts, light states, phase timers, priority flags and headline
+// figures of a running simulator in a named shared memory region, for any
+// number of local readers. It replaces polling lane_status.txt: the writer
+// updates the region every tick and a read is a copy out of mapped memory,
+// without system calls or locks.
+//
+// The region is a header, then Metrics, one JunctionStatus per junction and
+// one LaneStatus per lane (network lane table order). The header's sequence
+// is a seqlock: the writer makes it odd, copies a snapshot it has already
+// built into the region, and makes it even again. A reader copies the
+// region out and keeps the copy if the sequence was even and unchanged
+// around it, otherwise it tries again. The writer never waits for readers.
+class LiveStatus {
+public:
+    static constexpr uint32_t MAGIC = 0x534C4A54;       // "TJLS"
+    static constexpr uint32_t VERSION = 1;
+
+    // LaneStatus::flags
+    static constexpr uint8_t LANE_PRIORITY = 0x01;      // The priority lane (AL2)
+    static constexpr uint8_t LANE_PRIORITIZED = 0x02;   // ...currently being prioritized
+
+    struct Header {
+        uint32_t magic;
+        uint32_t version;
+        uint32_t junctionCount;
+        uint32_t laneCount;
+        uint64_t regionBytes;
+        uint64_t writerPid;
+        uint8_t reserved[32];
+        alignas(64) std::atomic<uint64_t> sequence;     // Odd while the writer copies
+        uint8_t padding[56];
+    };
+
+    // Headline figures (64 bytes)
+    struct Metrics {
+        uint64_t tick;                  // Snapshots published
+        uint64_t simulationTimeMs;
+        uint64_t publishedNanos;        // steady_clock (CLOCK_MONOTONIC) at publish
+        uint64_t exited;                // Vehicles that left owned junctions
+        uint32_t vehicles;              // Queued plus travelling between junctions
+        uint32_t queued;                // Queued in owned lanes
+        uint32_t delayP50Ms;            // Junction delay percentiles
+        uint32_t delayP90Ms;
+        uint32_t delayP99Ms;
+        uint32_t delayMaxMs;
+        float co2Kg;                    // Since start
+        float fuelLitres;
+    };
+
+    // Light and phase timers of one junction (16 bytes)
+    struct JunctionStatus {
+        uint8_t light;                  // TrafficLight::State
+        uint8_t nextLight;
+        uint8_t priorityMode;           // 1 while AL2 is served in priority mode
+        uint8_t owned;                  // 0 for junctions of other partitions
+        uint32_t phaseElapsedMs;        // Time in the current light state
+        uint32_t earliestChangeMs;      // Earliest time to the next change
+        uint32_t vehicles;              // Queued at the junction
+    };
+
+    // One lane (16 bytes)
+    struct LaneStatus {
+        char road;
+        uint8_t laneNumber;
+        uint8_t flags;                  // LANE_*
+        uint8_t reserved;
+        uint32_t junction;
+        uint32_t vehicles;
+        int32_t priority;
+    };
+
+    // A consistent copy of the region
+    struct Snapshot {
+        Metrics metrics;
+        std::vector<JunctionStatus> junctions;
+        std::vector<LaneStatus> lanes;
+    };
+
+    LiveStatus();
+
+    // Create the region for a manager's network (after initialize()) and
+    // publish its current state
+    bool create(const std::string& name, const TrafficManager& manager);
+
+    // Remove the region
+    void close();
+
+    bool isOpen() const { return header != nullptr; }
+
+    // Copy the manager's state into the region; call once per tick
+    void publish(const TrafficManager& manager);
+
+    const std::string& getLastError() const { return lastError; }
+
+    // Reader side: map a region by name (read-only)
+    bool open(const std::string& name);
+
+    // Reader side: copy the region out. False if the writer kept it busy
+    // for every one of the attempts (e.g. it died while copying).
+    bool read(Snapshot& snapshot, int attempts = 1000) const;
+
+    // Reader side: retries the last read() needed (0 if none)
+    uint64_t getRetries() const { return retries; }
+
+private:
+    SharedMemory region;
+    Header* header;
+    bool writer;
+    std::string lastError;
+    mutable uint64_t retries;
+
+    // Writer: snapshot built outside the seqlock, and the delay count the
+    // cached percentiles are for
+    std::vector<char> staging;
+    uint64_t percentileCount;
+
+    static size_t payloadBytes(uint32_t junctionCount, uint32_t laneCount);
+
+    char* payload() const { return reinterpret_cast<char*>(header) + sizeof(Header); }
+};
+
+#endif // LIVE_STATUS_H
@@ -0,0 +1,128 @@
+// FILE: include/managers/PartitionCluster.h
+#ifndef PARTITION_CLUSTER_H
+#define PARTITION_CLUSTER_H
+
+#include <atomic>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <sys/types.h>
+
+#include "utils/SharedMemory.h"
+#include "utils/SpscRing.h"
+
+class TrafficManager;
+
+// Runs one network as several worker processes on the same machine.
+//
+// The coordinator (the calling process) loads nothing itself: it creates a
+// shared memory region, forks one worker per partition and then drives
+// lock-step simulation steps. Each worker runs a TrafficManager restricted to
+// a contiguous junction range (RoadNetwork::partitionJunctions) and hands
+// vehicles crossing into another partition over a single-producer ring per
+// ordered partition pair. Rings are drained at the start of the next step.
+//
+// Workers checkpoint every checkpointInterval steps: a full base checkpoint
+// every baseInterval checkpoints and deltas against the previous one in
+// between, so a restore reads one base and at most baseInterval - 1 deltas.
+// If a worker dies, the coordinator rolls every partition back to the
+// newest checkpoint they all have, restarts the dead worker and continues.
+class PartitionCluster {
+public:
+    static constexpr uint32_t MAX_PARTITIONS = 64;
+
+    struct Options {
+        std::string networkPath;
+        std::string tracePath;              // Arrival trace replayed at the entry junction
+        double replaySpeed = 1.0;
+        uint32_t partitions = 2;
+        uint32_t steps = 1000;
+        uint32_t stepMs = 16;               // Simulated time per step
+        uint32_t checkpointInterval = 100;  // Steps between checkpoints
+        uint32_t baseInterval = 10;         // Checkpoints per full one (1: no deltas)
+        std::string checkpointDir = ".";
+        uint32_t ringCapacity = 4096;       // Transfers per partition pair
+        uint32_t reportInterval = 100;      // Steps between metric reports
+        int crashPartition = -1;            // Fault injection for testing
+        uint32_t crashStep = 0;
+    };
+
+    // Vehicle handed between partitions (one cache line)
+    struct TransferRecord {
+        uint32_t step;          // Step the vehicle left its partition
+        uint32_t laneIndex;     // Network lane it is heading for
+        uint32_t routeTarget;
+        uint8_t destination;
+        uint8_t isEmergency;
+        uint8_t idLength;
+        uint8_t reserved;
+        uint64_t arrivalTime;
+        char vehicleId[40];
+    };
+
+    // Per-worker state published to the coordinator
+    struct alignas(64) WorkerSlot {
+        std::atomic<uint32_t> ready;
+        std::atomic<uint32_t> doneStep;
+        std::atomic<uint32_t> epoch;
+        std::atomic<uint32_t> checkpointStep;
+        std::atomic<uint64_t> vehicles;
+        std::atomic<uint64_t> exited;
+        std::atomic<uint64_t> sent;
+        std::atomic<uint64_t> received;
+    };
+
+    // Control block at the start of the shared region
+    struct Control {
+        std::atomic<uint32_t> step;          // Highest step workers may run
+        std::atomic<uint32_t> epoch;         // Bumped on every rollback
+        std::atomic<uint32_t> rollbackStep;  // Checkpoint step to restore
+        std::atomic<uint32_t> stop;
+        WorkerSlot workers[MAX_PARTITIONS];
+    };
+
+    explicit PartitionCluster(const Options& options);
+    ~PartitionCluster();
+
+    // Run the coordinator; returns a process exit code
+    int run();
+
+private:
+    Options options;
+    SharedMemory region;
+    Control* control;
+    std::vector<SpscRing<TransferRecord>> rings;   // [from * partitions + to]
+    std::vector<pid_t> workerPids;
+
+    // Set up the shared region and rings
+    bool createRegion();
+
+    // Fork a worker; restore makes it load its checkpoint before stepping
+    bool spawnWorker(uint32_t index, bool restore);
+
+    // Body of a worker process (never returns)
+    void runWorker(uint32_t index, bool restore);
+
+    // Reap dead workers; returns the index of one that died, or -1
+    int checkCrashes();
+
+    // Roll all partitions back after a worker died; returns the step to resume at (0 on failure)
+    uint32_t recover(uint32_t crashed);
+
+    // Print aggregated metrics
+    void report(uint32_t step, double elapsedSeconds) const;
+
+    // Checkpoint of a partition at a step (.ckpt for full, .delta for deltas)
+    std::string checkpointPath(uint32_t index, uint32_t step) const;
+
+    // Step of the full checkpoint the checkpoint at step builds on
+    uint32_t chainStart(uint32_t step) const;
+
+    // Load the checkpoint at step: its base, then the deltas up to it
+    bool restoreCheckpoint(TrafficManager& manager, uint32_t index, uint32_t step) const;
+
+    // Delete a partition's base at start and the deltas that follow it
+    void removeChain(uint32_t index, uint32_t start) const;
+};
+
+#endif // PARTITION_CLUSTER_H
@@ -0,0 +1,145 @@
+// FILE: include/managers/SimServer.h
+#ifndef SIM_SERVER_H
+#define SIM_SERVER_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "utils/ResultCache.h"
+
+class TrafficManager;
+
+// Long-running simulation server on a Unix domain socket.
+//
+// Clients write fixed-size JobRecords and read one ResultRecord back per
+// job, in completion order (match them by jobId). Jobs from all connections
+// share one queue served by a pool of worker threads. Each worker keeps a
+// loaded TrafficManager per network file and reset()s it between jobs, so a
+// job pays for neither network loading, lane file setup nor log truncation.
+//
+// A job generates Poisson arrivals from its seed with the lane mix of
+// traffic_generator, steps the model headless for its duration and reports
+// queue and throughput figures. Results depend only on the job record, not
+// on which worker ran it or what ran before, so with a cache directory set
+// repeated jobs are answered from a ResultCache without running.
+class SimServer {
+public:
+    static constexpr uint32_t JOB_MAGIC = 0x424A4A54;     // "TJJB"
+    static constexpr uint32_t FLAG_FIXED_POINT = 0x01;
+    static constexpr size_t MAX_NETWORK_PATH = 224;
+
+    // Status codes in ResultRecord
+    static constexpr int32_t STATUS_OK = 0;
+    static constexpr int32_t STATUS_BAD_JOB = -1;
+    static constexpr int32_t STATUS_NETWORK = -2;
+
+    // Scenario request (256 bytes)
+    struct JobRecord {
+        uint32_t magic;
+        uint32_t jobId;
+        uint32_t seed;
+        uint32_t durationMs;          // Simulated time to run
+        uint32_t stepMs;              // Simulated time per step
+        float ratePerMinute;          // Mean arrivals per minute
+        uint32_t flags;               // FLAG_*
+        uint32_t reserved;
+        char networkPath[MAX_NETWORK_PATH];   // Empty: standard junction
+    };
+
+    // Outcome of one job (72 bytes)
+    struct ResultRecord {
+        uint32_t jobId;
+        int32_t status;               // STATUS_*
+        uint64_t simulatedMs;
+        uint64_t arrivals;
+        uint64_t exited;
+        uint32_t remaining;           // Vehicles still queued or in transit
+        uint32_t maxQueued;           // Largest vehicle count seen after a step
+        float meanQueued;             // Mean vehicle count over all steps
+        uint32_t steps;
+        uint64_t wallMicros;          // Time the worker spent on the job
+        uint32_t flags;               // RESULT_*
+        float meanPriorityQueued;     // Mean AL2 queue length over all steps
+        float fuelLitres;             // Fuel and CO2 of the run
+        float co2Kg;
+    };
+
+    // Result flags
+    static constexpr uint32_t RESULT_CACHED = 0x01;       // Served from the result cache
+
+    struct Options {
+        std::string socketPath = "simserver.sock";
+        unsigned workers = 0;                    // 0: one per hardware thread
+        std::vector<std::string> warmNetworks;   // Loaded on every worker at startup
+        bool logging = false;
+        std::string cacheDir;                    // Empty: no result cache
+        uint64_t cacheBytes = 256ULL << 20;
+    };
+
+    explicit SimServer(const Options& options);
+    ~SimServer();
+
+    // Serve until SIGINT/SIGTERM; returns a process exit code
+    int run();
+
+    // Client side: connect to a server, or -1
+    static int connectTo(const std::string& socketPath);
+
+private:
+    // One client connection; closed when the client is done and every
+    // result has been written
+    struct Connection {
+        int fd;
+        std::mutex writeMutex;
+        JobRecord partial;            // Job being read (accept loop only)
+        size_t partialBytes;
+        explicit Connection(int fd) : fd(fd), partial(), partialBytes(0) {}
+        ~Connection();
+    };
+
+    struct Job {
+        JobRecord record;
+        std::shared_ptr<Connection> connection;
+    };
+
+    Options options;
+    int listenFd;
+
+    std::mutex queueMutex;
+    std::condition_variable queueReady;
+    std::deque<Job> jobs;
+    bool stopping;
+
+    std::vector<std::thread> workers;
+    std::atomic<uint64_t> jobsDone;
+
+    ResultCache cache;
+
+    // Queue the complete jobs a readable client has sent; false once the
+    // client has closed the connection or sent garbage
+    bool readJobs(const std::shared_ptr<Connection>& connection);
+
+    // Worker thread body
+    void workerLoop();
+
+    // Run one job on a cached manager
+    ResultRecord runJob(const JobRecord& job, std::map<std::string, TrafficManager*>& managers);
+
+    // Result cache key: every input that determines a job's result, including
+    // the network file's contents and the server build (0 if unreadable)
+    static uint64_t cacheKey(const JobRecord& job, const std::string& networkPath);
+
+    // Cached manager for a network, loading it on first use (null on failure)
+    static TrafficManager* managerFor(const std::string& networkPath,
+                                      std::map<std::string, TrafficManager*>& managers);
+};
+
+#endif // SIM_SERVER_H
@@ -0,0 +1,229 @@
+// FILE: include/managers/StateStream.h
+#ifndef STATE_STREAM_H
+#define STATE_STREAM_H
+
+#include <atomic>
+#include <cstdint>
+#include <deque>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+class TrafficManager;
+
+// Live simulation state for viewers in other processes, over a Unix domain
+// socket or loopback TCP.
+//
+// The simulation thread calls publish() after a step. That only copies the
+// vehicles' positions into a buffer; a stream thread (I/O role) compares
+// them with the last frame it encoded and sends the difference to every
+// subscriber. If the stream thread is still busy with the previous step
+// the newer one replaces it, so frames can skip steps but publish() never
+// waits on a subscriber.
+//
+// Wire format (little-endian). On connecting a subscriber receives
+//
+//     u32 magic "TJSS", u32 version, u32 units per pixel
+//
+// then frames, each a u32 payload length followed by the payload:
+//
+//     u8 type ('K' keyframe, 'D' delta), varint sequence number,
+//     varint simulation time (ms), varint light count, u8 state per light,
+//     varint vehicle count, and per vehicle in increasing ID order:
+//         varint (ID gap << 1 | new), zigzag varint x and y,
+//         and for new vehicles: varint lane index, u8 attributes
+//
+// IDs are Vehicle::getSerial(); the gap is from the previous vehicle in
+// the frame (from 0 for the first). Positions are in 1/UNITS_PER_PIXEL
+// pixels. A keyframe lists every vehicle with absolute positions, all new.
+// A delta applies to the frame with the previous sequence number and lists
+// only vehicles that are new (absolute position) or moved (change of
+// position), then a varint count of removed vehicles and their ID gaps.
+// Attributes are the destination in bits 0-1 and bit 2 for emergency
+// vehicles. Lane indices are the network lane table's.
+//
+// Every subscriber has its own queue of frames to send. One that falls more
+// than maxQueuedBytes behind loses the deltas it hasn't started reading
+// and gets the next keyframe once it has caught up, then deltas again. A
+// keyframe is also sent to everyone every keyframeInterval frames.
+class StateStream {
+public:
+    static constexpr uint32_t MAGIC = 0x53534A54;       // "TJSS"
+    static constexpr uint32_t VERSION = 1;
+    static constexpr uint32_t UNITS_PER_PIXEL = 4;
+
+    static constexpr uint8_t FRAME_KEY = 'K';
+    static constexpr uint8_t FRAME_DELTA = 'D';
+
+    static constexpr uint8_t ATTR_DESTINATION = 0x03;
+    static constexpr uint8_t ATTR_EMERGENCY = 0x04;
+
+    struct Options {
+        uint32_t keyframeInterval = 60;             // Frames between keyframes
+        size_t maxQueuedBytes = 1 << 20;            // Per subscriber
+    };
+
+    // Counters since open()
+    struct Stats {
+        uint64_t published;         // publish() calls that copied a step
+        uint64_t frames;            // Frames encoded (steps not skipped)
+        uint64_t keyframes;
+        uint64_t bytesSent;
+        uint64_t deltasDropped;     // Frames dropped for slow subscribers
+        uint64_t subscribers;       // Connected now
+        uint64_t publishNanos;      // Simulation thread time in publish()
+    };
+
+    StateStream();
+    explicit StateStream(const Options& options);
+    ~StateStream();
+
+    // Listen on an address: "tcp:PORT" for loopback TCP (127.0.0.1), or
+    // the path of a Unix domain socket. Starts the stream thread.
+    bool open(const std::string& address);
+
+    // Stop the stream thread and disconnect every subscriber
+    void close();
+
+    bool isOpen() const { return listenFd >= 0; }
+
+    // Hand the state after a step to the stream thread. Cheap, and a no-op
+    // without subscribers.
+    void publish(const TrafficManager& manager);
+
+    Stats getStats() const;
+
+    // One-line summary of getStats()
+    std::string summary() const;
+
+    const std::string& getLastError() const { return lastError; }
+
+    // Client side: connect to an address as given to open(), or -1
+    static int connectTo(const std::string& address);
+
+private:
+    // A vehicle as published: quantized position and what a viewer needs
+    // to draw it
+    struct VehicleState {
+        uint32_t id;
+        int32_t x;
+        int32_t y;
+        uint32_t lane;
+        uint8_t attributes;
+
+        bool operator<(const VehicleState& other) const { return id < other.id; }
+    };
+
+    struct Step {
+        uint64_t time;
+        std::vector<uint8_t> lights;
+        std::vector<VehicleState> vehicles;
+    };
+
+    struct Subscriber {
+        int fd;
+        std::deque<std::shared_ptr<const std::string>> queue;
+        size_t sentOfFront;         // Bytes of queue.front() already sent
+        size_t queuedBytes;
+        bool live;                  // Has a keyframe and every delta since
+
+        explicit Subscriber(int fd) : fd(fd), sentOfFront(0), queuedBytes(0), live(false) {}
+    };
+
+    Options options;
+    int listenFd;
+    int wakePipe[2];
+    std::string socketPath;         // Unlinked on close (Unix sockets)
+    std::string lastError;
+    std::thread thread;
+
+    // Handoff from publish() to the stream thread
+    std::mutex pendingMutex;
+    Step pending;
+    bool hasPending;
+    bool stopping;
+    Step staging;                   // Filled by publish() (simulation thread only)
+
+    // Stream thread state
+    std::vector<Subscriber> subscribers;
+    Step last;                      // Last encoded step, vehicles sorted by ID
+    uint64_t sequence;
+    std::string deltaEntries;       // Scratch for encodeDelta()
+    std::string deltaRemoved;
+
+    std::atomic<uint64_t> subscriberCount;
+    std::atomic<uint64_t> published;
+    std::atomic<uint64_t> frames;
+    std::atomic<uint64_t> keyframes;
+    std::atomic<uint64_t> bytesSent;
+    std::atomic<uint64_t> deltasDropped;
+    std::atomic<uint64_t> publishNanos;
+
+    // Stream thread body
+    void run();
+
+    // Encode a step against the last one and queue it for subscribers
+    void encodeStep(Step& step);
+
+    static void encodeKeyframe(const Step& step, uint64_t sequence, std::string& out);
+    void encodeDelta(const Step& previous, const Step& step, uint64_t sequence, std::string& out);
+
+    // Queue a frame for one subscriber, applying the back-pressure rules
+    void enqueue(Subscriber& subscriber, const std::shared_ptr<const std::string>& frame, bool isKeyframe);
+
+    // Send what the socket takes without blocking; false if it is gone
+    bool flush(Subscriber& subscriber);
+
+    void wake();
+};
+
+// Client side of a state stream: feed it the bytes read from the socket and
+// it keeps the current vehicles, checking that deltas follow on.
+class StateStreamDecoder {
+public:
+    struct Vehicle {
+        int32_t x;                  // 1/UNITS_PER_PIXEL pixels
+        int32_t y;
+        uint32_t lane;
+        uint8_t attributes;         // StateStream::ATTR_*
+    };
+
+    StateStreamDecoder();
+
+    // Consume bytes; false on a malformed stream (see getLastError())
+    bool feed(const char* data, size_t size);
+
+    // State after the last complete frame
+    const std::map<uint32_t, Vehicle>& getVehicles() const { return vehicles; }
+    const std::vector<uint8_t>& getLights() const { return lights; }
+    uint64_t getSimulationTime() const { return simulationTime; }
+    uint64_t getSequence() const { return sequence; }
+
+    // Frames applied, of them keyframes, and the sequence numbers skipped
+    // because the sender dropped deltas
+    uint64_t getFrameCount() const { return frameCount; }
+    uint64_t getKeyframeCount() const { return keyframeCount; }
+    uint64_t getSkippedFrames() const { return skippedFrames; }
+
+    const std::string& getLastError() const { return lastError; }
+
+private:
+    std::string buffer;
+    bool haveHeader;
+    bool synced;                    // Applied a keyframe
+    std::map<uint32_t, Vehicle> vehicles;
+    std::vector<uint8_t> lights;
+    uint64_t simulationTime;
+    uint64_t sequence;
+    uint64_t frameCount;
+    uint64_t keyframeCount;
+    uint64_t skippedFrames;
+    std::string lastError;
+
+    bool applyFrame(const uint8_t* data, size_t size);
+};
+
+#endif // STATE_STREAM_H
@@ -7,20 +7,54 @@
 #include <atomic>
 #include <memory>
 #include <string>
+#include <functional>
 #include <SDL3/SDL.h>
 
 #include "core/Lane.h"
 #include "core/TrafficLight.h"
+#include "core/Junction.h"
+#include "core/Emissions.h"
+#include "core/PhaseAnalytics.h"
+#include "core/RoadNetwork.h"
+#include "core/RoutingTable.h"
 #include "managers/FileHandler.h"
 #include "utils/PriorityQueue.h"
+#include "utils/ArrivalTrace.h"
+#include "utils/LatencyHistogram.h"
+#include "utils/ThreadPool.h"
 
 class TrafficManager {
 public:
+    // A vehicle travelling along a link towards the next junction
+    struct VehicleTransfer {
+        uint64_t arrivalTime;
+        uint32_t laneIndex;
+        uint32_t routeTarget;
+        std::string vehicleId;
+        Destination destination;
+        bool isEmergency;
+
+        // Ties go by lane and id, so the order vehicles come off a link
+        // doesn't depend on how the heap was built (pushed or restored)
+        bool operator>(const VehicleTransfer& other) const {
+            if (arrivalTime != other.arrivalTime) return arrivalTime > other.arrivalTime;
+            if (laneIndex != other.laneIndex) return laneIndex > other.laneIndex;
+            return vehicleId > other.vehicleId;
+        }
+    };
+
     TrafficManager();
     ~TrafficManager();
 
-    // Initialize the manager
-    bool initialize();
+    // Initialize the manager. Without a network file the standard single
+    // four-way junction is built. Without lane files, arrivals only come
+    // from a trace or addArrival().
+    bool initialize(const std::string& networkPath = "", bool useLaneFiles = true);
+
+    // Return to the state right after initialize(): no vehicles, time 0,
+    // lights at the start of their cycle, base route costs. Lets one loaded
+    // network run many scenarios.
+    void reset();
 
     // Start the manager
     void start();
@@ -31,12 +65,40 @@ public:
     // Update the traffic state
     void update(uint32_t delta);
 
-    // Get the lanes for rendering
+    // Check if nothing is queued, travelling or waiting to be read, so the
+    // caller can block until getIdleTimeout() or the next lane file change
+    bool isIdle() const;
+
+    // Milliseconds until the next scheduled event: a light change or a
+    // replayed arrival
+    uint32_t getIdleTimeout() const;
+
+    // Read the lane files only when they change, calling onChange from a
+    // watcher thread to wake an idle caller. False if change notification
+    // isn't available; the files are then polled as before.
+    bool watchLaneFiles(std::function<void()> onChange);
+
+    // Get all lanes, indexed like the network lane table
     const std::vector<Lane*>& getLanes() const;
 
-    // Get the traffic light
+    // Get the lanes of one junction (road-major order)
+    const std::vector<Lane*>& getJunctionLanes(size_t junction) const;
+
+    // Get the lane with the given network lane index
+    Lane* getLane(uint32_t index) const;
+
+    // Get the traffic light of the displayed (entry) junction
     TrafficLight* getTrafficLight() const;
 
+    // Get the traffic light of a junction
+    TrafficLight* getTrafficLight(size_t junction) const;
+
+    // Get the road network
+    const RoadNetwork& getNetwork() const { return network; }
+
+    // Get the next-hop routing tables
+    const RoutingTable& getRouting() const { return routing; }
+
     // Check if a lane is being prioritized
     bool isLanePrioritized(char laneId, int laneNumber) const;
 
@@ -46,18 +108,213 @@ public:
     // Get statistics for display
     std::string getStatistics() const;
 
-    // Find lane by ID and number
+    // Find lane by ID and number on the displayed junction
     Lane* findLane(char laneId, int laneNumber) const;
 
+    // Find lane by junction, road ID and number
+    Lane* findLane(uint32_t junction, char laneId, int laneNumber) const;
+
+    // Replay arrivals from a binary trace instead of polling the lane files.
+    // speed scales trace time against simulation time; startHour seeks into the trace.
+    bool loadArrivalTrace(const std::string& path, double speed = 1.0, int startHour = 0);
+
+    // Queue a vehicle arriving on a road and lane of the entry junction.
+    // False if there is no such lane or it is lane 1 (outgoing).
+    bool addArrival(uint32_t vehicleId, char road, int laneNumber, Destination destination, bool isEmergency);
+
+    // Simulation time in milliseconds (sum of update deltas)
+    uint64_t getSimulationTime() const { return simulationTime; }
+
+    // Only update junctions [first, last) when running as one partition of
+    // a larger network. Vehicles heading outside the range are collected
+    // instead of delivered; see takeOutgoingTransfers().
+    void setPartition(uint32_t first, uint32_t last);
+
+    // Check if a junction is updated by this manager
+    bool ownsJunction(uint32_t junction) const { return junction >= partitionFirst && junction < partitionLast; }
+
+    // Transfers to junctions outside the partition since the last call
+    std::vector<VehicleTransfer> takeOutgoingTransfers();
+
+    // Hand back transfers that couldn't be delivered yet. They come first
+    // in the next takeOutgoingTransfers() and are kept in checkpoints
+    // meanwhile, so a rollback doesn't lose them.
+    void returnOutgoingTransfers(const std::vector<VehicleTransfer>& transfers);
+
+    // Accept a transfer handed over by another partition
+    void acceptTransfer(const VehicleTransfer& transfer);
+
+    // Vehicles travelling towards owned junctions (heap order)
+    const std::vector<VehicleTransfer>& getTransfersInTransit() const { return inTransit; }
+
+    // Vehicles queued in owned lanes plus those travelling towards them,
+    // and those handed back for another partition
+    size_t getVehicleCount() const;
+
+    // Vehicles that have left the network from owned junctions
+    uint64_t getExitedCount() const { return exitedCount; }
+
+    // Junction delay of every vehicle that has cleared an owned junction:
+    // simulation ms from joining a lane queue to leaving the junction.
+    // Cumulative since initialize()/reset(); subtract snapshots for windows.
+    const LatencyHistogram& getDelayHistogram() const { return delayHistogram; }
+
+    // Fuel, tractive energy and CO2 of vehicles at owned junctions since
+    // initialize()/reset() (see core/Emissions.h): all lanes, or one lane
+    // and turn
+    EmissionsBatch::Totals getEmissionTotals() const;
+    const EmissionsBatch::Totals& getEmissionTotals(uint32_t lane, Destination destination) const;
+
+    // Table of the emission totals per lane and turn, with the overall total
+    std::string getEmissionsSummary() const;
+
+    // Green time use of a junction's light, and summed over owned
+    // junctions, since initialize()/reset() (see core/PhaseAnalytics.h)
+    const PhaseAnalytics& getPhaseAnalytics(size_t junction) const { return phaseAnalytics[junction]; }
+    PhaseAnalytics::Summary getPhaseTotals() const;
+
+    // Table of green use per phase over owned junctions, with the last
+    // cycles of the entry junction
+    std::string getPhaseReport() const;
+
+    // Turn emissions accounting off or back on (on by default). Vehicles
+    // start from standing again when it comes back on.
+    void setEmissionsAccounting(bool enabled) {
+        emissionsAccounting = enabled;
+        emissionsBatch.clear();
+        emissionsSteps = 0;
+        emissionsElapsed = 0;
+    }
+
+    // Update vehicles on this many threads (1, the default, keeps everything
+    // on the calling thread). Results do not depend on the thread count.
+    void setWorkerThreads(size_t threads);
+
+    // Keep junctions in network file order instead of numbering them along
+    // the Hilbert curve (see RoadNetwork). Call before initialize().
+    void setHilbertOrder(bool enabled) { hilbertOrder = enabled; }
+
+    // Step vehicles in fixed-point arithmetic (FixedKinematics) so runs are
+    // bit-identical across builds and platforms; float is the default
+    void setFixedPointKinematics(bool enabled) { fixedPointKinematics = enabled; }
+
+    // Save/restore queued vehicles with their motion, in-transit vehicles,
+    // undelivered outgoing transfers, the light controllers of owned
+    // junctions, congestion link costs and the trace replay position, so a
+    // restored run carries on exactly as the saved one would have.
+    bool saveCheckpoint(const std::string& path) const;
+    bool loadCheckpoint(const std::string& path);
+
+    // Incremental checkpoints for long runs. A delta holds only the lanes
+    // whose queues or vehicles changed since the previous checkpoint (saved
+    // or restored, full or delta), the vehicles that went onto or off links
+    // since, any undelivered outgoing transfers and the light controllers
+    // and link costs that changed, so its size follows churn rather than
+    // vehicle count.
+    // Restore with loadCheckpoint() on the full checkpoint, then
+    // applyDeltaCheckpoint() on each delta after it in order; a delta that
+    // doesn't follow the current state is refused.
+    bool saveDeltaCheckpoint(const std::string& path) const;
+    bool applyDeltaCheckpoint(const std::string& path);
+
 private:
-    // Lanes for each road
+    // Junctions, lanes and links
+    RoadNetwork network;
+
+    // Next-hop tables over the network links
+    RoutingTable routing;
+
+    // Lanes for each road, indexed like the network lane table. The Lane
+    // objects sit in one block in that order, so the lanes of neighbouring
+    // junctions are neighbours in memory too.
     std::vector<Lane*> lanes;
+    Lane* laneBlock;
+    bool hilbertOrder;
+
+    // Lanes grouped per junction, and their lane table indices
+    std::vector<std::vector<Lane*>> junctionLanes;
+    std::vector<std::vector<uint32_t>> junctionLaneIndices;
+
+    // Fixed-topology kernels for standard four-way junctions, and each
+    // junction's kernel index (INVALID_INDEX: use the generic lane loops)
+    std::vector<StandardJunction> standardJunctions;
+    std::vector<uint32_t> standardIndex;
 
     // Priority queue for lane management
     PriorityQueue<Lane*> lanePriorityQueue;
 
-    // Traffic light
-    TrafficLight* trafficLight;
+    // Traffic light for each junction
+    std::vector<TrafficLight*> trafficLights;
+
+    // Vehicles between junctions, ordered by arrival time (min-heap)
+    std::vector<VehicleTransfer> inTransit;
+
+    // A junction's controller in a checkpoint: its light and the priority
+    // of its priority lane (A2), which decides when priority mode starts
+    struct LightCheckpoint {
+        TrafficLight::Snapshot light;
+        int32_t lanePriority;
+
+        bool operator!=(const LightCheckpoint& other) const {
+            return light != other.light || lanePriority != other.lanePriority;
+        }
+    };
+
+    // Delta checkpoint baseline: lane versions, light controllers and link
+    // costs at the last checkpoint saved or restored (empty before the
+    // first) and its simulation time, and the transfers pushed onto and
+    // popped off inTransit since. The log is dropped for a full rewrite of
+    // inTransit once it outgrows it. Saving a checkpoint moves the
+    // baseline, hence mutable.
+    mutable std::vector<uint64_t> checkpointLaneVersions;
+    mutable std::vector<LightCheckpoint> checkpointLights;
+    mutable std::vector<float> checkpointLinkCosts;
+    mutable uint64_t checkpointTime;
+    mutable std::vector<VehicleTransfer> transitAdded;
+    mutable std::vector<VehicleTransfer> transitRemoved;
+    mutable bool transitRewrite;
+
+    // 1 for lanes holding a vehicle that moved since the baseline (see
+    // Vehicle::hasMotionChanged), noted after every step
+    mutable std::vector<uint8_t> movedLanes;
+
+    // Partition range and transfers leaving it
+    uint32_t partitionFirst;
+    uint32_t partitionLast;
+    std::vector<VehicleTransfer> outbox;
+    uint64_t exitedCount;
+    LatencyHistogram delayHistogram;
+
+    // Emission totals per lane and turn (lane index * 3 + destination), and
+    // the batch the sampled step's vehicles are collected into. Steps and
+    // milliseconds since the last sample; emissionsSample is set for the
+    // step loops on a sampled step.
+    std::vector<EmissionsBatch::Totals> emissionTotals;
+    EmissionsBatch emissionsBatch;
+    bool emissionsAccounting;
+    bool emissionsSample;
+    uint32_t emissionsSteps;
+    uint32_t emissionsElapsed;
+
+    // Green time analytics per junction
+    std::vector<PhaseAnalytics> phaseAnalytics;
+
+    // A run of vehicles in one lane, updated as one parallel work item,
+    // and where its vehicles go in the emissions batch
+    struct VehicleChunk {
+        Lane* lane;
+        size_t begin;
+        size_t end;
+        bool isGreenLight;
+        bool moved;         // A vehicle of the chunk has moved (set by its task)
+        uint32_t laneIndex;
+        size_t entry;
+    };
+
+    // Workers for the vehicle step (null when single-threaded)
+    ThreadPool* workerPool;
+    std::vector<VehicleChunk> vehicleChunks;
+    bool fixedPointKinematics;
 
     // File handler for reading vehicle data
     FileHandler* fileHandler;
@@ -67,25 +324,91 @@ private:
 
     // Time tracking for periodic operations
     uint32_t lastFileCheckTime;
+    uint32_t lastStatusTime;
+    uint32_t lastDebugTime;
     uint32_t lastPriorityUpdateTime;
+    uint64_t simulationTime;
+    uint64_t lastRouteUpdateTime;
+
+    // Trace replay state
+    ArrivalTrace* arrivalTrace;
+    size_t traceCursor;
+    uint32_t traceStartTime;
+    double replaySpeed;
 
     // Read vehicles from files
     void readVehicles();
 
+    // Enqueue trace arrivals that are due at the current simulation time
+    void replayArrivals();
+
   void limitVehiclesPerLane();
   void preventVehicleOverlap();
 
     // Update lane priorities
     void updatePriorities();
 
+    // Advance the traffic lights of owned junctions after a step of delta
+    // ms, and account the step in their phase analytics
+    void updateLights(uint32_t delta);
+
     // Add a vehicle to the appropriate lane
     void addVehicle(Vehicle* vehicle);
 
+    // Push a transfer onto inTransit, or note one popped off it, for the
+    // next delta checkpoint
+    void pushTransit(const VehicleTransfer& transfer);
+    void logTransitRemoved(const VehicleTransfer& transfer);
+
+    // Make the current state the baseline of the next delta checkpoint
+    void markCheckpoint() const;
+
+    // Note the lane of a vehicle that step() moved
+    void noteMotion(const Vehicle* vehicle, uint32_t laneIndex) {
+        if (vehicle && vehicle->hasMotionChanged()) {
+            movedLanes[laneIndex] = 1;
+        }
+    }
+
+    // Controller state of a junction for a checkpoint, and putting it back
+    LightCheckpoint getLightCheckpoint(uint32_t junction) const;
+    void restoreLight(uint32_t junction, const LightCheckpoint& checkpoint);
+
+    // Set link costs from a checkpoint. The routes they change are recomputed
+    // at the next update, so a base and its deltas recompute them once.
+    void restoreLinkCosts(const std::vector<std::pair<uint32_t, float>>& costs);
+
     // Process vehicles in lanes
     void processVehicles(uint32_t delta);
 
+    // Step vehicles with the given Kinematics number type
+    template<typename Kinematics>
+    void stepVehicles(uint32_t delta);
+
+    // Step vehicles as lane chunks on the worker pool
+    template<typename Kinematics>
+    void stepVehiclesParallel(uint32_t delta);
+
+    // Put a vehicle just stepped into entry of the emissions batch
+    void recordEmissions(size_t entry, Vehicle* vehicle, uint32_t laneIndex) {
+        uint32_t turn = vehicle ? static_cast<uint32_t>(vehicle->getDestination()) : 0;
+        emissionsBatch.set(entry, vehicle, laneIndex * 3 + turn);
+    }
+
+    // Log the priority and free lanes of the displayed junction
+    void logLaneMovement();
+
     // Check for vehicles leaving the simulation
     void checkVehicleBoundaries();
+
+    // Hand a vehicle that left a junction to the downstream link, if any
+    bool forwardVehicle(uint32_t junction, Vehicle* vehicle);
+
+    // Enqueue vehicles whose link travel time has elapsed
+    void deliverTransfers();
+
+    // Feed queue lengths back into the routing link costs
+    void updateRouteCosts();
 };
 
 #endif // TRAFFIC_MANAGER_H
@@ -0,0 +1,151 @@
+// FILE: include/trafficsim.h
+#ifndef TRAFFICSIM_H
+#define TRAFFICSIM_H
+
+// C interface to the junction model, built as libtrafficsim. It runs the
+// same TrafficManager as the simulator without a window or lane files:
+// callers inject arrivals, step the model and read its state back.
+//
+// Thread safety:
+//   - A ts_sim handle is not locked internally. Calls on one handle must not
+//     overlap; a caller that shares a handle between threads serializes them.
+//   - Different handles are independent and may be used concurrently from
+//     different threads.
+//   - ts_set_logging() changes a process-wide setting and may be called from
+//     any thread.
+//   - With threads > 1 in ts_config, ts_step() runs vehicle updates on the
+//     handle's own worker threads and returns after they have finished.
+//
+// Buffers passed to the ts_read_* functions belong to the caller. The
+// library writes into them directly and keeps no pointer after returning.
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#if defined(_WIN32)
+#  ifdef TRAFFICSIM_BUILD
+#    define TS_API __declspec(dllexport)
+#  else
+#    define TS_API __declspec(dllimport)
+#  endif
+#else
+#  define TS_API __attribute__((visibility("default")))
+#endif
+
+// Incremented on incompatible changes to this header
+#define TS_API_VERSION 1
+
+// Status codes (functions returning a count return it when >= 0)
+#define TS_OK 0
+#define TS_ERROR_INVALID_ARGUMENT -1
+#define TS_ERROR_NETWORK -2
+#define TS_ERROR_IO -3
+#define TS_ERROR_INTERNAL -4
+
+// Light states, as in TrafficLight::State
+#define TS_LIGHT_ALL_RED 0
+#define TS_LIGHT_A_GREEN 1
+#define TS_LIGHT_B_GREEN 2
+#define TS_LIGHT_C_GREEN 3
+#define TS_LIGHT_D_GREEN 4
+
+// Destinations, as in the Destination enum
+#define TS_DESTINATION_STRAIGHT 0
+#define TS_DESTINATION_LEFT 1
+#define TS_DESTINATION_RIGHT 2
+
+// ts_arrival and ts_vehicle flags
+#define TS_VEHICLE_EMERGENCY 0x01
+#define TS_VEHICLE_TURNING 0x02
+
+typedef struct ts_sim ts_sim;
+
+typedef struct ts_config {
+    uint32_t struct_size;         // sizeof(ts_config), set by ts_config_init
+    const char* network_path;     // Network file, or NULL for the four-way junction
+    uint32_t threads;             // Vehicle update threads (1 = caller only)
+    uint32_t fixed_point;         // Nonzero: bit-reproducible fixed-point kinematics
+} ts_config;
+
+// A vehicle arriving at the entry junction
+typedef struct ts_arrival {
+    uint32_t vehicle_id;
+    uint8_t road;                 // 'A', 'B', 'C' or 'D'
+    uint8_t lane_number;          // 2 or 3 (lane 1 is outgoing)
+    uint8_t destination;          // TS_DESTINATION_*
+    uint8_t flags;                // TS_VEHICLE_EMERGENCY
+} ts_arrival;
+
+// One lane, in network lane table order
+typedef struct ts_lane {
+    uint32_t junction;
+    uint8_t road;
+    uint8_t lane_number;
+    uint8_t is_priority;          // Priority mode active on this lane
+    uint8_t reserved;
+    uint32_t vehicle_count;
+} ts_lane;
+
+// One queued vehicle
+typedef struct ts_vehicle {
+    float x;                      // Screen position of the displayed junction
+    float y;
+    uint32_t lane_index;          // Index into the ts_read_lanes() table
+    uint32_t flags;               // TS_VEHICLE_*
+} ts_vehicle;
+
+// Version of the library, to compare with TS_API_VERSION
+TS_API uint32_t ts_api_version(void);
+
+// Fill a config with defaults: standard junction, one thread, float kinematics
+TS_API void ts_config_init(ts_config* config);
+
+// Create a simulation. config may be NULL for the defaults.
+TS_API int ts_create(const ts_config* config, ts_sim** sim);
+
+// Destroy a simulation (NULL is ignored)
+TS_API void ts_destroy(ts_sim* sim);
+
+// Queue arrivals at the entry junction. Returns how many were accepted;
+// arrivals for unknown lanes or lane 1 are skipped.
+TS_API int ts_inject(ts_sim* sim, const ts_arrival* arrivals, size_t count);
+
+// Advance the model by ticks steps of tick_ms milliseconds each
+TS_API int ts_step(ts_sim* sim, uint32_t ticks, uint32_t tick_ms);
+
+// Simulation time in milliseconds
+TS_API uint64_t ts_time(const ts_sim* sim);
+
+// Vehicles that have left the network
+TS_API uint64_t ts_exited(const ts_sim* sim);
+
+// The ts_read_* functions fill at most capacity entries and return the
+// total number available, so a return value above capacity means the buffer
+// was too small. Pass capacity 0 to query the size.
+
+// Lane table with current vehicle counts
+TS_API int ts_read_lanes(const ts_sim* sim, ts_lane* lanes, size_t capacity);
+
+// Light state (TS_LIGHT_*) of each junction
+TS_API int ts_read_lights(const ts_sim* sim, uint8_t* states, size_t capacity);
+
+// Queued vehicles of all lanes, lane by lane, front of each queue first
+TS_API int ts_read_vehicles(const ts_sim* sim, ts_vehicle* vehicles, size_t capacity);
+
+// Save queued and in-transit vehicles to a checkpoint file, or restore them
+TS_API int ts_snapshot(const ts_sim* sim, const char* path);
+TS_API int ts_restore(ts_sim* sim, const char* path);
+
+// Turn the simulator's debug log on or off for the whole process. The
+// library starts with it off.
+TS_API void ts_set_logging(int enabled);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // TRAFFICSIM_H
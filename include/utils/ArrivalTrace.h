@@ -0,0 +1,93 @@
+// FILE: include/utils/ArrivalTrace.h
+#ifndef ARRIVAL_TRACE_H
+#define ARRIVAL_TRACE_H
+
+#include <cstdint>
+#include <cstddef>
+#include <string>
+#include <vector>
+
+// Compact binary arrival trace for offline replay.
+//
+// Layout (little-endian):
+//   Header   - 32 bytes, see ArrivalTrace::Header
+//   Records  - recordCount x 12 bytes, sorted by timeMs
+//   Index    - (hourCount + 1) x uint64_t, first record index of each hour
+//
+// The generator writes a trace once; the simulator memory-maps it and replays it
+// at any speed without parsing.
+class ArrivalTrace {
+public:
+    // One vehicle arrival
+    struct Record {
+        uint32_t timeMs;      // Arrival time relative to trace start
+        uint32_t vehicleId;   // Generator vehicle number
+        uint8_t road;         // 'A', 'B', 'C' or 'D'
+        uint8_t laneNumber;   // 2 or 3 (lane 1 is incoming only)
+        uint8_t destination;  // Destination enum value
+        uint8_t flags;        // FLAG_* bits
+    };
+
+    // File header
+    struct Header {
+        char magic[4];        // "TJTR"
+        uint32_t version;
+        uint64_t recordCount;
+        uint32_t durationMs;
+        uint32_t hourCount;
+        uint64_t indexOffset; // Byte offset of the hour index
+    };
+
+    static constexpr uint32_t FORMAT_VERSION = 1;
+    static constexpr uint32_t MS_PER_HOUR = 3600000;
+    static constexpr uint32_t MAX_HOURS = UINT32_MAX / MS_PER_HOUR; // Longest trace timeMs can hold
+    static constexpr uint8_t FLAG_EMERGENCY = 0x01;
+
+    ArrivalTrace();
+    ~ArrivalTrace();
+
+    ArrivalTrace(const ArrivalTrace&) = delete;
+    ArrivalTrace& operator=(const ArrivalTrace&) = delete;
+
+    // Write time-sorted records and the per-hour index to a trace file
+    bool write(const std::string& path, const std::vector<Record>& records, uint32_t durationMs);
+
+    // Map a trace file for replay
+    bool open(const std::string& path);
+
+    // Release the mapping
+    void close();
+
+    bool isOpen() const { return mapped; }
+
+    // Access to the mapped records
+    size_t size() const { return recordCount; }
+    const Record* records() const { return recordData; }
+    uint32_t getDuration() const { return durationMs; }
+    uint32_t getHourCount() const { return hourCount; }
+
+    // Index of the first record with timeMs >= the given time
+    size_t seek(uint32_t timeMs) const;
+
+    // Description of the last failed operation
+    const std::string& getLastError() const { return lastError; }
+
+private:
+    bool mapped;
+    const Record* recordData;
+    const uint64_t* hourIndex;
+    size_t recordCount;
+    uint32_t durationMs;
+    uint32_t hourCount;
+    std::string lastError;
+
+    // Platform mapping state
+    void* mapBase;
+    size_t mapLength;
+    std::vector<char> fallbackBuffer; // Used where mmap is unavailable
+};
+
+static_assert(sizeof(ArrivalTrace::Record) == 12, "ArrivalTrace::Record must stay 12 bytes");
+static_assert(sizeof(ArrivalTrace::Header) == 32, "ArrivalTrace::Header must stay 32 bytes");
+
+#endif // ARRIVAL_TRACE_H
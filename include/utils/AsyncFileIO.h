@@ -0,0 +1,137 @@
+// FILE: include/utils/AsyncFileIO.h
+#ifndef ASYNC_FILE_IO_H
+#define ASYNC_FILE_IO_H
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "utils/LatencyHistogram.h"
+
+class ThreadPool;
+
+// Batched file I/O for log flushes, status and trace writes and lane file
+// ingest.
+//
+// Writes are queued by append() and go out together on flush(); readFiles()
+// reads a set of files in one batch. On Linux a batch is one io_uring
+// submission, set up directly through the system calls so liburing isn't
+// needed. Elsewhere, or when the kernel refuses io_uring (too old, disabled
+// by sysctl or seccomp), the operations run on a small thread pool with one
+// pwrite/pread each.
+//
+// Each file is written at offsets tracked here rather than through
+// O_APPEND, so operations in a batch may complete in any order without
+// reordering the file. Not thread-safe; each user owns an instance.
+class AsyncFileIO {
+public:
+    enum class Backend {
+        AUTO,           // io_uring where available, else THREAD_POOL
+        IO_URING,
+        THREAD_POOL
+    };
+
+    struct Stats {
+        uint64_t operations;        // Reads and writes completed
+        uint64_t failures;
+        uint64_t batches;           // Batches that did any I/O
+        uint64_t syscalls;          // io_uring_enter, or pwrite/pread calls
+        uint64_t bytesWritten;
+        uint64_t bytesRead;
+        LatencyHistogram latencyUs; // Submission to completion, per operation
+    };
+
+    // queueDepth bounds the operations in flight at once. Asking for
+    // IO_URING where it isn't available falls back to THREAD_POOL; the
+    // reason is left in getLastError().
+    explicit AsyncFileIO(Backend backend = Backend::AUTO, unsigned queueDepth = 64);
+    ~AsyncFileIO();
+
+    AsyncFileIO(const AsyncFileIO&) = delete;
+    AsyncFileIO& operator=(const AsyncFileIO&) = delete;
+
+    // Open a file for writing, creating it if needed. Writes continue at
+    // the current end, or at the start after truncating. Returns a handle,
+    // or -1 with getLastError() set.
+    int openForWrite(const std::string& path, bool truncate);
+
+    // Flush the file's queued writes and close it. The handle may be given
+    // to a file opened later, so it must not be used again.
+    void closeFile(int handle);
+
+    // Queue data to be written after everything queued before it
+    void append(int handle, std::string data);
+    void append(int handle, const void* data, size_t length);
+
+    // Submit all queued writes and wait for them. False if any failed.
+    bool flush();
+
+    size_t getPendingBytes() const { return pendingBytes; }
+
+    // Read whole files in one batch. Missing files read as empty and are
+    // not failures; contents of files that fail to read are left empty.
+    bool readFiles(const std::vector<std::string>& paths, std::vector<std::string>& contents);
+
+    // IO_URING or THREAD_POOL, after any fallback
+    Backend getBackend() const { return backend; }
+    static const char* backendName(Backend backend);
+
+    const Stats& getStats() const { return stats; }
+    void resetStats();
+
+    // Description of the last failure
+    const std::string& getLastError() const { return lastError; }
+
+private:
+    // One read or write, resubmitted from where it stopped if it comes
+    // back short
+    struct Operation {
+        int fd;
+        bool write;
+        char* data;
+        size_t length;
+        uint64_t offset;
+        size_t done;
+        int error;
+    };
+
+    struct File {
+        int fd;
+        uint64_t endOffset;     // Where the next append lands
+    };
+
+    struct PendingWrite {
+        int handle;
+        uint64_t offset;
+        std::string data;
+    };
+
+    struct Ring;
+
+    Backend backend;
+    unsigned queueDepth;
+    Ring* ring;
+    ThreadPool* pool;
+
+    std::vector<File> files;    // Indexed by handle; fd -1 once closed, until reused
+    std::vector<PendingWrite> pending;
+    size_t pendingBytes;
+
+    Stats stats;
+    std::string lastError;
+
+    // Set up the io_uring instance; false with lastError set if unavailable
+    bool setupRing();
+    void destroyRing();
+
+    // Run operations to completion on the active backend. False if any failed.
+    bool runBatch(std::vector<Operation>& operations);
+    bool runRing(std::vector<Operation>& operations, std::chrono::steady_clock::time_point start);
+    bool runPool(std::vector<Operation>& operations, std::chrono::steady_clock::time_point start);
+
+    // Count one finished operation
+    void complete(const Operation& operation, uint64_t latencyUs);
+};
+
+#endif // ASYNC_FILE_IO_H
@@ -3,7 +3,13 @@
 
 #include <string>
 #include <vector>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
 #include <mutex>
+#include <thread>
+
+class AsyncFileIO;
 
 class DebugLogger {
 public:
@@ -18,15 +24,42 @@ public:
     // Initialize the logger
     static void initialize(const std::string& logFilePath = "traffic_simulator.log");
 
+    // Start logging to a file of its own in a process just forked. The
+    // parent's I/O ring is shared with the child and its threads don't
+    // exist there, so they are left to the parent.
+    static void initializeAfterFork(const std::string& logFilePath);
+
     // Log a message with a specific level
     static void log(const std::string& message, LogLevel level = LogLevel::INFO);
 
     // Get recent log messages for display
     static std::vector<std::string> getRecentLogs(int count = 10);
 
+    // Messages kept for display, and bytes waiting to be written to the
+    // file; both are bounded, and soak tests check they stay that way
+    static size_t getRecentLogCount();
+    static size_t getBufferedBytes();
+
     // Clear all logs
     static void clearLogs();
 
+    // Turn logging on or off (on by default); benchmarks switch it off
+    static void setEnabled(bool enabled);
+
+    // Echo messages to stdout as well as the log file (on by default);
+    // full-screen front-ends switch it off
+    static void setConsoleEcho(bool echo);
+
+    // Write buffered messages to the log file now. Messages are otherwise
+    // written in batches: when 32 KB are buffered, 100 ms after the last
+    // write, on an ERROR, at shutdown and at exit.
+    static void flush();
+
+    // Move those writes to a background thread (the "log" thread role), so
+    // threads that log never wait for the file. Not inherited by fork().
+    static void startFlushThread();
+    static void stopFlushThread();
+
     // Shutdown the logger
     static void shutdown();
 
@@ -34,13 +67,37 @@ private:
     static std::string logFilePath;
     static std::vector<std::string> recentLogs;
     static std::mutex logMutex;
-    static bool initialized;
+    static std::atomic<bool> initialized;  // Read without a lock by log()
+    static std::atomic<bool> enabled;
+    static std::atomic<bool> consoleEcho;
+
+    // Open log file and its batched writer. Lock order: ioMutex, then
+    // logMutex; the file is written under ioMutex alone.
+    static std::mutex ioMutex;
+    static AsyncFileIO* io;
+    static int logFile;
+    static std::string buffer;
+    static std::chrono::steady_clock::time_point lastFlush;
+
+    // Background flushing
+    static std::thread flusher;
+    static std::condition_variable flushWake;
+    static bool flusherRunning;
+    static bool flushRequested;
 
     // Get timestamp for log messages
     static std::string getTimestamp();
 
-    // Write to log file
-    static void writeToFile(const std::string& message);
+    // Start the log file over with a header line (caller holds both mutexes)
+    static void openLogFile(const std::string& header);
+
+    // Body of initialize() (caller holds ioMutex only)
+    static void startLogging(const std::string& path);
+
+    // Write out the buffer (caller holds ioMutex only)
+    static void writeBuffer();
+
+    static void flushLoop();
 };
 
 #endif // DEBUG_LOGGER_H
@@ -0,0 +1,68 @@
+// FILE: include/utils/FixedPoint.h
+#ifndef FIXED_POINT_H
+#define FIXED_POINT_H
+
+#include <cmath>
+#include <cstdint>
+
+// Signed fixed-point number with FractionBits fractional bits in an int64_t.
+// Every operation is integer arithmetic, so results are the same on every
+// compiler, optimization level and instruction set: no contraction into
+// fused multiply-adds, no excess precision, no vectorized reassociation.
+// Products shift right (rounding towards minus infinity), quotients truncate
+// towards zero. Conversions to and from float are exact scalings by a power
+// of two plus one IEEE rounding, which is equally reproducible.
+template<int FractionBits>
+class FixedPoint {
+public:
+    static constexpr int64_t ONE = int64_t(1) << FractionBits;
+
+    constexpr FixedPoint() : raw(0) {}
+
+    static constexpr FixedPoint fromRaw(int64_t value) { return FixedPoint(value); }
+    static constexpr FixedPoint fromInt(int64_t value) { return FixedPoint(value * ONE); }
+    static FixedPoint fromFloat(float value) {
+        return FixedPoint(static_cast<int64_t>(static_cast<double>(value) * ONE));
+    }
+
+    float toFloat() const { return static_cast<float>(static_cast<double>(raw) / ONE); }
+    int64_t getRaw() const { return raw; }
+
+    FixedPoint operator+(FixedPoint other) const { return FixedPoint(raw + other.raw); }
+    FixedPoint operator-(FixedPoint other) const { return FixedPoint(raw - other.raw); }
+    FixedPoint operator*(FixedPoint other) const { return FixedPoint((raw * other.raw) >> FractionBits); }
+    FixedPoint operator/(FixedPoint other) const { return FixedPoint((raw * ONE) / other.raw); }
+
+    bool operator<(FixedPoint other) const { return raw < other.raw; }
+    bool operator>(FixedPoint other) const { return raw > other.raw; }
+    bool operator<=(FixedPoint other) const { return raw <= other.raw; }
+    bool operator>=(FixedPoint other) const { return raw >= other.raw; }
+    bool operator==(FixedPoint other) const { return raw == other.raw; }
+
+    // Square root, rounded down (0 for negative values)
+    static FixedPoint sqrt(FixedPoint value) {
+        if (value.raw <= 0) return FixedPoint();
+        return FixedPoint(static_cast<int64_t>(isqrt(static_cast<uint64_t>(value.raw) << FractionBits)));
+    }
+
+private:
+    int64_t raw;
+
+    explicit constexpr FixedPoint(int64_t value) : raw(value) {}
+
+    // Integer square root (floor). The hardware square root only provides a
+    // first guess; the integer correction makes the result exact, so it does
+    // not depend on how the guess was rounded.
+    static uint64_t isqrt(uint64_t n) {
+        uint64_t result = static_cast<uint64_t>(std::sqrt(static_cast<double>(n)));
+        while (result > 0 && result * result > n) result--;
+        while ((result + 1) * (result + 1) <= n) result++;
+        return result;
+    }
+};
+
+// 16 fractional bits: 1/65536 px resolution, products of coordinates up to
+// about +/-10^6 px stay inside 64 bits
+typedef FixedPoint<16> Fixed;
+
+#endif // FIXED_POINT_H
@@ -0,0 +1,125 @@
+// FILE: include/utils/LatencyHistogram.h
+#ifndef LATENCY_HISTOGRAM_H
+#define LATENCY_HISTOGRAM_H
+
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+// Histogram of non-negative integer latencies (e.g. milliseconds) for
+// percentiles at any rate of recording.
+//
+// Log-linear buckets: values below 32 get a bucket each, above that every
+// power of two is split into 16 buckets, so a percentile is within 1/32 of
+// the true value (bucket midpoints). Recording is an index computation and
+// an increment; memory is fixed (about 8 KB). Two snapshots of a cumulative
+// histogram subtract into the histogram of what happened in between.
+class LatencyHistogram {
+public:
+    LatencyHistogram() : buckets(BUCKET_COUNT, 0), count(0), sum(0), max(0) {}
+
+    void record(uint64_t value) {
+        buckets[bucketOf(value)]++;
+        count++;
+        sum += value;
+        max = std::max(max, value);
+    }
+
+    void clear() {
+        std::fill(buckets.begin(), buckets.end(), 0);
+        count = 0;
+        sum = 0;
+        max = 0;
+    }
+
+    // Remove an earlier snapshot of this histogram, leaving what was
+    // recorded since. The maximum becomes the top of the highest bucket
+    // still holding values (capped at the overall maximum).
+    void subtract(const LatencyHistogram& earlier) {
+        for (size_t i = 0; i < BUCKET_COUNT; i++) {
+            buckets[i] -= std::min(buckets[i], earlier.buckets[i]);
+        }
+        count -= std::min(count, earlier.count);
+        sum -= std::min(sum, earlier.sum);
+        uint64_t top = 0;
+        for (size_t i = BUCKET_COUNT; i-- > 0;) {
+            if (buckets[i] != 0) {
+                top = lowerBound(i + 1) - 1;
+                break;
+            }
+        }
+        max = std::min(max, top);
+    }
+
+    uint64_t getCount() const { return count; }
+    uint64_t getMax() const { return max; }
+    double getMean() const { return count ? static_cast<double>(sum) / static_cast<double>(count) : 0.0; }
+
+    // Value below which a fraction p (0..1) of the values lie; 0 when empty
+    uint64_t getPercentile(double p) const {
+        if (count == 0) return 0;
+        uint64_t rank = static_cast<uint64_t>(p * static_cast<double>(count) + 0.5);
+        rank = std::max<uint64_t>(1, std::min(rank, count));
+
+        uint64_t seen = 0;
+        for (size_t i = 0; i < BUCKET_COUNT; i++) {
+            seen += buckets[i];
+            if (seen >= rank) {
+                uint64_t low = lowerBound(i);
+                uint64_t high = lowerBound(i + 1) - 1;
+                return std::min(max, low + (high - low) / 2);
+            }
+        }
+        return max;
+    }
+
+    // Call visit(low, high, count) for every non-empty bucket, lowest
+    // first; high is the largest value the bucket holds
+    template <typename Visit>
+    void forEachBucket(Visit visit) const {
+        for (size_t i = 0; i < BUCKET_COUNT; i++) {
+            if (buckets[i] != 0) {
+                visit(lowerBound(i), lowerBound(i + 1) - 1, buckets[i]);
+            }
+        }
+    }
+
+private:
+    static constexpr int LINEAR_BITS = 5;                       // 32 exact buckets
+    static constexpr int SUB_BITS = 4;                          // 16 per power of two
+    static constexpr size_t BUCKET_COUNT = (1u << LINEAR_BITS) + (64 - LINEAR_BITS) * (1u << SUB_BITS);
+
+    std::vector<uint64_t> buckets;
+    uint64_t count;
+    uint64_t sum;
+    uint64_t max;
+
+    static size_t bucketOf(uint64_t value) {
+        if (value < (1u << LINEAR_BITS)) {
+            return static_cast<size_t>(value);
+        }
+        int msb = LINEAR_BITS;
+        while (msb < 63 && (value >> (msb + 1)) != 0) {
+            msb++;
+        }
+        int shift = msb - SUB_BITS;
+        size_t sub = static_cast<size_t>((value >> shift) - (1u << SUB_BITS));
+        return (1u << LINEAR_BITS) + static_cast<size_t>(msb - LINEAR_BITS) * (1u << SUB_BITS) + sub;
+    }
+
+    // Smallest value in a bucket (one past the last value for BUCKET_COUNT)
+    static uint64_t lowerBound(size_t bucket) {
+        if (bucket < (1u << LINEAR_BITS)) {
+            return bucket;
+        }
+        if (bucket >= BUCKET_COUNT) {
+            return UINT64_MAX;
+        }
+        size_t offset = bucket - (1u << LINEAR_BITS);
+        int msb = LINEAR_BITS + static_cast<int>(offset >> SUB_BITS);
+        uint64_t sub = offset & ((1u << SUB_BITS) - 1);
+        return ((1ULL << SUB_BITS) + sub) << (msb - SUB_BITS);
+    }
+};
+
+#endif // LATENCY_HISTOGRAM_H
@@ -0,0 +1,101 @@
+// FILE: include/utils/ResultCache.h
+#ifndef RESULT_CACHE_H
+#define RESULT_CACHE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+// On-disk cache of run results keyed by a 64-bit hash of everything that
+// determines the result (scenario, parameters, seed and simulator build).
+//
+// Each entry is one file, <directory>/<key as 16 hex digits>.res:
+//   Header  - 24 bytes, see ResultCache::EntryHeader
+//   Payload - header.size bytes
+//
+// Entries are written to a temporary file and renamed into place, so readers
+// never see a partial entry and several processes can share a directory.
+// Every thread may call lookup() and store() concurrently. The total size is
+// kept under maxBytes by evicting least recently used entries; recency is
+// the file modification time, refreshed on every hit, so it survives
+// restarts. Processes sharing a directory each enforce the bound on what
+// they know about, which keeps the directory close to, not exactly at, it.
+class ResultCache {
+public:
+    static constexpr uint32_t FORMAT_VERSION = 1;
+
+    struct EntryHeader {
+        char magic[4];        // "TJRC"
+        uint32_t version;
+        uint64_t key;
+        uint32_t size;        // Payload bytes
+        uint32_t reserved;
+    };
+
+    ResultCache();
+
+    ResultCache(const ResultCache&) = delete;
+    ResultCache& operator=(const ResultCache&) = delete;
+
+    // Use a cache directory (created if missing) holding at most maxBytes
+    bool open(const std::string& directory, uint64_t maxBytes);
+
+    bool isOpen() const { return !directory.empty(); }
+
+    // Copy a cached payload of exactly size bytes into data; false on a miss
+    bool lookup(uint64_t key, void* data, size_t size);
+
+    // Store a payload, evicting old entries to stay within the size bound
+    bool store(uint64_t key, const void* data, size_t size);
+
+    // Counters since open()
+    uint64_t getHits() const;
+    uint64_t getMisses() const;
+    size_t getEntryCount() const;
+    uint64_t getTotalBytes() const;
+
+    // Description of the last failed operation
+    std::string getLastError() const;
+
+    // 64-bit FNV-1a, continuing from hash; stable across builds and platforms
+    static uint64_t hashBytes(const void* data, size_t size, uint64_t hash = FNV_OFFSET);
+
+    // Hash of the running executable, so results from other builds never
+    // match (falls back to the compile time where /proc is not available)
+    static uint64_t buildId();
+
+    static constexpr uint64_t FNV_OFFSET = 14695981039346656037ULL;
+
+private:
+    struct Entry {
+        uint64_t bytes;
+        uint64_t lastUse;     // Position in lru
+    };
+
+    std::string directory;
+    uint64_t maxBytes;
+    uint64_t totalBytes;
+    uint64_t hits;
+    uint64_t misses;
+    uint64_t useCounter;
+    std::string lastError;
+
+    // Entries by key, and keys by last use (oldest first)
+    std::unordered_map<uint64_t, Entry> entries;
+    std::map<uint64_t, uint64_t> lru;
+
+    mutable std::mutex mutex;
+
+    std::string entryPath(uint64_t key) const;
+
+    // Record a use of key (mutex held)
+    void touch(uint64_t key, uint64_t bytes);
+
+    // Delete least recently used entries until within maxBytes (mutex held)
+    void evict();
+};
+
+#endif // RESULT_CACHE_H
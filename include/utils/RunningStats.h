@@ -0,0 +1,61 @@
+// FILE: include/utils/RunningStats.h
+#ifndef RUNNING_STATS_H
+#define RUNNING_STATS_H
+
+#include <cmath>
+#include <cstdint>
+
+// Running mean and variance of a sample (Welford's update, which stays
+// accurate when the variance is small next to the mean), with Student-t
+// confidence intervals for deciding when replications have converged.
+class RunningStats {
+public:
+    RunningStats() : count(0), mean(0.0), m2(0.0) {}
+
+    void add(double value) {
+        count++;
+        double delta = value - mean;
+        mean += delta / static_cast<double>(count);
+        m2 += delta * (value - mean);
+    }
+
+    uint64_t getCount() const { return count; }
+    double getMean() const { return mean; }
+
+    // Sample variance (n - 1 denominator); 0 below two values
+    double getVariance() const { return count > 1 ? m2 / static_cast<double>(count - 1) : 0.0; }
+    double getStdDev() const { return std::sqrt(getVariance()); }
+
+    // Half-width of the two-sided confidence interval for the mean; infinite
+    // below two values
+    double getHalfWidth(double confidence) const {
+        if (count < 2) return INFINITY;
+        return studentT(confidence, count - 1) * getStdDev() / std::sqrt(static_cast<double>(count));
+    }
+
+    // Two-sided critical value of Student's t with dof degrees of freedom.
+    // Normal quantile (Abramowitz & Stegun 26.2.23) with the Cornish-Fisher
+    // expansion for t: within 0.1% from 4 degrees of freedom and a few
+    // percent low below that, so stopping rules should want 5+ samples.
+    static double studentT(double confidence, uint64_t dof) {
+        double p = (1.0 - confidence) / 2.0;
+        double t = std::sqrt(-2.0 * std::log(p));
+        double z = t - (2.515517 + 0.802853 * t + 0.010328 * t * t) /
+                       (1.0 + 1.432788 * t + 0.189269 * t * t + 0.001308 * t * t * t);
+
+        double v = static_cast<double>(dof);
+        double z2 = z * z;
+        double g1 = (z2 + 1.0) * z / 4.0;
+        double g2 = ((5.0 * z2 + 16.0) * z2 + 3.0) * z / 96.0;
+        double g3 = (((3.0 * z2 + 19.0) * z2 + 17.0) * z2 - 15.0) * z / 384.0;
+        double g4 = ((((79.0 * z2 + 776.0) * z2 + 1482.0) * z2 - 1920.0) * z2 - 945.0) * z / 92160.0;
+        return z + g1 / v + g2 / (v * v) + g3 / (v * v * v) + g4 / (v * v * v * v);
+    }
+
+private:
+    uint64_t count;
+    double mean;
+    double m2;      // Sum of squared deviations from the mean
+};
+
+#endif // RUNNING_STATS_H
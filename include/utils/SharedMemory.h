@@ -0,0 +1,42 @@
+// FILE: include/utils/SharedMemory.h
+#ifndef SHARED_MEMORY_H
+#define SHARED_MEMORY_H
+
+#include <cstddef>
+#include <string>
+
+// Named POSIX shared memory region (shm_open + mmap). The creator owns the
+// name and unlinks it on destruction; processes forked after create() share
+// the mapping directly, others can open() it by name.
+class SharedMemory {
+public:
+    SharedMemory();
+    ~SharedMemory();
+
+    SharedMemory(const SharedMemory&) = delete;
+    SharedMemory& operator=(const SharedMemory&) = delete;
+
+    // Create (or replace) a zero-filled region of the given size
+    bool create(const std::string& name, size_t size);
+
+    // Map an existing region, read-only for processes that only watch it
+    bool open(const std::string& name, bool readOnly = false);
+
+    // Unmap, and unlink the name if this object created it
+    void close();
+
+    void* data() const { return address; }
+    size_t size() const { return length; }
+
+    // Description of the last failed operation
+    const std::string& getLastError() const { return lastError; }
+
+private:
+    std::string name;
+    void* address;
+    size_t length;
+    bool owner;
+    std::string lastError;
+};
+
+#endif // SHARED_MEMORY_H
@@ -0,0 +1,104 @@
+// FILE: include/utils/SpscRing.h
+#ifndef SPSC_RING_H
+#define SPSC_RING_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <type_traits>
+
+// Single-producer/single-consumer ring buffer over caller-provided memory.
+// The memory may be shared between processes: the ring holds no pointers and
+// the indices are lock-free atomics. T must be trivially copyable.
+template<typename T>
+class SpscRing {
+    static_assert(std::is_trivially_copyable<T>::value, "SpscRing elements must be trivially copyable");
+
+    // Producer and consumer indices live on separate cache lines
+    struct Header {
+        alignas(64) std::atomic<uint64_t> head;   // Next slot to write
+        alignas(64) std::atomic<uint64_t> tail;   // Next slot to read
+        uint64_t capacity;                        // Power of two
+    };
+
+public:
+    SpscRing() : header(nullptr), slots(nullptr), mask(0) {}
+
+    // Bytes needed for a ring of the given capacity (rounded up to a power of two)
+    static size_t bytesFor(size_t capacity) {
+        size_t bytes = sizeof(Header) + roundUp(capacity) * sizeof(T);
+        return (bytes + 63) & ~static_cast<size_t>(63);
+    }
+
+    // Bind to memory of at least bytesFor(capacity) bytes. Exactly one side
+    // initializes the ring; the other attaches to it as-is.
+    void attach(void* memory, size_t capacity, bool initialize) {
+        if (initialize) {
+            header = new (memory) Header();
+            header->head.store(0, std::memory_order_relaxed);
+            header->tail.store(0, std::memory_order_relaxed);
+            header->capacity = roundUp(capacity);
+        } else {
+            header = static_cast<Header*>(memory);
+        }
+        slots = reinterpret_cast<T*>(static_cast<char*>(memory) + sizeof(Header));
+        mask = header->capacity - 1;
+    }
+
+    // Producer: append an element, false if the ring is full
+    bool push(const T& element) {
+        uint64_t head = header->head.load(std::memory_order_relaxed);
+        if (head - header->tail.load(std::memory_order_acquire) > mask) {
+            return false;
+        }
+        slots[head & mask] = element;
+        header->head.store(head + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Consumer: look at the oldest element without removing it
+    bool peek(T& element) const {
+        uint64_t tail = header->tail.load(std::memory_order_relaxed);
+        if (tail == header->head.load(std::memory_order_acquire)) {
+            return false;
+        }
+        element = slots[tail & mask];
+        return true;
+    }
+
+    // Consumer: remove the oldest element
+    bool pop(T& element) {
+        if (!peek(element)) {
+            return false;
+        }
+        header->tail.store(header->tail.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Drop all elements; only safe while neither side is using the ring
+    void reset() {
+        header->head.store(0, std::memory_order_relaxed);
+        header->tail.store(0, std::memory_order_relaxed);
+    }
+
+    size_t size() const {
+        return static_cast<size_t>(header->head.load(std::memory_order_acquire) -
+                                   header->tail.load(std::memory_order_acquire));
+    }
+
+    size_t capacity() const { return static_cast<size_t>(mask + 1); }
+
+private:
+    Header* header;
+    T* slots;
+    uint64_t mask;
+
+    static size_t roundUp(size_t capacity) {
+        size_t size = 1;
+        while (size < capacity) size <<= 1;
+        return size;
+    }
+};
+
+#endif // SPSC_RING_H
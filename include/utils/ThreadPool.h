@@ -0,0 +1,57 @@
+// FILE: include/utils/ThreadPool.h
+#ifndef THREAD_POOL_H
+#define THREAD_POOL_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "utils/ThreadRoles.h"
+
+// Fixed set of worker threads for data-parallel loops. Workers stay parked
+// between calls, so a parallelFor per simulation step costs a wake-up rather
+// than thread creation. The calling thread takes part in every loop; a pool
+// of one thread runs everything inline.
+class ThreadPool {
+public:
+    // threads counts the caller, so threads - 1 workers are started. The
+    // workers are named and placed for the given role.
+    explicit ThreadPool(size_t threads, ThreadRoles::Role role = ThreadRoles::Role::WORKER);
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    // Run task(i) for every i in [0, count) and wait for all of them.
+    // Indices are handed out dynamically, so tasks must not depend on which
+    // thread runs them or in what order.
+    void parallelFor(size_t count, const std::function<void(size_t)>& task);
+
+    size_t getThreadCount() const { return workers.size() + 1; }
+
+private:
+    std::vector<std::thread> workers;
+    std::mutex mutex;
+    std::condition_variable wake;
+    std::condition_variable finished;
+
+    // Current loop, published under the mutex
+    const std::function<void(size_t)>* currentTask;
+    size_t taskCount;
+    uint64_t generation;
+    size_t busyWorkers;
+    bool stopping;
+
+    std::atomic<size_t> nextIndex;
+
+    void workerLoop();
+
+    // Claim and run indices until the loop is exhausted
+    void runTasks();
+};
+
+#endif // THREAD_POOL_H
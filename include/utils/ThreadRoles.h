@@ -0,0 +1,76 @@
+// FILE: include/utils/ThreadRoles.h
+#ifndef THREAD_ROLES_H
+#define THREAD_ROLES_H
+
+#include <string>
+#include <thread>
+#include <vector>
+
+// Named roles for the long-lived threads, with a configurable placement
+// (CPU set, scheduling policy and priority) per role.
+//
+// A placement spec lists roles and where they go, separated by spaces or
+// semicolons:
+//
+//     sim=2:fifo:50 worker=3-5 log,ingest,io=0 render=1
+//
+// i.e. role[,role...]=cpus[:policy[:priority]], with CPUs as a list of
+// numbers and ranges ("0,2-3"), an empty list for "any", and policy one
+// of other, batch, idle, fifo or rr (priority 1-99 for fifo and rr).
+// Roles without a placement keep what they inherit. Real-time policies
+// need CAP_SYS_NICE or an RLIMIT_RTPRIO; a refused request leaves the
+// thread's policy alone and the report says so. Placement is applied on
+// Linux only; elsewhere threads are just named in the report.
+class ThreadRoles {
+public:
+    enum class Role {
+        SIMULATION,     // Steps the TrafficManager (also renders in the SDL front-end)
+        WORKER,         // Vehicle update pool
+        RENDER,
+        INGEST,         // Lane file watcher
+        LOGGING,        // Log flush thread
+        IO              // AsyncFileIO fallback pool, state stream
+    };
+    static constexpr int ROLE_COUNT = 6;
+
+    enum class Policy {
+        INHERIT,
+        OTHER,
+        BATCH,
+        IDLE,
+        FIFO,
+        RR
+    };
+
+    struct Placement {
+        std::vector<int> cpus;  // Empty for any CPU
+        Policy policy;
+        int priority;
+    };
+
+    // Set placements from a spec; roles not named keep theirs. On a bad
+    // spec nothing changes and error says what's wrong.
+    static bool configure(const std::string& spec, std::string& error);
+
+    // Same, from TRAFFIC_THREAD_ROLES if it is set
+    static bool configureFromEnvironment(std::string& error);
+
+    static Placement getPlacement(Role role);
+
+    // Name a thread, apply its role's placement and list it in the report.
+    // Call from the thread that created it, before the thread does work.
+    static void assign(std::thread& thread, Role role, const std::string& name);
+    static void assignCurrent(Role role, const std::string& name);
+
+    // Remove a thread from the report before it is joined
+    static void release(const std::thread& thread);
+
+    // Placement of every registered thread as applied, the kernel's
+    // isolated CPUs, and a warning for every CPU a placed simulation
+    // thread shares with a logging, ingest, I/O or render thread
+    static std::string report();
+
+    static const char* roleName(Role role);
+};
+
+#endif // THREAD_ROLES_H
@@ -0,0 +1,91 @@
+// FILE: include/utils/TickJitter.h
+#ifndef TICK_JITTER_H
+#define TICK_JITTER_H
+
+#include <chrono>
+#include <cstdio>
+#include <string>
+#include <thread>
+#include "utils/LatencyHistogram.h"
+
+// Timing of a periodic simulation tick in microseconds: how late each
+// wake-up came after its scheduled time, and how long the tick itself
+// took. Compare p99 of both with and without the simulation thread
+// isolated (see ThreadRoles) to see whether the placement helps.
+class TickJitter {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    // Sleep until a tick's scheduled start and record the lateness
+    void sleepUntil(Clock::time_point scheduled) {
+        std::this_thread::sleep_until(scheduled);
+        woke(scheduled);
+    }
+
+    // Record the lateness of a wake-up the caller slept for itself
+    void woke(Clock::time_point scheduled) {
+        Clock::time_point now = Clock::now();
+        wakeLatencyUs.record(now > scheduled ? micros(now - scheduled) : 0);
+    }
+
+    void tickStarted() { tickStart = Clock::now(); }
+    void tickFinished() { tickDurationUs.record(micros(Clock::now() - tickStart)); }
+
+    const LatencyHistogram& getWakeLatency() const { return wakeLatencyUs; }
+    const LatencyHistogram& getTickDuration() const { return tickDurationUs; }
+
+    void clear() {
+        wakeLatencyUs.clear();
+        tickDurationUs.clear();
+    }
+
+    // Count and percentiles of both, in microseconds, on one line
+    std::string summary() const {
+        return "wake " + describe(wakeLatencyUs) + "  tick " + describe(tickDurationUs);
+    }
+
+    // Write both histograms as CSV (metric,low_us,high_us,count), after
+    // '#' lines with the counts and percentiles. False if the file can't
+    // be written.
+    bool exportTo(const std::string& path) const {
+        FILE* file = std::fopen(path.c_str(), "w");
+        if (!file) {
+            return false;
+        }
+        std::fprintf(file, "# wake latency (us): %s\n", describe(wakeLatencyUs).c_str());
+        std::fprintf(file, "# tick duration (us): %s\n", describe(tickDurationUs).c_str());
+        std::fprintf(file, "metric,low_us,high_us,count\n");
+        auto write = [file](const char* metric, const LatencyHistogram& histogram) {
+            histogram.forEachBucket([&](uint64_t low, uint64_t high, uint64_t count) {
+                std::fprintf(file, "%s,%llu,%llu,%llu\n", metric, static_cast<unsigned long long>(low),
+                             static_cast<unsigned long long>(high), static_cast<unsigned long long>(count));
+            });
+        };
+        write("wake", wakeLatencyUs);
+        write("tick", tickDurationUs);
+        return std::fclose(file) == 0;
+    }
+
+private:
+    LatencyHistogram wakeLatencyUs;
+    LatencyHistogram tickDurationUs;
+    Clock::time_point tickStart;
+
+    static uint64_t micros(Clock::duration duration) {
+        return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(duration).count());
+    }
+
+    static std::string describe(const LatencyHistogram& histogram) {
+        char text[128];
+        std::snprintf(text, sizeof(text), "n=%llu p50=%llu p90=%llu p99=%llu p99.9=%llu max=%llu",
+                      static_cast<unsigned long long>(histogram.getCount()),
+                      static_cast<unsigned long long>(histogram.getPercentile(0.50)),
+                      static_cast<unsigned long long>(histogram.getPercentile(0.90)),
+                      static_cast<unsigned long long>(histogram.getPercentile(0.99)),
+                      static_cast<unsigned long long>(histogram.getPercentile(0.999)),
+                      static_cast<unsigned long long>(histogram.getMax()));
+        return text;
+    }
+};
+
+#endif // TICK_JITTER_H
@@ -0,0 +1,51 @@
+// FILE: include/visualization/Dashboard.h
+#ifndef DASHBOARD_H
+#define DASHBOARD_H
+
+#include <cstdint>
+#include <deque>
+#include <string>
+#include "utils/LatencyHistogram.h"
+
+class TerminalScreen;
+class TrafficManager;
+
+// Terminal view of a running TrafficManager: light state, the queue of
+// every lane of the displayed junction, throughput and junction delay
+// percentiles over a sliding window of simulation time and since start.
+//
+// Windowed figures come from snapshots of the manager's cumulative exit
+// count and delay histogram taken once per simulated second, so drawing
+// costs the same at any traffic level.
+class Dashboard {
+public:
+    explicit Dashboard(const TrafficManager& manager, uint32_t windowSeconds = 60);
+
+    // Draw the current state into the screen's back buffer. The footer
+    // shows the caller's output rate and refresh rate.
+    void draw(TerminalScreen& screen, double outputBytesPerSecond, double refreshHz);
+
+private:
+    // Cumulative figures at one simulation time
+    struct Snapshot {
+        uint64_t time;
+        uint64_t exited;
+        LatencyHistogram delays;
+    };
+
+    const TrafficManager& manager;
+    uint32_t windowSeconds;
+    std::deque<Snapshot> snapshots;     // Oldest first, one per simulated second
+
+    // Record a snapshot per elapsed simulated second and drop those older
+    // than the window
+    void takeSnapshots();
+
+    // "12.3s" style duration from milliseconds
+    static std::string formatDelay(uint64_t ms);
+
+    // hh:mm:ss.t from milliseconds
+    static std::string formatClock(uint64_t ms);
+};
+
+#endif // DASHBOARD_H
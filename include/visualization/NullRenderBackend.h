@@ -0,0 +1,96 @@
+// FILE: include/visualization/NullRenderBackend.h
+#ifndef NULL_RENDER_BACKEND_H
+#define NULL_RENDER_BACKEND_H
+
+#include "visualization/RenderBackend.h"
+#include <vector>
+
+// Backend that draws nothing and counts what a frame asked for: draw calls
+// by kind, state changes (and how many set what was already set), and the
+// bytes of vertex and pixel data a GPU backend would have been handed.
+// Time advances a fixed frameMs per present(), starting at 0.
+class NullRenderBackend : public RenderBackend {
+public:
+    struct Stats {
+        uint64_t frames = 0;
+        uint64_t clears = 0;
+        uint64_t points = 0;
+        uint64_t lines = 0;
+        uint64_t rects = 0;
+        uint64_t fillRects = 0;
+        uint64_t geometryCalls = 0;
+        uint64_t triangles = 0;
+        uint64_t textureDraws = 0;
+        uint64_t stateChanges = 0;        // Color, blend and texture modulation
+        uint64_t redundantChanges = 0;    // State changes to the current value
+        uint64_t vertexBytes = 0;         // Vertex, index and rect data
+        uint64_t textureBytes = 0;        // Pixels uploaded
+
+        // Draw calls of any kind (clears excluded)
+        uint64_t primitives() const {
+            return points + lines + rects + fillRects + geometryCalls + textureDraws;
+        }
+    };
+
+    explicit NullRenderBackend(uint32_t frameMs = 16);
+
+    const Stats& getStats() const { return stats; }
+    void resetStats() { stats = Stats(); }
+
+    void setDrawColor(Uint8 r, Uint8 g, Uint8 b, Uint8 a) override;
+    void setDrawBlendMode(SDL_BlendMode mode) override;
+
+    void clear() override;
+    void drawPoint(float x, float y) override;
+    void drawLine(float x1, float y1, float x2, float y2) override;
+    void drawRect(const SDL_FRect* rect) override;
+    void fillRect(const SDL_FRect* rect) override;
+    void drawGeometry(TextureId texture, const SDL_Vertex* vertices, int numVertices,
+                      const int* indices, int numIndices) override;
+
+    TextureId createTexture(int width, int height, const void* pixels, int pitch) override;
+    void destroyTexture(TextureId texture) override;
+    void setTextureBlendMode(TextureId texture, SDL_BlendMode mode) override;
+    void setTextureScaleMode(TextureId texture, SDL_ScaleMode mode) override;
+    void setTextureColorMod(TextureId texture, Uint8 r, Uint8 g, Uint8 b) override;
+    bool getTextureSize(TextureId texture, float* width, float* height) override;
+    void drawTexture(TextureId texture, const SDL_FRect* source, const SDL_FRect* target) override;
+    void drawTexture9Grid(TextureId texture, const SDL_FRect* source,
+                          float left, float right, float top, float bottom,
+                          float scale, const SDL_FRect* target) override;
+
+    void present() override;
+    uint64_t getTicks() override;
+
+private:
+    // What the null target remembers of a texture
+    struct Texture {
+        int width;
+        int height;
+        SDL_BlendMode blendMode;
+        SDL_ScaleMode scaleMode;
+        uint32_t colorMod;              // 0x00RRGGBB
+        bool live;
+    };
+
+    uint32_t frameMs;
+    uint64_t ticks;
+    uint32_t drawColor;                 // 0xRRGGBBAA
+    SDL_BlendMode blendMode;
+    std::vector<Texture> textures;      // Index id - 1
+    Stats stats;
+
+    // Count a state change from current to value and apply it
+    template<typename T>
+    void change(T& current, T value) {
+        stats.stateChanges++;
+        if (current == value) {
+            stats.redundantChanges++;
+        }
+        current = value;
+    }
+
+    Texture* lookup(TextureId texture);
+};
+
+#endif // NULL_RENDER_BACKEND_H
@@ -0,0 +1,52 @@
+// FILE: include/visualization/RecordingRenderBackend.h
+#ifndef RECORDING_RENDER_BACKEND_H
+#define RECORDING_RENDER_BACKEND_H
+
+#include "visualization/NullRenderBackend.h"
+#include <initializer_list>
+#include <ostream>
+#include <string>
+
+// Null backend that also writes every command to a stream as one line of
+// text ("line 10 20 30 40", "color 255 0 0 255", "frame 3"), so two runs of
+// a scene can be compared with diff. Numbers are printed with %g, texture
+// uploads as their size and a hash of the pixels. Time runs on the fixed
+// frame clock of NullRenderBackend, keeping animations reproducible.
+class RecordingRenderBackend : public NullRenderBackend {
+public:
+    explicit RecordingRenderBackend(std::ostream& out, uint32_t frameMs = 16);
+
+    void setDrawColor(Uint8 r, Uint8 g, Uint8 b, Uint8 a) override;
+    void setDrawBlendMode(SDL_BlendMode mode) override;
+
+    void clear() override;
+    void drawPoint(float x, float y) override;
+    void drawLine(float x1, float y1, float x2, float y2) override;
+    void drawRect(const SDL_FRect* rect) override;
+    void fillRect(const SDL_FRect* rect) override;
+    void drawGeometry(TextureId texture, const SDL_Vertex* vertices, int numVertices,
+                      const int* indices, int numIndices) override;
+
+    TextureId createTexture(int width, int height, const void* pixels, int pitch) override;
+    void destroyTexture(TextureId texture) override;
+    void setTextureBlendMode(TextureId texture, SDL_BlendMode mode) override;
+    void setTextureScaleMode(TextureId texture, SDL_ScaleMode mode) override;
+    void setTextureColorMod(TextureId texture, Uint8 r, Uint8 g, Uint8 b) override;
+    void drawTexture(TextureId texture, const SDL_FRect* source, const SDL_FRect* target) override;
+    void drawTexture9Grid(TextureId texture, const SDL_FRect* source,
+                          float left, float right, float top, float bottom,
+                          float scale, const SDL_FRect* target) override;
+
+    void present() override;
+
+private:
+    std::ostream& out;
+
+    // Write a command line: name followed by space-separated numbers
+    void write(const char* name, std::initializer_list<double> values);
+
+    // Rect as four numbers, or "all" for null
+    static std::string rectText(const SDL_FRect* rect);
+};
+
+#endif // RECORDING_RENDER_BACKEND_H
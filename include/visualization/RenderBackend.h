@@ -0,0 +1,67 @@
+// FILE: include/visualization/RenderBackend.h
+#ifndef RENDER_BACKEND_H
+#define RENDER_BACKEND_H
+
+#include <SDL3/SDL.h>
+#include <cstdint>
+
+// Target of every drawing path in the simulator.
+//
+// The calls mirror the part of the SDL renderer API the scene is drawn
+// with, minus the SDL_Renderer argument, so drawing code reads the same as
+// before. Implementations:
+//   SdlRenderBackend        draws through an SDL_Renderer
+//   NullRenderBackend       draws nothing; counts primitives, state changes and bytes
+//   RecordingRenderBackend  writes each command as a line of text for diffing
+// The last two need no window, display or GPU, so the CPU cost of building
+// a frame can be measured on any host.
+//
+// Animations take their time from getTicks() rather than SDL_GetTicks(), so
+// the headless backends can run them on a fixed frame clock and two
+// recordings of the same scene compare equal.
+class RenderBackend {
+public:
+    // Backend-owned texture handle; 0 is no texture
+    typedef uint32_t TextureId;
+
+    virtual ~RenderBackend() {}
+
+    // Draw state
+    virtual void setDrawColor(Uint8 r, Uint8 g, Uint8 b, Uint8 a) = 0;
+    virtual void setDrawBlendMode(SDL_BlendMode mode) = 0;
+
+    // Primitives in the current draw color; a null rect is the whole target
+    virtual void clear() = 0;
+    virtual void drawPoint(float x, float y) = 0;
+    virtual void drawLine(float x1, float y1, float x2, float y2) = 0;
+    virtual void drawRect(const SDL_FRect* rect) = 0;
+    virtual void fillRect(const SDL_FRect* rect) = 0;
+
+    // Triangles with per-vertex colors; null indices draw the vertices in order
+    virtual void drawGeometry(TextureId texture, const SDL_Vertex* vertices, int numVertices,
+                              const int* indices, int numIndices) = 0;
+
+    // Static RGBA32 texture from pixels (0 on failure)
+    virtual TextureId createTexture(int width, int height, const void* pixels, int pitch) = 0;
+    virtual void destroyTexture(TextureId texture) = 0;
+    virtual void setTextureBlendMode(TextureId texture, SDL_BlendMode mode) = 0;
+    virtual void setTextureScaleMode(TextureId texture, SDL_ScaleMode mode) = 0;
+    virtual void setTextureColorMod(TextureId texture, Uint8 r, Uint8 g, Uint8 b) = 0;
+    virtual bool getTextureSize(TextureId texture, float* width, float* height) = 0;
+
+    // Draw a texture, or the part of it in source (null: all of it)
+    virtual void drawTexture(TextureId texture, const SDL_FRect* source, const SDL_FRect* target) = 0;
+
+    // Draw a texture as a 9-grid: corners kept, edges and centre stretched
+    virtual void drawTexture9Grid(TextureId texture, const SDL_FRect* source,
+                                  float left, float right, float top, float bottom,
+                                  float scale, const SDL_FRect* target) = 0;
+
+    // End of frame
+    virtual void present() = 0;
+
+    // Milliseconds for animations
+    virtual uint64_t getTicks() = 0;
+};
+
+#endif // RENDER_BACKEND_H
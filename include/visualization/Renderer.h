@@ -9,6 +9,7 @@
 #include <random>
 #include <cmath>
 #include "core/Vehicle.h" // For Direction enum
+#include "visualization/RenderBackend.h"
 
 class Lane;
 class TrafficLight;
@@ -22,6 +23,10 @@ public:
     // Initialize renderer with window dimensions
     bool initialize(int width, int height, const std::string& title);
 
+    // Initialize without a window, drawing into a backend the caller owns
+    // (e.g. NullRenderBackend for benchmarks)
+    bool initializeHeadless(int width, int height, RenderBackend* target);
+
     // Start rendering loop
     void startRenderLoop();
 
@@ -44,11 +49,14 @@ public:
     void setFrameRateLimit(int fps);
 
 private:
-    // SDL components
+    // SDL components (null when headless)
     SDL_Window* window;
     SDL_Renderer* renderer;
-    SDL_Texture* carTexture;
-    SDL_Surface* surface;
+
+    // Everything is drawn through the backend
+    RenderBackend* backend;
+    bool ownsBackend;
+    RenderBackend::TextureId carTexture;
 
     // Rendering state
     bool active;
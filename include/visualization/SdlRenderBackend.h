@@ -0,0 +1,50 @@
+// FILE: include/visualization/SdlRenderBackend.h
+#ifndef SDL_RENDER_BACKEND_H
+#define SDL_RENDER_BACKEND_H
+
+#include "visualization/RenderBackend.h"
+#include <vector>
+
+// Backend drawing through an SDL_Renderer, which the caller keeps owning.
+// Textures still alive when the backend is destroyed are destroyed with it.
+class SdlRenderBackend : public RenderBackend {
+public:
+    explicit SdlRenderBackend(SDL_Renderer* renderer);
+    ~SdlRenderBackend() override;
+
+    SDL_Renderer* getRenderer() const { return renderer; }
+
+    void setDrawColor(Uint8 r, Uint8 g, Uint8 b, Uint8 a) override;
+    void setDrawBlendMode(SDL_BlendMode mode) override;
+
+    void clear() override;
+    void drawPoint(float x, float y) override;
+    void drawLine(float x1, float y1, float x2, float y2) override;
+    void drawRect(const SDL_FRect* rect) override;
+    void fillRect(const SDL_FRect* rect) override;
+    void drawGeometry(TextureId texture, const SDL_Vertex* vertices, int numVertices,
+                      const int* indices, int numIndices) override;
+
+    TextureId createTexture(int width, int height, const void* pixels, int pitch) override;
+    void destroyTexture(TextureId texture) override;
+    void setTextureBlendMode(TextureId texture, SDL_BlendMode mode) override;
+    void setTextureScaleMode(TextureId texture, SDL_ScaleMode mode) override;
+    void setTextureColorMod(TextureId texture, Uint8 r, Uint8 g, Uint8 b) override;
+    bool getTextureSize(TextureId texture, float* width, float* height) override;
+    void drawTexture(TextureId texture, const SDL_FRect* source, const SDL_FRect* target) override;
+    void drawTexture9Grid(TextureId texture, const SDL_FRect* source,
+                          float left, float right, float top, float bottom,
+                          float scale, const SDL_FRect* target) override;
+
+    void present() override;
+    uint64_t getTicks() override;
+
+private:
+    SDL_Renderer* renderer;
+    std::vector<SDL_Texture*> textures;     // Index id - 1; null once destroyed
+
+    // SDL texture for an id, or null
+    SDL_Texture* lookup(TextureId texture) const;
+};
+
+#endif // SDL_RENDER_BACKEND_H
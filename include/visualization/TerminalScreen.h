@@ -0,0 +1,74 @@
+// FILE: include/visualization/TerminalScreen.h
+#ifndef TERMINAL_SCREEN_H
+#define TERMINAL_SCREEN_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Double-buffered character grid for ANSI terminals.
+//
+// A frame is drawn into the back buffer with put()/fill(), then flush()
+// compares it with what the terminal already shows and emits escape
+// sequences for the changed cells only: a cursor move where a run of
+// changes starts (short unchanged gaps are rewritten instead, which is
+// cheaper), a style change where the style differs from the last cell
+// written, and the characters. An unchanged frame costs nothing, so the
+// output rate follows how much the picture changes, not the refresh rate.
+class TerminalScreen {
+public:
+    // Cell style: a foreground color plus attribute bits
+    enum Color : uint8_t {
+        DEFAULT = 0, RED = 1, GREEN = 2, YELLOW = 3, BLUE = 4, MAGENTA = 5, CYAN = 6, WHITE = 7
+    };
+    static constexpr uint8_t BOLD = 0x10;
+    static constexpr uint8_t DIM = 0x20;
+    static constexpr uint8_t REVERSE = 0x40;
+
+    TerminalScreen();
+
+    // Set the grid size; the next flush() redraws everything
+    void resize(int width, int height);
+    int getWidth() const { return width; }
+    int getHeight() const { return height; }
+
+    // Blank the back buffer
+    void clear();
+
+    // Write text at (x, y), clipped to the grid; returns the column after it
+    int put(int x, int y, const std::string& text, uint8_t style = DEFAULT);
+
+    // Fill count cells from (x, y) with one character
+    void fill(int x, int y, int count, char c, uint8_t style = DEFAULT);
+
+    // Escape sequences turning the shown frame into the back buffer, which
+    // then becomes the shown frame. Empty if nothing changed.
+    std::string flush();
+
+    // Forget what the terminal shows (e.g. after another program wrote to
+    // it) so the next flush() redraws every cell
+    void invalidate();
+
+    // Sequences to enter/leave full-screen mode: alternate screen, hidden
+    // cursor, no line wrap
+    static std::string enterSequence();
+    static std::string leaveSequence();
+
+private:
+    struct Cell {
+        char c;
+        uint8_t style;
+        bool operator==(const Cell& other) const { return c == other.c && style == other.style; }
+        bool operator!=(const Cell& other) const { return !(*this == other); }
+    };
+
+    int width;
+    int height;
+    std::vector<Cell> back;     // Frame being drawn
+    std::vector<Cell> front;    // Frame on the terminal
+    bool fullRedraw;
+
+    static void appendStyle(std::string& out, uint8_t style);
+};
+
+#endif // TERMINAL_SCREEN_H
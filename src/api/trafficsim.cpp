@@ -0,0 +1,199 @@
+// FILE: src/api/trafficsim.cpp
+#include "trafficsim.h"
+
+#include <atomic>
+#include <cstdint>
+#include <exception>
+#include <new>
+#include <string>
+
+#include "managers/TrafficManager.h"
+#include "utils/DebugLogger.h"
+
+struct ts_sim {
+    TrafficManager manager;
+};
+
+namespace {
+
+// Whether the embedder chose a log setting; otherwise ts_create turns the log off
+std::atomic<bool> loggingChosen(false);
+
+int clampCount(size_t count) {
+    return count > static_cast<size_t>(INT32_MAX) ? INT32_MAX : static_cast<int>(count);
+}
+
+} // namespace
+
+uint32_t ts_api_version(void) {
+    return TS_API_VERSION;
+}
+
+void ts_config_init(ts_config* config) {
+    if (!config) return;
+    config->struct_size = sizeof(ts_config);
+    config->network_path = nullptr;
+    config->threads = 1;
+    config->fixed_point = 0;
+}
+
+int ts_create(const ts_config* config, ts_sim** sim) {
+    if (!sim) return TS_ERROR_INVALID_ARGUMENT;
+    *sim = nullptr;
+
+    ts_config defaults;
+    ts_config_init(&defaults);
+    if (!config) {
+        config = &defaults;
+    } else if (config->struct_size < sizeof(ts_config)) {
+        return TS_ERROR_INVALID_ARGUMENT;
+    }
+
+    if (!loggingChosen.load()) {
+        DebugLogger::setEnabled(false);
+    }
+
+    try {
+        ts_sim* created = new ts_sim();
+        std::string networkPath = config->network_path ? config->network_path : "";
+        if (!created->manager.initialize(networkPath, false)) {
+            delete created;
+            return TS_ERROR_NETWORK;
+        }
+
+        created->manager.setWorkerThreads(config->threads > 1 ? config->threads : 1);
+        created->manager.setFixedPointKinematics(config->fixed_point != 0);
+        created->manager.start();
+
+        *sim = created;
+        return TS_OK;
+    } catch (const std::exception& e) {
+        DebugLogger::log("ts_create failed: " + std::string(e.what()), DebugLogger::LogLevel::ERROR);
+        return TS_ERROR_INTERNAL;
+    }
+}
+
+void ts_destroy(ts_sim* sim) {
+    delete sim;
+}
+
+int ts_inject(ts_sim* sim, const ts_arrival* arrivals, size_t count) {
+    if (!sim || (!arrivals && count > 0)) return TS_ERROR_INVALID_ARGUMENT;
+
+    try {
+        size_t accepted = 0;
+        for (size_t i = 0; i < count; i++) {
+            const ts_arrival& arrival = arrivals[i];
+            if (arrival.destination > TS_DESTINATION_RIGHT) continue;
+
+            if (sim->manager.addArrival(arrival.vehicle_id, static_cast<char>(arrival.road), arrival.lane_number,
+                                        static_cast<Destination>(arrival.destination),
+                                        (arrival.flags & TS_VEHICLE_EMERGENCY) != 0)) {
+                accepted++;
+            }
+        }
+        return clampCount(accepted);
+    } catch (const std::exception& e) {
+        DebugLogger::log("ts_inject failed: " + std::string(e.what()), DebugLogger::LogLevel::ERROR);
+        return TS_ERROR_INTERNAL;
+    }
+}
+
+int ts_step(ts_sim* sim, uint32_t ticks, uint32_t tick_ms) {
+    if (!sim) return TS_ERROR_INVALID_ARGUMENT;
+
+    try {
+        for (uint32_t i = 0; i < ticks; i++) {
+            sim->manager.update(tick_ms);
+        }
+        return TS_OK;
+    } catch (const std::exception& e) {
+        DebugLogger::log("ts_step failed: " + std::string(e.what()), DebugLogger::LogLevel::ERROR);
+        return TS_ERROR_INTERNAL;
+    }
+}
+
+uint64_t ts_time(const ts_sim* sim) {
+    return sim ? sim->manager.getSimulationTime() : 0;
+}
+
+uint64_t ts_exited(const ts_sim* sim) {
+    return sim ? sim->manager.getExitedCount() : 0;
+}
+
+int ts_read_lanes(const ts_sim* sim, ts_lane* lanes, size_t capacity) {
+    if (!sim || (!lanes && capacity > 0)) return TS_ERROR_INVALID_ARGUMENT;
+
+    const RoadNetwork& network = sim->manager.getNetwork();
+    const std::vector<Lane*>& managerLanes = sim->manager.getLanes();
+    for (size_t i = 0; i < managerLanes.size() && i < capacity; i++) {
+        const RoadNetwork::LaneInfo& info = network.getLane(i);
+        const Lane* lane = managerLanes[i];
+        lanes[i].junction = info.junction;
+        lanes[i].road = static_cast<uint8_t>(info.road);
+        lanes[i].lane_number = info.laneNumber;
+        lanes[i].is_priority = lane->isPriorityLane() && lane->getPriority() > 0;
+        lanes[i].reserved = 0;
+        lanes[i].vehicle_count = static_cast<uint32_t>(lane->getVehicleCount());
+    }
+    return clampCount(managerLanes.size());
+}
+
+int ts_read_lights(const ts_sim* sim, uint8_t* states, size_t capacity) {
+    if (!sim || (!states && capacity > 0)) return TS_ERROR_INVALID_ARGUMENT;
+
+    size_t junctions = sim->manager.getNetwork().getJunctionCount();
+    for (size_t j = 0; j < junctions && j < capacity; j++) {
+        states[j] = static_cast<uint8_t>(sim->manager.getTrafficLight(j)->getCurrentState());
+    }
+    return clampCount(junctions);
+}
+
+int ts_read_vehicles(const ts_sim* sim, ts_vehicle* vehicles, size_t capacity) {
+    if (!sim || (!vehicles && capacity > 0)) return TS_ERROR_INVALID_ARGUMENT;
+
+    const std::vector<Lane*>& lanes = sim->manager.getLanes();
+    size_t total = 0;
+    for (size_t i = 0; i < lanes.size(); i++) {
+        for (const Vehicle* vehicle : lanes[i]->getVehicles()) {
+            if (!vehicle) continue;
+            if (total < capacity) {
+                ts_vehicle& out = vehicles[total];
+                out.x = vehicle->getTurnPosX();
+                out.y = vehicle->getTurnPosY();
+                out.lane_index = static_cast<uint32_t>(i);
+                out.flags = (vehicle->isEmergencyVehicle() ? TS_VEHICLE_EMERGENCY : 0) |
+                            (vehicle->isTurning() ? TS_VEHICLE_TURNING : 0);
+            }
+            total++;
+        }
+    }
+    return clampCount(total);
+}
+
+int ts_snapshot(const ts_sim* sim, const char* path) {
+    if (!sim || !path) return TS_ERROR_INVALID_ARGUMENT;
+
+    try {
+        return sim->manager.saveCheckpoint(path) ? TS_OK : TS_ERROR_IO;
+    } catch (const std::exception& e) {
+        DebugLogger::log("ts_snapshot failed: " + std::string(e.what()), DebugLogger::LogLevel::ERROR);
+        return TS_ERROR_INTERNAL;
+    }
+}
+
+int ts_restore(ts_sim* sim, const char* path) {
+    if (!sim || !path) return TS_ERROR_INVALID_ARGUMENT;
+
+    try {
+        return sim->manager.loadCheckpoint(path) ? TS_OK : TS_ERROR_IO;
+    } catch (const std::exception& e) {
+        DebugLogger::log("ts_restore failed: " + std::string(e.what()), DebugLogger::LogLevel::ERROR);
+        return TS_ERROR_INTERNAL;
+    }
+}
+
+void ts_set_logging(int enabled) {
+    loggingChosen = true;
+    DebugLogger::setEnabled(enabled != 0);
+}
@@ -0,0 +1,1663 @@
+// FILE: src/bench/sim_bench.cpp
+// Benchmarks for the simulation core. Each benchmark is a subcommand:
+//
+//   sim_bench locality [--size N] [--steps S] [--parts P] [--model-size M]
+//                      [--vehicles V]
+//       Step kernel over a N x N grid network loaded in shuffled file order,
+//       row-major file order and Hilbert order. Reports time and last-level
+//       cache misses per step, plus links cut by P contiguous partitions.
+//       Then the same three orders through TrafficManager::update on a M x M
+//       grid (40 by default; the all-pairs routing tables keep it small)
+//       with V vehicles on every approach lane.
+//
+//   sim_bench junction [--size N] [--steps S] [--vehicles V]
+//       Junction tick (vehicle movement plus light update) over a N x N grid,
+//       once through the generic std::vector<Lane*> loops and once through
+//       the fixed-topology StandardJunction kernel, with V vehicles queued on
+//       every lane 2 and 3. Logging is switched off while timing.
+//
+//   sim_bench parallel [--vehicles N] [--steps S] [--threads T]
+//       N vehicles queued on the standard junction, stepped through
+//       TrafficManager with 1..T vehicle update threads. Reports time per
+//       step, scaling efficiency and whether the final vehicle state is
+//       bit-identical to the single-threaded run.
+//
+//   sim_bench kinematics [--vehicles N] [--steps S]
+//       Vehicle step throughput with float and fixed-point kinematics, with
+//       a hash of the final positions for comparing builds.
+//
+//   sim_bench soak [--days D] [--step-ms N] [--rate R] [--samples K] [--seed S]
+//       Standard junction run headless for D simulated days with Poisson
+//       arrivals at R per minute, logging to a file as a service would.
+//       Samples RSS, heap use, Vehicle objects, vehicles in the model and
+//       Vehicle objects outside it K times, along with the lane queue
+//       slots, in-transit entries, log buffer and recent-log list and
+//       routing tables. Tests each series for monotonic growth after
+//       warm-up (Mann-Kendall) and projects it to 30 days (Sen's slope).
+//       Exits with 2 if anything grows.
+//
+//   sim_bench render [--vehicles N[,N...]] [--frames F] [--record FILE]
+//       Visualization frames built with N vehicles queued (1000 and 10000 by
+//       default) into NullRenderBackend, so no display or GPU is needed.
+//       Reports CPU time, primitives, state changes (and the share that set
+//       the current value) and vertex data per frame. --record writes one
+//       frame of the last run as text through RecordingRenderBackend.
+//
+//   sim_bench io [--messages N] [--batch B] [--files F] [--rounds R]
+//       File I/O through AsyncFileIO on io_uring and on the thread-pool
+//       fallback: N log lines flushed B at a time, F lane files read
+//       together R times, and a 16 MB trace written in 64 KB pieces.
+//       Reports batches, system calls, MB/s and per-operation latency
+//       percentiles, next to one ofstream open/write/close per log line.
+//
+//   sim_bench emissions [--vehicles N] [--steps S]
+//       N vehicles queued on the standard junction, stepped S times through
+//       two TrafficManagers, one with emissions accounting and one without,
+//       in turn. Reports the share of tick time spent on the emissions batch
+//       and prints the per-lane and per-turn totals.
+//
+//   sim_bench jitter [--seconds S] [--period-us P] [--vehicles V]
+//                    [--sim-cpu C] [--noise-cpu N] [--out PREFIX]
+//       A simulation thread stepping V vehicles every P us while a log
+//       thread writes and flushes flat out, first with both on CPU C, then
+//       with the log thread (and its I/O pool) moved to CPU N. Reports
+//       wake-up lateness and tick time percentiles for both placements;
+//       --out writes PREFIX-shared.csv and PREFIX-isolated.csv histograms.
+//
+//   sim_bench checkpoint [--size N] [--vehicles V] [--arrivals A]
+//                        [--checkpoints C] [--every K] [--base-every B]
+//       N x N grid with V vehicles on every approach lane and A arrivals
+//       per step, checkpointed C times every K steps: a full checkpoint
+//       every B and deltas in between. Reports size and write time of
+//       each kind and the share of lanes the deltas carried, then restores
+//       the last chain into a fresh manager and checks the state matches.
+//       Arrivals also come from a trace replayed at the entry junction.
+//       Both managers then run K more steps as a run that crashed and
+//       recovered and one that didn't; exits with 1 if they diverge.
+#include "core/Junction.h"
+#include "core/Kinematics.h"
+#include "core/RoadNetwork.h"
+#include "managers/TrafficManager.h"
+#include "utils/AsyncFileIO.h"
+#include "utils/DebugLogger.h"
+#include "utils/ThreadRoles.h"
+#include "utils/TickJitter.h"
+#include "visualization/NullRenderBackend.h"
+#include "visualization/RecordingRenderBackend.h"
+#include "visualization/Renderer.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <numeric>
+#include <random>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <tuple>
+#include <vector>
+
+#ifdef __GLIBC__
+#include <malloc.h>
+#endif
+
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace {
+
+// Hardware counter for last-level cache read misses (Linux only)
+class CacheMissCounter {
+public:
+    CacheMissCounter() : fd(-1) {
+#ifdef __linux__
+        perf_event_attr attr;
+        std::memset(&attr, 0, sizeof(attr));
+        attr.size = sizeof(attr);
+        attr.type = PERF_TYPE_HW_CACHE;
+        attr.config = PERF_COUNT_HW_CACHE_LL |
+                      (PERF_COUNT_HW_CACHE_OP_READ << 8) |
+                      (PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+        attr.disabled = 1;
+        attr.exclude_kernel = 1;
+        attr.exclude_hv = 1;
+        fd = static_cast<int>(syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0));
+
+        // Some CPUs only expose the generic cache-miss event
+        if (fd < 0) {
+            attr.type = PERF_TYPE_HARDWARE;
+            attr.config = PERF_COUNT_HW_CACHE_MISSES;
+            fd = static_cast<int>(syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0));
+        }
+#endif
+    }
+
+    ~CacheMissCounter() {
+#ifdef __linux__
+        if (fd >= 0) close(fd);
+#endif
+    }
+
+    bool available() const { return fd >= 0; }
+
+    void start() {
+#ifdef __linux__
+        if (fd < 0) return;
+        ioctl(fd, PERF_EVENT_IOC_RESET, 0);
+        ioctl(fd, PERF_EVENT_IOC_ENABLE, 0);
+#endif
+    }
+
+    uint64_t stop() {
+        uint64_t count = 0;
+#ifdef __linux__
+        if (fd < 0) return 0;
+        ioctl(fd, PERF_EVENT_IOC_DISABLE, 0);
+        if (read(fd, &count, sizeof(count)) != sizeof(count)) count = 0;
+#endif
+        return count;
+    }
+
+private:
+    int fd;
+};
+
+// Per-lane simulation state, one cache line like a Lane object with its queue
+struct alignas(64) LaneBlock {
+    uint32_t queued;
+    uint32_t served;
+    float waitTime;
+    uint32_t arrivals;
+};
+
+// Write an N x N grid network with junction records in the given order
+void writeGrid(const std::string& path, int size, bool shuffled) {
+    std::vector<int> order(size * size);
+    std::iota(order.begin(), order.end(), 0);
+    if (shuffled) {
+        std::mt19937 rng(42);
+        std::shuffle(order.begin(), order.end(), rng);
+    }
+
+    std::ofstream file(path);
+    for (int j : order) {
+        file << "junction " << j << " " << (j % size) * 300 << " " << (j / size) * 300 << "\n";
+    }
+    for (int j : order) {
+        int r = j / size;
+        int c = j % size;
+        if (r > 0) file << "link " << j << " A " << j - size << " C 300\n";
+        if (c + 1 < size) file << "link " << j << " B " << j + 1 << " D 300\n";
+        if (r + 1 < size) file << "link " << j << " C " << j + size << " A 300\n";
+        if (c > 0) file << "link " << j << " D " << j - 1 << " B 300\n";
+    }
+}
+
+// One simulation step: every junction serves its approaches and hands the
+// served vehicles to the downstream junction's entry lane
+void step(const RoadNetwork& network, std::vector<LaneBlock>& lanes) {
+    for (uint32_t j = 0; j < network.getJunctionCount(); j++) {
+        const RoadNetwork::Junction& junction = network.getJunction(j);
+        for (int a = 0; a < junction.approachCount; a++) {
+            char road = static_cast<char>('A' + a);
+            LaneBlock& lane = lanes[network.laneIndex(j, road, 2)];
+            lane.waitTime += lane.queued * 0.016f;
+
+            uint32_t link = network.exitLink(j, road);
+            if (link == RoadNetwork::INVALID_INDEX || lane.queued == 0) {
+                continue;
+            }
+
+            const RoadNetwork::Link& l = network.getLink(link);
+            LaneBlock& next = lanes[network.laneIndex(l.toJunction, l.entryRoad, 2)];
+            lane.queued--;
+            lane.served++;
+            next.queued++;
+            next.arrivals++;
+        }
+    }
+}
+
+// Links whose endpoints fall in different partitions
+size_t cutLinks(const RoadNetwork& network, size_t parts) {
+    std::vector<uint32_t> bounds = network.partitionJunctions(parts);
+    std::vector<uint32_t> owner(network.getJunctionCount());
+    for (size_t p = 0; p + 1 < bounds.size(); p++) {
+        for (uint32_t j = bounds[p]; j < bounds[p + 1]; j++) {
+            owner[j] = static_cast<uint32_t>(p);
+        }
+    }
+
+    size_t cut = 0;
+    for (size_t l = 0; l < network.getLinkCount(); l++) {
+        const RoadNetwork::Link& link = network.getLink(l);
+        if (owner[link.fromJunction] != owner[link.toJunction]) cut++;
+    }
+    return cut;
+}
+
+void runLocality(const std::string& label, const std::string& path, bool hilbert,
+                 int steps, size_t parts) {
+    RoadNetwork network;
+    if (!network.loadFromFile(path, hilbert)) {
+        std::cerr << "Failed to load " << path << ": " << network.getLastError() << std::endl;
+        return;
+    }
+
+    // Allocate lane state in network lane order and seed a few vehicles per lane
+    std::vector<LaneBlock> lanes(network.getLaneCount());
+    for (auto& lane : lanes) {
+        lane.queued = 4;
+        lane.served = 0;
+        lane.waitTime = 0.0f;
+        lane.arrivals = 0;
+    }
+
+    // Warm up once so page faults are not counted
+    step(network, lanes);
+
+    CacheMissCounter counter;
+    auto begin = std::chrono::steady_clock::now();
+    counter.start();
+    for (int s = 0; s < steps; s++) {
+        step(network, lanes);
+    }
+    uint64_t misses = counter.stop();
+    double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - begin).count();
+
+    std::printf("%-22s %10.3f ms/step  ", label.c_str(), ms / steps);
+    if (counter.available()) {
+        std::printf("%12.0f LLC misses/step  ", static_cast<double>(misses) / steps);
+    } else {
+        std::printf("%12s LLC misses/step  ", "n/a");
+    }
+    std::printf("%zu/%zu links cut by %zu partitions\n",
+                cutLinks(network, parts), network.getLinkCount(), parts);
+}
+
+// The simulator itself over the same grid: TrafficManager::update with
+// vehicles waiting on every approach lane
+void runModelLocality(const std::string& label, const std::string& path, bool hilbert,
+                      int steps, int vehiclesPerLane) {
+    TrafficManager manager;
+    manager.setHilbertOrder(hilbert);
+    if (!manager.initialize(path, false)) {
+        std::cerr << "Failed to load " << path << std::endl;
+        return;
+    }
+    manager.start();
+
+    const RoadNetwork& network = manager.getNetwork();
+    for (uint32_t i = 0; i < network.getLaneCount(); i++) {
+        const RoadNetwork::LaneInfo& info = network.getLane(i);
+        for (int v = 0; info.laneNumber != 1 && v < vehiclesPerLane; v++) {
+            TrafficManager::VehicleTransfer transfer;
+            transfer.arrivalTime = 0;
+            transfer.laneIndex = i;
+            transfer.routeTarget = RoadNetwork::INVALID_INDEX;
+            transfer.vehicleId = "L" + std::to_string(i) + "_" + std::to_string(v);
+            transfer.destination = info.laneNumber == 3 ? Destination::LEFT : Destination::STRAIGHT;
+            transfer.isEmergency = false;
+            manager.acceptTransfer(transfer);
+        }
+    }
+
+    // The first step delivers the vehicles into their lanes
+    manager.update(16);
+
+    CacheMissCounter counter;
+    auto begin = std::chrono::steady_clock::now();
+    counter.start();
+    for (int s = 0; s < steps; s++) {
+        manager.update(16);
+    }
+    uint64_t misses = counter.stop();
+    double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - begin).count();
+
+    std::printf("%-22s %10.3f ms/step  ", label.c_str(), ms / steps);
+    if (counter.available()) {
+        std::printf("%12.0f LLC misses/step  ", static_cast<double>(misses) / steps);
+    } else {
+        std::printf("%12s LLC misses/step  ", "n/a");
+    }
+    std::printf("%zu vehicles\n", manager.getVehicleCount());
+}
+
+int benchLocality(int argc, char* argv[]) {
+    int size = 400;
+    int steps = 20;
+    size_t parts = 8;
+    int modelSize = 40;
+    int vehiclesPerLane = 2;
+
+    for (int i = 0; i < argc; i++) {
+        std::string arg = argv[i];
+        bool hasValue = i + 1 < argc;
+        if (arg == "--size" && hasValue) size = std::atoi(argv[++i]);
+        else if (arg == "--steps" && hasValue) steps = std::atoi(argv[++i]);
+        else if (arg == "--parts" && hasValue) parts = static_cast<size_t>(std::atoi(argv[++i]));
+        else if (arg == "--model-size" && hasValue) modelSize = std::max(1, std::atoi(argv[++i]));
+        else if (arg == "--vehicles" && hasValue) vehiclesPerLane = std::max(0, std::atoi(argv[++i]));
+        else {
+            std::cerr << "Usage: sim_bench locality [--size N] [--steps S] [--parts P] [--model-size M]\n"
+                      << "                          [--vehicles V]" << std::endl;
+            return 1;
+        }
+    }
+
+    const std::string shuffledPath = "sim_bench_grid_shuffled.net";
+    const std::string rowMajorPath = "sim_bench_grid_rows.net";
+    writeGrid(shuffledPath, size, true);
+    writeGrid(rowMajorPath, size, false);
+
+    std::printf("Grid %dx%d: %d junctions, %d lanes\n", size, size, size * size, size * size * 12);
+    runLocality("file order (shuffled)", shuffledPath, false, steps, parts);
+    runLocality("file order (rows)", rowMajorPath, false, steps, parts);
+    runLocality("hilbert order", shuffledPath, true, steps, parts);
+
+    // Same comparison through the simulator, whose Lane objects are laid
+    // out in junction order
+    writeGrid(shuffledPath, modelSize, true);
+    writeGrid(rowMajorPath, modelSize, false);
+    DebugLogger::setEnabled(false);
+    std::printf("\nTrafficManager::update, grid %dx%d, %d vehicles per approach lane\n",
+                modelSize, modelSize, vehiclesPerLane);
+    runModelLocality("file order (shuffled)", shuffledPath, false, steps, vehiclesPerLane);
+    runModelLocality("file order (rows)", rowMajorPath, false, steps, vehiclesPerLane);
+    runModelLocality("hilbert order", shuffledPath, true, steps, vehiclesPerLane);
+
+    std::remove(shuffledPath.c_str());
+    std::remove(rowMajorPath.c_str());
+    return 0;
+}
+
+// Lanes and lights of every junction in a network
+struct JunctionSet {
+    std::vector<Lane*> lanes;
+    std::vector<std::vector<Lane*>> junctionLanes;
+    std::vector<TrafficLight*> lights;
+    std::vector<StandardJunction> kernels;
+
+    JunctionSet(const RoadNetwork& network, int vehiclesPerLane) {
+        junctionLanes.resize(network.getJunctionCount());
+        for (size_t i = 0; i < network.getLaneCount(); i++) {
+            const RoadNetwork::LaneInfo& info = network.getLane(i);
+            Lane* lane = new Lane(info.road, info.laneNumber);
+            for (int v = 0; v < vehiclesPerLane && info.laneNumber > 1; v++) {
+                lane->enqueue(new Vehicle("B" + std::to_string(i) + "-" + std::to_string(v),
+                                          info.road, info.laneNumber));
+            }
+            lanes.push_back(lane);
+            junctionLanes[info.junction].push_back(lane);
+        }
+
+        kernels.resize(network.getJunctionCount());
+        for (size_t j = 0; j < network.getJunctionCount(); j++) {
+            kernels[j].bind(junctionLanes[j]);
+            lights.push_back(new TrafficLight());
+            lights.back()->restart(0);
+        }
+    }
+
+    ~JunctionSet() {
+        for (auto* lane : lanes) {
+            while (!lane->isEmpty()) delete lane->dequeue();
+            delete lane;
+        }
+        for (auto* light : lights) delete light;
+    }
+};
+
+// The generic per-junction tick, as TrafficManager runs it for junctions
+// without a kernel
+void genericTick(JunctionSet& set, uint32_t delta, uint32_t time) {
+    for (size_t j = 0; j < set.lights.size(); j++) {
+        char greenRoad = ' ';
+        auto state = set.lights[j]->getCurrentState();
+        if (state == TrafficLight::State::A_GREEN) greenRoad = 'A';
+        else if (state == TrafficLight::State::B_GREEN) greenRoad = 'B';
+        else if (state == TrafficLight::State::C_GREEN) greenRoad = 'C';
+        else if (state == TrafficLight::State::D_GREEN) greenRoad = 'D';
+
+        for (auto* lane : set.junctionLanes[j]) {
+            bool isGreenLight = lane->getLaneId() == greenRoad || lane->getLaneNumber() == 3;
+            for (auto* vehicle : lane->getVehicles()) {
+                if (vehicle) vehicle->update(delta, isGreenLight, 0.0f);
+            }
+        }
+    }
+    for (size_t j = 0; j < set.lights.size(); j++) {
+        set.lights[j]->update(set.junctionLanes[j], time);
+    }
+}
+
+void kernelTick(JunctionSet& set, uint32_t delta, uint32_t time) {
+    for (size_t j = 0; j < set.lights.size(); j++) {
+        set.kernels[j].moveVehicles(delta, set.lights[j]->getCurrentState());
+    }
+    for (size_t j = 0; j < set.lights.size(); j++) {
+        set.kernels[j].updateLight(*set.lights[j], time);
+    }
+}
+
+double timeTicks(void (*tick)(JunctionSet&, uint32_t, uint32_t),
+                 const RoadNetwork& network, int vehiclesPerLane, int steps) {
+    JunctionSet set(network, vehiclesPerLane);
+    const uint32_t delta = 16;
+    tick(set, delta, 0);
+
+    auto begin = std::chrono::steady_clock::now();
+    for (int s = 1; s <= steps; s++) {
+        tick(set, delta, static_cast<uint32_t>(s) * delta);
+    }
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - begin).count() / steps;
+}
+
+int benchJunction(int argc, char* argv[]) {
+    int size = 200;
+    int steps = 200;
+    int vehiclesPerLane = 2;
+
+    for (int i = 0; i < argc; i++) {
+        std::string arg = argv[i];
+        bool hasValue = i + 1 < argc;
+        if (arg == "--size" && hasValue) size = std::atoi(argv[++i]);
+        else if (arg == "--steps" && hasValue) steps = std::atoi(argv[++i]);
+        else if (arg == "--vehicles" && hasValue) vehiclesPerLane = std::atoi(argv[++i]);
+        else {
+            std::cerr << "Usage: sim_bench junction [--size N] [--steps S] [--vehicles V]" << std::endl;
+            return 1;
+        }
+    }
+
+    const std::string path = "sim_bench_grid_junction.net";
+    writeGrid(path, size, false);
+    RoadNetwork network;
+    bool loaded = network.loadFromFile(path);
+    std::remove(path.c_str());
+    if (!loaded) {
+        std::cerr << "Failed to load grid: " << network.getLastError() << std::endl;
+        return 1;
+    }
+
+    DebugLogger::setEnabled(false);
+    std::printf("Grid %dx%d: %zu junctions, %zu lanes, %d vehicles per lane\n",
+                size, size, network.getJunctionCount(), network.getLaneCount(), vehiclesPerLane);
+    double generic = timeTicks(genericTick, network, vehiclesPerLane, steps);
+    double kernel = timeTicks(kernelTick, network, vehiclesPerLane, steps);
+    std::printf("%-22s %10.3f ms/step\n", "generic lane loops", generic);
+    std::printf("%-22s %10.3f ms/step  (%.2fx)\n", "Junction<4, 3> kernel", kernel, generic / kernel);
+    return 0;
+}
+
+// FNV-1a, for comparing simulation state between runs and builds
+void hashBytes(uint64_t& hash, const void* data, size_t size) {
+    const unsigned char* bytes = static_cast<const unsigned char*>(data);
+    for (size_t i = 0; i < size; i++) {
+        hash = (hash ^ bytes[i]) * 1099511628211ULL;
+    }
+}
+
+void hashVehicle(uint64_t& hash, const Vehicle& vehicle) {
+    char road = vehicle.getLane();
+    int laneNumber = vehicle.getLaneNumber();
+    float x = vehicle.getTurnPosX();
+    float y = vehicle.getTurnPosY();
+    hashBytes(hash, &road, sizeof(road));
+    hashBytes(hash, &laneNumber, sizeof(laneNumber));
+    hashBytes(hash, &x, sizeof(x));
+    hashBytes(hash, &y, sizeof(y));
+}
+
+// Hash of every queued vehicle's lane and position
+uint64_t vehicleStateHash(const TrafficManager& manager) {
+    uint64_t hash = 1469598103934665603ULL;
+    for (auto* lane : manager.getLanes()) {
+        for (auto* vehicle : lane->getVehicles()) {
+            hashVehicle(hash, *vehicle);
+        }
+    }
+    uint64_t exited = manager.getExitedCount();
+    hashBytes(hash, &exited, sizeof(exited));
+    return hash;
+}
+
+// Step every vehicle S times with the light switching every 300 steps;
+// returns ns per vehicle step and the final state hash
+template<typename Kinematics>
+double timeKinematics(int vehicleCount, int steps, uint64_t& hash) {
+    std::vector<Vehicle*> vehicles;
+    for (int v = 0; v < vehicleCount; v++) {
+        char road = static_cast<char>('A' + v % 4);
+        int laneNumber = 2 + (v / 4) % 2;
+        vehicles.push_back(new Vehicle("K" + std::to_string(v), road, laneNumber));
+        vehicles.back()->setQueuePosition(v / 8 % 16);
+    }
+
+    auto begin = std::chrono::steady_clock::now();
+    for (int s = 0; s < steps; s++) {
+        bool isGreenLight = (s / 300) % 2 == 0;
+        for (auto* vehicle : vehicles) {
+            vehicle->step<Kinematics>(16, isGreenLight);
+        }
+    }
+    double ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - begin).count();
+
+    hash = 1469598103934665603ULL;
+    for (auto* vehicle : vehicles) {
+        hashVehicle(hash, *vehicle);
+        delete vehicle;
+    }
+    return ns / (static_cast<double>(vehicleCount) * steps);
+}
+
+int benchKinematics(int argc, char* argv[]) {
+    int vehicles = 20000;
+    int steps = 1000;
+
+    for (int i = 0; i < argc; i++) {
+        std::string arg = argv[i];
+        bool hasValue = i + 1 < argc;
+        if (arg == "--vehicles" && hasValue) vehicles = std::atoi(argv[++i]);
+        else if (arg == "--steps" && hasValue) steps = std::atoi(argv[++i]);
+        else {
+            std::cerr << "Usage: sim_bench kinematics [--vehicles N] [--steps S]" << std::endl;
+            return 1;
+        }
+    }
+
+    DebugLogger::setEnabled(false);
+    std::printf("%d vehicles, %d steps\n", vehicles, steps);
+
+    uint64_t floatHash = 0;
+    uint64_t fixedHash = 0;
+    double floatNs = timeKinematics<FloatKinematics>(vehicles, steps, floatHash);
+    double fixedNs = timeKinematics<FixedKinematics>(vehicles, steps, fixedHash);
+    std::printf("%-12s %8.2f ns/vehicle-step  state %016llx\n", "float", floatNs,
+                static_cast<unsigned long long>(floatHash));
+    std::printf("%-12s %8.2f ns/vehicle-step  state %016llx  (%.2fx float time)\n", "fixed-point", fixedNs,
+                static_cast<unsigned long long>(fixedHash), fixedNs / floatNs);
+    return 0;
+}
+
+// Spread N vehicles over the eight lanes that accept arrivals and step once
+// to deliver them
+void queueVehicles(TrafficManager& manager, int vehicles) {
+    const RoadNetwork& network = manager.getNetwork();
+    for (int v = 0; v < vehicles; v++) {
+        char road = static_cast<char>('A' + v % 4);
+        int laneNumber = 2 + (v / 4) % 2;
+
+        TrafficManager::VehicleTransfer transfer;
+        transfer.arrivalTime = 0;
+        transfer.laneIndex = network.laneIndex(0, road, laneNumber);
+        transfer.routeTarget = 0;
+        transfer.vehicleId = "P" + std::to_string(v);
+        transfer.destination = laneNumber == 3 || v % 3 == 0 ? Destination::LEFT : Destination::STRAIGHT;
+        transfer.isEmergency = false;
+        manager.acceptTransfer(transfer);
+    }
+    manager.update(16);
+}
+
+int benchParallel(int argc, char* argv[]) {
+    int vehicles = 50000;
+    int steps = 200;
+    int maxThreads = static_cast<int>(std::max(1u, std::thread::hardware_concurrency()));
+
+    for (int i = 0; i < argc; i++) {
+        std::string arg = argv[i];
+        bool hasValue = i + 1 < argc;
+        if (arg == "--vehicles" && hasValue) vehicles = std::atoi(argv[++i]);
+        else if (arg == "--steps" && hasValue) steps = std::atoi(argv[++i]);
+        else if (arg == "--threads" && hasValue) maxThreads = std::atoi(argv[++i]);
+        else {
+            std::cerr << "Usage: sim_bench parallel [--vehicles N] [--steps S] [--threads T]" << std::endl;
+            return 1;
+        }
+    }
+
+    DebugLogger::setEnabled(false);
+    std::printf("Standard junction: %d vehicles on lanes 2 and 3, %d steps\n", vehicles, steps);
+
+    double baseline = 0.0;
+    uint64_t baselineHash = 0;
+    for (int threads = 1; threads <= maxThreads; threads *= 2) {
+        TrafficManager manager;
+        if (!manager.initialize()) {
+            std::cerr << "Failed to initialize the traffic manager" << std::endl;
+            return 1;
+        }
+        manager.setWorkerThreads(static_cast<size_t>(threads));
+        manager.start();
+
+        queueVehicles(manager, vehicles);
+
+        auto begin = std::chrono::steady_clock::now();
+        for (int s = 0; s < steps; s++) {
+            manager.update(16);
+        }
+        double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - begin).count() / steps;
+        uint64_t hash = vehicleStateHash(manager);
+
+        if (threads == 1) {
+            baseline = ms;
+            baselineHash = hash;
+        }
+        double speedup = baseline / ms;
+        std::printf("%2d thread(s) %10.3f ms/step  speedup %5.2fx  efficiency %5.1f%%  state %016llx %s\n",
+                    threads, ms, speedup, 100.0 * speedup / threads,
+                    static_cast<unsigned long long>(hash),
+                    hash == baselineHash ? "identical" : "DIFFERS");
+
+        if (threads < maxThreads && threads * 2 > maxThreads) {
+            threads = maxThreads / 2;
+        }
+    }
+    return 0;
+}
+
+// One soak measurement
+struct SoakSample {
+    double days;            // Simulated time
+    double rssBytes;
+    double heapBytes;       // Allocated and not freed (0 where unknown)
+    double vehicleObjects;
+    double modelVehicles;   // Queued or in transit in the model
+    double orphanVehicles;  // Vehicle objects the model no longer holds
+    double laneSlots;       // Vehicle pointers the lane queues have room for
+    double transitEntries;  // Room in the in-transit heap
+    double logBufferBytes;  // Log messages not yet written
+    double recentLogs;      // Log messages kept for display
+    double routingBytes;    // Routing tables
+};
+
+// Resident set size from /proc (0 elsewhere)
+double residentBytes() {
+#ifdef __linux__
+    std::ifstream statm("/proc/self/statm");
+    uint64_t size = 0;
+    uint64_t resident = 0;
+    if (statm >> size >> resident) {
+        return static_cast<double>(resident) * static_cast<double>(sysconf(_SC_PAGESIZE));
+    }
+#endif
+    return 0.0;
+}
+
+// Bytes handed out by malloc and not yet freed (glibc only)
+double heapInUse() {
+#if defined(__GLIBC__) && (__GLIBC__ > 2 || (__GLIBC__ == 2 && __GLIBC_MINOR__ >= 33))
+    struct mallinfo2 info = mallinfo2();
+    return static_cast<double>(info.uordblks + info.hblkhd);
+#else
+    return 0.0;
+#endif
+}
+
+// Mann-Kendall trend statistic, normalised (tie-corrected); above 2.33 is
+// an increasing trend at the 1% level
+double mannKendallZ(const std::vector<double>& values) {
+    size_t n = values.size();
+    if (n < 3) return 0.0;
+
+    double s = 0.0;
+    for (size_t i = 0; i < n; i++) {
+        for (size_t j = i + 1; j < n; j++) {
+            s += (values[j] > values[i]) - (values[j] < values[i]);
+        }
+    }
+
+    // Memory figures are page- or object-granular, so ties are common
+    std::vector<double> sorted(values);
+    std::sort(sorted.begin(), sorted.end());
+    double nd = static_cast<double>(n);
+    double variance = nd * (nd - 1) * (2 * nd + 5);
+    for (size_t i = 0; i < n;) {
+        size_t j = i;
+        while (j < n && sorted[j] == sorted[i]) j++;
+        double t = static_cast<double>(j - i);
+        variance -= t * (t - 1) * (2 * t + 5);
+        i = j;
+    }
+    variance /= 18.0;
+
+    if (variance <= 0.0 || s == 0.0) return 0.0;
+    return (s > 0 ? s - 1 : s + 1) / std::sqrt(variance);
+}
+
+// Sen's slope: median of the pairwise slopes, robust to steps and outliers
+double senSlope(const std::vector<double>& times, const std::vector<double>& values) {
+    std::vector<double> slopes;
+    for (size_t i = 0; i < values.size(); i++) {
+        for (size_t j = i + 1; j < values.size(); j++) {
+            if (times[j] > times[i]) {
+                slopes.push_back((values[j] - values[i]) / (times[j] - times[i]));
+            }
+        }
+    }
+    if (slopes.empty()) return 0.0;
+
+    auto middle = slopes.begin() + slopes.size() / 2;
+    std::nth_element(slopes.begin(), middle, slopes.end());
+    return *middle;
+}
+
+int benchSoak(int argc, char* argv[]) {
+    double days = 1.0;
+    int stepMs = 100;
+    double rate = 12.0;
+    int samples = 200;
+    uint32_t seed = 1;
+
+    for (int i = 0; i < argc; i++) {
+        std::string arg = argv[i];
+        bool hasValue = i + 1 < argc;
+        if (arg == "--days" && hasValue) days = std::atof(argv[++i]);
+        else if (arg == "--step-ms" && hasValue) stepMs = std::max(1, std::atoi(argv[++i]));
+        else if (arg == "--rate" && hasValue) rate = std::atof(argv[++i]);
+        else if (arg == "--samples" && hasValue) samples = std::max(10, std::atoi(argv[++i]));
+        else if (arg == "--seed" && hasValue) seed = static_cast<uint32_t>(std::strtoul(argv[++i], nullptr, 10));
+        else {
+            std::cerr << "Usage: sim_bench soak [--days D] [--step-ms N] [--rate R] [--samples K] [--seed S]"
+                      << std::endl;
+            return 1;
+        }
+    }
+
+    // Log as a deployed service does, to a file only, so the logger's own
+    // buffers are part of what is tested
+    const std::string logPath = "sim_bench_soak.log";
+    DebugLogger::initialize(logPath);
+    DebugLogger::setConsoleEcho(false);
+
+    TrafficManager manager;
+    if (!manager.initialize("", false)) {
+        std::cerr << "Failed to initialize the traffic manager" << std::endl;
+        return 1;
+    }
+    manager.start();
+
+    const double msPerDay = 86400000.0;
+    const uint64_t totalSteps = static_cast<uint64_t>(days * msPerDay / stepMs);
+    const uint64_t sampleEvery = std::max<uint64_t>(1, totalSteps / samples);
+    std::printf("Soak: %.2f simulated days, %d ms steps (%llu), %.1f arrivals/min, %d samples\n",
+                days, stepMs, static_cast<unsigned long long>(totalSteps), rate, samples);
+
+    // Same lane and direction mix as simserver jobs
+    std::mt19937 gen(seed);
+    std::uniform_int_distribution<int> roadDist(0, 3);
+    std::discrete_distribution<int> laneDist({0.0, 0.6, 0.4});
+    std::bernoulli_distribution straightDist(0.6);
+    std::bernoulli_distribution priorityBias(0.1);
+    std::bernoulli_distribution emergencyDist(0.002);
+    std::exponential_distribution<double> gapDist(rate > 0.0 ? rate / 60000.0 : 1.0);
+    double nextArrival = rate > 0.0 ? gapDist(gen) : INFINITY;
+    uint32_t vehicleId = 1;
+    uint64_t arrivals = 0;
+
+    // Allocated and touched up front so sampling doesn't show up as growth
+    std::vector<SoakSample> series(totalSteps / sampleEvery + 2);
+    size_t sampleCount = 0;
+    auto begin = std::chrono::steady_clock::now();
+    for (uint64_t step = 0; step <= totalSteps; step++) {
+        if (step % sampleEvery == 0 || step == totalSteps) {
+            SoakSample& sample = series[sampleCount++];
+            sample.days = static_cast<double>(step) * stepMs / msPerDay;
+            sample.rssBytes = residentBytes();
+            sample.heapBytes = heapInUse();
+            sample.vehicleObjects = static_cast<double>(Vehicle::getLiveCount());
+            sample.modelVehicles = static_cast<double>(manager.getVehicleCount());
+            sample.orphanVehicles = sample.vehicleObjects - sample.modelVehicles;
+            sample.laneSlots = 0.0;
+            for (auto* lane : manager.getLanes()) {
+                sample.laneSlots += static_cast<double>(lane->getVehicles().capacity());
+            }
+            sample.transitEntries = static_cast<double>(manager.getTransfersInTransit().capacity());
+            sample.logBufferBytes = static_cast<double>(DebugLogger::getBufferedBytes());
+            sample.recentLogs = static_cast<double>(DebugLogger::getRecentLogCount());
+            sample.routingBytes = static_cast<double>(manager.getRouting().getMemoryBytes());
+        }
+        if (step == totalSteps) break;
+
+        double stepEnd = static_cast<double>(step + 1) * stepMs;
+        while (nextArrival < stepEnd) {
+            char road = static_cast<char>('A' + roadDist(gen));
+            int laneNumber = laneDist(gen) + 1;
+            bool isEmergency = emergencyDist(gen);
+            if (priorityBias(gen)) {
+                road = 'A';
+                laneNumber = 2;
+            }
+            Destination destination = laneNumber == 3 || !straightDist(gen) ? Destination::LEFT
+                                                                             : Destination::STRAIGHT;
+            if (manager.addArrival(vehicleId++, road, laneNumber, destination, isEmergency)) {
+                arrivals++;
+            }
+            nextArrival += gapDist(gen);
+        }
+        manager.update(static_cast<uint32_t>(stepMs));
+    }
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - begin).count();
+    series.resize(sampleCount);
+    DebugLogger::shutdown();
+    DebugLogger::setEnabled(false);
+    std::error_code error;
+    double logBytes = static_cast<double>(std::filesystem::file_size(logPath, error));
+    std::filesystem::remove(logPath, error);
+    std::printf("%llu arrivals, %llu exited, %.1f s wall time (%.0fx real time), %.1f MB logged\n\n",
+                static_cast<unsigned long long>(arrivals),
+                static_cast<unsigned long long>(manager.getExitedCount()),
+                seconds, days * 86400.0 / seconds, logBytes / 1048576.0);
+
+    // Queues and allocator pools fill up first; test the rest for growth
+    size_t warmup = series.size() / 5;
+    std::vector<double> times;
+    for (size_t i = warmup; i < series.size(); i++) {
+        times.push_back(series[i].days);
+    }
+
+    struct Series {
+        const char* name;
+        double SoakSample::*field;
+        double unit;
+        const char* suffix;     // "M" for MiB
+    };
+    const Series columns[] = {
+        {"RSS", &SoakSample::rssBytes, 1048576.0, "M"},
+        {"heap in use", &SoakSample::heapBytes, 1048576.0, "M"},
+        {"Vehicle objects", &SoakSample::vehicleObjects, 1.0, ""},
+        {"model vehicles", &SoakSample::modelVehicles, 1.0, ""},
+        {"orphan vehicles", &SoakSample::orphanVehicles, 1.0, ""},
+        {"lane slots", &SoakSample::laneSlots, 1.0, ""},
+        {"in-transit slots", &SoakSample::transitEntries, 1.0, ""},
+        {"log buffer", &SoakSample::logBufferBytes, 1024.0, "K"},
+        {"recent logs", &SoakSample::recentLogs, 1.0, ""},
+        {"routing tables", &SoakSample::routingBytes, 1024.0, "K"},
+    };
+    const size_t firstSubsystem = 5;
+
+    const double horizonDays = 30.0;
+    std::vector<bool> growing;
+    std::printf("%-16s %12s %12s %12s %8s %14s %14s\n",
+                "series", "start", "end", "max", "trend z", "slope/day", "at 30 days");
+    for (const Series& column : columns) {
+        std::vector<double> values;
+        double maxValue = 0.0;
+        for (size_t i = warmup; i < series.size(); i++) {
+            values.push_back(series[i].*(column.field) / column.unit);
+            maxValue = std::max(maxValue, values.back());
+        }
+
+        double z = mannKendallZ(values);
+        double slope = senSlope(times, values);
+        double projected = values.back() + slope * (horizonDays - times.back());
+
+        // Significant, and material over 30 days (above 1% of the level or
+        // one unit), so page-granular noise is not flagged
+        bool grows = z > 2.33 && slope > 0.0 &&
+                     slope * horizonDays > std::max(0.01 * std::fabs(values.front()), 1.0);
+        growing.push_back(grows);
+
+        std::printf("%-16s %10.2f%-2s %10.2f%-2s %10.2f%-2s %8.2f %14.4f %12.2f%-2s %s\n",
+                    column.name, values.front(), column.suffix, values.back(), column.suffix,
+                    maxValue, column.suffix, z, slope, projected, column.suffix, grows ? "GROWING" : "flat");
+    }
+
+    // Subsystems that hold on to more and more on their own
+    std::string subsystems;
+    for (size_t c = firstSubsystem; c < growing.size(); c++) {
+        if (growing[c]) {
+            subsystems += (subsystems.empty() ? "" : ", ") + std::string(columns[c].name);
+        }
+    }
+
+    // Tell a leak apart from memory that follows legitimately growing queues
+    bool memoryGrows = growing[0] || growing[1];
+    if (growing[4]) {
+        std::printf("\nVehicle objects are leaking: 30 days of uptime are NOT safe.\n");
+    } else if (growing[3]) {
+        std::printf("\nQueues grow without bound at %.1f arrivals/min (%.0f%% of arrivals exited)%s: "
+                    "30 days of uptime are NOT safe at this load.\n",
+                    rate, arrivals > 0 ? 100.0 * manager.getExitedCount() / arrivals : 0.0,
+                    memoryGrows ? " and memory grows with them" : "");
+    } else if (!subsystems.empty()) {
+        std::printf("\n%s grow%s with no matching growth in vehicles: 30 days of uptime are NOT safe.\n",
+                    subsystems.c_str(), subsystems.find(',') == std::string::npos ? "s" : "");
+    } else if (memoryGrows) {
+        std::printf("\nMemory grows with no matching growth in vehicles: 30 days of uptime are NOT safe.\n");
+    } else {
+        std::printf("\nNo monotonic growth after warm-up: 30 days of uptime look safe.\n");
+        return 0;
+    }
+    return 2;
+}
+
+// Build F frames of the scene with V vehicles queued into a null backend
+int benchRender(int argc, char* argv[]) {
+    std::vector<int> counts = {1000, 10000};
+    int frames = 100;
+    std::string recordPath;
+
+    for (int i = 0; i < argc; i++) {
+        std::string arg = argv[i];
+        bool hasValue = i + 1 < argc;
+        if (arg == "--vehicles" && hasValue) {
+            counts.clear();
+            std::stringstream list(argv[++i]);
+            std::string item;
+            while (std::getline(list, item, ',')) {
+                counts.push_back(std::max(0, std::atoi(item.c_str())));
+            }
+        } else if (arg == "--frames" && hasValue) {
+            frames = std::max(1, std::atoi(argv[++i]));
+        } else if (arg == "--record" && hasValue) {
+            recordPath = argv[++i];
+        } else {
+            std::cerr << "Usage: sim_bench render [--vehicles N[,N...]] [--frames F] [--record FILE]" << std::endl;
+            return 1;
+        }
+    }
+
+    DebugLogger::setEnabled(false);
+    std::printf("Frame build into the null backend, %d frames per run\n", frames);
+    std::printf("%9s %12s %12s %10s %10s %12s\n",
+                "vehicles", "us/frame", "primitives", "states", "redundant", "vertex KB");
+
+    for (int vehicles : counts) {
+        TrafficManager manager;
+        if (!manager.initialize("", false)) {
+            std::cerr << "Failed to initialize the traffic manager" << std::endl;
+            return 1;
+        }
+        manager.start();
+        queueVehicles(manager, vehicles);
+
+        NullRenderBackend backend;
+        Renderer renderer;
+        if (!renderer.initializeHeadless(800, 800, &backend)) {
+            std::cerr << "Failed to initialize the headless renderer" << std::endl;
+            return 1;
+        }
+        renderer.setTrafficManager(&manager);
+
+        // First frame bakes the effect textures
+        renderer.renderFrame();
+        backend.resetStats();
+
+        auto begin = std::chrono::steady_clock::now();
+        for (int f = 0; f < frames; f++) {
+            renderer.renderFrame();
+        }
+        double us = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - begin).count();
+
+        const NullRenderBackend::Stats& stats = backend.getStats();
+        double perFrame = 1.0 / static_cast<double>(stats.frames);
+        std::printf("%9zu %12.1f %12.0f %10.0f %9.1f%% %12.1f\n",
+                    manager.getVehicleCount(), us / frames,
+                    static_cast<double>(stats.primitives()) * perFrame,
+                    static_cast<double>(stats.stateChanges) * perFrame,
+                    stats.stateChanges ? 100.0 * stats.redundantChanges / stats.stateChanges : 0.0,
+                    static_cast<double>(stats.vertexBytes) * perFrame / 1024.0);
+        renderer.cleanup();
+
+        // One frame of the last scene as text, for diffing between builds
+        if (!recordPath.empty() && vehicles == counts.back()) {
+            std::ofstream out(recordPath);
+            if (!out.is_open()) {
+                std::cerr << "Cannot write " << recordPath << std::endl;
+                return 1;
+            }
+            RecordingRenderBackend recorder(out);
+            Renderer recording;
+            recording.initializeHeadless(800, 800, &recorder);
+            recording.setTrafficManager(&manager);
+            recording.renderFrame();
+            recording.cleanup();
+            std::printf("Recorded one frame (%llu commands) to %s\n",
+                        static_cast<unsigned long long>(recorder.getStats().primitives() +
+                                                        recorder.getStats().stateChanges),
+                        recordPath.c_str());
+        }
+    }
+    return 0;
+}
+
+// One line of the I/O table; latencies are per operation
+void printIoRow(const char* backend, const char* workload, const AsyncFileIO::Stats& stats, double seconds) {
+    uint64_t bytes = stats.bytesWritten + stats.bytesRead;
+    std::printf("%-12s %-7s %9llu %8llu %9llu %8.3f %9.1f %8llu %8llu %8llu\n",
+                backend, workload,
+                static_cast<unsigned long long>(stats.operations),
+                static_cast<unsigned long long>(stats.batches),
+                static_cast<unsigned long long>(stats.syscalls),
+                stats.operations ? static_cast<double>(stats.syscalls) / stats.operations : 0.0,
+                seconds > 0.0 ? bytes / seconds / (1024.0 * 1024.0) : 0.0,
+                static_cast<unsigned long long>(stats.latencyUs.getPercentile(0.50)),
+                static_cast<unsigned long long>(stats.latencyUs.getPercentile(0.99)),
+                static_cast<unsigned long long>(stats.latencyUs.getMax()));
+}
+
+// Log, ingest and trace workloads through AsyncFileIO on both backends
+int benchIo(int argc, char* argv[]) {
+    int messages = 100000;
+    int batch = 64;
+    int fileCount = 4;
+    int rounds = 2000;
+
+    for (int i = 0; i < argc; i++) {
+        std::string arg = argv[i];
+        bool hasValue = i + 1 < argc;
+        if (arg == "--messages" && hasValue) {
+            messages = std::max(1, std::atoi(argv[++i]));
+        } else if (arg == "--batch" && hasValue) {
+            batch = std::max(1, std::atoi(argv[++i]));
+        } else if (arg == "--files" && hasValue) {
+            fileCount = std::max(1, std::atoi(argv[++i]));
+        } else if (arg == "--rounds" && hasValue) {
+            rounds = std::max(1, std::atoi(argv[++i]));
+        } else {
+            std::cerr << "Usage: sim_bench io [--messages N] [--batch B] [--files F] [--rounds R]" << std::endl;
+            return 1;
+        }
+    }
+
+    const std::string dir = "sim_bench_io";
+    std::error_code error;
+    std::filesystem::create_directories(dir, error);
+    if (error) {
+        std::cerr << "Cannot create " << dir << ": " << error.message() << std::endl;
+        return 1;
+    }
+
+    // A typical log line and lane file (20 arrivals)
+    const std::string line = "[2026-01-01 12:00:00.000] [INFO] Vehicle V12345_L2_STRAIGHT moved from lane A2 "
+                             "to junction 17 (queue 12)\n";
+    std::vector<std::string> lanePaths;
+    for (int f = 0; f < fileCount; f++) {
+        lanePaths.push_back(dir + "/lane" + std::to_string(f) + ".txt");
+        std::ofstream lane(lanePaths.back(), std::ios::trunc);
+        for (int v = 0; v < 20; v++) {
+            lane << "V" << v << "_L2:A\n";
+        }
+    }
+    const size_t traceBytes = 16u << 20;
+    const size_t chunkBytes = 64u << 10;
+    const std::string chunk(chunkBytes, 'T');
+
+    using Clock = std::chrono::steady_clock;
+    std::printf("%d log lines (batches of %d), %d lane files x %d rounds, %zu MB trace\n",
+                messages, batch, fileCount, rounds, traceBytes >> 20);
+    std::printf("%-12s %-7s %9s %8s %9s %8s %9s %8s %8s %8s\n",
+                "backend", "load", "ops", "batches", "syscalls", "calls/op", "MB/s", "p50 us", "p99 us", "max us");
+
+    // What DebugLogger used to do for every line
+    {
+        auto begin = Clock::now();
+        for (int i = 0; i < messages; i++) {
+            std::ofstream file(dir + "/log_ofstream.txt", std::ios::app);
+            file << line;
+        }
+        double seconds = std::chrono::duration<double>(Clock::now() - begin).count();
+        std::printf("%-12s %-7s %9d %8s %9s %8s %9.1f %8s %8s %8s\n", "ofstream", "log", messages,
+                    "-", "-", "-", messages * line.size() / seconds / (1024.0 * 1024.0), "-", "-", "-");
+        std::filesystem::remove(dir + "/log_ofstream.txt", error);
+    }
+
+    for (AsyncFileIO::Backend wanted : {AsyncFileIO::Backend::IO_URING, AsyncFileIO::Backend::THREAD_POOL}) {
+        AsyncFileIO io(wanted);
+        const char* name = AsyncFileIO::backendName(wanted);
+        if (io.getBackend() != wanted) {
+            std::printf("%-12s %s\n", name, io.getLastError().c_str());
+            continue;
+        }
+
+        int log = io.openForWrite(dir + "/log.txt", true);
+        auto begin = Clock::now();
+        for (int i = 0; i < messages; i++) {
+            io.append(log, line);
+            if ((i + 1) % batch == 0) {
+                io.flush();
+            }
+        }
+        io.flush();
+        printIoRow(name, "log", io.getStats(), std::chrono::duration<double>(Clock::now() - begin).count());
+        io.closeFile(log);
+        io.resetStats();
+
+        std::vector<std::string> contents;
+        begin = Clock::now();
+        for (int r = 0; r < rounds; r++) {
+            io.readFiles(lanePaths, contents);
+        }
+        printIoRow(name, "ingest", io.getStats(), std::chrono::duration<double>(Clock::now() - begin).count());
+        io.resetStats();
+
+        int trace = io.openForWrite(dir + "/trace.bin", true);
+        begin = Clock::now();
+        for (size_t written = 0; written < traceBytes; written += chunkBytes) {
+            io.append(trace, chunk);
+        }
+        io.flush();
+        printIoRow(name, "trace", io.getStats(), std::chrono::duration<double>(Clock::now() - begin).count());
+        io.closeFile(trace);
+
+        if (io.getStats().failures > 0) {
+            std::cerr << "I/O failed: " << io.getLastError() << std::endl;
+            return 1;
+        }
+    }
+
+    std::filesystem::remove_all(dir, error);
+    return 0;
+}
+
+// Tick time with and without the emissions batch
+int benchEmissions(int argc, char* argv[]) {
+    int vehicles = 20000;
+    int steps = 200;
+
+    for (int i = 0; i < argc; i++) {
+        std::string arg = argv[i];
+        bool hasValue = i + 1 < argc;
+        if (arg == "--vehicles" && hasValue) vehicles = std::max(1, std::atoi(argv[++i]));
+        else if (arg == "--steps" && hasValue) steps = std::max(1, std::atoi(argv[++i]));
+        else {
+            std::cerr << "Usage: sim_bench emissions [--vehicles N] [--steps S]" << std::endl;
+            return 1;
+        }
+    }
+
+    DebugLogger::setEnabled(false);
+
+    // Two identical managers stepped in turn, so drift in machine load and
+    // cache state hits both the same
+    TrafficManager managers[2];
+    double ms[2] = {0.0, 0.0};
+    for (int m = 0; m < 2; m++) {
+        if (!managers[m].initialize("", false)) {
+            std::cerr << "Failed to initialize the traffic manager" << std::endl;
+            return 1;
+        }
+        managers[m].setEmissionsAccounting(m == 1);
+        managers[m].start();
+        queueVehicles(managers[m], vehicles);
+    }
+    for (int s = 0; s < steps; s++) {
+        for (int m = 0; m < 2; m++) {
+            int k = (s % 2 == 0) ? m : 1 - m;
+            auto begin = std::chrono::steady_clock::now();
+            managers[k].update(16);
+            ms[k] += std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - begin).count();
+        }
+    }
+    double offMs = ms[0] / steps;
+    double onMs = ms[1] / steps;
+    TrafficManager& manager = managers[1];
+
+    std::printf("%d vehicles, %d steps of 16 ms\n", vehicles, steps);
+    std::printf("%-16s %8.3f ms/step\n", "accounting off", offMs);
+    std::printf("%-16s %8.3f ms/step  (%+.1f%% tick time, %.1f ns/vehicle)\n\n", "accounting on", onMs,
+                100.0 * (onMs - offMs) / offMs, (onMs - offMs) * 1e6 / vehicles);
+    std::printf("%s", manager.getEmissionsSummary().c_str());
+    return 0;
+}
+
+// One placement: a paced simulation thread with a log-flushing thread
+// beside it. Thread roles must be configured by the caller.
+TickJitter runJitter(int seconds, int periodUs, int vehicles, const std::string& logPath) {
+    std::atomic<bool> stop(false);
+    std::thread noise([&]() {
+        AsyncFileIO io(AsyncFileIO::Backend::THREAD_POOL);
+        const std::string line = "[2026-01-01 12:00:00.000] [INFO] Vehicle V12345_L2_STRAIGHT moved from lane A2 "
+                                 "to junction 17 (queue 12)\n";
+        int file = io.openForWrite(logPath, true);
+        for (int batch = 1; !stop.load(std::memory_order_relaxed); batch++) {
+            for (int i = 0; i < 256; i++) {
+                io.append(file, line);
+            }
+            io.flush();
+
+            // Keep the file small
+            if (batch % 64 == 0) {
+                io.closeFile(file);
+                file = io.openForWrite(logPath, true);
+            }
+        }
+    });
+    ThreadRoles::assign(noise, ThreadRoles::Role::LOGGING, "log-noise");
+
+    TickJitter jitter;
+    std::thread sim([&]() {
+        TrafficManager manager;
+        if (!manager.initialize("", false)) {
+            return;
+        }
+        manager.start();
+        queueVehicles(manager, vehicles);
+
+        const auto period = std::chrono::microseconds(periodUs);
+        const uint32_t stepMs = static_cast<uint32_t>(std::max(1, periodUs / 1000));
+        auto next = TickJitter::Clock::now();
+        const auto end = next + std::chrono::seconds(seconds);
+        while (next < end) {
+            next += period;
+            jitter.sleepUntil(next);
+            jitter.tickStarted();
+            manager.update(stepMs);
+            jitter.tickFinished();
+        }
+    });
+    ThreadRoles::assign(sim, ThreadRoles::Role::SIMULATION, "sim");
+    std::cout << ThreadRoles::report();
+
+    ThreadRoles::release(sim);
+    sim.join();
+    stop = true;
+    ThreadRoles::release(noise);
+    noise.join();
+    return jitter;
+}
+
+// Tick jitter with the log thread sharing the simulation CPU, then isolated from it
+int benchJitter(int argc, char* argv[]) {
+    int seconds = 5;
+    int periodUs = 2000;
+    int vehicles = 2000;
+    int cpus = static_cast<int>(std::max(1u, std::thread::hardware_concurrency()));
+    int simCpu = cpus - 1;
+    int noiseCpu = 0;
+    std::string outPrefix;
+
+    for (int i = 0; i < argc; i++) {
+        std::string arg = argv[i];
+        bool hasValue = i + 1 < argc;
+        if (arg == "--seconds" && hasValue) {
+            seconds = std::max(1, std::atoi(argv[++i]));
+        } else if (arg == "--period-us" && hasValue) {
+            periodUs = std::max(100, std::atoi(argv[++i]));
+        } else if (arg == "--vehicles" && hasValue) {
+            vehicles = std::max(0, std::atoi(argv[++i]));
+        } else if (arg == "--sim-cpu" && hasValue) {
+            simCpu = std::max(0, std::atoi(argv[++i]));
+        } else if (arg == "--noise-cpu" && hasValue) {
+            noiseCpu = std::max(0, std::atoi(argv[++i]));
+        } else if (arg == "--out" && hasValue) {
+            outPrefix = argv[++i];
+        } else {
+            std::cerr << "Usage: sim_bench jitter [--seconds S] [--period-us P] [--vehicles V]\n"
+                      << "                        [--sim-cpu C] [--noise-cpu N] [--out PREFIX]" << std::endl;
+            return 1;
+        }
+    }
+
+    DebugLogger::setEnabled(false);
+    if (simCpu == noiseCpu) {
+        std::cout << "Simulation and noise CPU are the same (" << simCpu
+                  << "); both runs share a CPU" << std::endl;
+    }
+
+    struct Scenario {
+        const char* name;
+        int logCpu;
+    };
+    const Scenario scenarios[] = {{"shared", simCpu}, {"isolated", noiseCpu}};
+    TickJitter results[2];
+
+    for (int k = 0; k < 2; k++) {
+        std::string spec = "sim=" + std::to_string(simCpu) + " log,io=" + std::to_string(scenarios[k].logCpu);
+        std::string error;
+        if (!ThreadRoles::configure(spec, error)) {
+            std::cerr << error << std::endl;
+            return 1;
+        }
+        std::cout << "\n" << scenarios[k].name << " (" << spec << ")" << std::endl;
+        results[k] = runJitter(seconds, periodUs, vehicles, "sim_bench_jitter.log");
+
+        if (!outPrefix.empty()) {
+            std::string path = outPrefix + "-" + scenarios[k].name + ".csv";
+            if (!results[k].exportTo(path)) {
+                std::cerr << "Cannot write " << path << std::endl;
+                return 1;
+            }
+        }
+    }
+    std::remove("sim_bench_jitter.log");
+
+    std::printf("\nTick every %d us for %d s with %d vehicles, log thread flushing alongside\n",
+                periodUs, seconds, vehicles);
+    std::printf("%-9s %9s %9s %9s %9s   %9s %9s %9s\n",
+                "placement", "wake p50", "wake p99", "p99.9", "max", "tick p50", "tick p99", "max");
+    for (int k = 0; k < 2; k++) {
+        const LatencyHistogram& wake = results[k].getWakeLatency();
+        const LatencyHistogram& tick = results[k].getTickDuration();
+        std::printf("%-9s %9llu %9llu %9llu %9llu   %9llu %9llu %9llu\n", scenarios[k].name,
+                    static_cast<unsigned long long>(wake.getPercentile(0.50)),
+                    static_cast<unsigned long long>(wake.getPercentile(0.99)),
+                    static_cast<unsigned long long>(wake.getPercentile(0.999)),
+                    static_cast<unsigned long long>(wake.getMax()),
+                    static_cast<unsigned long long>(tick.getPercentile(0.50)),
+                    static_cast<unsigned long long>(tick.getPercentile(0.99)),
+                    static_cast<unsigned long long>(tick.getMax()));
+    }
+    return 0;
+}
+
+// Hash of everything a checkpoint holds: lane queues and priorities,
+// queued vehicles' motion, vehicles on links (in arrival order, since the
+// heap layout differs after a restore), light controllers, time and exits
+uint64_t checkpointStateHash(const TrafficManager& manager) {
+    uint64_t hash = 1469598103934665603ULL;
+    const std::vector<Lane*>& lanes = manager.getLanes();
+    for (uint32_t i = 0; i < lanes.size(); i++) {
+        int priority = lanes[i]->getPriority();
+        hashBytes(hash, &priority, sizeof(priority));
+        for (auto* vehicle : lanes[i]->getVehicles()) {
+            uint32_t target = vehicle->getRouteTarget();
+            uint64_t queuedAt = vehicle->getQueuedAt();
+            Vehicle::Motion motion = vehicle->getMotion();
+            hashBytes(hash, &i, sizeof(i));
+            hashBytes(hash, vehicle->getId().data(), vehicle->getId().size());
+            hashBytes(hash, &target, sizeof(target));
+            hashBytes(hash, &queuedAt, sizeof(queuedAt));
+            hashBytes(hash, &motion, sizeof(motion));
+        }
+    }
+
+    for (size_t j = 0; j < manager.getNetwork().getJunctionCount(); j++) {
+        TrafficLight::Snapshot light = manager.getTrafficLight(j)->getSnapshot();
+        hashBytes(hash, &light, sizeof(light));
+    }
+
+    std::vector<TrafficManager::VehicleTransfer> transit = manager.getTransfersInTransit();
+    std::sort(transit.begin(), transit.end(), [](const auto& a, const auto& b) {
+        return std::tie(a.arrivalTime, a.vehicleId, a.laneIndex) < std::tie(b.arrivalTime, b.vehicleId, b.laneIndex);
+    });
+    for (const auto& transfer : transit) {
+        hashBytes(hash, &transfer.arrivalTime, sizeof(transfer.arrivalTime));
+        hashBytes(hash, transfer.vehicleId.data(), transfer.vehicleId.size());
+        hashBytes(hash, &transfer.laneIndex, sizeof(transfer.laneIndex));
+    }
+
+    uint64_t time = manager.getSimulationTime();
+    uint64_t exited = manager.getExitedCount();
+    hashBytes(hash, &time, sizeof(time));
+    hashBytes(hash, &exited, sizeof(exited));
+    return hash;
+}
+
+// Full against delta checkpoints on a busy grid, and restore of the chain
+int benchCheckpoint(int argc, char* argv[]) {
+    int size = 30;
+    int vehiclesPerLane = 3;
+    int arrivals = 4;
+    int checkpoints = 40;
+    int every = 60;
+    int baseEvery = 10;
+
+    for (int i = 0; i < argc; i++) {
+        std::string arg = argv[i];
+        bool hasValue = i + 1 < argc;
+        if (arg == "--size" && hasValue) size = std::max(1, std::atoi(argv[++i]));
+        else if (arg == "--vehicles" && hasValue) vehiclesPerLane = std::max(0, std::atoi(argv[++i]));
+        else if (arg == "--arrivals" && hasValue) arrivals = std::max(0, std::atoi(argv[++i]));
+        else if (arg == "--checkpoints" && hasValue) checkpoints = std::max(1, std::atoi(argv[++i]));
+        else if (arg == "--every" && hasValue) every = std::max(1, std::atoi(argv[++i]));
+        else if (arg == "--base-every" && hasValue) baseEvery = std::max(1, std::atoi(argv[++i]));
+        else {
+            std::cerr << "Usage: sim_bench checkpoint [--size N] [--vehicles V] [--arrivals A] [--checkpoints C]\n"
+                      << "                            [--every K] [--base-every B]" << std::endl;
+            return 1;
+        }
+    }
+
+    std::error_code error;
+    const std::string dir = "sim_bench_checkpoint";
+    const std::string gridPath = dir + "/grid.net";
+    const std::string tracePath = dir + "/arrivals.trace";
+    std::filesystem::create_directories(dir, error);
+    writeGrid(gridPath, size, false);
+
+    // An arrival every 500 ms at the entry junction, past the end of the
+    // run after the restore
+    std::mt19937 rng(7);
+    std::vector<ArrivalTrace::Record> records;
+    uint32_t traceMs = static_cast<uint32_t>(checkpoints + 1) * every * 16;
+    for (uint32_t t = 0; t < traceMs; t += 500) {
+        ArrivalTrace::Record record = ArrivalTrace::Record();
+        record.timeMs = t;
+        record.vehicleId = static_cast<uint32_t>(records.size());
+        record.road = static_cast<uint8_t>('A' + rng() % 4);
+        record.laneNumber = static_cast<uint8_t>(2 + rng() % 2);
+        record.destination = static_cast<uint8_t>(record.laneNumber == 3 ? Destination::LEFT : Destination::STRAIGHT);
+        records.push_back(record);
+    }
+    ArrivalTrace trace;
+    if (!trace.write(tracePath, records, traceMs)) {
+        std::cerr << "Could not write " << tracePath << std::endl;
+        return 1;
+    }
+
+    DebugLogger::setEnabled(false);
+    TrafficManager manager;
+    if (!manager.initialize(gridPath, false) || !manager.loadArrivalTrace(tracePath)) {
+        std::cerr << "Failed to initialize the traffic manager" << std::endl;
+        return 1;
+    }
+    manager.start();
+
+    // Vehicles waiting on every approach lane, then a trickle of arrivals
+    // at random lanes while the run goes on
+    const RoadNetwork& network = manager.getNetwork();
+    std::vector<uint32_t> approachLanes;
+    for (uint32_t i = 0; i < network.getLaneCount(); i++) {
+        if (network.getLane(i).laneNumber != 1) {
+            approachLanes.push_back(i);
+        }
+    }
+    uint32_t vehicleId = 0;
+    auto arrive = [&](TrafficManager& target, uint32_t laneIndex, uint32_t id) {
+        TrafficManager::VehicleTransfer transfer;
+        transfer.arrivalTime = target.getSimulationTime();
+        transfer.laneIndex = laneIndex;
+        transfer.routeTarget = RoadNetwork::INVALID_INDEX;
+        transfer.vehicleId = "C" + std::to_string(id);
+        transfer.destination = network.getLane(laneIndex).laneNumber == 3 ? Destination::LEFT : Destination::STRAIGHT;
+        transfer.isEmergency = false;
+        target.acceptTransfer(transfer);
+    };
+    for (uint32_t laneIndex : approachLanes) {
+        for (int v = 0; v < vehiclesPerLane; v++) {
+            arrive(manager, laneIndex, vehicleId++);
+        }
+    }
+    std::uniform_int_distribution<size_t> laneDist(0, approachLanes.size() - 1);
+
+    std::printf("Grid %dx%d: %zu lanes, %d vehicles per approach lane, %d arrivals per step\n",
+                size, size, network.getLaneCount(), vehiclesPerLane, arrivals);
+    std::printf("%d checkpoints every %d steps of 16 ms, a full one every %d\n\n", checkpoints, every, baseEvery);
+
+    // Chain of the last checkpoint and the state hash at each checkpoint
+    std::vector<std::string> chain;
+    std::vector<uint64_t> hashes;
+    double fullMs = 0.0, deltaMs = 0.0, fullBytes = 0.0, deltaBytes = 0.0, changedShare = 0.0, movedShare = 0.0;
+    int fulls = 0, deltas = 0;
+    std::vector<uint64_t> versions(network.getLaneCount(), 0);
+    for (int c = 0; c < checkpoints; c++) {
+        for (int s = 0; s < every; s++) {
+            for (int a = 0; a < arrivals; a++) {
+                arrive(manager, approachLanes[laneDist(rng)], vehicleId++);
+            }
+            manager.update(16);
+        }
+
+        // What the delta will pick up: lanes whose queue changed go whole,
+        // in the others only the vehicles that moved
+        size_t changed = 0, moved = 0, queued = 0;
+        const std::vector<Lane*>& lanes = manager.getLanes();
+        for (size_t i = 0; i < lanes.size(); i++) {
+            const auto& vehicles = lanes[i]->getVehicles();
+            queued += vehicles.size();
+            if (lanes[i]->getVersion() != versions[i]) {
+                changed++;
+            } else {
+                for (auto* vehicle : vehicles) {
+                    moved += vehicle->hasMotionChanged() ? 1 : 0;
+                }
+            }
+            versions[i] = lanes[i]->getVersion();
+        }
+
+        bool base = c % baseEvery == 0;
+        std::string path = dir + "/" + std::to_string(c) + (base ? ".ckpt" : ".delta");
+        auto begin = std::chrono::steady_clock::now();
+        bool saved = base ? manager.saveCheckpoint(path) : manager.saveDeltaCheckpoint(path);
+        double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - begin).count();
+        if (!saved) {
+            std::cerr << "Could not write " << path << std::endl;
+            return 1;
+        }
+        double bytes = static_cast<double>(std::filesystem::file_size(path, error));
+
+        if (base) {
+            fulls++;
+            fullMs += ms;
+            fullBytes += bytes;
+            chain.clear();
+        } else {
+            deltas++;
+            deltaMs += ms;
+            deltaBytes += bytes;
+            changedShare += static_cast<double>(changed) / lanes.size();
+            movedShare += queued > 0 ? static_cast<double>(moved) / queued : 0.0;
+        }
+        chain.push_back(path);
+        hashes.push_back(checkpointStateHash(manager));
+    }
+
+    std::printf("%-8s %6s %12s %10s %12s %15s\n", "kind", "count", "KB", "ms", "lanes whole", "vehicles moved");
+    if (fulls > 0) {
+        std::printf("%-8s %6d %12.1f %10.3f %11.1f%% %15s\n", "full", fulls, fullBytes / fulls / 1024.0,
+                    fullMs / fulls, 100.0, "-");
+    }
+    if (deltas > 0) {
+        std::printf("%-8s %6d %12.1f %10.3f %11.1f%% %14.1f%%\n", "delta", deltas, deltaBytes / deltas / 1024.0,
+                    deltaMs / deltas, 100.0 * changedShare / deltas, 100.0 * movedShare / deltas);
+    }
+
+    // Restore the last checkpoint into a fresh manager and compare, the
+    // way a restarted cluster worker does
+    TrafficManager restored;
+    if (!restored.initialize(gridPath, false) || !restored.loadArrivalTrace(tracePath)) {
+        std::cerr << "Failed to initialize the traffic manager" << std::endl;
+        return 1;
+    }
+    restored.start();
+    auto begin = std::chrono::steady_clock::now();
+    bool ok = restored.loadCheckpoint(chain[0]);
+    double baseMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - begin).count();
+    for (size_t i = 1; ok && i < chain.size(); i++) {
+        ok = restored.applyDeltaCheckpoint(chain[i]);
+    }
+    double chainMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - begin).count();
+    bool identical = ok && checkpointStateHash(restored) == hashes.back();
+
+    // Carry on from the checkpoint in both, with the same arrivals: the
+    // restored manager is a run that crashed and recovered. Its first step
+    // recomputes the routes the chain's link costs changed.
+    bool recovered = identical;
+    double firstStepMs = 0.0;
+    for (int s = 0; recovered && s < every; s++) {
+        for (int a = 0; a < arrivals; a++) {
+            uint32_t laneIndex = approachLanes[laneDist(rng)];
+            arrive(manager, laneIndex, vehicleId);
+            arrive(restored, laneIndex, vehicleId++);
+        }
+        manager.update(16);
+        begin = std::chrono::steady_clock::now();
+        restored.update(16);
+        if (s == 0) {
+            firstStepMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - begin).count();
+        }
+    }
+    std::printf("\nRestore: base %.3f ms, base + %zu deltas %.3f ms, state %s\n", baseMs, chain.size() - 1,
+                chainMs, identical ? "identical" : "DIFFERENT");
+    std::printf("First step after the restore (route recompute): %.3f ms\n", firstStepMs);
+    recovered = recovered && checkpointStateHash(restored) == checkpointStateHash(manager);
+    std::printf("Recovered run after %d more steps: %zu vehicles, %llu exited, state %s\n", every,
+                restored.getVehicleCount(), static_cast<unsigned long long>(restored.getExitedCount()),
+                recovered ? "matches the run without a crash" : "DIFFERS from the run without a crash");
+
+    std::filesystem::remove_all(dir, error);
+    return identical && recovered ? 0 : 1;
+}
+
+void printUsage() {
+    std::cout << "Usage: sim_bench <benchmark> [options]\n"
+              << "Benchmarks:\n"
+              << "  locality   Junction/lane memory order (cache misses per step)\n"
+              << "  junction   Fixed-topology junction kernel vs generic lane loops\n"
+              << "  parallel   Vehicle update scaling across threads (50k vehicles)\n"
+              << "  kinematics Float vs fixed-point vehicle step\n"
+              << "  soak       Long headless run with memory growth detection\n"
+              << "  render     Frame build cost with no display (null render backend)\n"
+              << "  io         Batched file I/O on io_uring and the thread-pool fallback\n"
+              << "  emissions  Tick time spent on fuel and emissions accounting\n"
+              << "  jitter     Simulation tick latency with the log thread shared or isolated\n"
+              << "  checkpoint Full against delta checkpoints, and restoring the chain\n";
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    if (argc < 2) {
+        printUsage();
+        return 1;
+    }
+
+    std::string name = argv[1];
+    if (name == "locality") {
+        return benchLocality(argc - 2, argv + 2);
+    }
+    if (name == "junction") {
+        return benchJunction(argc - 2, argv + 2);
+    }
+    if (name == "parallel") {
+        return benchParallel(argc - 2, argv + 2);
+    }
+    if (name == "kinematics") {
+        return benchKinematics(argc - 2, argv + 2);
+    }
+    if (name == "soak") {
+        return benchSoak(argc - 2, argv + 2);
+    }
+    if (name == "render") {
+        return benchRender(argc - 2, argv + 2);
+    }
+    if (name == "io") {
+        return benchIo(argc - 2, argv + 2);
+    }
+    if (name == "emissions") {
+        return benchEmissions(argc - 2, argv + 2);
+    }
+    if (name == "jitter") {
+        return benchJitter(argc - 2, argv + 2);
+    }
+    if (name == "checkpoint") {
+        return benchCheckpoint(argc - 2, argv + 2);
+    }
+
+    printUsage();
+    return name == "--help" ? 0 : 1;
+}
@@ -1,207 +1,270 @@
+// FILE: src/console_simulator.cpp
+// Terminal front-end: runs a TrafficManager like the SDL simulator and shows
+// lane queues, light state, throughput and delay percentiles as a
+// full-screen ANSI dashboard. Only cells that changed since the last frame
+// are written, so it can refresh at 10+ Hz over SSH for a few KB/s.
+//
+//   console_simulator [--network <file>] [--refresh HZ] [--speed X]
+//                     [--window S] [--threads N] [--replay <trace> [--start-hour H]]
+//                     [--log] [--thread-roles <spec>] [--jitter-out <file>]
+//                     [--stream <socket path | tcp:PORT>] [--status-shm <name>]
+//
+// --stream publishes every step to viewers in other processes (see
+// StateStream and stream_viewer). --status-shm keeps lane counts, lights
+// and headline figures in shared memory for sim_status and other local
+// tools (see LiveStatus).
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <cstdlib>
+#include <filesystem>
 #include <iostream>
-#include <fstream>
 #include <string>
-#include <vector>
-#include <filesystem>
-#include <thread>
-#include <chrono>
 
-namespace fs = std::filesystem;
-
-// Constants
-const std::string DATA_DIR = "data/lanes";
+#include <signal.h>
+#include <sys/ioctl.h>
+#include <unistd.h>
 
-// Basic structure to represent a vehicle
-struct SimpleVehicle {
-    std::string id;
-    char lane;
-    int laneNumber;
-    bool isEmergency;
-    float x, y;
-};
-
-// Simple console logging
-void log_message(const std::string& msg) {
-    std::cout << "[Simulator] " << msg << std::endl;
-
-    // Also log to file
-    std::ofstream log("simulator_debug.log", std::ios::app);
-    if (log.is_open()) {
-        log << "[Simulator] " << msg << std::endl;
-        log.close();
-    }
-}
-
-// Ensure data directories exist
-bool ensure_directories() {
-    try {
-        if (!fs::exists(DATA_DIR)) {
-            fs::create_directories(DATA_DIR);
-            log_message("Created directory: " + DATA_DIR);
-        }
-        return true;
-    } catch (const std::exception& e) {
-        log_message("Error creating directories: " + std::string(e.what()));
-        return false;
-    }
-}
+#include "managers/LiveStatus.h"
+#include "managers/StateStream.h"
+#include "managers/TrafficManager.h"
+#include "utils/DebugLogger.h"
+#include "utils/ThreadRoles.h"
+#include "utils/TickJitter.h"
+#include "visualization/Dashboard.h"
+#include "visualization/TerminalScreen.h"
 
-// Read vehicles from lane files
-std::vector<SimpleVehicle> read_vehicles() {
-    std::vector<SimpleVehicle> vehicles;
-
-    for (char laneId : {'A', 'B', 'C', 'D'}) {
-        std::string filePath = DATA_DIR + "/lane" + laneId + ".txt";
-        std::ifstream file(filePath);
-
-        if (!file.is_open()) {
-            continue;
-        }
-
-        std::vector<std::string> lines;
-        std::string line;
-
-        while (std::getline(file, line)) {
-            if (!line.empty()) {
-                lines.push_back(line);
-            }
-        }
-        file.close();
-
-        // Clear the file
-        std::ofstream clearFile(filePath, std::ios::trunc);
-        clearFile.close();
-
-        // Process lines
-        for (const auto& line : lines) {
-            size_t pos = line.find(":");
-            if (pos == std::string::npos) continue;
+namespace fs = std::filesystem;
 
-            std::string vehicleId = line.substr(0, pos);
-            char lane = line[pos + 1];
+namespace {
 
-            // Extract info from ID
-            int laneNumber = 2; // Default
-            if (vehicleId.find("L1") != std::string::npos) {
-                laneNumber = 1;
-            } else if (vehicleId.find("L3") != std::string::npos) {
-                laneNumber = 3;
-            }
+const std::string DATA_DIR = "data/lanes";
 
-            bool isEmergency = (vehicleId.find("EMG") != std::string::npos);
+// Simulation step, as in the SDL front-end's render loop
+const uint32_t STEP_MS = 16;
 
-            // Add to vehicles list (position doesn't matter in console)
-            SimpleVehicle vehicle = {vehicleId, lane, laneNumber, isEmergency, 0, 0};
-            vehicles.push_back(vehicle);
+volatile sig_atomic_t stopRequested = 0;
+volatile sig_atomic_t resizeRequested = 0;
 
-            log_message("Read vehicle: " + vehicleId + " on lane " + lane +
-                       (isEmergency ? " (EMERGENCY)" : ""));
-        }
-    }
+void onStop(int) {
+    stopRequested = 1;
+}
 
-    return vehicles;
+void onResize(int) {
+    resizeRequested = 1;
 }
 
-// Simulate traffic flow (just for demonstration)
-void update_simulation(std::vector<SimpleVehicle>& vehicles) {
-    // Remove some vehicles to simulate them passing through
-    if (!vehicles.empty()) {
-        // Remove the first vehicle
-        log_message("Vehicle " + vehicles[0].id + " passed through the intersection");
-        vehicles.erase(vehicles.begin());
+// Terminal size, or 80x24 when stdout is not a terminal
+void terminalSize(int& width, int& height) {
+    winsize size = {};
+    if (ioctl(STDOUT_FILENO, TIOCGWINSZ, &size) == 0 && size.ws_col > 0 && size.ws_row > 0) {
+        width = size.ws_col;
+        height = size.ws_row;
+    } else {
+        width = 80;
+        height = 24;
     }
 }
 
-// Print the current state of the simulation
-void print_simulation_state(const std::vector<SimpleVehicle>& vehicles) {
-    log_message("Current simulation state:");
-    log_message("Total vehicles: " + std::to_string(vehicles.size()));
-
-    // Count vehicles by lane
-    int countA = 0, countB = 0, countC = 0, countD = 0;
-    for (const auto& v : vehicles) {
-        switch (v.lane) {
-            case 'A': countA++; break;
-            case 'B': countB++; break;
-            case 'C': countC++; break;
-            case 'D': countD++; break;
+// Write everything, retrying on partial writes; false if the terminal is gone
+bool writeAll(const std::string& data) {
+    size_t done = 0;
+    while (done < data.size()) {
+        ssize_t n = write(STDOUT_FILENO, data.data() + done, data.size() - done);
+        if (n < 0) {
+            if (errno == EINTR) continue;
+            return false;
         }
+        done += static_cast<size_t>(n);
     }
+    return true;
+}
 
-    log_message("Vehicles by lane:");
-    log_message("  Lane A: " + std::to_string(countA));
-    log_message("  Lane B: " + std::to_string(countB));
-    log_message("  Lane C: " + std::to_string(countC));
-    log_message("  Lane D: " + std::to_string(countD));
-
-    // Print first few vehicles in each lane
-    log_message("First few vehicles in each lane:");
-    for (char lane : {'A', 'B', 'C', 'D'}) {
-        std::string laneVehicles = "  Lane " + std::string(1, lane) + ": ";
-        int count = 0;
-
-        for (const auto& v : vehicles) {
-            if (v.lane == lane && count < 3) {
-                laneVehicles += v.id + " ";
-                count++;
-            }
+} // namespace
+
+int main(int argc, char* argv[]) {
+    std::string networkPath;
+    std::string replayPath;
+    int replayStartHour = 0;
+    double refreshHz = 10.0;
+    double speed = 1.0;
+    int windowSeconds = 60;
+    int threads = 1;
+    bool logging = false;
+    std::string threadRoles;
+    std::string jitterPath;
+    std::string streamAddress;
+    std::string statusName;
+
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        bool hasValue = i + 1 < argc;
+
+        if (arg == "--network" && hasValue) {
+            networkPath = argv[++i];
+        } else if (arg == "--refresh" && hasValue) {
+            refreshHz = std::max(0.1, std::atof(argv[++i]));
+        } else if (arg == "--speed" && hasValue) {
+            speed = std::max(0.0, std::atof(argv[++i]));
+        } else if (arg == "--window" && hasValue) {
+            windowSeconds = std::max(1, std::atoi(argv[++i]));
+        } else if (arg == "--threads" && hasValue) {
+            threads = std::max(1, std::atoi(argv[++i]));
+        } else if (arg == "--replay" && hasValue) {
+            replayPath = argv[++i];
+        } else if (arg == "--start-hour" && hasValue) {
+            replayStartHour = std::atoi(argv[++i]);
+        } else if (arg == "--log") {
+            logging = true;
+        } else if (arg == "--thread-roles" && hasValue) {
+            threadRoles = argv[++i];
+        } else if (arg == "--jitter-out" && hasValue) {
+            jitterPath = argv[++i];
+        } else if (arg == "--stream" && hasValue) {
+            streamAddress = argv[++i];
+        } else if (arg == "--status-shm" && hasValue) {
+            statusName = argv[++i];
+        } else {
+            std::cout << "Usage: console_simulator [--network <file>] [--refresh HZ] [--speed X] [--window S]\n"
+                      << "                         [--threads N] [--replay <trace> [--start-hour H]] [--log]\n"
+                      << "                         [--thread-roles <spec>] [--jitter-out <file>]\n"
+                      << "                         [--stream <socket path | tcp:PORT>] [--status-shm <name>]"
+                      << std::endl;
+            return arg == "--help" ? 0 : 1;
         }
+    }
 
-        if (count == 0) {
-            laneVehicles += "(empty)";
-        }
+    // The log would scroll the dashboard away: file only, and only on request
+    DebugLogger::setConsoleEcho(false);
+    DebugLogger::setEnabled(logging);
 
-        log_message(laneVehicles);
+    // Thread placement must be known before any thread starts
+    std::string roleError;
+    if (!ThreadRoles::configureFromEnvironment(roleError) ||
+        (!threadRoles.empty() && !ThreadRoles::configure(threadRoles, roleError))) {
+        std::cerr << "Bad thread roles: " << roleError << std::endl;
+        return 1;
+    }
+    ThreadRoles::assignCurrent(ThreadRoles::Role::SIMULATION, "sim");
+    if (logging) {
+        DebugLogger::startFlushThread();
     }
-}
-
-// Main function
-int main() {
-    try {
-        // Initialize
-        log_message("Starting console traffic simulator");
 
-        // Ensure data directory exists
-        if (!ensure_directories()) {
-            log_message("Failed to create data directories");
-            return 1;
-        }
+    std::error_code error;
+    fs::create_directories(DATA_DIR, error);
 
-        // Main simulation loop
-        std::vector<SimpleVehicle> vehicles;
-        bool running = true;
-        int iteration = 0;
+    TrafficManager manager;
+    if (!manager.initialize(networkPath)) {
+        std::cerr << "Failed to initialize the traffic manager" << std::endl;
+        return 1;
+    }
+    manager.setWorkerThreads(static_cast<size_t>(threads));
+    if (!replayPath.empty() && !manager.loadArrivalTrace(replayPath, 1.0, replayStartHour)) {
+        std::cerr << "Failed to load arrival trace: " << replayPath << std::endl;
+        return 1;
+    }
+    manager.start();
 
-        while (running && iteration < 60) { // Run for 60 iterations
-            // Read new vehicles
-            std::vector<SimpleVehicle> newVehicles = read_vehicles();
-            if (!newVehicles.empty()) {
-                log_message("Added " + std::to_string(newVehicles.size()) + " new vehicles");
-                vehicles.insert(vehicles.end(), newVehicles.begin(), newVehicles.end());
-            }
+    StateStream stream;
+    if (!streamAddress.empty() && !stream.open(streamAddress)) {
+        std::cerr << stream.getLastError() << std::endl;
+        return 1;
+    }
+    LiveStatus status;
+    if (!statusName.empty() && !status.create(statusName, manager)) {
+        std::cerr << status.getLastError() << std::endl;
+        return 1;
+    }
 
-            // Update simulation
-            update_simulation(vehicles);
+    // Stays on the main screen, above the dashboard, after quitting
+    std::string placement = ThreadRoles::report();
+    writeAll(placement);
+    DebugLogger::log(placement);
+
+    signal(SIGINT, onStop);
+    signal(SIGTERM, onStop);
+    signal(SIGHUP, onStop);
+    signal(SIGWINCH, onResize);
+    signal(SIGPIPE, SIG_IGN);
+
+    TerminalScreen screen;
+    int width = 0;
+    int height = 0;
+    terminalSize(width, height);
+    screen.resize(width, height);
+    Dashboard dashboard(manager, static_cast<uint32_t>(windowSeconds));
+    writeAll(TerminalScreen::enterSequence());
+
+    using Clock = std::chrono::steady_clock;
+    const auto framePeriod = std::chrono::duration_cast<Clock::duration>(
+        std::chrono::duration<double>(1.0 / refreshHz));
+    auto lastFrame = Clock::now();
+    auto nextFrame = lastFrame;
+    double pendingMs = 0.0;
+
+    // Output rate over the last second
+    auto rateStart = lastFrame;
+    uint64_t rateBytes = 0;
+    double bytesPerSecond = 0.0;
+    TickJitter jitter;
+
+    while (!stopRequested) {
+        if (resizeRequested) {
+            resizeRequested = 0;
+            terminalSize(width, height);
+            screen.resize(width, height);
+        }
 
-            // Print current state
-            print_simulation_state(vehicles);
+        // Advance simulation time by the elapsed wall time in fixed steps
+        auto now = Clock::now();
+        pendingMs += std::chrono::duration<double, std::milli>(now - lastFrame).count() * speed;
+        lastFrame = now;
+        jitter.tickStarted();
+        while (pendingMs >= STEP_MS) {
+            manager.update(STEP_MS);
+            stream.publish(manager);
+            status.publish(manager);
+            pendingMs -= STEP_MS;
+        }
+        jitter.tickFinished();
 
-            // Wait for a second before next iteration
-            log_message("Waiting for next iteration...");
-            std::this_thread::sleep_for(std::chrono::seconds(1));
+        dashboard.draw(screen, bytesPerSecond, refreshHz);
+        std::string output = screen.flush();
+        if (!writeAll(output)) {
+            break;
+        }
 
-            iteration++;
+        rateBytes += output.size();
+        double rateSeconds = std::chrono::duration<double>(now - rateStart).count();
+        if (rateSeconds >= 1.0) {
+            bytesPerSecond = static_cast<double>(rateBytes) / rateSeconds;
+            rateBytes = 0;
+            rateStart = now;
         }
 
-        log_message("Simulation complete. Total iterations: " + std::to_string(iteration));
-        return 0;
+        // Sleep to the next frame; skip frames rather than queue them up
+        nextFrame += framePeriod;
+        now = Clock::now();
+        if (nextFrame < now) {
+            nextFrame = now;
+        }
+        jitter.sleepUntil(nextFrame);
     }
-    catch (const std::exception& e) {
-        log_message("Unhandled exception: " + std::string(e.what()));
-        return 1;
+
+    writeAll(TerminalScreen::leaveSequence());
+    stream.close();
+    status.close();
+    manager.stop();
+
+    std::cout << "Fuel and emissions:\n" << manager.getEmissionsSummary();
+    std::cout << "Signal phases:\n" << manager.getPhaseReport();
+    std::cout << "Tick jitter (us): " << jitter.summary() << std::endl;
+    if (!streamAddress.empty()) {
+        std::cout << "State stream: " << stream.summary() << std::endl;
     }
-    catch (...) {
-        log_message("Unknown exception");
-        return 1;
+    if (!jitterPath.empty() && !jitter.exportTo(jitterPath)) {
+        std::cerr << "Failed to write " << jitterPath << std::endl;
     }
+    DebugLogger::stopFlushThread();
+    return 0;
 }
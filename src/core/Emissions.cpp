@@ -0,0 +1,93 @@
+#include "core/Emissions.h"
+#include <algorithm>
+#include <cmath>
+
+namespace {
+
+// The model over plain arrays that don't overlap, as straight-line
+// arithmetic the vectorizer can take
+void evaluate(size_t count, uint32_t delta,
+              const float* __restrict dx, const float* __restrict dy, const float* __restrict lastSpeed,
+              float* __restrict speed, float* __restrict distance,
+              float* __restrict energy, float* __restrict fuel) {
+    const float dt = static_cast<float>(delta) / 1000.0f;
+    const float invDt = delta > 0 ? 1.0f / dt : 0.0f;
+
+    for (size_t i = 0; i < count; i++) {
+        float moved = std::sqrt(dx[i] * dx[i] + dy[i] * dy[i]) * EmissionsBatch::METERS_PER_PIXEL;
+        float v = std::min(moved * invDt, EmissionsBatch::MAX_SPEED);
+        float a = (v - lastSpeed[i]) * invDt;
+
+        float powerKw = EmissionsBatch::MASS_TONNES * (v * (1.1f * a + 0.132f) + 0.000302f * v * v * v);
+        float tractive = std::max(powerKw, 0.0f);
+        speed[i] = v;
+        distance[i] = v * dt;
+        energy[i] = tractive * dt;
+        fuel[i] = (EmissionsBatch::ALPHA_ML_PER_S + EmissionsBatch::BETA_ML_PER_KJ * tractive) * dt;
+    }
+}
+
+} // namespace
+
+void EmissionsBatch::begin(size_t count) {
+    vehicles.resize(count);
+    slots.resize(count);
+    dx.resize(count);
+    dy.resize(count);
+    lastSpeed.resize(count);
+}
+
+void EmissionsBatch::run(uint32_t delta, std::vector<Totals>& totals) {
+    const size_t count = vehicles.size();
+    speed.resize(count);
+    distance.resize(count);
+    energy.resize(count);
+    fuel.resize(count);
+
+    evaluate(count, delta, dx.data(), dy.data(), lastSpeed.data(),
+             speed.data(), distance.data(), energy.data(), fuel.data());
+
+    // Sum each run of entries with the same slot, then add the sums to
+    // the slot's running totals
+    const double seconds = static_cast<double>(delta) / 1000.0;
+    size_t i = 0;
+    while (i < count) {
+        uint32_t slot = slots[i];
+        float fuelSum = 0.0f;
+        float energySum = 0.0f;
+        float distanceSum = 0.0f;
+        size_t vehicleCount = 0;
+        for (; i < count && slots[i] == slot; i++) {
+            if (vehicles[i]) {
+                fuelSum += fuel[i];
+                energySum += energy[i];
+                distanceSum += distance[i];
+                vehicleCount++;
+            }
+        }
+
+        Totals& totalsOfSlot = totals[slot];
+        totalsOfSlot.fuelMl += fuelSum;
+        totalsOfSlot.energyKj += energySum;
+        totalsOfSlot.co2G += static_cast<double>(fuelSum) * CO2_G_PER_ML;
+        totalsOfSlot.distanceM += distanceSum;
+        totalsOfSlot.vehicleSeconds += static_cast<double>(vehicleCount) * seconds;
+    }
+
+    // This sample becomes the one the next set() calls read
+    lastVehicles.swap(vehicles);
+    lastStepSpeed.swap(speed);
+    lastStepEnergy.swap(energy);
+    lastStepFuel.swap(fuel);
+}
+
+void EmissionsBatch::settle(Vehicle* vehicle) const {
+    if (apply(vehicle, vehicle->getEnergy().batchIndex)) {
+        vehicle->getEnergy().batchIndex = NO_ENTRY;
+    }
+}
+
+void EmissionsBatch::clear() {
+    vehicles.clear();
+    lastVehicles.clear();
+}
@@ -0,0 +1,261 @@
+// FILE: src/core/GlowTextures.cpp
+#include "core/GlowTextures.h"
+#include "utils/DebugLogger.h"
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <initializer_list>
+#include <vector>
+
+std::map<RenderBackend*, GlowTextures*> GlowTextures::instances;
+
+namespace {
+
+// Outlines in the neon frame glow; also the border width of its 9-grid
+const int FRAME_RINGS = 5;
+
+// White canvas with premultiplied alpha. Each primitive is composited the
+// way SDL blends it onto the screen, so a pixel ends up holding the combined
+// effect of every layer that covered it.
+class Canvas {
+public:
+    Canvas(int width, int height)
+        : width(width), height(height), level(width * height, 0.0f), alpha(width * height, 0.0f) {}
+
+    // Blend one pixel of brightness (fraction of the tint) with opacity
+    void blend(int x, int y, float brightness, float opacity) {
+        if (x < 0 || y < 0 || x >= width || y >= height) return;
+        size_t i = static_cast<size_t>(y * width + x);
+        level[i] = brightness * opacity + level[i] * (1.0f - opacity);
+        alpha[i] = opacity + alpha[i] * (1.0f - opacity);
+    }
+
+    void fillRect(int x, int y, int w, int h, float brightness, float opacity) {
+        for (int row = y; row < y + h; row++) {
+            for (int col = x; col < x + w; col++) {
+                blend(col, row, brightness, opacity);
+            }
+        }
+    }
+
+    // One-pixel outline, each pixel blended once
+    void outlineRect(int x, int y, int w, int h, float brightness, float opacity) {
+        for (int col = x; col < x + w; col++) {
+            blend(col, y, brightness, opacity);
+            if (h > 1) blend(col, y + h - 1, brightness, opacity);
+        }
+        for (int row = y + 1; row < y + h - 1; row++) {
+            blend(x, row, brightness, opacity);
+            if (w > 1) blend(x + w - 1, row, brightness, opacity);
+        }
+    }
+
+    // Bresenham line between rounded endpoints, both included
+    void line(float x0, float y0, float x1, float y1, float brightness, float opacity) {
+        int ax = static_cast<int>(std::lround(x0));
+        int ay = static_cast<int>(std::lround(y0));
+        int bx = static_cast<int>(std::lround(x1));
+        int by = static_cast<int>(std::lround(y1));
+        int dx = std::abs(bx - ax);
+        int dy = -std::abs(by - ay);
+        int sx = ax < bx ? 1 : -1;
+        int sy = ay < by ? 1 : -1;
+        int error = dx + dy;
+        while (true) {
+            blend(ax, ay, brightness, opacity);
+            if (ax == bx && ay == by) break;
+            int e2 = 2 * error;
+            if (e2 >= dy) { error += dy; ax += sx; }
+            if (e2 <= dx) { error += dx; ay += sy; }
+        }
+    }
+
+    // Upload as a static RGBA texture for premultiplied blending
+    RenderBackend::TextureId upload(RenderBackend* backend) const {
+        std::vector<uint8_t> pixels(static_cast<size_t>(width * height) * 4);
+        for (size_t i = 0; i < level.size(); i++) {
+            uint8_t value = static_cast<uint8_t>(std::lround(level[i] * 255.0f));
+            pixels[i * 4 + 0] = value;
+            pixels[i * 4 + 1] = value;
+            pixels[i * 4 + 2] = value;
+            pixels[i * 4 + 3] = static_cast<uint8_t>(std::lround(alpha[i] * 255.0f));
+        }
+
+        RenderBackend::TextureId texture = backend->createTexture(width, height, pixels.data(), width * 4);
+        if (!texture) {
+            DebugLogger::log("Failed to create glow texture", DebugLogger::LogLevel::ERROR);
+            return 0;
+        }
+        backend->setTextureBlendMode(texture, SDL_BLENDMODE_BLEND_PREMULTIPLIED);
+        backend->setTextureScaleMode(texture, SDL_SCALEMODE_NEAREST);
+        return texture;
+    }
+
+private:
+    int width;
+    int height;
+    std::vector<float> level;   // Premultiplied brightness
+    std::vector<float> alpha;
+};
+
+// Opacity of an SDL alpha byte
+float opacity(int alphaByte) {
+    return static_cast<float>(alphaByte) / 255.0f;
+}
+
+// Light of a 4-pixel square with `rings` filled glow squares of alpha
+// 200 / (2i) around it, as drawn by Renderer::drawVehicleLights
+Canvas vehicleLight(int rings) {
+    int size = 4 + 2 * rings;
+    Canvas canvas(size, size);
+    canvas.fillRect(rings, rings, 4, 4, 1.0f, opacity(200));
+    for (int i = 1; i <= rings; i++) {
+        canvas.fillRect(rings - i, rings - i, 4 + 2 * i, 4 + 2 * i, 1.0f, opacity(200 / (i * 2)));
+    }
+    return canvas;
+}
+
+} // namespace
+
+GlowTextures* GlowTextures::forBackend(RenderBackend* backend) {
+    auto it = instances.find(backend);
+    if (it != instances.end()) {
+        return it->second;
+    }
+    GlowTextures* textures = new GlowTextures(backend);
+    instances[backend] = textures;
+    return textures;
+}
+
+void GlowTextures::release(RenderBackend* backend) {
+    auto it = instances.find(backend);
+    if (it != instances.end()) {
+        delete it->second;
+        instances.erase(it);
+    }
+}
+
+GlowTextures::GlowTextures(RenderBackend* renderBackend)
+    : backend(renderBackend),
+      frameGlow(0) {
+    // Rings 1..5 outside the frame with alpha 255 / (3i); the centre stays
+    // clear and stretches with the 9-grid
+    int size = 2 * FRAME_RINGS + 1;
+    Canvas frame(size, size);
+    for (int i = 1; i <= FRAME_RINGS; i++) {
+        int inset = FRAME_RINGS - i;
+        frame.outlineRect(inset, inset, size - 2 * inset, size - 2 * inset, 1.0f, opacity(255 / (i * 3)));
+    }
+    frameGlow = frame.upload(backend);
+}
+
+GlowTextures::~GlowTextures() {
+    backend->destroyTexture(frameGlow);
+    for (auto* textures : {&hexagons, &lights, &vehicleLights}) {
+        for (auto& entry : *textures) {
+            backend->destroyTexture(entry.second);
+        }
+    }
+}
+
+void GlowTextures::drawTinted(TextureId texture, float x, float y, SDL_Color color) {
+    if (!texture) return;
+
+    float w = 0.0f;
+    float h = 0.0f;
+    backend->getTextureSize(texture, &w, &h);
+    backend->setTextureColorMod(texture, color.r, color.g, color.b);
+    SDL_FRect target = {x, y, w, h};
+    backend->drawTexture(texture, nullptr, &target);
+}
+
+void GlowTextures::drawFrameGlow(const SDL_FRect& rect, SDL_Color color) {
+    if (!frameGlow) return;
+
+    const float ring = static_cast<float>(FRAME_RINGS);
+    SDL_FRect target = {rect.x - ring, rect.y - ring, rect.w + 2 * ring, rect.h + 2 * ring};
+    backend->setTextureColorMod(frameGlow, color.r, color.g, color.b);
+    backend->drawTexture9Grid(frameGlow, nullptr, ring, ring, ring, ring, 1.0f, &target);
+}
+
+void GlowTextures::drawHexagon(int x, int y, float radius, SDL_Color color) {
+    int key = static_cast<int>(std::lround(radius * 10.0f));
+    TextureId& texture = hexagons[key];
+    int half = static_cast<int>(std::ceil(radius * 1.4f)) + 2;
+
+    if (!texture) {
+        // Centre of the hexagon at (half, half), first vertex at the top
+        const int SIDES = 6;
+        float pointsX[SIDES + 1];
+        float pointsY[SIDES + 1];
+        for (int i = 0; i <= SIDES; i++) {
+            float angle = 2.0f * static_cast<float>(M_PI) * static_cast<float>(i % SIDES) / SIDES -
+                          static_cast<float>(M_PI) / 2.0f;
+            pointsX[i] = radius * cosf(angle);
+            pointsY[i] = radius * sinf(angle);
+        }
+
+        Canvas canvas(2 * half + 1, 2 * half + 1);
+        float c = static_cast<float>(half);
+
+        // Glow: outlines scaled by 1.08 .. 1.4 at alpha 50
+        for (int ring = 1; ring <= 5; ring++) {
+            float scale = 1.0f + static_cast<float>(ring) * 0.08f;
+            for (int j = 0; j < SIDES; j++) {
+                canvas.line(c + pointsX[j] * scale, c + pointsY[j] * scale,
+                            c + pointsX[j + 1] * scale, c + pointsY[j + 1] * scale, 1.0f, opacity(50));
+            }
+        }
+
+        // Fill: fan of lines from the first vertex at half brightness
+        for (int i = 0; i < SIDES - 2; i++) {
+            canvas.line(c + pointsX[0], c + pointsY[0], c + pointsX[i + 1], c + pointsY[i + 1], 0.5f, opacity(200));
+            canvas.line(c + pointsX[0], c + pointsY[0], c + pointsX[i + 2], c + pointsY[i + 2], 0.5f, opacity(200));
+            canvas.line(c + pointsX[i + 1], c + pointsY[i + 1], c + pointsX[i + 2], c + pointsY[i + 2],
+                        0.5f, opacity(200));
+        }
+
+        // Border
+        for (int j = 0; j < SIDES; j++) {
+            canvas.line(c + pointsX[j], c + pointsY[j], c + pointsX[j + 1], c + pointsY[j + 1], 1.0f, 1.0f);
+        }
+        texture = canvas.upload(backend);
+    }
+
+    drawTinted(texture, static_cast<float>(x - half), static_cast<float>(y - half), color);
+}
+
+void GlowTextures::drawLight(int x, int y, int size, SDL_Color color, float flicker) {
+    TextureId& texture = lights[size];
+    const int RINGS = 3;
+
+    if (!texture) {
+        // Light square at (RINGS, RINGS); inner fill at alpha 200, outlines
+        // 1..3 pixels outside it at alpha 100 / i
+        Canvas canvas(size + 2 * RINGS, size + 2 * RINGS);
+        canvas.fillRect(RINGS + 2, RINGS + 2, size - 4, size - 4, 1.0f, opacity(200));
+        for (int i = 1; i <= RINGS; i++) {
+            canvas.outlineRect(RINGS - i, RINGS - i, size + 2 * i, size + 2 * i, 1.0f, opacity(100 / i));
+        }
+        texture = canvas.upload(backend);
+    }
+
+    // Flicker dims the tint: exact for the inner light, and for the glow the
+    // difference is the dark panel showing through a little less
+    SDL_Color dimmed = {
+        static_cast<Uint8>(color.r * flicker),
+        static_cast<Uint8>(color.g * flicker),
+        static_cast<Uint8>(color.b * flicker),
+        color.a
+    };
+    drawTinted(texture, static_cast<float>(x - size / 2 - RINGS), static_cast<float>(y - size / 2 - RINGS), dimmed);
+}
+
+void GlowTextures::drawVehicleLight(float x, float y, int rings, SDL_Color color) {
+    TextureId& texture = vehicleLights[rings];
+    if (!texture) {
+        texture = vehicleLight(rings).upload(backend);
+    }
+    float offset = 2.0f + static_cast<float>(rings);
+    drawTinted(texture, x - offset, y - offset, color);
+}
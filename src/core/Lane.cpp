@@ -8,7 +8,8 @@ Lane::Lane(char laneId, int laneNumber)
     : laneId(laneId),
       laneNumber(laneNumber),
       isPriority(laneId == 'A' && laneNumber == 2), // AL2 is the priority lane
-      priority(0) {
+      priority(0),
+      version(0) {
 
     std::ostringstream oss;
     oss << "Created lane " << laneId << laneNumber;
@@ -30,6 +31,7 @@ void Lane::enqueue(Vehicle* vehicle) {
     }
 
     vehicleQueue.enqueue(vehicle);
+    version++;
     int currentCount = vehicleQueue.size();
 
     // Log the action
@@ -60,6 +62,7 @@ Vehicle* Lane::dequeue() {
     }
 
     Vehicle* vehicle = vehicleQueue.dequeue();
+    version++;
     int currentCount = vehicleQueue.size();
 
     // Log the action
@@ -0,0 +1,143 @@
+// FILE: src/core/PhaseAnalytics.cpp
+#include "core/PhaseAnalytics.h"
+#include "core/Vehicle.h"
+
+void PhaseAnalytics::Figures::add(const Figures& other) {
+    greenMs += other.greenMs;
+    wastedMs += other.wastedMs;
+    discharged += other.discharged;
+    greens += other.greens;
+    residual += other.residual;
+}
+
+void PhaseAnalytics::Summary::add(const Summary& other) {
+    totalMs += other.totalMs;
+    allRedMs += other.allRedMs;
+    cycles += other.cycles;
+    for (int p = 0; p < PHASE_COUNT; p++) {
+        phases[p].add(other.phases[p]);
+    }
+}
+
+PhaseAnalytics::Figures PhaseAnalytics::Summary::getGreen() const {
+    Figures green = {};
+    for (int p = 0; p < PHASE_COUNT; p++) {
+        green.add(phases[p]);
+    }
+    return green;
+}
+
+PhaseAnalytics::PhaseAnalytics() {
+    reset();
+}
+
+void PhaseAnalytics::reset() {
+    totals = Summary{};
+    cycle = Summary{};
+    inCycle = false;
+    recentCycles.clear();
+    for (int p = 0; p < PHASE_COUNT; p++) {
+        passed[p] = 0;
+        exited[p] = 0;
+    }
+}
+
+int PhaseAnalytics::phaseOf(TrafficLight::State state) {
+    switch (state) {
+        case TrafficLight::State::A_GREEN: return 0;
+        case TrafficLight::State::B_GREEN: return 1;
+        case TrafficLight::State::C_GREEN: return 2;
+        case TrafficLight::State::D_GREEN: return 3;
+        default: return -1;
+    }
+}
+
+int PhaseAnalytics::phaseServing(const Lane& lane) {
+    int phase = lane.getLaneId() - 'A';
+    if (lane.getLaneNumber() == 3 || phase < 0 || phase >= PHASE_COUNT) {
+        return -1;
+    }
+    return phase;
+}
+
+void PhaseAnalytics::onExit(const Lane& lane) {
+    int phase = phaseServing(lane);
+    if (phase >= 0) {
+        exited[phase]++;
+    }
+}
+
+bool PhaseAnalytics::step(TrafficLight::State state, TrafficLight::State nextState, uint32_t delta, uint64_t now,
+                          const std::vector<Lane*>& lanes) {
+    // Waiting and passed vehicles of every road, so the passed counts stay
+    // current through the other phases' greens
+    uint32_t waiting[PHASE_COUNT] = {};
+    uint32_t passedNow[PHASE_COUNT] = {};
+    for (const Lane* lane : lanes) {
+        int road = phaseServing(*lane);
+        if (road < 0) {
+            continue;
+        }
+        for (const Vehicle* vehicle : lane->getVehicles()) {
+            if (!vehicle) {
+                continue;
+            }
+            if (vehicle->hasPassedStopLine()) {
+                passedNow[road]++;
+            } else {
+                waiting[road]++;
+            }
+        }
+    }
+
+    const int phase = phaseOf(state);
+    uint32_t discharged = 0;
+    if (phase >= 0 && passedNow[phase] + exited[phase] > passed[phase]) {
+        discharged = passedNow[phase] + exited[phase] - passed[phase];
+    }
+    for (int p = 0; p < PHASE_COUNT; p++) {
+        passed[p] = passedNow[p];
+        exited[p] = 0;
+    }
+
+    const bool greenEnds = phase >= 0 && nextState != state;
+    Summary* spans[2] = {&totals, inCycle ? &cycle : nullptr};
+    for (Summary* span : spans) {
+        if (!span) {
+            continue;
+        }
+        span->totalMs += delta;
+        if (phase < 0) {
+            span->allRedMs += delta;
+            continue;
+        }
+
+        Figures& figures = span->phases[phase];
+        figures.greenMs += delta;
+        figures.discharged += discharged;
+        if (waiting[phase] == 0 && discharged == 0) {
+            figures.wastedMs += delta;
+        }
+        if (greenEnds) {
+            figures.greens++;
+            figures.residual += waiting[phase];
+        }
+    }
+    // Each A green starts a cycle
+    if (nextState != TrafficLight::State::A_GREEN || state == TrafficLight::State::A_GREEN) {
+        return false;
+    }
+    bool completed = inCycle;
+    if (completed) {
+        cycle.cycles = 1;
+        totals.cycles++;
+        recentCycles.push_back(cycle);
+        if (recentCycles.size() > RECENT_CYCLES) {
+            recentCycles.pop_front();
+        }
+    }
+    cycle = Summary{};
+    cycle.startMs = now;
+    inCycle = true;
+    return completed;
+}
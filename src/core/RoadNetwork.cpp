@@ -0,0 +1,373 @@
+// FILE: src/core/RoadNetwork.cpp
+#include "core/RoadNetwork.h"
+#include "utils/DebugLogger.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+
+namespace {
+
+// Minimal tokenizer over one line of the network file
+struct LineCursor {
+    const char* pos;
+    const char* end;
+
+    void skipSpace() {
+        while (pos < end && (*pos == ' ' || *pos == '\t' || *pos == '\r')) pos++;
+    }
+
+    // Next whitespace separated token (empty at end of line)
+    std::string token() {
+        skipSpace();
+        const char* start = pos;
+        while (pos < end && *pos != ' ' && *pos != '\t' && *pos != '\r') pos++;
+        return std::string(start, pos - start);
+    }
+
+    bool number(long& value) {
+        std::string t = token();
+        if (t.empty()) return false;
+        char* stop = nullptr;
+        value = std::strtol(t.c_str(), &stop, 10);
+        return *stop == '\0';
+    }
+
+    bool number(float& value) {
+        std::string t = token();
+        if (t.empty()) return false;
+        char* stop = nullptr;
+        value = std::strtof(t.c_str(), &stop);
+        return *stop == '\0';
+    }
+
+    bool atEnd() {
+        skipSpace();
+        return pos >= end;
+    }
+};
+
+// Junction as read from the file, added once the final order is known
+struct RawJunction {
+    long id;
+    float x;
+    float y;
+    int approaches;
+    int lanesPerApproach;
+    uint64_t order;
+};
+
+// Link as read from the file, resolved once all junctions are known
+struct RawLink {
+    long fromId;
+    char exitRoad;
+    long toId;
+    char entryRoad;
+    float length;
+    int line;
+};
+
+// Movement override as read from the file
+struct RawMovement {
+    long junctionId;
+    char road;
+    int laneNumber;
+    uint8_t movements;
+    int line;
+};
+
+} // namespace
+
+RoadNetwork::RoadNetwork()
+    : entryJunction(0) {}
+
+void RoadNetwork::clear() {
+    junctions.clear();
+    lanes.clear();
+    links.clear();
+    approachExitLinks.clear();
+    junctionById.clear();
+    entryJunction = 0;
+}
+
+uint32_t RoadNetwork::addJunction(uint32_t id, float x, float y, int approachCount, int lanesPerApproach) {
+    Junction junction;
+    junction.id = id;
+    junction.x = x;
+    junction.y = y;
+    junction.firstLane = static_cast<uint32_t>(lanes.size());
+    junction.firstApproach = static_cast<uint32_t>(approachExitLinks.size());
+    junction.approachCount = static_cast<uint16_t>(approachCount);
+    junction.lanesPerApproach = static_cast<uint16_t>(lanesPerApproach);
+
+    uint32_t index = static_cast<uint32_t>(junctions.size());
+    junctions.push_back(junction);
+    junctionById[id] = index;
+
+    // Lanes are laid out road-major so laneIndex() is a multiply-add
+    for (int a = 0; a < approachCount; a++) {
+        for (int l = 1; l <= lanesPerApproach; l++) {
+            LaneInfo lane;
+            lane.junction = index;
+            lane.road = static_cast<char>('A' + a);
+            lane.laneNumber = static_cast<uint8_t>(l);
+            lane.movements = defaultMovements(l);
+            lanes.push_back(lane);
+        }
+        approachExitLinks.push_back(INVALID_INDEX);
+    }
+
+    return index;
+}
+
+void RoadNetwork::buildDefault() {
+    clear();
+    addJunction(0, 0.0f, 0.0f, 4, 3);
+}
+
+uint64_t RoadNetwork::hilbertIndex(uint32_t x, uint32_t y) {
+    // Standard iterative xy -> d mapping, walking from the coarsest quadrant down
+    const uint32_t n = 65536;
+    uint64_t d = 0;
+    for (uint32_t s = n / 2; s > 0; s /= 2) {
+        uint32_t rx = (x & s) ? 1 : 0;
+        uint32_t ry = (y & s) ? 1 : 0;
+        d += static_cast<uint64_t>(s) * s * ((3 * rx) ^ ry);
+
+        // Rotate the quadrant so the curve stays continuous
+        if (ry == 0) {
+            if (rx == 1) {
+                x = n - 1 - x;
+                y = n - 1 - y;
+            }
+            std::swap(x, y);
+        }
+    }
+    return d;
+}
+
+std::vector<uint32_t> RoadNetwork::partitionJunctions(size_t parts) const {
+    std::vector<uint32_t> bounds;
+    bounds.push_back(0);
+    if (parts == 0) {
+        return bounds;
+    }
+
+    // Cut whenever the running lane count passes the next equal share
+    size_t total = lanes.size();
+    size_t part = 1;
+    for (size_t j = 0; j < junctions.size() && part < parts; j++) {
+        size_t lanesBefore = junctions[j].firstLane;
+        if (lanesBefore * parts >= total * part && j > bounds.back()) {
+            bounds.push_back(static_cast<uint32_t>(j));
+            part++;
+        }
+    }
+    while (bounds.size() <= parts) {
+        bounds.push_back(static_cast<uint32_t>(junctions.size()));
+    }
+    return bounds;
+}
+
+uint32_t RoadNetwork::findJunction(uint32_t id) const {
+    auto it = junctionById.find(id);
+    return it != junctionById.end() ? it->second : INVALID_INDEX;
+}
+
+bool RoadNetwork::loadFromFile(const std::string& path, bool hilbertOrder) {
+    // Read the whole file in one go; parsing works on the buffer
+    std::ifstream file(path, std::ios::binary);
+    if (!file.is_open()) {
+        lastError = "Could not open network file " + path;
+        DebugLogger::log(lastError, DebugLogger::LogLevel::ERROR);
+        return false;
+    }
+    std::string buffer((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+    file.close();
+
+    clear();
+
+    std::vector<RawJunction> rawJunctions;
+    std::vector<RawLink> rawLinks;
+    std::vector<RawMovement> rawMovements;
+
+    auto fail = [&](int line, const std::string& message) {
+        std::ostringstream oss;
+        oss << path << ":" << line << ": " << message;
+        lastError = oss.str();
+        DebugLogger::log("Network load failed: " + lastError, DebugLogger::LogLevel::ERROR);
+        clear();
+        return false;
+    };
+
+    const char* pos = buffer.data();
+    const char* bufferEnd = pos + buffer.size();
+    int lineNumber = 0;
+
+    while (pos < bufferEnd) {
+        const char* lineEnd = static_cast<const char*>(std::memchr(pos, '\n', bufferEnd - pos));
+        if (!lineEnd) lineEnd = bufferEnd;
+        lineNumber++;
+
+        // Strip comments
+        const char* hash = static_cast<const char*>(std::memchr(pos, '#', lineEnd - pos));
+        LineCursor cursor{pos, hash ? hash : lineEnd};
+        pos = lineEnd + 1;
+
+        std::string keyword = cursor.token();
+        if (keyword.empty()) {
+            continue;
+        }
+
+        if (keyword == "junction") {
+            long id = 0, approaches = 4, lanesPer = 3;
+            float x = 0.0f, y = 0.0f;
+            if (!cursor.number(id) || !cursor.number(x) || !cursor.number(y)) {
+                return fail(lineNumber, "expected: junction <id> <x> <y> [approaches] [lanes]");
+            }
+            if (!cursor.atEnd() && !cursor.number(approaches)) {
+                return fail(lineNumber, "invalid approach count");
+            }
+            if (!cursor.atEnd() && !cursor.number(lanesPer)) {
+                return fail(lineNumber, "invalid lane count");
+            }
+            if (id < 0 || approaches < 1 || approaches > 26 || lanesPer < 1 || lanesPer > 255) {
+                return fail(lineNumber, "junction values out of range");
+            }
+            if (!junctionById.emplace(static_cast<uint32_t>(id), 0).second) {
+                return fail(lineNumber, "duplicate junction id " + std::to_string(id));
+            }
+            rawJunctions.push_back({id, x, y, static_cast<int>(approaches), static_cast<int>(lanesPer), 0});
+        }
+        else if (keyword == "link") {
+            RawLink link;
+            std::string exitRoad, entryRoad;
+            link.line = lineNumber;
+            if (!cursor.number(link.fromId) || (exitRoad = cursor.token()).size() != 1 ||
+                !cursor.number(link.toId) || (entryRoad = cursor.token()).size() != 1 ||
+                !cursor.number(link.length)) {
+                return fail(lineNumber, "expected: link <fromId> <road> <toId> <road> <length>");
+            }
+            // Lengths become routing costs, which must be positive
+            if (!std::isfinite(link.length) || link.length <= 0.0f) {
+                return fail(lineNumber, "link length must be a positive number");
+            }
+            link.exitRoad = exitRoad[0];
+            link.entryRoad = entryRoad[0];
+            rawLinks.push_back(link);
+        }
+        else if (keyword == "movement") {
+            RawMovement movement;
+            movement.line = lineNumber;
+            movement.movements = 0;
+            std::string laneName;
+            std::string list;
+            if (!cursor.number(movement.junctionId)) {
+                return fail(lineNumber, "expected: movement <junctionId> <road><lane> <moves>");
+            }
+            laneName = cursor.token();
+            list = cursor.token();
+            if (laneName.size() < 2 || list.empty()) {
+                return fail(lineNumber, "expected: movement <junctionId> <road><lane> <moves>");
+            }
+            movement.road = laneName[0];
+            movement.laneNumber = std::atoi(laneName.c_str() + 1);
+
+            std::stringstream moves(list);
+            std::string move;
+            while (std::getline(moves, move, ',')) {
+                if (move == "STRAIGHT") movement.movements |= MOVE_STRAIGHT;
+                else if (move == "LEFT") movement.movements |= MOVE_LEFT;
+                else if (move == "RIGHT") movement.movements |= MOVE_RIGHT;
+                else if (move != "NONE") return fail(lineNumber, "unknown movement " + move);
+            }
+            rawMovements.push_back(movement);
+        }
+        else {
+            return fail(lineNumber, "unknown record '" + keyword + "'");
+        }
+    }
+
+    if (rawJunctions.empty()) {
+        return fail(lineNumber, "network has no junctions");
+    }
+
+    // Number junctions along a Hilbert curve so spatial neighbours are
+    // neighbours in memory
+    long entryId = rawJunctions[0].id;
+    if (hilbertOrder) {
+        float minX = rawJunctions[0].x, maxX = minX;
+        float minY = rawJunctions[0].y, maxY = minY;
+        for (const auto& raw : rawJunctions) {
+            minX = std::min(minX, raw.x);
+            maxX = std::max(maxX, raw.x);
+            minY = std::min(minY, raw.y);
+            maxY = std::max(maxY, raw.y);
+        }
+        float scale = 65535.0f / std::max(std::max(maxX - minX, maxY - minY), 1.0f);
+        for (auto& raw : rawJunctions) {
+            raw.order = hilbertIndex(static_cast<uint32_t>((raw.x - minX) * scale),
+                                     static_cast<uint32_t>((raw.y - minY) * scale));
+        }
+        std::stable_sort(rawJunctions.begin(), rawJunctions.end(),
+                         [](const RawJunction& a, const RawJunction& b) { return a.order < b.order; });
+    }
+
+    junctionById.clear();
+    junctions.reserve(rawJunctions.size());
+    for (const auto& raw : rawJunctions) {
+        addJunction(static_cast<uint32_t>(raw.id), raw.x, raw.y, raw.approaches, raw.lanesPerApproach);
+    }
+    entryJunction = findJunction(static_cast<uint32_t>(entryId));
+
+    // Store links in the order of their source junction
+    std::stable_sort(rawLinks.begin(), rawLinks.end(), [this](const RawLink& a, const RawLink& b) {
+        return findJunction(static_cast<uint32_t>(a.fromId)) < findJunction(static_cast<uint32_t>(b.fromId));
+    });
+
+    // Resolve links now that every junction has an index
+    links.reserve(rawLinks.size());
+    for (const auto& raw : rawLinks) {
+        uint32_t from = findJunction(static_cast<uint32_t>(raw.fromId));
+        uint32_t to = findJunction(static_cast<uint32_t>(raw.toId));
+        if (from == INVALID_INDEX || to == INVALID_INDEX) {
+            return fail(raw.line, "link references unknown junction");
+        }
+
+        const Junction& fromJunction = junctions[from];
+        const Junction& toJunction = junctions[to];
+        int exitApproach = raw.exitRoad - 'A';
+        int entryApproach = raw.entryRoad - 'A';
+        if (exitApproach < 0 || exitApproach >= fromJunction.approachCount ||
+            entryApproach < 0 || entryApproach >= toJunction.approachCount) {
+            return fail(raw.line, "link road out of range");
+        }
+
+        uint32_t& slot = approachExitLinks[fromJunction.firstApproach + exitApproach];
+        if (slot != INVALID_INDEX) {
+            return fail(raw.line, "road already has an outgoing link");
+        }
+        slot = static_cast<uint32_t>(links.size());
+
+        links.push_back({from, to, raw.exitRoad, raw.entryRoad, raw.length});
+    }
+
+    // Apply movement overrides
+    for (const auto& raw : rawMovements) {
+        uint32_t junction = findJunction(static_cast<uint32_t>(raw.junctionId));
+        uint32_t lane = laneIndex(junction, raw.road, raw.laneNumber);
+        if (lane == INVALID_INDEX) {
+            return fail(raw.line, "movement references unknown lane");
+        }
+        lanes[lane].movements = raw.movements;
+    }
+
+    std::ostringstream oss;
+    oss << "Loaded network " << path << ": " << junctions.size() << " junctions, "
+        << lanes.size() << " lanes, " << links.size() << " links";
+    DebugLogger::log(oss.str());
+
+    return true;
+}
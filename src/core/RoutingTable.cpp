@@ -0,0 +1,177 @@
+// FILE: src/core/RoutingTable.cpp
+#include "core/RoutingTable.h"
+#include "core/Constants.h"
+#include "utils/DebugLogger.h"
+#include "utils/ThreadPool.h"
+#include <algorithm>
+#include <functional>
+#include <limits>
+#include <queue>
+#include <sstream>
+
+RoutingTable::RoutingTable()
+    : junctionCount(0),
+      threadPool(nullptr),
+      staleCount(0) {}
+
+void RoutingTable::build(const RoadNetwork& network) {
+    junctionCount = network.getJunctionCount();
+    size_t linkCount = network.getLinkCount();
+
+    // Copy link endpoints and free-flow travel times
+    linkFrom.resize(linkCount);
+    linkTo.resize(linkCount);
+    linkApproach.resize(linkCount);
+    linkCosts.resize(linkCount);
+    for (size_t l = 0; l < linkCount; l++) {
+        const RoadNetwork::Link& link = network.getLink(l);
+        linkFrom[l] = link.fromJunction;
+        linkTo[l] = link.toJunction;
+        linkApproach[l] = static_cast<uint16_t>(link.exitRoad - 'A');
+        linkCosts[l] = link.length / Constants::LINK_SPEED;
+    }
+
+    // Reverse adjacency: bucket links by the junction they arrive at
+    incomingStart.assign(junctionCount + 1, 0);
+    for (size_t l = 0; l < linkCount; l++) {
+        incomingStart[linkTo[l] + 1]++;
+    }
+    for (size_t j = 0; j < junctionCount; j++) {
+        incomingStart[j + 1] += incomingStart[j];
+    }
+    incomingLinks.resize(linkCount);
+    std::vector<uint32_t> fill(incomingStart.begin(), incomingStart.end() - 1);
+    for (size_t l = 0; l < linkCount; l++) {
+        incomingLinks[fill[linkTo[l]]++] = static_cast<uint32_t>(l);
+    }
+
+    hops.assign(junctionCount * junctionCount, NO_ROUTE);
+    distances.assign(junctionCount * junctionCount, std::numeric_limits<float>::infinity());
+    stale.assign(junctionCount, 0);
+    staleCount = 0;
+
+    std::vector<uint32_t> all(junctionCount);
+    for (size_t d = 0; d < junctionCount; d++) {
+        all[d] = static_cast<uint32_t>(d);
+    }
+    computeDestinations(all);
+
+    size_t threads = threadPool ? threadPool->getThreadCount() : 1;
+    std::ostringstream oss;
+    oss << "Routing tables built for " << junctionCount << " junctions using "
+        << std::min(threads, junctionCount) << " threads";
+    DebugLogger::log(oss.str());
+}
+
+void RoutingTable::computeDestination(uint32_t destination) {
+    typedef std::pair<float, uint32_t> Entry;
+
+    uint16_t* hop = hops.data() + static_cast<size_t>(destination) * junctionCount;
+    float* dist = distances.data() + static_cast<size_t>(destination) * junctionCount;
+
+    std::fill(hop, hop + junctionCount, NO_ROUTE);
+    std::fill(dist, dist + junctionCount, std::numeric_limits<float>::infinity());
+
+    // Dijkstra outward from the destination along reversed links
+    std::priority_queue<Entry, std::vector<Entry>, std::greater<Entry>> open;
+    dist[destination] = 0.0f;
+    open.push(Entry(0.0f, destination));
+
+    while (!open.empty()) {
+        Entry top = open.top();
+        open.pop();
+
+        uint32_t v = top.second;
+        if (top.first > dist[v]) {
+            continue; // Stale entry
+        }
+
+        for (uint32_t i = incomingStart[v]; i < incomingStart[v + 1]; i++) {
+            uint32_t link = incomingLinks[i];
+            uint32_t u = linkFrom[link];
+            float candidate = dist[v] + linkCosts[link];
+            if (candidate < dist[u]) {
+                dist[u] = candidate;
+                hop[u] = linkApproach[link];
+                open.push(Entry(candidate, u));
+            }
+        }
+    }
+}
+
+void RoutingTable::computeDestinations(const std::vector<uint32_t>& destinations) {
+    if (!threadPool || destinations.size() <= 1) {
+        for (uint32_t d : destinations) {
+            computeDestination(d);
+        }
+        return;
+    }
+
+    // Destinations are independent, so any worker can take any of them
+    threadPool->parallelFor(destinations.size(), [&](size_t i) {
+        computeDestination(destinations[i]);
+    });
+}
+
+size_t RoutingTable::getMemoryBytes() const {
+    return linkFrom.capacity() * sizeof(uint32_t) + linkTo.capacity() * sizeof(uint32_t) +
+           linkApproach.capacity() * sizeof(uint16_t) + linkCosts.capacity() * sizeof(float) +
+           incomingStart.capacity() * sizeof(uint32_t) + incomingLinks.capacity() * sizeof(uint32_t) +
+           hops.capacity() * sizeof(uint16_t) + distances.capacity() * sizeof(float) + stale.capacity();
+}
+
+size_t RoutingTable::updateLinkCost(uint32_t link, float cost) {
+    return updateLinkCosts({{link, cost}});
+}
+
+size_t RoutingTable::updateLinkCosts(const std::vector<std::pair<uint32_t, float>>& changes) {
+    deferLinkCosts(changes);
+    return recomputeStale();
+}
+
+void RoutingTable::deferLinkCosts(const std::vector<std::pair<uint32_t, float>>& changes) {
+    for (const auto& change : changes) {
+        uint32_t link = change.first;
+        if (link >= linkCosts.size()) {
+            continue;
+        }
+
+        float oldCost = linkCosts[link];
+        float newCost = change.second;
+        linkCosts[link] = newCost;
+        if (newCost == oldCost) {
+            continue;
+        }
+
+        uint32_t u = linkFrom[link];
+        uint32_t v = linkTo[link];
+
+        // A destination's tree changes if it routes over this link, or if the
+        // cheaper link now beats or ties the current route out of its start
+        // junction. Ties are recomputed too, so the tables are the ones a
+        // fresh build on the current costs gives whatever the update history.
+        // Rows already stale are out of date and get recomputed anyway.
+        for (size_t d = 0; d < junctionCount; d++) {
+            size_t row = d * junctionCount;
+            if (!stale[d] && (hops[row + u] == linkApproach[link] ||
+                              (newCost < oldCost && newCost + distances[row + v] <= distances[row + u]))) {
+                stale[d] = 1;
+                staleCount++;
+            }
+        }
+    }
+}
+
+size_t RoutingTable::recomputeStale() {
+    std::vector<uint32_t> destinations;
+    for (size_t d = 0; d < junctionCount && destinations.size() < staleCount; d++) {
+        if (stale[d]) {
+            destinations.push_back(static_cast<uint32_t>(d));
+            stale[d] = 0;
+        }
+    }
+    staleCount = 0;
+    computeDestinations(destinations);
+
+    return destinations.size();
+}
@@ -1,5 +1,7 @@
 // FILE: src/core/TrafficLight.cpp
 #include "core/TrafficLight.h"
+#include "core/GlowTextures.h"
+#include "visualization/RenderBackend.h"
 #include "utils/DebugLogger.h"
 #include <sstream>
 #include <cmath>
@@ -22,19 +24,63 @@ TrafficLight::~TrafficLight() {
     DebugLogger::log("TrafficLight destroyed");
 }
 
+void TrafficLight::restart(uint32_t currentTime) {
+    currentState = State::ALL_RED;
+    nextState = State::A_GREEN;
+    lastStateChangeTime = currentTime;
+    isPriorityMode = false;
+    shouldResumeNormalMode = false;
+    forceAGreen = false;
+    priorityModeStartTime = 0;
+}
+
+TrafficLight::Snapshot TrafficLight::getSnapshot() const {
+    Snapshot snapshot = Snapshot();
+    snapshot.lastStateChangeTime = lastStateChangeTime;
+    snapshot.priorityModeStartTime = priorityModeStartTime;
+    snapshot.currentState = static_cast<uint8_t>(currentState);
+    snapshot.nextState = static_cast<uint8_t>(nextState);
+    snapshot.isPriorityMode = isPriorityMode ? 1 : 0;
+    snapshot.shouldResumeNormalMode = shouldResumeNormalMode ? 1 : 0;
+    snapshot.forceAGreen = forceAGreen ? 1 : 0;
+    return snapshot;
+}
+
+void TrafficLight::restore(const Snapshot& snapshot) {
+    currentState = static_cast<State>(snapshot.currentState);
+    nextState = static_cast<State>(snapshot.nextState);
+    lastStateChangeTime = snapshot.lastStateChangeTime;
+    priorityModeStartTime = snapshot.priorityModeStartTime;
+    isPriorityMode = snapshot.isPriorityMode != 0;
+    shouldResumeNormalMode = snapshot.shouldResumeNormalMode != 0;
+    forceAGreen = snapshot.forceAGreen != 0;
+}
+
 void TrafficLight::update(const std::vector<Lane*>& lanes) {
-    uint32_t currentTime = SDL_GetTicks();
-    uint32_t elapsedTime = currentTime - lastStateChangeTime;
+    update(lanes, SDL_GetTicks());
+}
 
-    // CRITICAL: Find priority lane A2 directly
+void TrafficLight::update(const std::vector<Lane*>& lanes, uint32_t currentTime) {
+    // CRITICAL: Find priority lane A2 directly, and total the normal lanes (L2)
     Lane* al2Lane = nullptr;
+    int laneTwoCount = 0;
+    int laneTwoVehicles = 0;
     for (auto* lane : lanes) {
-        if (lane->getLaneId() == 'A' && lane->getLaneNumber() == 2) {
-            al2Lane = lane;
-            break;
+        if (lane->getLaneNumber() == 2) {
+            if (!al2Lane && lane->getLaneId() == 'A') {
+                al2Lane = lane;
+            }
+            laneTwoCount++;
+            laneTwoVehicles += lane->getVehicleCount();
         }
     }
 
+    update(al2Lane, laneTwoCount, laneTwoVehicles, currentTime);
+}
+
+void TrafficLight::update(Lane* al2Lane, int laneTwoCount, int laneTwoVehicles, uint32_t currentTime) {
+    uint32_t elapsedTime = currentTime - lastStateChangeTime;
+
     // CRITICAL FIX: Direct priority detection and override
     if (al2Lane) {
         int vehicleCount = al2Lane->getVehicleCount();
@@ -100,8 +146,6 @@ void TrafficLight::update(const std::vector<Lane*>& lanes) {
             }
         } else {
             // Extend the green duration in priority mode
-            int priorityGreenDuration = 6000; // 6 seconds of green in priority mode
-
             if (elapsedTime >= priorityGreenDuration) {
                 // Go to ALL_RED briefly before returning to A_GREEN
                 currentState = State::ALL_RED;
@@ -121,13 +165,13 @@ void TrafficLight::update(const std::vector<Lane*>& lanes) {
         stateDuration = allRedDuration; // 2 seconds for ALL_RED
     } else {
         // Calculate average using lane counts
-        float averageVehicleCount = calculateAverageVehicleCount(lanes);
+        float averageVehicleCount = calculateAverageVehicleCount(al2Lane, laneTwoCount, laneTwoVehicles);
 
         // Set duration using formula: Total time = |V| * t (2 seconds per vehicle)
         stateDuration = static_cast<int>(averageVehicleCount * 2000);
 
         // Apply minimum and maximum limits for reasonable times
-        if (stateDuration < 3000) stateDuration = 3000; // Min 3 seconds
+        if (stateDuration < minGreenDuration) stateDuration = minGreenDuration; // Min 3 seconds
         if (stateDuration > 15000) stateDuration = 15000; // Max 15 seconds
 
         // Log the calculation
@@ -173,18 +217,33 @@ void TrafficLight::update(const std::vector<Lane*>& lanes) {
     }
 }
 
-float TrafficLight::calculateAverageVehicleCount(const std::vector<Lane*>& lanes) {
-    int normalLaneCount = 0;
-    int totalVehicleCount = 0;
+uint32_t TrafficLight::getTimeToNextChange(uint32_t currentTime) const {
+    // Priority mode only alternates ALL_RED and A_GREEN
+    int stateDuration;
+    if (currentState == State::ALL_RED) {
+        stateDuration = allRedDuration;
+    } else if (isPriorityMode && forceAGreen) {
+        stateDuration = priorityGreenDuration;
+    } else {
+        stateDuration = minGreenDuration;
+    }
+
+    uint32_t elapsedTime = currentTime - lastStateChangeTime;
+    if (elapsedTime >= static_cast<uint32_t>(stateDuration)) {
+        return 0;
+    }
+    return static_cast<uint32_t>(stateDuration) - elapsedTime;
+}
+
+float TrafficLight::calculateAverageVehicleCount(Lane* al2Lane, int laneTwoCount, int laneTwoVehicles) {
+    // Only lane 2 (normal lanes) count
+    int normalLaneCount = laneTwoCount;
+    int totalVehicleCount = laneTwoVehicles;
 
-    for (auto* lane : lanes) {
-        // Only count lane 2 (normal lanes)
-        // In priority mode, exclude the priority lane (A2) from calculation
-        if (lane->getLaneNumber() == 2 &&
-            !(isPriorityMode && lane->getLaneId() == 'A')) {
-            normalLaneCount++;
-            totalVehicleCount += lane->getVehicleCount();
-        }
+    // In priority mode, exclude the priority lane (A2) from calculation
+    if (isPriorityMode && al2Lane) {
+        normalLaneCount--;
+        totalVehicleCount -= al2Lane->getVehicleCount();
     }
 
     // Calculate average: |V| = (1/n) * Σ|Li|
@@ -211,7 +270,7 @@ bool TrafficLight::isGreen(char lane) const {
     }
 }
 
-void TrafficLight::render(SDL_Renderer* renderer) {
+void TrafficLight::render(RenderBackend* backend) {
     // Render modern holographic-style traffic light control system
 
     // Constants for positioning
@@ -221,19 +280,19 @@ void TrafficLight::render(SDL_Renderer* renderer) {
     const int CENTER_Y = WINDOW_HEIGHT / 2;
 
     // Draw main traffic control center in top-right corner
-    drawTrafficControlCenter(renderer);
+    drawTrafficControlCenter(backend);
 
     // Draw junction lights (one at each road)
-    drawJunctionLight(renderer, CENTER_X, CENTER_Y - 100, 'A', isGreen('A')); // North (A) light
-    drawJunctionLight(renderer, CENTER_X + 100, CENTER_Y, 'B', isGreen('B')); // East (B) light
-    drawJunctionLight(renderer, CENTER_X, CENTER_Y + 100, 'C', isGreen('C')); // South (C) light
-    drawJunctionLight(renderer, CENTER_X - 100, CENTER_Y, 'D', isGreen('D')); // West (D) light
+    drawJunctionLight(backend, CENTER_X, CENTER_Y - 100, 'A', isGreen('A')); // North (A) light
+    drawJunctionLight(backend, CENTER_X + 100, CENTER_Y, 'B', isGreen('B')); // East (B) light
+    drawJunctionLight(backend, CENTER_X, CENTER_Y + 100, 'C', isGreen('C')); // South (C) light
+    drawJunctionLight(backend, CENTER_X - 100, CENTER_Y, 'D', isGreen('D')); // West (D) light
 
     // Draw the state transition timer
-    drawStateTimer(renderer);
+    drawStateTimer(backend);
 }
 
-void TrafficLight::drawTrafficControlCenter(SDL_Renderer* renderer) {
+void TrafficLight::drawTrafficControlCenter(RenderBackend* backend) {
     // Draw holographic traffic management system display in top-right corner
     const int PANEL_WIDTH = 160;
     const int PANEL_HEIGHT = 160;
@@ -241,55 +300,55 @@ void TrafficLight::drawTrafficControlCenter(SDL_Renderer* renderer) {
     const int PANEL_Y = 20;
 
     // Draw glass-style panel with dark blue semi-transparent background
-    SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_BLEND);
+    backend->setDrawBlendMode(SDL_BLENDMODE_BLEND);
 
     // Panel main background
-    SDL_SetRenderDrawColor(renderer, 10, 20, 40, 180);
+    backend->setDrawColor(10, 20, 40, 180);
     SDL_FRect panel = {
         static_cast<float>(PANEL_X),
         static_cast<float>(PANEL_Y),
         static_cast<float>(PANEL_WIDTH),
         static_cast<float>(PANEL_HEIGHT)
     };
-    SDL_RenderFillRect(renderer, &panel);
+    backend->fillRect(&panel);
 
     // Panel outer glow effect
     for (int i = 1; i <= 3; i++) {
-        SDL_SetRenderDrawColor(renderer, 100, 140, 200, 40 / i);
+        backend->setDrawColor(100, 140, 200, 40 / i);
         SDL_FRect glow = {
             panel.x - i, panel.y - i,
             panel.w + i*2, panel.h + i*2
         };
-        SDL_RenderRect(renderer, &glow);
+        backend->drawRect(&glow);
     }
 
     // Panel border
-    SDL_SetRenderDrawColor(renderer, 100, 140, 200, 255);
-    SDL_RenderRect(renderer, &panel);
+    backend->setDrawColor(100, 140, 200, 255);
+    backend->drawRect(&panel);
 
     // Panel top header
-    SDL_SetRenderDrawColor(renderer, 40, 60, 100, 200);
+    backend->setDrawColor(40, 60, 100, 200);
     SDL_FRect header = {
         panel.x, panel.y,
         panel.w, 25.0f
     };
-    SDL_RenderFillRect(renderer, &header);
+    backend->fillRect(&header);
 
     // Draw "TRAFFIC CONTROL" title
-    SDL_SetRenderDrawColor(renderer, 220, 230, 255, 255);
-    drawPanelText(renderer, "TRAFFIC CONTROL", PANEL_X + PANEL_WIDTH/2 - 55, PANEL_Y + 8);
+    backend->setDrawColor(220, 230, 255, 255);
+    drawPanelText(backend, "TRAFFIC CONTROL", PANEL_X + PANEL_WIDTH/2 - 55, PANEL_Y + 8);
 
     // Inner panel for light status
-    SDL_SetRenderDrawColor(renderer, 20, 30, 50, 200);
+    backend->setDrawColor(20, 30, 50, 200);
     SDL_FRect innerPanel = {
         panel.x + 8, panel.y + 35,
         panel.w - 16, panel.h - 45
     };
-    SDL_RenderFillRect(renderer, &innerPanel);
+    backend->fillRect(&innerPanel);
 
     // Inner panel border
-    SDL_SetRenderDrawColor(renderer, 80, 100, 160, 150);
-    SDL_RenderRect(renderer, &innerPanel);
+    backend->setDrawColor(80, 100, 160, 150);
+    backend->drawRect(&innerPanel);
 
     // Draw road light indicators
     const int LIGHT_SIZE = 18;
@@ -303,8 +362,8 @@ void TrafficLight::drawTrafficControlCenter(SDL_Renderer* renderer) {
         int y = START_Y + i * LIGHT_SPACING;
 
         // Draw road label
-        SDL_SetRenderDrawColor(renderer, 180, 200, 255, 255);
-        drawPanelText(renderer, roads[i], PANEL_X + 15, y);
+        backend->setDrawColor(180, 200, 255, 255);
+        drawPanelText(backend, roads[i], PANEL_X + 15, y);
 
         // Determine light color based on state
         bool isRoad = false;
@@ -316,31 +375,31 @@ void TrafficLight::drawTrafficControlCenter(SDL_Renderer* renderer) {
         }
 
         // Draw holographic light indicator
-        drawHolographicLight(renderer, PANEL_X + PANEL_WIDTH - 30, y, LIGHT_SIZE, isRoad);
+        drawHolographicLight(backend, PANEL_X + PANEL_WIDTH - 30, y, LIGHT_SIZE, isRoad);
     }
 
     // Draw priority mode indicator if active
     if (isPriorityMode) {
         // Flashing priority alert
-        uint32_t time = SDL_GetTicks();
+        uint32_t time = static_cast<uint32_t>(backend->getTicks());
         bool flash = (time / 500) % 2 == 0;
 
-        SDL_SetRenderDrawColor(renderer, flash ? 255 : 200, flash ? 140 : 100, 0, 200);
+        backend->setDrawColor(flash ? 255 : 200, flash ? 140 : 100, 0, 200);
         SDL_FRect priorityBox = {
             panel.x + 10, panel.y + panel.h - 30,
             panel.w - 20, 20.0f
         };
-        SDL_RenderFillRect(renderer, &priorityBox);
+        backend->fillRect(&priorityBox);
 
         // Priority text
-        SDL_SetRenderDrawColor(renderer, 255, 255, 255, 255);
-        drawPanelText(renderer, "PRIORITY MODE: A2", PANEL_X + 20, PANEL_Y + PANEL_HEIGHT - 25);
+        backend->setDrawColor(255, 255, 255, 255);
+        drawPanelText(backend, "PRIORITY MODE: A2", PANEL_X + 20, PANEL_Y + PANEL_HEIGHT - 25);
     }
 
-    SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_NONE);
+    backend->setDrawBlendMode(SDL_BLENDMODE_NONE);
 }
 
-void TrafficLight::drawJunctionLight(SDL_Renderer* renderer, int x, int y, char roadId, bool isGreen) {
+void TrafficLight::drawJunctionLight(RenderBackend* backend, int x, int y, char roadId, bool isGreen) {
     // Draw futuristic traffic light on the roads
     const int LIGHT_WIDTH = 30;
     const int LIGHT_HEIGHT = 50;
@@ -370,20 +429,20 @@ void TrafficLight::drawJunctionLight(SDL_Renderer* renderer, int x, int y, char
     }
 
     // Draw light housing
-    SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_BLEND);
+    backend->setDrawBlendMode(SDL_BLENDMODE_BLEND);
 
     // Light housing (dark)
-    SDL_SetRenderDrawColor(renderer, 40, 40, 50, 220);
+    backend->setDrawColor(40, 40, 50, 220);
     SDL_FRect housing = {
         posX, posY,
         static_cast<float>(LIGHT_WIDTH),
         static_cast<float>(LIGHT_HEIGHT)
     };
-    SDL_RenderFillRect(renderer, &housing);
+    backend->fillRect(&housing);
 
     // Housing border
-    SDL_SetRenderDrawColor(renderer, 80, 80, 100, 255);
-    SDL_RenderRect(renderer, &housing);
+    backend->setDrawColor(80, 80, 100, 255);
+    backend->drawRect(&housing);
 
     // Light lens
     float lensSize = 20.0f;
@@ -391,76 +450,76 @@ void TrafficLight::drawJunctionLight(SDL_Renderer* renderer, int x, int y, char
     float lensY = posY + (LIGHT_HEIGHT - lensSize) / 2;
 
     // Draw lens background
-    SDL_SetRenderDrawColor(renderer, 30, 30, 35, 255);
+    backend->setDrawColor(30, 30, 35, 255);
     SDL_FRect lens = {
         lensX, lensY,
         lensSize, lensSize
     };
-    SDL_RenderFillRect(renderer, &lens);
+    backend->fillRect(&lens);
 
     // Draw active light (red or green)
     if (isGreen) {
         // Green with glow effect
         // Inner bright glow
-        SDL_SetRenderDrawColor(renderer, 100, 255, 100, 255);
+        backend->setDrawColor(100, 255, 100, 255);
         SDL_FRect greenLight = {
             lensX + 2, lensY + 2,
             lensSize - 4, lensSize - 4
         };
-        SDL_RenderFillRect(renderer, &greenLight);
+        backend->fillRect(&greenLight);
 
         // Add inner highlight
-        SDL_SetRenderDrawColor(renderer, 180, 255, 180, 200);
+        backend->setDrawColor(180, 255, 180, 200);
         SDL_FRect greenHighlight = {
             lensX + 4, lensY + 4,
             lensSize/2, lensSize/2
         };
-        SDL_RenderFillRect(renderer, &greenHighlight);
+        backend->fillRect(&greenHighlight);
 
         // Outer glow
         for (int i = 1; i <= 5; i++) {
-            SDL_SetRenderDrawColor(renderer, 100, 255, 100, 200 / i);
+            backend->setDrawColor(100, 255, 100, 200 / i);
             SDL_FRect greenGlow = {
                 lensX - i, lensY - i,
                 lensSize + i*2, lensSize + i*2
             };
-            SDL_RenderRect(renderer, &greenGlow);
+            backend->drawRect(&greenGlow);
         }
     } else {
         // Red with glow effect
         // Inner bright glow
-        SDL_SetRenderDrawColor(renderer, 255, 50, 50, 255);
+        backend->setDrawColor(255, 50, 50, 255);
         SDL_FRect redLight = {
             lensX + 2, lensY + 2,
             lensSize - 4, lensSize - 4
         };
-        SDL_RenderFillRect(renderer, &redLight);
+        backend->fillRect(&redLight);
 
         // Add inner highlight
-        SDL_SetRenderDrawColor(renderer, 255, 150, 150, 200);
+        backend->setDrawColor(255, 150, 150, 200);
         SDL_FRect redHighlight = {
             lensX + 4, lensY + 4,
             lensSize/2, lensSize/2
         };
-        SDL_RenderFillRect(renderer, &redHighlight);
+        backend->fillRect(&redHighlight);
 
         // Outer glow
         for (int i = 1; i <= 5; i++) {
-            SDL_SetRenderDrawColor(renderer, 255, 50, 50, 200 / i);
+            backend->setDrawColor(255, 50, 50, 200 / i);
             SDL_FRect redGlow = {
                 lensX - i, lensY - i,
                 lensSize + i*2, lensSize + i*2
             };
-            SDL_RenderRect(renderer, &redGlow);
+            backend->drawRect(&redGlow);
         }
     }
 
     // Draw lens border
-    SDL_SetRenderDrawColor(renderer, 100, 100, 120, 255);
-    SDL_RenderRect(renderer, &lens);
+    backend->setDrawColor(100, 100, 120, 255);
+    backend->drawRect(&lens);
 
     // Draw road identifier
-    SDL_SetRenderDrawColor(renderer, 200, 220, 255, 255);
+    backend->setDrawColor(200, 220, 255, 255);
     char roadChar[2] = {roadId, '\0'};
 
     // Position depends on road
@@ -484,14 +543,14 @@ void TrafficLight::drawJunctionLight(SDL_Renderer* renderer, int x, int y, char
             break;
     }
 
-    drawPanelText(renderer, roadChar, textX, textY);
+    drawPanelText(backend, roadChar, textX, textY);
 
-    SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_NONE);
+    backend->setDrawBlendMode(SDL_BLENDMODE_NONE);
 }
 
-void TrafficLight::drawStateTimer(SDL_Renderer* renderer) {
+void TrafficLight::drawStateTimer(RenderBackend* backend) {
     // Draw a timer showing state progression with animation
-    uint32_t currentTime = SDL_GetTicks();
+    uint32_t currentTime = static_cast<uint32_t>(backend->getTicks());
     uint32_t elapsedTime = currentTime - lastStateChangeTime;
 
     // Calculate state duration
@@ -499,11 +558,11 @@ void TrafficLight::drawStateTimer(SDL_Renderer* renderer) {
     if (currentState == State::ALL_RED) {
         stateDuration = allRedDuration;
     } else if (isPriorityMode && currentState == State::A_GREEN) {
-        stateDuration = 6000; // 6 seconds in priority mode
+        stateDuration = priorityGreenDuration;
     } else {
         float avgVehicleCount = 5.0f; // Default fallback
         stateDuration = static_cast<int>(avgVehicleCount * 2000);
-        stateDuration = std::max(3000, std::min(stateDuration, 15000));
+        stateDuration = std::max(minGreenDuration, std::min(stateDuration, 15000));
     }
 
     // Calculate progress (0.0 to 1.0)
@@ -516,13 +575,12 @@ void TrafficLight::drawStateTimer(SDL_Renderer* renderer) {
     const int RADIUS = 30;
 
     // Draw background circle
-    SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_BLEND);
-    SDL_SetRenderDrawColor(renderer, 30, 40, 60, 200);
+    backend->setDrawBlendMode(SDL_BLENDMODE_BLEND);
+    backend->setDrawColor(30, 40, 60, 200);
 
     for (int i = 0; i < 360; i += 5) {
         float radian = i * M_PI / 180.0f;
-        SDL_RenderLine(renderer,
-                      CENTER_X, CENTER_Y,
+        backend->drawLine(CENTER_X, CENTER_Y,
                       CENTER_X + RADIUS * cosf(radian),
                       CENTER_Y + RADIUS * sinf(radian));
     }
@@ -545,20 +603,18 @@ void TrafficLight::drawStateTimer(SDL_Renderer* renderer) {
     }
 
     // Draw the arc segments
-    SDL_SetRenderDrawColor(renderer, arcColor.r, arcColor.g, arcColor.b, arcColor.a);
+    backend->setDrawColor(arcColor.r, arcColor.g, arcColor.b, arcColor.a);
 
     for (int i = 0; i < progressDegrees; i += 2) {
         float radian = i * M_PI / 180.0f;
-        SDL_RenderLine(renderer,
-                      CENTER_X, CENTER_Y,
+        backend->drawLine(CENTER_X, CENTER_Y,
                       CENTER_X + RADIUS * cosf(radian),
                       CENTER_Y + RADIUS * sinf(radian));
     }
 
     // Draw a clock hand for visual effect
     float handRadian = progressDegrees * M_PI / 180.0f;
-    SDL_RenderLine(renderer,
-                  CENTER_X, CENTER_Y,
+    backend->drawLine(CENTER_X, CENTER_Y,
                   CENTER_X + (RADIUS-5) * cosf(handRadian),
                   CENTER_Y + (RADIUS-5) * sinf(handRadian));
 
@@ -566,450 +622,403 @@ void TrafficLight::drawStateTimer(SDL_Renderer* renderer) {
     int secondsRemaining = (stateDuration - elapsedTime) / 1000 + 1;
     std::string timeStr = std::to_string(secondsRemaining) + "s";
 
-    SDL_SetRenderDrawColor(renderer, 220, 230, 255, 255);
-    drawPanelText(renderer, timeStr.c_str(), CENTER_X - 8, CENTER_Y - 5);
+    backend->setDrawColor(220, 230, 255, 255);
+    drawPanelText(backend, timeStr.c_str(), CENTER_X - 8, CENTER_Y - 5);
 
-    SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_NONE);
+    backend->setDrawBlendMode(SDL_BLENDMODE_NONE);
 }
 
-void TrafficLight::drawHolographicLight(SDL_Renderer* renderer, int x, int y, int size, bool isActive) {
+void TrafficLight::drawHolographicLight(RenderBackend* backend, int x, int y, int size, bool isActive) {
     // Draw a holographic light indicator
-    SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_BLEND);
+    backend->setDrawBlendMode(SDL_BLENDMODE_BLEND);
 
     // Flickering effect for hologram
-    uint32_t time = SDL_GetTicks();
+    uint32_t time = static_cast<uint32_t>(backend->getTicks());
     float flicker = 0.8f + 0.2f * sin(time * 0.01f);
 
     // Background
-    SDL_SetRenderDrawColor(renderer, 30, 40, 60, 200);
+    backend->setDrawColor(30, 40, 60, 200);
     SDL_FRect lightBg = {
         static_cast<float>(x - size/2),
         static_cast<float>(y - size/2),
         static_cast<float>(size),
         static_cast<float>(size)
     };
-    SDL_RenderFillRect(renderer, &lightBg);
-
-    // Light state
-    if (isActive) {
-        // Active green light
-        SDL_SetRenderDrawColor(renderer,
-                               static_cast<Uint8>(100 * flicker),
-                               static_cast<Uint8>(255 * flicker),
-                               static_cast<Uint8>(100 * flicker),
-                               200);
-
-        // Inner light
-        SDL_FRect innerLight = {
-            lightBg.x + 2, lightBg.y + 2,
-            lightBg.w - 4, lightBg.h - 4
-        };
-        SDL_RenderFillRect(renderer, &innerLight);
-
-        // Glow
-        for (int i = 1; i <= 3; i++) {
-            SDL_SetRenderDrawColor(renderer, 100, 255, 100, static_cast<Uint8>(100/i * flicker));
-            SDL_FRect glow = {
-                lightBg.x - i, lightBg.y - i,
-                lightBg.w + i*2, lightBg.h + i*2
-            };
-            SDL_RenderRect(renderer, &glow);
-        }
-    } else {
-        // Inactive red light
-        SDL_SetRenderDrawColor(renderer,
-                               static_cast<Uint8>(255 * flicker),
-                               static_cast<Uint8>(80 * flicker),
-                               static_cast<Uint8>(80 * flicker),
-                               200);
-
-        // Inner light
-        SDL_FRect innerLight = {
-            lightBg.x + 2, lightBg.y + 2,
-            lightBg.w - 4, lightBg.h - 4
-        };
-        SDL_RenderFillRect(renderer, &innerLight);
-
-        // Glow
-        for (int i = 1; i <= 3; i++) {
-            SDL_SetRenderDrawColor(renderer, 255, 80, 80, static_cast<Uint8>(100/i * flicker));
-            SDL_FRect glow = {
-                lightBg.x - i, lightBg.y - i,
-                lightBg.w + i*2, lightBg.h + i*2
-            };
-            SDL_RenderRect(renderer, &glow);
-        }
-    }
+    backend->fillRect(&lightBg);
+
+    // Inner light and glow: green when active, red otherwise
+    SDL_Color lightColor = isActive ? SDL_Color{100, 255, 100, 200} : SDL_Color{255, 80, 80, 200};
+    GlowTextures::forBackend(backend)->drawLight(x, y, size, lightColor, flicker);
 
     // Border
-    SDL_SetRenderDrawColor(renderer, 100, 140, 200, 255);
-    SDL_RenderRect(renderer, &lightBg);
+    backend->setDrawColor(100, 140, 200, 255);
+    backend->drawRect(&lightBg);
 
-    SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_NONE);
+    backend->setDrawBlendMode(SDL_BLENDMODE_NONE);
 }
 
-void TrafficLight::drawPanelText(SDL_Renderer* renderer, const char* text, int x, int y) {
+void TrafficLight::drawPanelText(RenderBackend* backend, const char* text, int x, int y) {
     // Simplified text drawing for the panel
-    SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_BLEND);
+    backend->setDrawBlendMode(SDL_BLENDMODE_BLEND);
 
     // Draw characters
     for (int i = 0; text[i] != '\0'; i++) {
-        drawPanelChar(renderer, text[i], x + i*8, y);
+        drawPanelChar(backend, text[i], x + i*8, y);
     }
 
-    SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_NONE);
+    backend->setDrawBlendMode(SDL_BLENDMODE_NONE);
 }
 
-void TrafficLight::drawPanelChar(SDL_Renderer* renderer, char c, int x, int y) {
+void TrafficLight::drawPanelChar(RenderBackend* backend, char c, int x, int y) {
     // Simplified monospaced character drawing
     switch (c) {
         case 'A':
-            SDL_RenderLine(renderer, x+3, y, x, y+9);      // Left diagonal
-            SDL_RenderLine(renderer, x+3, y, x+6, y+9);    // Right diagonal
-            SDL_RenderLine(renderer, x+1, y+6, x+5, y+6);  // Middle
+            backend->drawLine(x+3, y, x, y+9);      // Left diagonal
+            backend->drawLine(x+3, y, x+6, y+9);    // Right diagonal
+            backend->drawLine(x+1, y+6, x+5, y+6);  // Middle
             break;
         case 'B':
-            SDL_RenderLine(renderer, x, y, x, y+9);        // Left vertical
-            SDL_RenderLine(renderer, x, y, x+4, y);        // Top
-            SDL_RenderLine(renderer, x+4, y, x+5, y+2);    // Top curve
-            SDL_RenderLine(renderer, x+5, y+2, x+4, y+4);  // Middle top
-            SDL_RenderLine(renderer, x, y+4, x+4, y+4);    // Middle
-            SDL_RenderLine(renderer, x+4, y+4, x+5, y+7);  // Middle bottom
-            SDL_RenderLine(renderer, x+5, y+7, x+4, y+9);  // Bottom curve
-            SDL_RenderLine(renderer, x+4, y+9, x, y+9);    // Bottom
+            backend->drawLine(x, y, x, y+9);        // Left vertical
+            backend->drawLine(x, y, x+4, y);        // Top
+            backend->drawLine(x+4, y, x+5, y+2);    // Top curve
+            backend->drawLine(x+5, y+2, x+4, y+4);  // Middle top
+            backend->drawLine(x, y+4, x+4, y+4);    // Middle
+            backend->drawLine(x+4, y+4, x+5, y+7);  // Middle bottom
+            backend->drawLine(x+5, y+7, x+4, y+9);  // Bottom curve
+            backend->drawLine(x+4, y+9, x, y+9);    // Bottom
             break;
         case 'C':
-            SDL_RenderLine(renderer, x+5, y+2, x+2, y);    // Top right
-            SDL_RenderLine(renderer, x+2, y, x, y+2);      // Top left
-            SDL_RenderLine(renderer, x, y+2, x, y+7);      // Left
-            SDL_RenderLine(renderer, x, y+7, x+2, y+9);    // Bottom left
-            SDL_RenderLine(renderer, x+2, y+9, x+5, y+7);  // Bottom right
+            backend->drawLine(x+5, y+2, x+2, y);    // Top right
+            backend->drawLine(x+2, y, x, y+2);      // Top left
+            backend->drawLine(x, y+2, x, y+7);      // Left
+            backend->drawLine(x, y+7, x+2, y+9);    // Bottom left
+            backend->drawLine(x+2, y+9, x+5, y+7);  // Bottom right
             break;
         case 'D':
-            SDL_RenderLine(renderer, x, y, x, y+9);        // Left vertical
-            SDL_RenderLine(renderer, x, y, x+3, y);        // Top
-            SDL_RenderLine(renderer, x+3, y, x+5, y+2);    // Top right
-            SDL_RenderLine(renderer, x+5, y+2, x+5, y+7);  // Right
-            SDL_RenderLine(renderer, x+5, y+7, x+3, y+9);  // Bottom right
-            SDL_RenderLine(renderer, x+3, y+9, x, y+9);    // Bottom
+            backend->drawLine(x, y, x, y+9);        // Left vertical
+            backend->drawLine(x, y, x+3, y);        // Top
+            backend->drawLine(x+3, y, x+5, y+2);    // Top right
+            backend->drawLine(x+5, y+2, x+5, y+7);  // Right
+            backend->drawLine(x+5, y+7, x+3, y+9);  // Bottom right
+            backend->drawLine(x+3, y+9, x, y+9);    // Bottom
             break;
         case 'E':
-            SDL_RenderLine(renderer, x, y, x, y+9);        // Vertical
-            SDL_RenderLine(renderer, x, y, x+5, y);        // Top
-            SDL_RenderLine(renderer, x, y+4, x+4, y+4);    // Middle
-            SDL_RenderLine(renderer, x, y+9, x+5, y+9);    // Bottom
+            backend->drawLine(x, y, x, y+9);        // Vertical
+            backend->drawLine(x, y, x+5, y);        // Top
+            backend->drawLine(x, y+4, x+4, y+4);    // Middle
+            backend->drawLine(x, y+9, x+5, y+9);    // Bottom
             break;
         case 'F':
-            SDL_RenderLine(renderer, x, y, x, y+9);        // Vertical
-            SDL_RenderLine(renderer, x, y, x+5, y);        // Top
-            SDL_RenderLine(renderer, x, y+4, x+4, y+4);    // Middle
+            backend->drawLine(x, y, x, y+9);        // Vertical
+            backend->drawLine(x, y, x+5, y);        // Top
+            backend->drawLine(x, y+4, x+4, y+4);    // Middle
             break;
         case 'G':
-            SDL_RenderLine(renderer, x+5, y+2, x+2, y);    // Top right
-            SDL_RenderLine(renderer, x+2, y, x, y+2);      // Top left
-            SDL_RenderLine(renderer, x, y+2, x, y+7);      // Left
-            SDL_RenderLine(renderer, x, y+7, x+2, y+9);    // Bottom left
-            SDL_RenderLine(renderer, x+2, y+9, x+5, y+7);  // Bottom right
-            SDL_RenderLine(renderer, x+5, y+7, x+5, y+5);  // Right
-            SDL_RenderLine(renderer, x+5, y+5, x+3, y+5);  // G hook
+            backend->drawLine(x+5, y+2, x+2, y);    // Top right
+            backend->drawLine(x+2, y, x, y+2);      // Top left
+            backend->drawLine(x, y+2, x, y+7);      // Left
+            backend->drawLine(x, y+7, x+2, y+9);    // Bottom left
+            backend->drawLine(x+2, y+9, x+5, y+7);  // Bottom right
+            backend->drawLine(x+5, y+7, x+5, y+5);  // Right
+            backend->drawLine(x+5, y+5, x+3, y+5);  // G hook
             break;
         case 'H':
-            SDL_RenderLine(renderer, x, y, x, y+9);        // Left vertical
-            SDL_RenderLine(renderer, x+5, y, x+5, y+9);    // Right vertical
-            SDL_RenderLine(renderer, x, y+4, x+5, y+4);    // Middle
+            backend->drawLine(x, y, x, y+9);        // Left vertical
+            backend->drawLine(x+5, y, x+5, y+9);    // Right vertical
+            backend->drawLine(x, y+4, x+5, y+4);    // Middle
             break;
         case 'I':
-            SDL_RenderLine(renderer, x+2, y, x+2, y+9);    // Vertical
+            backend->drawLine(x+2, y, x+2, y+9);    // Vertical
             break;
         case 'L':
-            SDL_RenderLine(renderer, x, y, x, y+9);        // Vertical
-            SDL_RenderLine(renderer, x, y+9, x+5, y+9);    // Bottom
+            backend->drawLine(x, y, x, y+9);        // Vertical
+            backend->drawLine(x, y+9, x+5, y+9);    // Bottom
             break;
         case 'M':
-            SDL_RenderLine(renderer, x, y, x, y+9);        // Left vertical
-            SDL_RenderLine(renderer, x+5, y, x+5, y+9);    // Right vertical
-            SDL_RenderLine(renderer, x, y, x+2, y+5);      // Left diagonal
-            SDL_RenderLine(renderer, x+5, y, x+3, y+5);    // Right diagonal
+            backend->drawLine(x, y, x, y+9);        // Left vertical
+            backend->drawLine(x+5, y, x+5, y+9);    // Right vertical
+            backend->drawLine(x, y, x+2, y+5);      // Left diagonal
+            backend->drawLine(x+5, y, x+3, y+5);    // Right diagonal
             break;
         case 'N':
-            SDL_RenderLine(renderer, x, y, x, y+9);        // Left vertical
-            SDL_RenderLine(renderer, x+5, y, x+5, y+9);    // Right vertical
-            SDL_RenderLine(renderer, x, y, x+5, y+9);      // Diagonal
+            backend->drawLine(x, y, x, y+9);        // Left vertical
+            backend->drawLine(x+5, y, x+5, y+9);    // Right vertical
+            backend->drawLine(x, y, x+5, y+9);      // Diagonal
             break;
         case 'O':
-            SDL_RenderLine(renderer, x+2, y, x+3, y);      // Top
-            SDL_RenderLine(renderer, x, y+2, x, y+7);      // Left
-            SDL_RenderLine(renderer, x+2, y+9, x+3, y+9);  // Bottom
-            SDL_RenderLine(renderer, x+5, y+2, x+5, y+7);  // Right
-            SDL_RenderLine(renderer, x+2, y, x, y+2);      // Top left
-            SDL_RenderLine(renderer, x+3, y, x+5, y+2);    // Top right
-            SDL_RenderLine(renderer, x, y+7, x+2, y+9);    // Bottom left
-            SDL_RenderLine(renderer, x+5, y+7, x+3, y+9);  // Bottom right
+            backend->drawLine(x+2, y, x+3, y);      // Top
+            backend->drawLine(x, y+2, x, y+7);      // Left
+            backend->drawLine(x+2, y+9, x+3, y+9);  // Bottom
+            backend->drawLine(x+5, y+2, x+5, y+7);  // Right
+            backend->drawLine(x+2, y, x, y+2);      // Top left
+            backend->drawLine(x+3, y, x+5, y+2);    // Top right
+            backend->drawLine(x, y+7, x+2, y+9);    // Bottom left
+            backend->drawLine(x+5, y+7, x+3, y+9);  // Bottom right
             break;
         case 'P':
-            SDL_RenderLine(renderer, x, y, x, y+9);        // Vertical
-            SDL_RenderLine(renderer, x, y, x+3, y);        // Top
-            SDL_RenderLine(renderer, x+3, y, x+5, y+2);    // Top curve
-            SDL_RenderLine(renderer, x+5, y+2, x+3, y+5);  // Bottom curve
-            SDL_RenderLine(renderer, x+3, y+5, x, y+5);    // Bottom
+            backend->drawLine(x, y, x, y+9);        // Vertical
+            backend->drawLine(x, y, x+3, y);        // Top
+            backend->drawLine(x+3, y, x+5, y+2);    // Top curve
+            backend->drawLine(x+5, y+2, x+3, y+5);  // Bottom curve
+            backend->drawLine(x+3, y+5, x, y+5);    // Bottom
             break;
         case 'R':
-            SDL_RenderLine(renderer, x, y, x, y+9);        // Vertical
-            SDL_RenderLine(renderer, x, y, x+3, y);        // Top
-            SDL_RenderLine(renderer, x+3, y, x+5, y+2);    // Top curve
-            SDL_RenderLine(renderer, x+5, y+2, x+3, y+5);  // Bottom curve
-            SDL_RenderLine(renderer, x+3, y+5, x, y+5);    // Middle
-            SDL_RenderLine(renderer, x+2, y+5, x+5, y+9);  // Diagonal
+            backend->drawLine(x, y, x, y+9);        // Vertical
+            backend->drawLine(x, y, x+3, y);        // Top
+            backend->drawLine(x+3, y, x+5, y+2);    // Top curve
+            backend->drawLine(x+5, y+2, x+3, y+5);  // Bottom curve
+            backend->drawLine(x+3, y+5, x, y+5);    // Middle
+            backend->drawLine(x+2, y+5, x+5, y+9);  // Diagonal
             break;
         case 'S':
-            SDL_RenderLine(renderer, x+5, y+2, x+2, y);    // Top right
-            SDL_RenderLine(renderer, x+2, y, x, y+2);      // Top left
-            SDL_RenderLine(renderer, x, y+2, x+2, y+4);    // Middle left
-            SDL_RenderLine(renderer, x+2, y+4, x+3, y+4);  // Middle
-            SDL_RenderLine(renderer, x+3, y+4, x+5, y+6);  // Middle right
-            SDL_RenderLine(renderer, x+5, y+6, x+3, y+9);  // Bottom right
-            SDL_RenderLine(renderer, x+3, y+9, x, y+7);    // Bottom left
+            backend->drawLine(x+5, y+2, x+2, y);    // Top right
+            backend->drawLine(x+2, y, x, y+2);      // Top left
+            backend->drawLine(x, y+2, x+2, y+4);    // Middle left
+            backend->drawLine(x+2, y+4, x+3, y+4);  // Middle
+            backend->drawLine(x+3, y+4, x+5, y+6);  // Middle right
+            backend->drawLine(x+5, y+6, x+3, y+9);  // Bottom right
+            backend->drawLine(x+3, y+9, x, y+7);    // Bottom left
             break;
         case 'T':
-            SDL_RenderLine(renderer, x, y, x+5, y);        // Top
-            SDL_RenderLine(renderer, x+2, y, x+2, y+9);    // Vertical
+            backend->drawLine(x, y, x+5, y);        // Top
+            backend->drawLine(x+2, y, x+2, y+9);    // Vertical
             break;
         case 'Y':
-            SDL_RenderLine(renderer, x, y, x+2, y+4);      // Left diagonal
-            SDL_RenderLine(renderer, x+5, y, x+3, y+4);    // Right diagonal
-            SDL_RenderLine(renderer, x+2, y+4, x+2, y+9);  // Bottom vertical
+            backend->drawLine(x, y, x+2, y+4);      // Left diagonal
+            backend->drawLine(x+5, y, x+3, y+4);    // Right diagonal
+            backend->drawLine(x+2, y+4, x+2, y+9);  // Bottom vertical
             break;
         case '0':
-            SDL_RenderLine(renderer, x+2, y, x+3, y);      // Top
-            SDL_RenderLine(renderer, x, y+2, x, y+7);      // Left
-            SDL_RenderLine(renderer, x+2, y+9, x+3, y+9);  // Bottom
-            SDL_RenderLine(renderer, x+5, y+2, x+5, y+7);  // Right
-            SDL_RenderLine(renderer, x+2, y, x, y+2);      // Top left
-            SDL_RenderLine(renderer, x+3, y, x+5, y+2);    // Top right
-            SDL_RenderLine(renderer, x, y+7, x+2, y+9);    // Bottom left
-            SDL_RenderLine(renderer, x+5, y+7, x+3, y+9);  // Bottom right
+            backend->drawLine(x+2, y, x+3, y);      // Top
+            backend->drawLine(x, y+2, x, y+7);      // Left
+            backend->drawLine(x+2, y+9, x+3, y+9);  // Bottom
+            backend->drawLine(x+5, y+2, x+5, y+7);  // Right
+            backend->drawLine(x+2, y, x, y+2);      // Top left
+            backend->drawLine(x+3, y, x+5, y+2);    // Top right
+            backend->drawLine(x, y+7, x+2, y+9);    // Bottom left
+            backend->drawLine(x+5, y+7, x+3, y+9);  // Bottom right
             break;
         case '1':
-            SDL_RenderLine(renderer, x+2, y, x+2, y+9);    // Vertical
-            SDL_RenderLine(renderer, x+1, y+2, x+2, y);    // Diagonal
+            backend->drawLine(x+2, y, x+2, y+9);    // Vertical
+            backend->drawLine(x+1, y+2, x+2, y);    // Diagonal
             break;
         case '2':
-            SDL_RenderLine(renderer, x+1, y+1, x+2, y);    // Top left curve
-            SDL_RenderLine(renderer, x+2, y, x+4, y);      // Top
-            SDL_RenderLine(renderer, x+4, y, x+5, y+2);    // Top right curve
-            SDL_RenderLine(renderer, x+5, y+2, x+3, y+5);  // Middle curve
-            SDL_RenderLine(renderer, x+3, y+5, x, y+9);    // Bottom left diagonal
-            SDL_RenderLine(renderer, x, y+9, x+5, y+9);    // Bottom
+            backend->drawLine(x+1, y+1, x+2, y);    // Top left curve
+            backend->drawLine(x+2, y, x+4, y);      // Top
+            backend->drawLine(x+4, y, x+5, y+2);    // Top right curve
+            backend->drawLine(x+5, y+2, x+3, y+5);  // Middle curve
+            backend->drawLine(x+3, y+5, x, y+9);    // Bottom left diagonal
+            backend->drawLine(x, y+9, x+5, y+9);    // Bottom
             break;
         case '3':
-            SDL_RenderLine(renderer, x+1, y+1, x+3, y);    // Top left curve
-            SDL_RenderLine(renderer, x+3, y, x+4, y+1);    // Top right curve
-            SDL_RenderLine(renderer, x+4, y+1, x+3, y+4);  // Middle top curve
-            SDL_RenderLine(renderer, x+3, y+4, x+4, y+5);  // Middle bottom curve
-            SDL_RenderLine(renderer, x+4, y+5, x+3, y+8);  // Bottom right curve
-            SDL_RenderLine(renderer, x+3, y+8, x+1, y+9);  // Bottom left curve
-            SDL_RenderLine(renderer, x+2, y+4, x+3, y+4);  // Middle connect
+            backend->drawLine(x+1, y+1, x+3, y);    // Top left curve
+            backend->drawLine(x+3, y, x+4, y+1);    // Top right curve
+            backend->drawLine(x+4, y+1, x+3, y+4);  // Middle top curve
+            backend->drawLine(x+3, y+4, x+4, y+5);  // Middle bottom curve
+            backend->drawLine(x+4, y+5, x+3, y+8);  // Bottom right curve
+            backend->drawLine(x+3, y+8, x+1, y+9);  // Bottom left curve
+            backend->drawLine(x+2, y+4, x+3, y+4);  // Middle connect
             break;
         case '4':
-            SDL_RenderLine(renderer, x+4, y, x+4, y+9);    // Right vertical
-            SDL_RenderLine(renderer, x+4, y, x, y+6);      // Diagonal
-            SDL_RenderLine(renderer, x, y+6, x+5, y+6);    // Horizontal
+            backend->drawLine(x+4, y, x+4, y+9);    // Right vertical
+            backend->drawLine(x+4, y, x, y+6);      // Diagonal
+            backend->drawLine(x, y+6, x+5, y+6);    // Horizontal
             break;
         case '5':
-            SDL_RenderLine(renderer, x+5, y, x, y);        // Top
-            SDL_RenderLine(renderer, x, y, x, y+4);        // Left vertical
-            SDL_RenderLine(renderer, x, y+4, x+4, y+4);    // Middle
-            SDL_RenderLine(renderer, x+4, y+4, x+5, y+6);  // Middle right curve
-            SDL_RenderLine(renderer, x+5, y+6, x+4, y+9);  // Bottom right curve
-            SDL_RenderLine(renderer, x+4, y+9, x, y+9);    // Bottom
+            backend->drawLine(x+5, y, x, y);        // Top
+            backend->drawLine(x, y, x, y+4);        // Left vertical
+            backend->drawLine(x, y+4, x+4, y+4);    // Middle
+            backend->drawLine(x+4, y+4, x+5, y+6);  // Middle right curve
+            backend->drawLine(x+5, y+6, x+4, y+9);  // Bottom right curve
+            backend->drawLine(x+4, y+9, x, y+9);    // Bottom
             break;
         case '6':
-            SDL_RenderLine(renderer, x+5, y+1, x+3, y);    // Top right curve
-            SDL_RenderLine(renderer, x+3, y, x+1, y+1);    // Top left curve
-            SDL_RenderLine(renderer, x+1, y+1, x, y+3);    // Upper left curve
-            SDL_RenderLine(renderer, x, y+3, x, y+7);      // Left vertical
-            SDL_RenderLine(renderer, x, y+7, x+2, y+9);    // Bottom left curve
-            SDL_RenderLine(renderer, x+2, y+9, x+4, y+8);  // Bottom curve
-            SDL_RenderLine(renderer, x+4, y+8, x+5, y+6);  // Bottom right curve
-            SDL_RenderLine(renderer, x+5, y+6, x+4, y+4);  // Middle right curve
-            SDL_RenderLine(renderer, x+4, y+4, x, y+4);    // Middle
+            backend->drawLine(x+5, y+1, x+3, y);    // Top right curve
+            backend->drawLine(x+3, y, x+1, y+1);    // Top left curve
+            backend->drawLine(x+1, y+1, x, y+3);    // Upper left curve
+            backend->drawLine(x, y+3, x, y+7);      // Left vertical
+            backend->drawLine(x, y+7, x+2, y+9);    // Bottom left curve
+            backend->drawLine(x+2, y+9, x+4, y+8);  // Bottom curve
+            backend->drawLine(x+4, y+8, x+5, y+6);  // Bottom right curve
+            backend->drawLine(x+5, y+6, x+4, y+4);  // Middle right curve
+            backend->drawLine(x+4, y+4, x, y+4);    // Middle
             break;
         case '7':
-            SDL_RenderLine(renderer, x, y, x+5, y);        // Top
-            SDL_RenderLine(renderer, x+5, y, x+2, y+9);    // Diagonal
+            backend->drawLine(x, y, x+5, y);        // Top
+            backend->drawLine(x+5, y, x+2, y+9);    // Diagonal
             break;
         case '8':
-            SDL_RenderLine(renderer, x+1, y+1, x+2, y);    // Top left curve
-            SDL_RenderLine(renderer, x+2, y, x+3, y);      // Top
-            SDL_RenderLine(renderer, x+3, y, x+4, y+1);    // Top right curve
-            SDL_RenderLine(renderer, x+4, y+1, x+4, y+3);  // Upper right vertical
-            SDL_RenderLine(renderer, x+4, y+3, x+3, y+4);  // Middle top right
-            SDL_RenderLine(renderer, x+3, y+4, x+2, y+4);  // Middle
-            SDL_RenderLine(renderer, x+2, y+4, x+1, y+3);  // Middle top left
-            SDL_RenderLine(renderer, x+1, y+3, x+1, y+1);  // Upper left vertical
-            SDL_RenderLine(renderer, x+1, y+5, x+2, y+4);  // Middle bottom left
-            SDL_RenderLine(renderer, x+2, y+4, x+3, y+4);  // Middle
-            SDL_RenderLine(renderer, x+3, y+4, x+4, y+5);  // Middle bottom right
-            SDL_RenderLine(renderer, x+4, y+5, x+4, y+7);  // Lower right vertical
-            SDL_RenderLine(renderer, x+4, y+7, x+3, y+9);  // Bottom right curve
-            SDL_RenderLine(renderer, x+3, y+9, x+2, y+9);  // Bottom
-            SDL_RenderLine(renderer, x+2, y+9, x+1, y+7);  // Bottom left curve
-            SDL_RenderLine(renderer, x+1, y+7, x+1, y+5);  // Lower left vertical
+            backend->drawLine(x+1, y+1, x+2, y);    // Top left curve
+            backend->drawLine(x+2, y, x+3, y);      // Top
+            backend->drawLine(x+3, y, x+4, y+1);    // Top right curve
+            backend->drawLine(x+4, y+1, x+4, y+3);  // Upper right vertical
+            backend->drawLine(x+4, y+3, x+3, y+4);  // Middle top right
+            backend->drawLine(x+3, y+4, x+2, y+4);  // Middle
+            backend->drawLine(x+2, y+4, x+1, y+3);  // Middle top left
+            backend->drawLine(x+1, y+3, x+1, y+1);  // Upper left vertical
+            backend->drawLine(x+1, y+5, x+2, y+4);  // Middle bottom left
+            backend->drawLine(x+2, y+4, x+3, y+4);  // Middle
+            backend->drawLine(x+3, y+4, x+4, y+5);  // Middle bottom right
+            backend->drawLine(x+4, y+5, x+4, y+7);  // Lower right vertical
+            backend->drawLine(x+4, y+7, x+3, y+9);  // Bottom right curve
+            backend->drawLine(x+3, y+9, x+2, y+9);  // Bottom
+            backend->drawLine(x+2, y+9, x+1, y+7);  // Bottom left curve
+            backend->drawLine(x+1, y+7, x+1, y+5);  // Lower left vertical
             break;
         case '9':
-            SDL_RenderLine(renderer, x+1, y+1, x+2, y);    // Top left curve
-            SDL_RenderLine(renderer, x+2, y, x+3, y);      // Top
-            SDL_RenderLine(renderer, x+3, y, x+4, y+1);    // Top right curve
-            SDL_RenderLine(renderer, x+4, y+1, x+5, y+3);  // Upper right curve
-            SDL_RenderLine(renderer, x+5, y+3, x+5, y+7);  // Right vertical
-            SDL_RenderLine(renderer, x+5, y+7, x+3, y+9);  // Bottom right curve
-            SDL_RenderLine(renderer, x+3, y+9, x+1, y+8);  // Bottom curve
-            SDL_RenderLine(renderer, x+1, y+1, x, y+3);    // Upper left curve
-            SDL_RenderLine(renderer, x, y+3, x+1, y+5);    // Middle left curve
-            SDL_RenderLine(renderer, x+1, y+5, x+5, y+5);  // Middle
+            backend->drawLine(x+1, y+1, x+2, y);    // Top left curve
+            backend->drawLine(x+2, y, x+3, y);      // Top
+            backend->drawLine(x+3, y, x+4, y+1);    // Top right curve
+            backend->drawLine(x+4, y+1, x+5, y+3);  // Upper right curve
+            backend->drawLine(x+5, y+3, x+5, y+7);  // Right vertical
+            backend->drawLine(x+5, y+7, x+3, y+9);  // Bottom right curve
+            backend->drawLine(x+3, y+9, x+1, y+8);  // Bottom curve
+            backend->drawLine(x+1, y+1, x, y+3);    // Upper left curve
+            backend->drawLine(x, y+3, x+1, y+5);    // Middle left curve
+            backend->drawLine(x+1, y+5, x+5, y+5);  // Middle
             break;
         case ':':
-            SDL_RenderPoint(renderer, x+2, y+2);           // Top dot
-            SDL_RenderPoint(renderer, x+2, y+7);           // Bottom dot
+            backend->drawPoint(x+2, y+2);           // Top dot
+            backend->drawPoint(x+2, y+7);           // Bottom dot
             break;
         case ' ':
             // Space - do nothing
             break;
         case '-':
-            SDL_RenderLine(renderer, x, y+4, x+4, y+4);    // Middle
+            backend->drawLine(x, y+4, x+4, y+4);    // Middle
             break;
         case '_':
-            SDL_RenderLine(renderer, x, y+9, x+5, y+9);    // Bottom
+            backend->drawLine(x, y+9, x+5, y+9);    // Bottom
             break;
         case '.':
-            SDL_RenderPoint(renderer, x+2, y+9);           // Dot
+            backend->drawPoint(x+2, y+9);           // Dot
             break;
         case ',':
-            SDL_RenderLine(renderer, x+2, y+7, x+1, y+9);  // Comma
+            backend->drawLine(x+2, y+7, x+1, y+9);  // Comma
             break;
         case '!':
-            SDL_RenderLine(renderer, x+2, y, x+2, y+6);    // Vertical
-            SDL_RenderPoint(renderer, x+2, y+9);           // Bottom dot
+            backend->drawLine(x+2, y, x+2, y+6);    // Vertical
+            backend->drawPoint(x+2, y+9);           // Bottom dot
             break;
         case '/':
-            SDL_RenderLine(renderer, x+5, y, x, y+9);      // Diagonal
+            backend->drawLine(x+5, y, x, y+9);      // Diagonal
             break;
         case '\\':
-            SDL_RenderLine(renderer, x, y, x+5, y+9);      // Diagonal
+            backend->drawLine(x, y, x+5, y+9);      // Diagonal
             break;
         case '(':
-            SDL_RenderLine(renderer, x+3, y, x+1, y+4);    // Top curve
-            SDL_RenderLine(renderer, x+1, y+4, x+3, y+9);  // Bottom curve
+            backend->drawLine(x+3, y, x+1, y+4);    // Top curve
+            backend->drawLine(x+1, y+4, x+3, y+9);  // Bottom curve
             break;
         case ')':
-            SDL_RenderLine(renderer, x+1, y, x+3, y+4);    // Top curve
-            SDL_RenderLine(renderer, x+3, y+4, x+1, y+9);  // Bottom curve
+            backend->drawLine(x+1, y, x+3, y+4);    // Top curve
+            backend->drawLine(x+3, y+4, x+1, y+9);  // Bottom curve
             break;
         case '+':
-            SDL_RenderLine(renderer, x, y+4, x+4, y+4);    // Horizontal
-            SDL_RenderLine(renderer, x+2, y+2, x+2, y+7);  // Vertical
+            backend->drawLine(x, y+4, x+4, y+4);    // Horizontal
+            backend->drawLine(x+2, y+2, x+2, y+7);  // Vertical
             break;
         case '=':
-            SDL_RenderLine(renderer, x, y+3, x+4, y+3);    // Top
-            SDL_RenderLine(renderer, x, y+6, x+4, y+6);    // Bottom
+            backend->drawLine(x, y+3, x+4, y+3);    // Top
+            backend->drawLine(x, y+6, x+4, y+6);    // Bottom
             break;
         case '[':
-            SDL_RenderLine(renderer, x+3, y, x+1, y);      // Top
-            SDL_RenderLine(renderer, x+1, y, x+1, y+9);    // Vertical
-            SDL_RenderLine(renderer, x+1, y+9, x+3, y+9);  // Bottom
+            backend->drawLine(x+3, y, x+1, y);      // Top
+            backend->drawLine(x+1, y, x+1, y+9);    // Vertical
+            backend->drawLine(x+1, y+9, x+3, y+9);  // Bottom
             break;
         case ']':
-            SDL_RenderLine(renderer, x+1, y, x+3, y);      // Top
-            SDL_RenderLine(renderer, x+3, y, x+3, y+9);    // Vertical
-            SDL_RenderLine(renderer, x+3, y+9, x+1, y+9);  // Bottom
+            backend->drawLine(x+1, y, x+3, y);      // Top
+            backend->drawLine(x+3, y, x+3, y+9);    // Vertical
+            backend->drawLine(x+3, y+9, x+1, y+9);  // Bottom
             break;
         case '{':
-            SDL_RenderLine(renderer, x+3, y, x+2, y+1);    // Top curve
-            SDL_RenderLine(renderer, x+2, y+1, x+2, y+3);  // Upper vertical
-            SDL_RenderLine(renderer, x+2, y+3, x+1, y+4);  // Middle top curve
-            SDL_RenderLine(renderer, x+1, y+4, x+2, y+5);  // Middle bottom curve
-            SDL_RenderLine(renderer, x+2, y+5, x+2, y+8);  // Lower vertical
-            SDL_RenderLine(renderer, x+2, y+8, x+3, y+9);  // Bottom curve
+            backend->drawLine(x+3, y, x+2, y+1);    // Top curve
+            backend->drawLine(x+2, y+1, x+2, y+3);  // Upper vertical
+            backend->drawLine(x+2, y+3, x+1, y+4);  // Middle top curve
+            backend->drawLine(x+1, y+4, x+2, y+5);  // Middle bottom curve
+            backend->drawLine(x+2, y+5, x+2, y+8);  // Lower vertical
+            backend->drawLine(x+2, y+8, x+3, y+9);  // Bottom curve
             break;
         case '}':
-            SDL_RenderLine(renderer, x+1, y, x+2, y+1);    // Top curve
-            SDL_RenderLine(renderer, x+2, y+1, x+2, y+3);  // Upper vertical
-            SDL_RenderLine(renderer, x+2, y+3, x+3, y+4);  // Middle top curve
-            SDL_RenderLine(renderer, x+3, y+4, x+2, y+5);  // Middle bottom curve
-            SDL_RenderLine(renderer, x+2, y+5, x+2, y+8);  // Lower vertical
-            SDL_RenderLine(renderer, x+2, y+8, x+1, y+9);  // Bottom curve
+            backend->drawLine(x+1, y, x+2, y+1);    // Top curve
+            backend->drawLine(x+2, y+1, x+2, y+3);  // Upper vertical
+            backend->drawLine(x+2, y+3, x+3, y+4);  // Middle top curve
+            backend->drawLine(x+3, y+4, x+2, y+5);  // Middle bottom curve
+            backend->drawLine(x+2, y+5, x+2, y+8);  // Lower vertical
+            backend->drawLine(x+2, y+8, x+1, y+9);  // Bottom curve
             break;
         case '>':
-            SDL_RenderLine(renderer, x, y+2, x+3, y+4);    // Top
-            SDL_RenderLine(renderer, x+3, y+4, x, y+7);    // Bottom
+            backend->drawLine(x, y+2, x+3, y+4);    // Top
+            backend->drawLine(x+3, y+4, x, y+7);    // Bottom
             break;
         case '<':
-            SDL_RenderLine(renderer, x+3, y+2, x, y+4);    // Top
-            SDL_RenderLine(renderer, x, y+4, x+3, y+7);    // Bottom
+            backend->drawLine(x+3, y+2, x, y+4);    // Top
+            backend->drawLine(x, y+4, x+3, y+7);    // Bottom
             break;
         case '\'':
-            SDL_RenderLine(renderer, x+2, y, x+2, y+2);    // Quote
+            backend->drawLine(x+2, y, x+2, y+2);    // Quote
             break;
         case '"':
-            SDL_RenderLine(renderer, x+1, y, x+1, y+2);    // Left quote
-            SDL_RenderLine(renderer, x+3, y, x+3, y+2);    // Right quote
+            backend->drawLine(x+1, y, x+1, y+2);    // Left quote
+            backend->drawLine(x+3, y, x+3, y+2);    // Right quote
             break;
         case '`':
-            SDL_RenderLine(renderer, x+1, y, x+2, y+2);    // Backtick
+            backend->drawLine(x+1, y, x+2, y+2);    // Backtick
             break;
         case '~':
-            SDL_RenderLine(renderer, x, y+4, x+2, y+3);    // Left curve
-            SDL_RenderLine(renderer, x+2, y+3, x+4, y+5);  // Right curve
+            backend->drawLine(x, y+4, x+2, y+3);    // Left curve
+            backend->drawLine(x+2, y+3, x+4, y+5);  // Right curve
             break;
         case '@':
-            SDL_RenderLine(renderer, x+3, y, x+1, y+2);    // Top left curve
-            SDL_RenderLine(renderer, x+1, y+2, x+1, y+7);  // Left vertical
-            SDL_RenderLine(renderer, x+1, y+7, x+3, y+9);  // Bottom left curve
-            SDL_RenderLine(renderer, x+3, y+9, x+5, y+7);  // Bottom right curve
-            SDL_RenderLine(renderer, x+5, y+7, x+5, y+2);  // Right vertical
-            SDL_RenderLine(renderer, x+5, y+2, x+3, y);    // Top right curve
-            SDL_RenderLine(renderer, x+3, y+5, x+3, y+7);  // Inner vertical
-            SDL_RenderLine(renderer, x+3, y+7, x+4, y+7);  // Inner horizontal
-            SDL_RenderLine(renderer, x+4, y+7, x+5, y+5);  // Inner curve
+            backend->drawLine(x+3, y, x+1, y+2);    // Top left curve
+            backend->drawLine(x+1, y+2, x+1, y+7);  // Left vertical
+            backend->drawLine(x+1, y+7, x+3, y+9);  // Bottom left curve
+            backend->drawLine(x+3, y+9, x+5, y+7);  // Bottom right curve
+            backend->drawLine(x+5, y+7, x+5, y+2);  // Right vertical
+            backend->drawLine(x+5, y+2, x+3, y);    // Top right curve
+            backend->drawLine(x+3, y+5, x+3, y+7);  // Inner vertical
+            backend->drawLine(x+3, y+7, x+4, y+7);  // Inner horizontal
+            backend->drawLine(x+4, y+7, x+5, y+5);  // Inner curve
             break;
         case '#':
-            SDL_RenderLine(renderer, x+1, y+1, x+1, y+8);  // Left vertical
-            SDL_RenderLine(renderer, x+4, y+1, x+4, y+8);  // Right vertical
-            SDL_RenderLine(renderer, x, y+3, x+5, y+3);    // Top horizontal
-            SDL_RenderLine(renderer, x, y+6, x+5, y+6);    // Bottom horizontal
+            backend->drawLine(x+1, y+1, x+1, y+8);  // Left vertical
+            backend->drawLine(x+4, y+1, x+4, y+8);  // Right vertical
+            backend->drawLine(x, y+3, x+5, y+3);    // Top horizontal
+            backend->drawLine(x, y+6, x+5, y+6);    // Bottom horizontal
             break;
         case '$':
-            SDL_RenderLine(renderer, x+2, y, x+2, y+9);    // Middle vertical
-            SDL_RenderLine(renderer, x+4, y+1, x+2, y+1);  // Top right
-            SDL_RenderLine(renderer, x+2, y+1, x, y+3);    // Top left curve
-            SDL_RenderLine(renderer, x, y+3, x+2, y+5);    // Middle left curve
-            SDL_RenderLine(renderer, x+2, y+5, x+4, y+5);  // Middle
-            SDL_RenderLine(renderer, x+4, y+5, x+5, y+7);  // Bottom right curve
-            SDL_RenderLine(renderer, x+5, y+7, x+3, y+9);  // Bottom curve
+            backend->drawLine(x+2, y, x+2, y+9);    // Middle vertical
+            backend->drawLine(x+4, y+1, x+2, y+1);  // Top right
+            backend->drawLine(x+2, y+1, x, y+3);    // Top left curve
+            backend->drawLine(x, y+3, x+2, y+5);    // Middle left curve
+            backend->drawLine(x+2, y+5, x+4, y+5);  // Middle
+            backend->drawLine(x+4, y+5, x+5, y+7);  // Bottom right curve
+            backend->drawLine(x+5, y+7, x+3, y+9);  // Bottom curve
             break;
         case '%':
-            SDL_RenderLine(renderer, x+5, y, x, y+9);      // Main diagonal
-            SDL_RenderPoint(renderer, x+1, y+2);           // Top circle
-            SDL_RenderPoint(renderer, x+4, y+7);           // Bottom circle
+            backend->drawLine(x+5, y, x, y+9);      // Main diagonal
+            backend->drawPoint(x+1, y+2);           // Top circle
+            backend->drawPoint(x+4, y+7);           // Bottom circle
             break;
         case '^':
-            SDL_RenderLine(renderer, x+1, y+3, x+2, y);    // Left diagonal
-            SDL_RenderLine(renderer, x+2, y, x+3, y+3);    // Right diagonal
+            backend->drawLine(x+1, y+3, x+2, y);    // Left diagonal
+            backend->drawLine(x+2, y, x+3, y+3);    // Right diagonal
             break;
         case '&':
-            SDL_RenderLine(renderer, x+4, y+1, x+2, y);    // Top right
-            SDL_RenderLine(renderer, x+2, y, x, y+2);      // Top left curve
-            SDL_RenderLine(renderer, x, y+2, x+2, y+4);    // Middle left curve
-            SDL_RenderLine(renderer, x+2, y+4, x, y+7);    // Middle right curve
-            SDL_RenderLine(renderer, x, y+7, x+2, y+9);    // Bottom left curve
-            SDL_RenderLine(renderer, x+2, y+9, x+4, y+7);  // Bottom right curve
-            SDL_RenderLine(renderer, x+4, y+7, x+5, y+9);  // Bottom right diagonal
+            backend->drawLine(x+4, y+1, x+2, y);    // Top right
+            backend->drawLine(x+2, y, x, y+2);      // Top left curve
+            backend->drawLine(x, y+2, x+2, y+4);    // Middle left curve
+            backend->drawLine(x+2, y+4, x, y+7);    // Middle right curve
+            backend->drawLine(x, y+7, x+2, y+9);    // Bottom left curve
+            backend->drawLine(x+2, y+9, x+4, y+7);  // Bottom right curve
+            backend->drawLine(x+4, y+7, x+5, y+9);  // Bottom right diagonal
             break;
         case '*':
-            SDL_RenderLine(renderer, x+2, y+2, x+2, y+7);  // Vertical
-            SDL_RenderLine(renderer, x, y+4, x+4, y+4);    // Horizontal
-            SDL_RenderLine(renderer, x+1, y+2, x+3, y+7);  // Diagonal 1
-            SDL_RenderLine(renderer, x+3, y+2, x+1, y+7);  // Diagonal 2
+            backend->drawLine(x+2, y+2, x+2, y+7);  // Vertical
+            backend->drawLine(x, y+4, x+4, y+4);    // Horizontal
+            backend->drawLine(x+1, y+2, x+3, y+7);  // Diagonal 1
+            backend->drawLine(x+3, y+2, x+1, y+7);  // Diagonal 2
             break;
         default:
             // For unknown characters, draw a rectangle
@@ -1017,7 +1026,7 @@ void TrafficLight::drawPanelChar(SDL_Renderer* renderer, char c, int x, int y) {
                 static_cast<float>(x), static_cast<float>(y),
                 5.0f, 9.0f
             };
-            SDL_RenderRect(renderer, &charBox);
+            backend->drawRect(&charBox);
             break;
     }
 }
@@ -1,13 +1,22 @@
 // FILE: src/core/Vehicle.cpp
 #include "core/Vehicle.h"
+#include "core/VehicleTransitions.h"
+#include "core/Kinematics.h"
+#include "core/Emissions.h"
 #include "core/Constants.h"
 #include "utils/DebugLogger.h"
+#include <algorithm>
+#include <atomic>
 #include <cmath>
 #include <sstream>
 #include <random> // Add this for random number generation
 
+std::atomic<int64_t> Vehicle::liveCount(0);
+std::atomic<uint32_t> Vehicle::nextSerial(0);
+
 Vehicle::Vehicle(const std::string& id, char lane, int laneNumber, bool isEmergency)
     : id(id),
+      serial(nextSerial.fetch_add(1, std::memory_order_relaxed)),
       lane(lane),
       laneNumber(laneNumber),
       isEmergency(isEmergency),
@@ -19,10 +28,16 @@ Vehicle::Vehicle(const std::string& id, char lane, int laneNumber, bool isEmerge
       turnPosY(0.0f),
       queuePos(0),
       destination(Destination::STRAIGHT),
+      routeTarget(0xFFFFFFFF),
+      queuedAt(0),
+      energy{0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, EmissionsBatch::NO_ENTRY},
       currentDirection(Direction::DOWN),
       state(VehicleState::APPROACHING),
+      motionChanged(false),
       currentWaypoint(0) {
 
+    liveCount.fetch_add(1, std::memory_order_relaxed);
+
     // Log creation
     std::ostringstream oss;
     oss << "Created vehicle " << id << " in lane " << lane << laneNumber;
@@ -36,23 +51,9 @@ Vehicle::Vehicle(const std::string& id, char lane, int laneNumber, bool isEmerge
 
     // Determine current direction based on road (lane letter)
     // A is North (top), B is East (right), C is South (bottom), D is West (left)
-    switch (lane) {
-        case 'A':
-            currentDirection = Direction::DOWN;  // Road A (North) vehicles move DOWN
-            break;
-        case 'B':
-            currentDirection = Direction::LEFT;  // Road B (East) vehicles move LEFT
-            break;
-        case 'C':
-            currentDirection = Direction::UP;    // Road C (South) vehicles move UP
-            break;
-        case 'D':
-            currentDirection = Direction::RIGHT; // Road D (West) vehicles move RIGHT
-            break;
-        default:
-            DebugLogger::log("Invalid lane ID: " + std::string(1, lane), DebugLogger::LogLevel::ERROR);
-            currentDirection = Direction::DOWN;
-            break;
+    currentDirection = VehicleTransitions::directionForRoad(lane);
+    if (lane < 'A' || lane > 'D') {
+        DebugLogger::log("Invalid lane ID: " + std::string(1, lane), DebugLogger::LogLevel::ERROR);
     }
 
     // Lane spacing - wider for better visibility
@@ -170,6 +171,8 @@ Vehicle::Vehicle(const std::string& id, char lane, int laneNumber, bool isEmerge
 }
 
 Vehicle::~Vehicle() {
+    liveCount.fetch_sub(1, std::memory_order_relaxed);
+
     std::ostringstream oss;
     oss << "Destroyed vehicle " << id;
     DebugLogger::log(oss.str());
@@ -496,18 +499,10 @@ void Vehicle::setTurnProgress(float progress) {
     this->turnProgress = progress;
 }
 
-float Vehicle::getTurnPosX() const {
-    return turnPosX;
-}
-
 void Vehicle::setTurnPosX(float x) {
     this->turnPosX = x;
 }
 
-float Vehicle::getTurnPosY() const {
-    return turnPosY;
-}
-
 void Vehicle::setTurnPosY(float y) {
     this->turnPosY = y;
 }
@@ -532,15 +527,47 @@ void Vehicle::setDestination(Destination dest) {
     }
 }
 
-Destination Vehicle::getDestination() const {
-    return destination;
-}
-
 float Vehicle::easeInOutQuad(float t) const {
     return t < 0.5f ? 2.0f * t * t : -1.0f + (4.0f - 2.0f * t) * t;
 }
 
+Vehicle::Motion Vehicle::getMotion() const {
+    Motion motion = Motion();
+    motion.posX = turnPosX;
+    motion.posY = turnPosY;
+    motion.animPos = animPos;
+    motion.turnProgress = turnProgress;
+    motion.waypoint = static_cast<uint32_t>(currentWaypoint);
+    motion.lane = lane;
+    motion.laneNumber = static_cast<uint8_t>(laneNumber);
+    motion.direction = static_cast<uint8_t>(currentDirection);
+    motion.state = static_cast<uint8_t>(state);
+    motion.turning = turning ? 1 : 0;
+    return motion;
+}
+
+void Vehicle::setMotion(const Motion& motion) {
+    turnPosX = motion.posX;
+    turnPosY = motion.posY;
+    animPos = motion.animPos;
+    turnProgress = motion.turnProgress;
+    currentWaypoint = std::min<size_t>(motion.waypoint, waypoints.size() - 1);
+    lane = motion.lane;
+    laneNumber = motion.laneNumber;
+    currentDirection = static_cast<Direction>(motion.direction);
+    state = static_cast<VehicleState>(motion.state);
+    turning = motion.turning != 0;
+}
+
 void Vehicle::update(uint32_t delta, bool isGreenLight, float targetPos) {
+    (void)targetPos;
+    step<FloatKinematics>(delta, isGreenLight);
+}
+
+template<typename Kinematics>
+void Vehicle::step(uint32_t delta, bool isGreenLight) {
+    typedef typename Kinematics::Scalar Scalar;
+
     // CRITICAL FIX: Free lane vehicles (L3) can ALWAYS move regardless of traffic light
     bool canMove = isGreenLight;
 
@@ -548,48 +575,55 @@ void Vehicle::update(uint32_t delta, bool isGreenLight, float targetPos) {
     if (laneNumber == 3) {
         canMove = true;
 
-        // Debug log for free lane
-        static uint32_t lastLogTime = 0;
+        // Debug log for free lane (vehicles may be updated from several threads)
+        static std::atomic<uint32_t> lastLogTime(0);
         uint32_t currentTime = SDL_GetTicks();
-        if (currentTime - lastLogTime > 3000) {
+        uint32_t lastTime = lastLogTime.load(std::memory_order_relaxed);
+        if (currentTime - lastTime > 3000 &&
+            lastLogTime.compare_exchange_strong(lastTime, currentTime, std::memory_order_relaxed)) {
 DebugLogger::log("FREE LANE (" + std::string(1, lane) + "3): Vehicle " + id + " moving freely",
                DebugLogger::LogLevel::ERROR);
-            lastLogTime = currentTime;
         }
     }
 
     // DEBUG: Log A2 priority lane status
     if (lane == 'A' && laneNumber == 2) {
-        static uint32_t lastLogTime = 0;
+        static std::atomic<uint32_t> lastLogTime(0);
         uint32_t currentTime = SDL_GetTicks();
-        if (currentTime - lastLogTime > 3000) {
+        uint32_t lastTime = lastLogTime.load(std::memory_order_relaxed);
+        if (currentTime - lastTime > 3000 &&
+            lastLogTime.compare_exchange_strong(lastTime, currentTime, std::memory_order_relaxed)) {
             DebugLogger::log("PRIORITY LANE (A2): Vehicle " + id + " canMove=" +
                          (canMove ? "true" : "false"), DebugLogger::LogLevel::ERROR);
-            lastLogTime = currentTime;
         }
     }
 
     // Fine-tune speed for smoother animation
-    const float SPEED_BASE = 0.018f;
-    const float SPEED = SPEED_BASE * delta;
-    const float VEHICLE_SPACING = 50.0f; // Increased from 35.0f for better separation
+    const Scalar SPEED_BASE = Kinematics::fromFloat(0.018f);
+    const Scalar SPEED = SPEED_BASE * Kinematics::fromInt(delta);
+    const Scalar VEHICLE_SPACING = Kinematics::fromFloat(50.0f); // Increased from 35.0f for better separation
+
+    // Work on the position in the kinematics number type
+    Scalar posX = Kinematics::fromFloat(turnPosX);
+    Scalar posY = Kinematics::fromFloat(turnPosY);
 
     if (canMove) {
         // We have more waypoints to travel
         if (currentWaypoint < waypoints.size() - 1) {
-            // Get current and next waypoint
-            auto& current = waypoints[currentWaypoint];
-            auto& next = waypoints[currentWaypoint + 1];
+            motionChanged = true;
+
+            // Get next waypoint
+            const Point& next = waypoints[currentWaypoint + 1];
 
             // Calculate direction vector
-            float dx = next.x - turnPosX;
-            float dy = next.y - turnPosY;
+            Scalar dx = Kinematics::fromFloat(next.x) - posX;
+            Scalar dy = Kinematics::fromFloat(next.y) - posY;
 
             // Calculate distance to next waypoint
-            float distance = std::sqrt(dx*dx + dy*dy);
+            Scalar distance = Kinematics::sqrt(dx*dx + dy*dy);
 
             // If close enough to waypoint, move to next
-            if (distance < 3.0f) {
+            if (distance < Kinematics::fromFloat(3.0f)) {
                 currentWaypoint++;
 
                 // Log progress through waypoints for debugging
@@ -600,175 +634,64 @@ DebugLogger::log("FREE LANE (" + std::string(1, lane) + "3): Vehicle " + id + "
                                  DebugLogger::LogLevel::DEBUG);
                 }
 
-                // For L3 (always turns left) and L2 (turns left if specified)
-                if ((laneNumber == 3) ||
-                    (laneNumber == 2 && destination == Destination::LEFT)) {
-
-                    // When entering turning points (varies by direction)
-                    if (currentWaypoint == 2) {
-                        turning = true;
-                        turnProgress = 0.0f;
-                        state = VehicleState::IN_INTERSECTION;
-
-                        // Log turn start
-                        std::ostringstream oss;
-                        oss << "Vehicle " << id << " on " << lane << laneNumber << " is now turning LEFT";
-                        DebugLogger::log(oss.str(), DebugLogger::LogLevel::ERROR);
-                    }
-                }
+                // Turning and exiting follow from the transition table for
+                // this route and the waypoint just reached
+                const VehicleTransitions::Transition& transition =
+                    VehicleTransitions::onWaypoint(lane, laneNumber, destination, currentWaypoint);
 
-                // Determine when a vehicle has exited the intersection
-                bool isExiting = false;
+                if (transition.actions & VehicleTransitions::ACTION_START_TURN) {
+                    turning = true;
+                    turnProgress = 0.0f;
+                    state = transition.nextState;
 
-                if (laneNumber == 3) {
-                    // L3 vehicles typically reach exit point at waypoint 3
-                    isExiting = (currentWaypoint == 3);
-                } else if (laneNumber == 2) {
-                    if (destination == Destination::LEFT) {
-                        // L2 turning left typically reaches exit at waypoint 3
-                        isExiting = (currentWaypoint == 3);
-                    } else {
-                        // L2 going straight typically reaches exit at waypoint 2
-                        isExiting = (currentWaypoint == 2);
-                    }
+                    // Log turn start
+                    std::ostringstream oss;
+                    oss << "Vehicle " << id << " on " << lane << laneNumber << " is now turning LEFT";
+                    DebugLogger::log(oss.str(), DebugLogger::LogLevel::ERROR);
                 }
 
-                // Update vehicle state when exiting
-                if (isExiting) {
+                // Update vehicle state when exiting: move onto lane 1 of the exit road
+                if (transition.actions & VehicleTransitions::ACTION_EXIT) {
                     turning = false;
-                    state = VehicleState::EXITING;
-
-                    // CRITICAL: Ensure the lane assignments strictly follow the rules
-                    std::string newLaneStr;
-                    switch (currentDirection) {
-                        case Direction::DOWN:  // From North (A)
-                            if (laneNumber == 3) {
-                                // AL3 → BL1
-                                lane = 'B';
-                                laneNumber = 1;
-                                currentDirection = Direction::LEFT;
-                                newLaneStr = "B1 (turned LEFT from A3)";
-                            }
-                            else if (destination == Destination::LEFT) {
-                                // AL2(left) → DL1
-                                lane = 'D';
-                                laneNumber = 1;
-                                currentDirection = Direction::RIGHT;
-                                newLaneStr = "D1 (turned LEFT from A2)";
-                            }
-                            else {
-                                // AL2(straight) → CL1
-                                lane = 'C';
-                                laneNumber = 1;
-                                currentDirection = Direction::UP;
-                                newLaneStr = "C1 (going STRAIGHT from A2)";
-                            }
-                            break;
-
-                        case Direction::UP:    // From South (C)
-                            if (laneNumber == 3) {
-                                // CL3 → DL1
-                                lane = 'D';
-                                laneNumber = 1;
-                                currentDirection = Direction::RIGHT;
-                                newLaneStr = "D1 (turned LEFT from C3)";
-                            }
-                            else if (destination == Destination::LEFT) {
-                                // CL2(left) → BL1
-                                lane = 'B';
-                                laneNumber = 1;
-                                currentDirection = Direction::LEFT;
-                                newLaneStr = "B1 (turned LEFT from C2)";
-                            }
-                            else {
-                                // CL2(straight) → AL1
-                                lane = 'A';
-                                laneNumber = 1;
-                                currentDirection = Direction::DOWN;
-                                newLaneStr = "A1 (going STRAIGHT from C2)";
-                            }
-                            break;
-
-                        case Direction::LEFT:  // From East (B)
-                            if (laneNumber == 3) {
-                                // BL3 → CL1
-                                lane = 'C';
-                                laneNumber = 1;
-                                currentDirection = Direction::UP;
-                                newLaneStr = "C1 (turned LEFT from B3)";
-                            }
-                            else if (destination == Destination::LEFT) {
-                                // BL2(left) → AL1
-                                lane = 'A';
-                                laneNumber = 1;
-                                currentDirection = Direction::DOWN;
-                                newLaneStr = "A1 (turned LEFT from B2)";
-                            }
-                            else {
-                                // BL2(straight) → DL1
-                                lane = 'D';
-                                laneNumber = 1;
-                                currentDirection = Direction::RIGHT;
-                                newLaneStr = "D1 (going STRAIGHT from B2)";
-                            }
-                            break;
-
-                        case Direction::RIGHT: // From West (D)
-                            if (laneNumber == 3) {
-                                // DL3 → AL1
-                                lane = 'A';
-                                laneNumber = 1;
-                                currentDirection = Direction::DOWN;
-                                newLaneStr = "A1 (turned LEFT from D3)";
-                            }
-                            else if (destination == Destination::LEFT) {
-                                // DL2(left) → CL1
-                                lane = 'C';
-                                laneNumber = 1;
-                                currentDirection = Direction::UP;
-                                newLaneStr = "C1 (turned LEFT from D2)";
-                            }
-                            else {
-                                // DL2(straight) → BL1
-                                lane = 'B';
-                                laneNumber = 1;
-                                currentDirection = Direction::LEFT;
-                                newLaneStr = "B1 (going STRAIGHT from D2)";
-                            }
-                            break;
-                    }
+                    state = transition.nextState;
+
+                    std::ostringstream newLane;
+                    newLane << transition.exitRoad << "1 ("
+                            << (destination == Destination::LEFT ? "turned LEFT" : "going STRAIGHT")
+                            << " from " << lane << laneNumber << ")";
+
+                    lane = transition.exitRoad;
+                    laneNumber = 1;
+                    currentDirection = transition.exitDirection;
 
                     // Log lane change
-                    DebugLogger::log("==================== Vehicle " + id + " now on " + newLaneStr +
+                    DebugLogger::log("==================== Vehicle " + id + " now on " + newLane.str() +
                                   " ====================", DebugLogger::LogLevel::ERROR);
                 }
             }
 
             // Adjust speed based on position and turn status
-            float adjustedSpeed = SPEED;
+            Scalar adjustedSpeed = SPEED;
 
             // Slower when approaching intersection
             if (currentWaypoint == 1) {
-                adjustedSpeed *= 0.9f;
+                adjustedSpeed = adjustedSpeed * Kinematics::fromFloat(0.9f);
             }
             // Even slower in turning phase
             else if (turning) {
-                adjustedSpeed *= 0.7f;
+                adjustedSpeed = adjustedSpeed * Kinematics::fromFloat(0.7f);
             }
             // Faster when exiting intersection
             else if (currentWaypoint >= 3) {
-                adjustedSpeed *= 1.2f;
+                adjustedSpeed = adjustedSpeed * Kinematics::fromFloat(1.2f);
             }
 
             // Move toward next waypoint
-            if (distance > 0) {
-                // Normalize direction vector
-                dx /= distance;
-                dy /= distance;
-
+            if (distance > Kinematics::fromInt(0)) {
                 // Move toward waypoint with adjusted speed
-                turnPosX += dx * adjustedSpeed;
-                turnPosY += dy * adjustedSpeed;
+                Kinematics::moveAlong(posX, posY, dx, dy, distance, adjustedSpeed);
+                turnPosX = Kinematics::toFloat(posX);
+                turnPosY = Kinematics::toFloat(posY);
 
                 // Update animation position
                 animPos = (currentDirection == Direction::UP || currentDirection == Direction::DOWN) ?
@@ -777,7 +700,10 @@ DebugLogger::log("FREE LANE (" + std::string(1, lane) + "3): Vehicle " + id + "
 
             // Update turn progress for visualization
             if (turning) {
-                turnProgress = std::min(1.0f, turnProgress + 0.002f * delta);
+                Scalar progress = Kinematics::fromFloat(turnProgress) +
+                                  Kinematics::fromFloat(0.002f) * Kinematics::fromInt(delta);
+                Scalar full = Kinematics::fromInt(1);
+                turnProgress = Kinematics::toFloat(full < progress ? full : progress);
             }
         }
 
@@ -787,11 +713,13 @@ DebugLogger::log("FREE LANE (" + std::string(1, lane) + "3): Vehicle " + id + "
             const int windowWidth = 800;
             const int windowHeight = 800;
 
-            // Check if off-screen
-            if (turnPosX < -30.0f || turnPosX > windowWidth + 30.0f ||
-                turnPosY < -30.0f || turnPosY > windowHeight + 30.0f) {
+            // Check if off-screen (the last waypoint sits 30px past the edge and
+            // vehicles stop within a few pixels of it, so test against the edge)
+            if (turnPosX < 0.0f || turnPosX > windowWidth ||
+                turnPosY < 0.0f || turnPosY > windowHeight) {
                 // Flag for removal
                 state = VehicleState::EXITED;
+                motionChanged = true;
                 DebugLogger::log("Vehicle " + id + " has left the screen", DebugLogger::LogLevel::DEBUG);
             }
         }
@@ -803,47 +731,48 @@ DebugLogger::log("FREE LANE (" + std::string(1, lane) + "3): Vehicle " + id + "
             auto& stopLine = waypoints[1];
 
             // Calculate target position based on queue position with improved spacing
-            float queueOffsetDistance = VEHICLE_SPACING * (queuePos + 0.2f); // Added small offset for better staggering
-            float queueStopX = stopLine.x;
-            float queueStopY = stopLine.y;
+            Scalar queueOffsetDistance = VEHICLE_SPACING *
+                (Kinematics::fromInt(queuePos) + Kinematics::fromFloat(0.2f)); // Added small offset for better staggering
+            Scalar queueStopX = Kinematics::fromFloat(stopLine.x);
+            Scalar queueStopY = Kinematics::fromFloat(stopLine.y);
 
             // Adjust target position based on direction of travel
             switch (currentDirection) {
                 case Direction::DOWN:  // From North (A)
-                    queueStopY -= queueOffsetDistance;
+                    queueStopY = queueStopY - queueOffsetDistance;
                     break;
                 case Direction::UP:    // From South (C)
-                    queueStopY += queueOffsetDistance;
+                    queueStopY = queueStopY + queueOffsetDistance;
                     break;
                 case Direction::LEFT:  // From East (B)
-                    queueStopX += queueOffsetDistance;
+                    queueStopX = queueStopX + queueOffsetDistance;
                     break;
                 case Direction::RIGHT: // From West (D)
-                    queueStopX -= queueOffsetDistance;
+                    queueStopX = queueStopX - queueOffsetDistance;
                     break;
             }
 
             // Calculate direction and distance to queue position
-            float dx = queueStopX - turnPosX;
-            float dy = queueStopY - turnPosY;
-            float distance = std::sqrt(dx*dx + dy*dy);
+            Scalar dx = queueStopX - posX;
+            Scalar dy = queueStopY - posY;
+            Scalar distance = Kinematics::sqrt(dx*dx + dy*dy);
 
             // Adjust speed based on distance (decelerate as approaching)
-            float adjustedSpeed = SPEED;
-            if (distance < 50.0f) {
+            Scalar adjustedSpeed = SPEED;
+            if (distance < Kinematics::fromFloat(50.0f)) {
                 // Slow down as approaching the stop position
-                adjustedSpeed *= (distance / 50.0f) + 0.2f;
+                adjustedSpeed = adjustedSpeed *
+                    (distance / Kinematics::fromFloat(50.0f) + Kinematics::fromFloat(0.2f));
             }
 
             // Only move if far enough from target position (prevents jitter)
-            if (distance > 2.0f) {
-                // Normalize direction
-                dx /= distance;
-                dy /= distance;
+            if (distance > Kinematics::fromFloat(2.0f)) {
+                motionChanged = true;
 
                 // Move toward queue position with adjusted speed
-                turnPosX += dx * adjustedSpeed;
-                turnPosY += dy * adjustedSpeed;
+                Kinematics::moveAlong(posX, posY, dx, dy, distance, adjustedSpeed);
+                turnPosX = Kinematics::toFloat(posX);
+                turnPosY = Kinematics::toFloat(posY);
 
                 // Update animation position
                 animPos = (currentDirection == Direction::UP || currentDirection == Direction::DOWN) ?
@@ -853,6 +782,9 @@ DebugLogger::log("FREE LANE (" + std::string(1, lane) + "3): Vehicle " + id + "
     }
 }
 
+template void Vehicle::step<FloatKinematics>(uint32_t delta, bool isGreenLight);
+template void Vehicle::step<FixedKinematics>(uint32_t delta, bool isGreenLight);
+
 void Vehicle::calculateTurnPath(float startX, float startY, float controlX, float controlY,
                               float endX, float endY, float progress) {
     // Quadratic bezier curve calculation for smooth turning
@@ -868,7 +800,7 @@ void Vehicle::calculateTurnPath(float startX, float startY, float controlX, floa
                progress * progress * endY;
 }
 
-void Vehicle::render(SDL_Renderer* renderer, SDL_Texture* vehicleTexture, int queuePos) {
+void Vehicle::render(RenderBackend* backend, RenderBackend::TextureId vehicleTexture, int queuePos) {
     // Store queue position for use in update method
     this->queuePos = queuePos;
 
@@ -878,7 +810,7 @@ void Vehicle::render(SDL_Renderer* renderer, SDL_Texture* vehicleTexture, int qu
     // STEP 1: Choose appropriate vehicle color based on lane and type
     if (isEmergency) {
         // Emergency vehicles are bright red with flashing effect
-        uint32_t time = SDL_GetTicks();
+        uint32_t time = static_cast<uint32_t>(backend->getTicks());
         bool flash = (time / 250) % 2 == 0; // Flash every 250ms
         color = flash ? SDL_Color{255, 0, 0, 255} : SDL_Color{180, 0, 0, 255};
     }
@@ -942,7 +874,7 @@ void Vehicle::render(SDL_Renderer* renderer, SDL_Texture* vehicleTexture, int qu
     }
 
     // Set color for vehicle body
-    SDL_SetRenderDrawColor(renderer, color.r, color.g, color.b, color.a);
+    backend->setDrawColor(color.r, color.g, color.b, color.a);
 
     // STEP 2: Determine vehicle dimensions - LARGER for better visibility
     float vehicleWidth = 14.0f;  // Wider than original
@@ -990,7 +922,7 @@ void Vehicle::render(SDL_Renderer* renderer, SDL_Texture* vehicleTexture, int qu
     }
 
     // STEP 4: Draw the vehicle body with border
-    SDL_RenderFillRect(renderer, &vehicleRect);
+    backend->fillRect(&vehicleRect);
 
     // Add 3D effect with gradient
     SDL_Color shadowColor = {
@@ -1008,7 +940,7 @@ void Vehicle::render(SDL_Renderer* renderer, SDL_Texture* vehicleTexture, int qu
     };
 
     // Add shadow edge
-    SDL_SetRenderDrawColor(renderer, shadowColor.r, shadowColor.g, shadowColor.b, shadowColor.a);
+    backend->setDrawColor(shadowColor.r, shadowColor.g, shadowColor.b, shadowColor.a);
     SDL_FRect shadowEdge;
 
     if (currentDirection == Direction::DOWN || currentDirection == Direction::UP) {
@@ -1016,10 +948,10 @@ void Vehicle::render(SDL_Renderer* renderer, SDL_Texture* vehicleTexture, int qu
     } else {
         shadowEdge = {vehicleRect.x, vehicleRect.y + vehicleRect.h * 0.6f, vehicleRect.w, vehicleRect.h * 0.4f};
     }
-    SDL_RenderFillRect(renderer, &shadowEdge);
+    backend->fillRect(&shadowEdge);
 
     // Add highlight edge
-    SDL_SetRenderDrawColor(renderer, highlightColor.r, highlightColor.g, highlightColor.b, highlightColor.a);
+    backend->setDrawColor(highlightColor.r, highlightColor.g, highlightColor.b, highlightColor.a);
     SDL_FRect highlightEdge;
 
     if (currentDirection == Direction::DOWN || currentDirection == Direction::UP) {
@@ -1027,18 +959,18 @@ void Vehicle::render(SDL_Renderer* renderer, SDL_Texture* vehicleTexture, int qu
     } else {
         highlightEdge = {vehicleRect.x, vehicleRect.y, vehicleRect.w, vehicleRect.h * 0.3f};
     }
-    SDL_RenderFillRect(renderer, &highlightEdge);
+    backend->fillRect(&highlightEdge);
 
     // Add border outline for better definition
-    SDL_SetRenderDrawColor(renderer, 0, 0, 0, 255); // Black border
-    SDL_RenderRect(renderer, &vehicleRect);
+    backend->setDrawColor(0, 0, 0, 255); // Black border
+    backend->drawRect(&vehicleRect);
 
     // STEP 5: Draw destination indicator - VERY CLEAR directional arrows
     // This shows exactly where each vehicle is going - LEFT or STRAIGHT
 
     if (destination == Destination::LEFT) {
         // LEFT TURN indicator - arrow pointing left relative to vehicle direction
-        SDL_SetRenderDrawColor(renderer, 255, 255, 0, 255); // Bright yellow
+        backend->setDrawColor(255, 255, 0, 255); // Bright yellow
 
         // Draw left arrow based on vehicle direction
         SDL_FPoint arrow[3];
@@ -1075,22 +1007,22 @@ void Vehicle::render(SDL_Renderer* renderer, SDL_Texture* vehicleTexture, int qu
         }
 
         // Draw filled triangle
-        SDL_RenderFillTriangleF(renderer, arrow[0].x, arrow[0].y, arrow[1].x, arrow[1].y, arrow[2].x, arrow[2].y);
+        fillTriangle(backend, arrow[0].x, arrow[0].y, arrow[1].x, arrow[1].y, arrow[2].x, arrow[2].y);
 
         // Draw "L" symbol in bright yellow to indicate LEFT turn
-        SDL_SetRenderDrawColor(renderer, 255, 255, 0, 255);
+        backend->setDrawColor(255, 255, 0, 255);
         float centerX = vehicleRect.x + vehicleRect.w/2;
         float centerY = vehicleRect.y + vehicleRect.h/2;
         float symbolSize = 6.0f;
 
-        SDL_RenderLine(renderer, centerX - symbolSize/2, centerY - symbolSize/2,
+        backend->drawLine(centerX - symbolSize/2, centerY - symbolSize/2,
                        centerX - symbolSize/2, centerY + symbolSize/2);
-        SDL_RenderLine(renderer, centerX - symbolSize/2, centerY + symbolSize/2,
+        backend->drawLine(centerX - symbolSize/2, centerY + symbolSize/2,
                        centerX + symbolSize/2, centerY + symbolSize/2);
     }
     else if (destination == Destination::STRAIGHT) {
         // STRAIGHT indicator - double parallel lines
-        SDL_SetRenderDrawColor(renderer, 255, 255, 0, 255); // Bright yellow
+        backend->setDrawColor(255, 255, 0, 255); // Bright yellow
 
         SDL_FRect line1, line2;
         float lineWidth = 2.5f;
@@ -1123,69 +1055,69 @@ void Vehicle::render(SDL_Renderer* renderer, SDL_Texture* vehicleTexture, int qu
                 break;
         }
 
-        SDL_RenderFillRect(renderer, &line1);
-        SDL_RenderFillRect(renderer, &line2);
+        backend->fillRect(&line1);
+        backend->fillRect(&line2);
 
         // Draw "S" symbol in bright yellow to indicate STRAIGHT
-        SDL_SetRenderDrawColor(renderer, 255, 255, 0, 255);
+        backend->setDrawColor(255, 255, 0, 255);
         float centerX = vehicleRect.x + vehicleRect.w/2;
         float centerY = vehicleRect.y + vehicleRect.h/2;
         float symbolSize = 6.0f;
 
         // Draw S shape with 5 line segments
-        SDL_RenderLine(renderer, centerX + symbolSize/2, centerY - symbolSize/2,
+        backend->drawLine(centerX + symbolSize/2, centerY - symbolSize/2,
                       centerX - symbolSize/2, centerY - symbolSize/2);
-        SDL_RenderLine(renderer, centerX - symbolSize/2, centerY - symbolSize/2,
+        backend->drawLine(centerX - symbolSize/2, centerY - symbolSize/2,
                       centerX - symbolSize/2, centerY);
-        SDL_RenderLine(renderer, centerX - symbolSize/2, centerY,
+        backend->drawLine(centerX - symbolSize/2, centerY,
                       centerX + symbolSize/2, centerY);
-        SDL_RenderLine(renderer, centerX + symbolSize/2, centerY,
+        backend->drawLine(centerX + symbolSize/2, centerY,
                       centerX + symbolSize/2, centerY + symbolSize/2);
-        SDL_RenderLine(renderer, centerX + symbolSize/2, centerY + symbolSize/2,
+        backend->drawLine(centerX + symbolSize/2, centerY + symbolSize/2,
                       centerX - symbolSize/2, centerY + symbolSize/2);
     }
 
     // STEP 6: Add lane number indicators as distinctive marks
-    SDL_SetRenderDrawColor(renderer, 255, 255, 255, 255); // White for indicators
+    backend->setDrawColor(255, 255, 255, 255); // White for indicators
 
     // Draw large lane number on vehicle
     float numX = vehicleRect.x + vehicleRect.w*0.5f;
     float numY = vehicleRect.y + vehicleRect.h*0.5f;
     float numSize = 8.0f;
 
-    SDL_SetRenderDrawColor(renderer, 0, 0, 0, 255); // Black for number
+    backend->setDrawColor(0, 0, 0, 255); // Black for number
 
     switch (laneNumber) {
         case 1: // Draw "1"
-            SDL_RenderLine(renderer, numX, numY - numSize/2, numX, numY + numSize/2);
+            backend->drawLine(numX, numY - numSize/2, numX, numY + numSize/2);
             break;
 
         case 2: // Draw "2"
-            SDL_RenderLine(renderer, numX - numSize/2, numY - numSize/2, numX + numSize/2, numY - numSize/2);
-            SDL_RenderLine(renderer, numX + numSize/2, numY - numSize/2, numX + numSize/2, numY);
-            SDL_RenderLine(renderer, numX + numSize/2, numY, numX - numSize/2, numY);
-            SDL_RenderLine(renderer, numX - numSize/2, numY, numX - numSize/2, numY + numSize/2);
-            SDL_RenderLine(renderer, numX - numSize/2, numY + numSize/2, numX + numSize/2, numY + numSize/2);
+            backend->drawLine(numX - numSize/2, numY - numSize/2, numX + numSize/2, numY - numSize/2);
+            backend->drawLine(numX + numSize/2, numY - numSize/2, numX + numSize/2, numY);
+            backend->drawLine(numX + numSize/2, numY, numX - numSize/2, numY);
+            backend->drawLine(numX - numSize/2, numY, numX - numSize/2, numY + numSize/2);
+            backend->drawLine(numX - numSize/2, numY + numSize/2, numX + numSize/2, numY + numSize/2);
             break;
 
         case 3: // Draw "3"
-            SDL_RenderLine(renderer, numX - numSize/2, numY - numSize/2, numX + numSize/2, numY - numSize/2);
-            SDL_RenderLine(renderer, numX + numSize/2, numY - numSize/2, numX + numSize/2, numY);
-            SDL_RenderLine(renderer, numX - numSize/2, numY, numX + numSize/2, numY);
-            SDL_RenderLine(renderer, numX + numSize/2, numY, numX + numSize/2, numY + numSize/2);
-            SDL_RenderLine(renderer, numX - numSize/2, numY + numSize/2, numX + numSize/2, numY + numSize/2);
+            backend->drawLine(numX - numSize/2, numY - numSize/2, numX + numSize/2, numY - numSize/2);
+            backend->drawLine(numX + numSize/2, numY - numSize/2, numX + numSize/2, numY);
+            backend->drawLine(numX - numSize/2, numY, numX + numSize/2, numY);
+            backend->drawLine(numX + numSize/2, numY, numX + numSize/2, numY + numSize/2);
+            backend->drawLine(numX - numSize/2, numY + numSize/2, numX + numSize/2, numY + numSize/2);
             break;
     }
 
     // STEP 7: Emergency vehicle indicators (if applicable)
     if (isEmergency) {
         // Draw a flashing effect
-        uint32_t time = SDL_GetTicks();
+        uint32_t time = static_cast<uint32_t>(backend->getTicks());
         bool flash = (time / 200) % 2 == 0; // Flash every 200ms
 
         if (flash) {
             // Draw a cross symbol for emergency vehicles when flashing
-            SDL_SetRenderDrawColor(renderer, 255, 255, 255, 255); // White
+            backend->setDrawColor(255, 255, 255, 255); // White
 
             float crossSize = 10.0f;
             SDL_FRect crossV, crossH;
@@ -1193,64 +1125,64 @@ void Vehicle::render(SDL_Renderer* renderer, SDL_Texture* vehicleTexture, int qu
             crossH = {turnPosX - crossSize/2, turnPosY - 1.5f, crossSize, 3.0f};
             crossV = {turnPosX - 1.5f, turnPosY - crossSize/2, 3.0f, crossSize};
 
-            SDL_RenderFillRect(renderer, &crossH);
-            SDL_RenderFillRect(renderer, &crossV);
+            backend->fillRect(&crossH);
+            backend->fillRect(&crossV);
 
             // Draw "E" for Emergency
-            SDL_SetRenderDrawColor(renderer, 255, 255, 255, 255);
+            backend->setDrawColor(255, 255, 255, 255);
             float eX = vehicleRect.x + vehicleRect.w*0.3f;
             float eY = vehicleRect.y + vehicleRect.h*0.3f;
             float eSize = 6.0f;
 
-            SDL_RenderLine(renderer, eX, eY, eX, eY + eSize);
-            SDL_RenderLine(renderer, eX, eY, eX + eSize/2, eY);
-            SDL_RenderLine(renderer, eX, eY + eSize/2, eX + eSize/2, eY + eSize/2);
-            SDL_RenderLine(renderer, eX, eY + eSize, eX + eSize/2, eY + eSize);
+            backend->drawLine(eX, eY, eX, eY + eSize);
+            backend->drawLine(eX, eY, eX + eSize/2, eY);
+            backend->drawLine(eX, eY + eSize/2, eX + eSize/2, eY + eSize/2);
+            backend->drawLine(eX, eY + eSize, eX + eSize/2, eY + eSize);
         }
     }
 
     // STEP 8: Add road indicator
     // Draw small road letter (A,B,C,D) on each vehicle for easy identification
-    SDL_SetRenderDrawColor(renderer, 255, 255, 255, 255);
+    backend->setDrawColor(255, 255, 255, 255);
     float roadX = vehicleRect.x + vehicleRect.w*0.25f;
     float roadY = vehicleRect.y + vehicleRect.h*0.25f;
     float roadSize = 6.0f;
 
     switch (lane) {
         case 'A': // Draw "A"
-            SDL_RenderLine(renderer, roadX - roadSize/2, roadY + roadSize/2, roadX, roadY - roadSize/2);
-            SDL_RenderLine(renderer, roadX, roadY - roadSize/2, roadX + roadSize/2, roadY + roadSize/2);
-            SDL_RenderLine(renderer, roadX - roadSize/4, roadY, roadX + roadSize/4, roadY);
+            backend->drawLine(roadX - roadSize/2, roadY + roadSize/2, roadX, roadY - roadSize/2);
+            backend->drawLine(roadX, roadY - roadSize/2, roadX + roadSize/2, roadY + roadSize/2);
+            backend->drawLine(roadX - roadSize/4, roadY, roadX + roadSize/4, roadY);
             break;
 
         case 'B': // Draw "B"
-            SDL_RenderLine(renderer, roadX - roadSize/2, roadY - roadSize/2, roadX - roadSize/2, roadY + roadSize/2);
-            SDL_RenderLine(renderer, roadX - roadSize/2, roadY - roadSize/2, roadX + roadSize/2, roadY - roadSize/2);
-            SDL_RenderLine(renderer, roadX + roadSize/2, roadY - roadSize/2, roadX + roadSize/2, roadY);
-            SDL_RenderLine(renderer, roadX + roadSize/2, roadY, roadX - roadSize/2, roadY);
-            SDL_RenderLine(renderer, roadX - roadSize/2, roadY, roadX - roadSize/2, roadY + roadSize/2);
-            SDL_RenderLine(renderer, roadX - roadSize/2, roadY + roadSize/2, roadX + roadSize/2, roadY + roadSize/2);
-            SDL_RenderLine(renderer, roadX + roadSize/2, roadY + roadSize/2, roadX + roadSize/2, roadY);
+            backend->drawLine(roadX - roadSize/2, roadY - roadSize/2, roadX - roadSize/2, roadY + roadSize/2);
+            backend->drawLine(roadX - roadSize/2, roadY - roadSize/2, roadX + roadSize/2, roadY - roadSize/2);
+            backend->drawLine(roadX + roadSize/2, roadY - roadSize/2, roadX + roadSize/2, roadY);
+            backend->drawLine(roadX + roadSize/2, roadY, roadX - roadSize/2, roadY);
+            backend->drawLine(roadX - roadSize/2, roadY, roadX - roadSize/2, roadY + roadSize/2);
+            backend->drawLine(roadX - roadSize/2, roadY + roadSize/2, roadX + roadSize/2, roadY + roadSize/2);
+            backend->drawLine(roadX + roadSize/2, roadY + roadSize/2, roadX + roadSize/2, roadY);
             break;
 
         case 'C': // Draw "C"
-            SDL_RenderLine(renderer, roadX + roadSize/2, roadY - roadSize/2, roadX - roadSize/2, roadY - roadSize/2);
-            SDL_RenderLine(renderer, roadX - roadSize/2, roadY - roadSize/2, roadX - roadSize/2, roadY + roadSize/2);
-            SDL_RenderLine(renderer, roadX - roadSize/2, roadY + roadSize/2, roadX + roadSize/2, roadY + roadSize/2);
+            backend->drawLine(roadX + roadSize/2, roadY - roadSize/2, roadX - roadSize/2, roadY - roadSize/2);
+            backend->drawLine(roadX - roadSize/2, roadY - roadSize/2, roadX - roadSize/2, roadY + roadSize/2);
+            backend->drawLine(roadX - roadSize/2, roadY + roadSize/2, roadX + roadSize/2, roadY + roadSize/2);
             break;
 
         case 'D': // Draw "D"
-            SDL_RenderLine(renderer, roadX - roadSize/2, roadY - roadSize/2, roadX - roadSize/2, roadY + roadSize/2);
-            SDL_RenderLine(renderer, roadX - roadSize/2, roadY - roadSize/2, roadX, roadY - roadSize/2);
-            SDL_RenderLine(renderer, roadX, roadY - roadSize/2, roadX + roadSize/2, roadY);
-            SDL_RenderLine(renderer, roadX + roadSize/2, roadY, roadX, roadY + roadSize/2);
-            SDL_RenderLine(renderer, roadX, roadY + roadSize/2, roadX - roadSize/2, roadY + roadSize/2);
+            backend->drawLine(roadX - roadSize/2, roadY - roadSize/2, roadX - roadSize/2, roadY + roadSize/2);
+            backend->drawLine(roadX - roadSize/2, roadY - roadSize/2, roadX, roadY - roadSize/2);
+            backend->drawLine(roadX, roadY - roadSize/2, roadX + roadSize/2, roadY);
+            backend->drawLine(roadX + roadSize/2, roadY, roadX, roadY + roadSize/2);
+            backend->drawLine(roadX, roadY + roadSize/2, roadX - roadSize/2, roadY + roadSize/2);
             break;
     }
 }
 // Helper for drawing triangles (SDL3 compatible)
-void Vehicle::SDL_RenderFillTriangleF(SDL_Renderer* renderer, float x1, float y1, float x2, float y2, float x3, float y3) {
-    // Create vertices for rendering with SDL_RenderGeometry
+void Vehicle::fillTriangle(RenderBackend* backend, float x1, float y1, float x2, float y2, float x3, float y3) {
+    // Create vertices for rendering as geometry
     SDL_Vertex vertices[3];
 
     // Create color with normalized values (0.0-1.0)
@@ -1275,5 +1207,5 @@ void Vehicle::SDL_RenderFillTriangleF(SDL_Renderer* renderer, float x1, float y1
     vertices[2].color = fcolor;
 
     // Draw the triangle
-    SDL_RenderGeometry(renderer, NULL, vertices, 3, NULL, 0);
+    backend->drawGeometry(0, vertices, 3, NULL, 0);
 }
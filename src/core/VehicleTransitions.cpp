@@ -0,0 +1,91 @@
+// FILE: src/core/VehicleTransitions.cpp
+#include "core/VehicleTransitions.h"
+#include "core/Junction.h"
+#include <array>
+
+namespace {
+
+typedef VehicleTransitions::Transition Transition;
+
+constexpr Direction ROAD_DIRECTIONS[VehicleTransitions::ROADS] = {
+    Direction::DOWN,    // A (North)
+    Direction::LEFT,    // B (East)
+    Direction::UP,      // C (South)
+    Direction::RIGHT    // D (West)
+};
+
+// Waypoints at which a movement starts turning and leaves the junction.
+// These follow the paths laid out in Vehicle::initializeWaypoints: straight
+// paths cross the centre (waypoint 2 is the exit), left turns have two turn
+// points (waypoint 2 starts the turn, waypoint 3 is the exit).
+struct MovementPath {
+    uint8_t turnWaypoint;   // 0 if the movement does not turn
+    uint8_t exitWaypoint;
+};
+
+constexpr MovementPath STRAIGHT_PATH = {0, 2};
+constexpr MovementPath LEFT_PATH = {2, 3};
+
+// Table slot for a lane/destination pair, -1 for lanes that don't cross
+constexpr int movementSlot(int laneNumber, Destination destination) {
+    return laneNumber == 3 ? 2
+         : laneNumber == 2 ? (destination == Destination::LEFT ? 1 : 0)
+         : -1;
+}
+
+typedef std::array<Transition, VehicleTransitions::MAX_WAYPOINTS> WaypointRow;
+typedef std::array<WaypointRow, VehicleTransitions::ROADS * VehicleTransitions::MOVEMENTS> TransitionTable;
+
+constexpr Transition NO_TRANSITION = {VehicleTransitions::ACTION_NONE, VehicleState::APPROACHING, '\0', Direction::DOWN};
+
+constexpr TransitionTable buildTable() {
+    TransitionTable table{};
+    for (auto& row : table) {
+        for (auto& entry : row) entry = NO_TRANSITION;
+    }
+
+    // One route per turn offset; every entry road gets the same movements
+    for (int turn = 0; turn < VehicleTransitions::ROADS; turn++) {
+        const StandardJunction::Route& route = StandardJunction::ROUTES[turn];
+        if (route.laneNumber == 0) continue;
+
+        const MovementPath& path = route.destination == Destination::LEFT ? LEFT_PATH : STRAIGHT_PATH;
+        int slot = movementSlot(route.laneNumber, route.destination);
+
+        for (int road = 0; road < VehicleTransitions::ROADS; road++) {
+            int exitRoad = (road + turn) % VehicleTransitions::ROADS;
+            WaypointRow& row = table[road * VehicleTransitions::MOVEMENTS + slot];
+
+            if (path.turnWaypoint != 0) {
+                row[path.turnWaypoint].actions = VehicleTransitions::ACTION_START_TURN;
+                row[path.turnWaypoint].nextState = VehicleState::IN_INTERSECTION;
+            }
+
+            Transition& exit = row[path.exitWaypoint];
+            exit.actions = VehicleTransitions::ACTION_EXIT;
+            exit.nextState = VehicleState::EXITING;
+            exit.exitRoad = static_cast<char>('A' + exitRoad);
+            exit.exitDirection = ROAD_DIRECTIONS[exitRoad];
+        }
+    }
+    return table;
+}
+
+constexpr TransitionTable TABLE = buildTable();
+
+} // namespace
+
+const VehicleTransitions::Transition& VehicleTransitions::onWaypoint(char road, int laneNumber,
+                                                                    Destination destination, size_t waypoint) {
+    int r = road - 'A';
+    int slot = movementSlot(laneNumber, destination);
+    if (r < 0 || r >= ROADS || slot < 0 || waypoint >= static_cast<size_t>(MAX_WAYPOINTS)) {
+        return NO_TRANSITION;
+    }
+    return TABLE[r * MOVEMENTS + slot][waypoint];
+}
+
+Direction VehicleTransitions::directionForRoad(char road) {
+    int r = road - 'A';
+    return r >= 0 && r < ROADS ? ROAD_DIRECTIONS[r] : Direction::DOWN;
+}
@@ -10,15 +10,21 @@
 #include <algorithm>
 #include <random>
 #include <cmath>
+#include <cstdlib>
+#include <cstdint>
 
 // Include the necessary headers
 #include "core/Vehicle.h"
 #include "core/Lane.h"
 #include "core/TrafficLight.h"
+#include "core/GlowTextures.h"
 #include "managers/TrafficManager.h"
 #include "managers/FileHandler.h"
 #include "visualization/Renderer.h"
+#include "visualization/SdlRenderBackend.h"
 #include "utils/DebugLogger.h"
+#include "utils/ThreadRoles.h"
+#include "utils/TickJitter.h"
 
 namespace fs = std::filesystem;
 
@@ -94,7 +100,9 @@ enum class VehicleDirection {
 class RenderSystem {
 public:
     SDL_Window* window;
+    TickJitter jitter;          // Simulation step timing of the render loop
     SDL_Renderer* rendererSDL;
+    RenderBackend* backend;
     int windowWidth;
     int windowHeight;
     bool active;
@@ -104,6 +112,7 @@ public:
     RenderSystem()
         : window(nullptr),
           rendererSDL(nullptr),
+          backend(nullptr),
           windowWidth(800),
           windowHeight(800),
           active(false),
@@ -132,6 +141,7 @@ public:
             log_message("Failed to create renderer: " + std::string(SDL_GetError()));
             return false;
         }
+        backend = new SdlRenderBackend(rendererSDL);
 
         active = true;
         log_message("Renderer initialized successfully");
@@ -150,46 +160,46 @@ public:
         const int SIDEWALK_WIDTH = 20;
 
         // Draw grass background
-        SDL_SetRenderDrawColor(rendererSDL, GRASS_COLOR.r, GRASS_COLOR.g, GRASS_COLOR.b, GRASS_COLOR.a);
-        SDL_RenderClear(rendererSDL);
+        backend->setDrawColor(GRASS_COLOR.r, GRASS_COLOR.g, GRASS_COLOR.b, GRASS_COLOR.a);
+        backend->clear();
 
         // Draw sidewalks
-        SDL_SetRenderDrawColor(rendererSDL, SIDEWALK_COLOR.r, SIDEWALK_COLOR.g, SIDEWALK_COLOR.b, SIDEWALK_COLOR.a);
+        backend->setDrawColor(SIDEWALK_COLOR.r, SIDEWALK_COLOR.g, SIDEWALK_COLOR.b, SIDEWALK_COLOR.a);
 
         // Horizontal sidewalks
         SDL_FRect hSidewalk1 = {0, (float)(windowHeight/2 - ROAD_WIDTH/2 - SIDEWALK_WIDTH),
                                (float)windowWidth, (float)SIDEWALK_WIDTH};
         SDL_FRect hSidewalk2 = {0, (float)(windowHeight/2 + ROAD_WIDTH/2),
                                (float)windowWidth, (float)SIDEWALK_WIDTH};
-        SDL_RenderFillRect(rendererSDL, &hSidewalk1);
-        SDL_RenderFillRect(rendererSDL, &hSidewalk2);
+        backend->fillRect(&hSidewalk1);
+        backend->fillRect(&hSidewalk2);
 
         // Vertical sidewalks
         SDL_FRect vSidewalk1 = {(float)(windowWidth/2 - ROAD_WIDTH/2 - SIDEWALK_WIDTH), 0,
                                (float)SIDEWALK_WIDTH, (float)windowHeight};
         SDL_FRect vSidewalk2 = {(float)(windowWidth/2 + ROAD_WIDTH/2), 0,
                                (float)SIDEWALK_WIDTH, (float)windowHeight};
-        SDL_RenderFillRect(rendererSDL, &vSidewalk1);
-        SDL_RenderFillRect(rendererSDL, &vSidewalk2);
+        backend->fillRect(&vSidewalk1);
+        backend->fillRect(&vSidewalk2);
 
         // Draw main roads (dark gray)
-        SDL_SetRenderDrawColor(rendererSDL, ROAD_COLOR.r, ROAD_COLOR.g, ROAD_COLOR.b, ROAD_COLOR.a);
+        backend->setDrawColor(ROAD_COLOR.r, ROAD_COLOR.g, ROAD_COLOR.b, ROAD_COLOR.a);
 
         // Horizontal road
         SDL_FRect hRoad = {0, (float)(windowHeight/2 - ROAD_WIDTH/2),
                           (float)windowWidth, (float)ROAD_WIDTH};
-        SDL_RenderFillRect(rendererSDL, &hRoad);
+        backend->fillRect(&hRoad);
 
         // Vertical road
         SDL_FRect vRoad = {(float)(windowWidth/2 - ROAD_WIDTH/2), 0,
                           (float)ROAD_WIDTH, (float)windowHeight};
-        SDL_RenderFillRect(rendererSDL, &vRoad);
+        backend->fillRect(&vRoad);
 
         // Draw intersection (slightly darker)
-        SDL_SetRenderDrawColor(rendererSDL, INTERSECTION_COLOR.r, INTERSECTION_COLOR.g, INTERSECTION_COLOR.b, INTERSECTION_COLOR.a);
+        backend->setDrawColor(INTERSECTION_COLOR.r, INTERSECTION_COLOR.g, INTERSECTION_COLOR.b, INTERSECTION_COLOR.a);
         SDL_FRect intersection = {(float)(windowWidth/2 - ROAD_WIDTH/2), (float)(windowHeight/2 - ROAD_WIDTH/2),
                                  (float)ROAD_WIDTH, (float)ROAD_WIDTH};
-        SDL_RenderFillRect(rendererSDL, &intersection);
+        backend->fillRect(&intersection);
 
         // Draw lane dividers
         // Horizontal lane dividers
@@ -198,11 +208,11 @@ public:
 
             if (i == 1) {
                 // Center line (yellow)
-                SDL_SetRenderDrawColor(rendererSDL, YELLOW_MARKER_COLOR.r, YELLOW_MARKER_COLOR.g,
+                backend->setDrawColor(YELLOW_MARKER_COLOR.r, YELLOW_MARKER_COLOR.g,
                                      YELLOW_MARKER_COLOR.b, YELLOW_MARKER_COLOR.a);
             } else {
                 // Other lane dividers (white)
-                SDL_SetRenderDrawColor(rendererSDL, LANE_MARKER_COLOR.r, LANE_MARKER_COLOR.g,
+                backend->setDrawColor(LANE_MARKER_COLOR.r, LANE_MARKER_COLOR.g,
                                      LANE_MARKER_COLOR.b, LANE_MARKER_COLOR.a);
             }
 
@@ -210,7 +220,7 @@ public:
             for (int x = 0; x < windowWidth; x += 30) {
                 if (x < windowWidth/2 - ROAD_WIDTH/2 || x > windowWidth/2 + ROAD_WIDTH/2) {
                     SDL_FRect line = {(float)x, (float)y - 2, 15, 4};
-                    SDL_RenderFillRect(rendererSDL, &line);
+                    backend->fillRect(&line);
                 }
             }
         }
@@ -221,11 +231,11 @@ public:
 
             if (i == 1) {
                 // Center line (yellow)
-                SDL_SetRenderDrawColor(rendererSDL, YELLOW_MARKER_COLOR.r, YELLOW_MARKER_COLOR.g,
+                backend->setDrawColor(YELLOW_MARKER_COLOR.r, YELLOW_MARKER_COLOR.g,
                                      YELLOW_MARKER_COLOR.b, YELLOW_MARKER_COLOR.a);
             } else {
                 // Other lane dividers (white)
-                SDL_SetRenderDrawColor(rendererSDL, LANE_MARKER_COLOR.r, LANE_MARKER_COLOR.g,
+                backend->setDrawColor(LANE_MARKER_COLOR.r, LANE_MARKER_COLOR.g,
                                      LANE_MARKER_COLOR.b, LANE_MARKER_COLOR.a);
             }
 
@@ -233,46 +243,46 @@ public:
             for (int y = 0; y < windowHeight; y += 30) {
                 if (y < windowHeight/2 - ROAD_WIDTH/2 || y > windowHeight/2 + ROAD_WIDTH/2) {
                     SDL_FRect line = {(float)x - 2, (float)y, 4, 15};
-                    SDL_RenderFillRect(rendererSDL, &line);
+                    backend->fillRect(&line);
                 }
             }
         }
 
         // Draw crosswalks
-        SDL_SetRenderDrawColor(rendererSDL, 255, 255, 255, 255);
+        backend->setDrawColor(255, 255, 255, 255);
 
         // North crosswalk
         for (int i = 0; i < 10; i++) {
             SDL_FRect stripe = {(float)(windowWidth/2 - ROAD_WIDTH/2 + 15*i),
                                (float)(windowHeight/2 - ROAD_WIDTH/2 - 15), 10, 15};
-            SDL_RenderFillRect(rendererSDL, &stripe);
+            backend->fillRect(&stripe);
         }
 
         // South crosswalk
         for (int i = 0; i < 10; i++) {
             SDL_FRect stripe = {(float)(windowWidth/2 - ROAD_WIDTH/2 + 15*i),
                                (float)(windowHeight/2 + ROAD_WIDTH/2), 10, 15};
-            SDL_RenderFillRect(rendererSDL, &stripe);
+            backend->fillRect(&stripe);
         }
 
         // East crosswalk
         for (int i = 0; i < 10; i++) {
             SDL_FRect stripe = {(float)(windowWidth/2 + ROAD_WIDTH/2),
                                (float)(windowHeight/2 - ROAD_WIDTH/2 + 15*i), 15, 10};
-            SDL_RenderFillRect(rendererSDL, &stripe);
+            backend->fillRect(&stripe);
         }
 
         // West crosswalk
         for (int i = 0; i < 10; i++) {
             SDL_FRect stripe = {(float)(windowWidth/2 - ROAD_WIDTH/2 - 15),
                                (float)(windowHeight/2 - ROAD_WIDTH/2 + 15*i), 15, 10};
-            SDL_RenderFillRect(rendererSDL, &stripe);
+            backend->fillRect(&stripe);
         }
     }
 
     // Render a frame
     void renderFrame() {
-        if (!active || !rendererSDL || !trafficMgr) {
+        if (!active || !backend || !trafficMgr) {
             return;
         }
 
@@ -281,16 +291,16 @@ public:
 
         // Draw traffic lights
         if (trafficMgr->getTrafficLight()) {
-            trafficMgr->getTrafficLight()->render(rendererSDL);
+            trafficMgr->getTrafficLight()->render(backend);
         }
 
         // Draw vehicles
-        for (auto* lane : trafficMgr->getLanes()) {
+        for (auto* lane : trafficMgr->getJunctionLanes(trafficMgr->getNetwork().getEntryJunction())) {
             for (auto* vehicle : lane->getVehicles()) {
                 if (vehicle) {
                     // Create default parameters for vehicle rendering
                     int queuePos = 0; // Not important for this call
-                    vehicle->render(rendererSDL, nullptr, queuePos);
+                    vehicle->render(backend, 0, queuePos);
                 }
             }
         }
@@ -301,7 +311,24 @@ public:
         }
 
         // Present render
-        SDL_RenderPresent(rendererSDL);
+        backend->present();
+    }
+
+    // Handle one SDL event
+    void handleEvent(const SDL_Event& event, bool& running) {
+        if (event.type == SDL_EVENT_QUIT) {
+            running = false;
+        } else if (event.type == SDL_EVENT_KEY_DOWN) {
+            // Fixed SDL3 key handling
+            int key = event.key.which;
+
+            if (key == SDL_SCANCODE_D) {
+                showDebug = !showDebug;
+                log_message("Debug overlay " + std::string(showDebug ? "enabled" : "disabled"));
+            } else if (key == SDL_SCANCODE_ESCAPE) {
+                running = false;
+            }
+        }
     }
 
     // Start render loop
@@ -315,39 +342,54 @@ public:
         bool running = true;
         uint32_t lastUpdateTime = SDL_GetTicks();
 
+        // Lane file writes wake the loop through an SDL event while it is idle
+        Uint32 wakeEvent = SDL_RegisterEvents(1);
+        bool watching = trafficMgr && wakeEvent != 0 &&
+            trafficMgr->watchLaneFiles([wakeEvent]() {
+                SDL_Event wake = {};
+                wake.type = wakeEvent;
+                SDL_PushEvent(&wake);
+            });
+        if (!watching) {
+            log_message("Lane file watch unavailable, polling every frame");
+        }
+        log_message(ThreadRoles::report());
+
         while (running) {
-            // Process events
             SDL_Event event;
-            while (SDL_PollEvent(&event)) {
-                if (event.type == SDL_EVENT_QUIT) {
-                    running = false;
-                } else if (event.type == SDL_EVENT_KEY_DOWN) {
-                    // Fixed SDL3 key handling
-                    int key = event.key.which;
-
-                    if (key == SDL_SCANCODE_D) {
-                        showDebug = !showDebug;
-                        log_message("Debug overlay " + std::string(showDebug ? "enabled" : "disabled"));
-                    } else if (key == SDL_SCANCODE_ESCAPE) {
-                        running = false;
-                    }
+
+            // Nothing to simulate: sleep until input, a lane file write or the
+            // next light change instead of spinning at 60 FPS
+            if (watching && trafficMgr->isIdle()) {
+                uint32_t timeout = std::min<uint32_t>(trafficMgr->getIdleTimeout(), INT32_MAX);
+                if (SDL_WaitEventTimeout(&event, static_cast<Sint32>(timeout))) {
+                    handleEvent(event, running);
                 }
             }
 
+            // Process events
+            while (SDL_PollEvent(&event)) {
+                handleEvent(event, running);
+            }
+
             // Calculate delta time
             uint32_t currentTime = SDL_GetTicks();
             uint32_t deltaTime = currentTime - lastUpdateTime;
 
             // Update traffic manager
             if (trafficMgr) {
+                jitter.tickStarted();
                 trafficMgr->update(deltaTime);
+                jitter.tickFinished();
             }
 
             // Render frame
             renderFrame();
 
             // Limit frame rate
+            auto wake = TickJitter::Clock::now() + std::chrono::milliseconds(16);
             SDL_Delay(16); // ~60 FPS
+            jitter.woke(wake);
 
             lastUpdateTime = currentTime;
         }
@@ -358,25 +400,25 @@ public:
         if (!trafficMgr) return;
 
         // Draw semi-transparent background
-        SDL_SetRenderDrawColor(rendererSDL, 0, 0, 0, 180);
-        SDL_SetRenderDrawBlendMode(rendererSDL, SDL_BLENDMODE_BLEND);
+        backend->setDrawColor(0, 0, 0, 180);
+        backend->setDrawBlendMode(SDL_BLENDMODE_BLEND);
         SDL_FRect overlayRect = {10, 10, 200, 100}; // Much smaller overlay
-        SDL_RenderFillRect(rendererSDL, &overlayRect);
-        SDL_SetRenderDrawBlendMode(rendererSDL, SDL_BLENDMODE_NONE);
+        backend->fillRect(&overlayRect);
+        backend->setDrawBlendMode(SDL_BLENDMODE_NONE);
 
         // Draw border
-        SDL_SetRenderDrawColor(rendererSDL, 255, 255, 255, 255);
-        SDL_RenderRect(rendererSDL, &overlayRect);
+        backend->setDrawColor(255, 255, 255, 255);
+        backend->drawRect(&overlayRect);
 
         // Function to draw text (simplified with rectangles)
         auto drawText = [this](const std::string& text, float x, float y, SDL_Color color) {
-            SDL_SetRenderDrawColor(rendererSDL, color.r, color.g, color.b, color.a);
+            backend->setDrawColor(color.r, color.g, color.b, color.a);
             SDL_FRect rect = {x, y, text.length() * 7.0f, 16.0f};
-            SDL_RenderFillRect(rendererSDL, &rect);
+            backend->fillRect(&rect);
 
             // Black border
-            SDL_SetRenderDrawColor(rendererSDL, 0, 0, 0, 255);
-            SDL_RenderRect(rendererSDL, &rect);
+            backend->setDrawColor(0, 0, 0, 255);
+            backend->drawRect(&rect);
         };
 
         // Title
@@ -424,6 +466,12 @@ public:
 
     // Clean up resources
     void cleanup() {
+        if (backend) {
+            GlowTextures::release(backend);
+            delete backend;
+            backend = nullptr;
+        }
+
         if (rendererSDL) {
             SDL_DestroyRenderer(rendererSDL);
             rendererSDL = nullptr;
@@ -446,13 +494,70 @@ int main(int argc, char* argv[]) {
         log_message("Starting Traffic Junction Simulator");
 
 
+        // Parse command line options
+        std::string replayPath;
+        std::string networkPath;
+        double replaySpeed = 1.0;
+        int replayStartHour = 0;
+        int threads = 1;
+        bool fixedPoint = false;
+        std::string threadRoles;
+        std::string jitterPath;
+
+        for (int i = 1; i < argc; i++) {
+            std::string arg = argv[i];
+            bool hasValue = i + 1 < argc;
+
+            if (arg == "--replay" && hasValue) {
+                replayPath = argv[++i];
+            } else if (arg == "--speed" && hasValue) {
+                replaySpeed = std::atof(argv[++i]);
+            } else if (arg == "--start-hour" && hasValue) {
+                replayStartHour = std::atoi(argv[++i]);
+            } else if (arg == "--network" && hasValue) {
+                networkPath = argv[++i];
+            } else if (arg == "--threads" && hasValue) {
+                threads = std::atoi(argv[++i]);
+            } else if (arg == "--fixed-point") {
+                fixedPoint = true;
+            } else if (arg == "--thread-roles" && hasValue) {
+                threadRoles = argv[++i];
+            } else if (arg == "--jitter-out" && hasValue) {
+                jitterPath = argv[++i];
+            } else {
+                std::cout << "Usage: simulator [--network <file>] [--threads N] [--fixed-point] [--replay <trace> [--speed X] [--start-hour H]]\n"
+                          << "                 [--thread-roles <spec>] [--jitter-out <file>]" << std::endl;
+                return arg == "--help" ? 0 : 1;
+            }
+        }
+
+        // Thread placement must be known before any thread starts
+        std::string roleError;
+        if (!ThreadRoles::configureFromEnvironment(roleError) ||
+            (!threadRoles.empty() && !ThreadRoles::configure(threadRoles, roleError))) {
+            log_message("Bad thread roles: " + roleError);
+            return 1;
+        }
+        ThreadRoles::assignCurrent(ThreadRoles::Role::SIMULATION, "sim-render");
+        DebugLogger::startFlushThread();
+
         // Create traffic manager
         TrafficManager trafficManager;
-        if (!trafficManager.initialize()) {
+        if (!trafficManager.initialize(networkPath)) {
             log_message("Failed to initialize traffic manager");
             SDL_Quit();
             return 1;
         }
+        trafficManager.setWorkerThreads(threads > 1 ? static_cast<size_t>(threads) : 1);
+        trafficManager.setFixedPointKinematics(fixedPoint);
+
+        // Replay a recorded workload instead of the live lane files
+        if (!replayPath.empty() &&
+            !trafficManager.loadArrivalTrace(replayPath, replaySpeed, replayStartHour)) {
+            log_message("Failed to load arrival trace: " + replayPath);
+            SDL_Quit();
+            return 1;
+        }
 
         // Create renderer
         RenderSystem renderer;
@@ -476,7 +581,14 @@ int main(int argc, char* argv[]) {
         renderer.cleanup();
         SDL_Quit();
 
+        log_message("Fuel and emissions:\n" + trafficManager.getEmissionsSummary());
+        log_message("Signal phases:\n" + trafficManager.getPhaseReport());
+        log_message("Tick jitter (us): " + renderer.jitter.summary());
+        if (!jitterPath.empty() && !renderer.jitter.exportTo(jitterPath)) {
+            log_message("Failed to write " + jitterPath);
+        }
         log_message("Simulator shutdown complete");
+        DebugLogger::stopFlushThread();
         return 0;
     }
     catch (const std::exception& e) {
@@ -1,21 +1,35 @@
 // FILE: src/managers/FileHandler.cpp
 #include "managers/FileHandler.h"
 #include "utils/DebugLogger.h"
+#include "utils/ThreadRoles.h"
 #include <fstream>
 #include <sstream>
 #include <filesystem>
 #include <thread>
 #include <chrono>
+#include <cstring>
+
+#ifdef __linux__
+#include <poll.h>
+#include <unistd.h>
+#include <sys/eventfd.h>
+#include <sys/inotify.h>
+#endif
 
 namespace fs = std::filesystem;
 
 FileHandler::FileHandler(const std::string& dataPath)
-    : dataPath(dataPath) {
+    : dataPath(dataPath),
+      watchFd(-1),
+      stopFd(-1),
+      changed(true),
+      statusFile(-1) {
 
     DebugLogger::log("FileHandler created with path: " + dataPath);
 }
 
 FileHandler::~FileHandler() {
+    stopWatching();
     DebugLogger::log("FileHandler destroyed");
 }
 
@@ -29,13 +43,23 @@ std::vector<Vehicle*> FileHandler::readVehiclesFromFiles() {
         return vehicles;
     }
 
-    // Read from each lane file (A, B, C, D)
+    // Read the four lane files (A, B, C, D) in one batch
+    std::vector<std::string> paths;
     for (char laneId : {'A', 'B', 'C', 'D'}) {
-        std::string filePath = getLaneFilePath(laneId);
+        paths.push_back(getLaneFilePath(laneId));
+    }
+    std::vector<std::string> contents;
+    if (!io.readFiles(paths, contents)) {
+        DebugLogger::log("Error reading lane files: " + io.getLastError(), DebugLogger::LogLevel::ERROR);
+
+        // Unread files keep their vehicles for the next read
+        changed = true;
+    }
 
-        // Only try to read if file exists
-        if (fs::exists(filePath)) {
-            auto laneVehicles = readVehiclesFromFile(laneId);
+    const char laneIds[] = {'A', 'B', 'C', 'D'};
+    for (size_t i = 0; i < paths.size(); i++) {
+        if (!contents[i].empty()) {
+            auto laneVehicles = takeVehiclesFromFile(laneIds[i], contents[i]);
             vehicles.insert(vehicles.end(), laneVehicles.begin(), laneVehicles.end());
         }
     }
@@ -50,41 +74,25 @@ std::vector<Vehicle*> FileHandler::readVehiclesFromFiles() {
     return vehicles;
 }
 
-std::vector<Vehicle*> FileHandler::readVehiclesFromFile(char laneId) {
-    std::vector<Vehicle*> vehicles;
+std::vector<Vehicle*> FileHandler::takeVehiclesFromFile(char laneId, const std::string& content) {
     std::string filePath = getLaneFilePath(laneId);
-
-    // Multiple attempts to open file (addresses file locking issues)
-    std::ifstream file;
-    int attempts = 0;
-    while (attempts < 3) {
-        file.open(filePath);
-        if (file.is_open()) {
-            break;
-        }
-        // Wait and retry if file is locked
-        std::this_thread::sleep_for(std::chrono::milliseconds(50));
-        attempts++;
-    }
-
-    if (!file.is_open()) {
-        return vehicles;
-    }
-
     std::vector<std::string> lines;
+    std::istringstream stream(content);
     std::string line;
 
-    // Read all lines from file
-    while (std::getline(file, line)) {
+    // Split into lines, tolerating CRLF files
+    while (std::getline(stream, line)) {
+        if (!line.empty() && line.back() == '\r') {
+            line.pop_back();
+        }
         if (!line.empty()) {
             lines.push_back(line);
         }
     }
-    file.close();
 
     // Don't modify file if no lines were read
     if (lines.empty()) {
-        return vehicles;
+        return {};
     }
 
     // Process lines first before clearing file (prevents data loss if parsing fails)
@@ -98,7 +106,7 @@ std::vector<Vehicle*> FileHandler::readVehiclesFromFile(char laneId) {
 
     // Clear the file after reading to prevent duplicates - with error handling
     bool fileClearedSuccessfully = false;
-    attempts = 0;
+    int attempts = 0;
     while (!fileClearedSuccessfully && attempts < 3) {
         try {
             std::ofstream clearFile(filePath, std::ios::trunc);
@@ -214,27 +222,40 @@ Vehicle* FileHandler::parseVehicleLine(const std::string& line) {
 
 void FileHandler::writeLaneStatus(char laneId, int laneNumber, int vehicleCount, bool isPriority) {
     std::lock_guard<std::mutex> lock(mutex);
-    std::string statusPath = getLaneStatusFilePath();
 
-    // Make sure the directory exists
-    fs::path dir = fs::path(statusPath).parent_path();
-    if (!fs::exists(dir)) {
-        try {
-            fs::create_directories(dir);
-        } catch (const std::exception& e) {
-            DebugLogger::log("Error creating directory: " + std::string(e.what()),
-                           DebugLogger::LogLevel::ERROR);
+    if (statusFile < 0) {
+        std::string statusPath = getLaneStatusFilePath();
+
+        // Make sure the directory exists
+        fs::path dir = fs::path(statusPath).parent_path();
+        if (!fs::exists(dir)) {
+            try {
+                fs::create_directories(dir);
+            } catch (const std::exception& e) {
+                DebugLogger::log("Error creating directory: " + std::string(e.what()),
+                               DebugLogger::LogLevel::ERROR);
+                return;
+            }
+        }
+
+        statusFile = io.openForWrite(statusPath, false);
+        if (statusFile < 0) {
+            DebugLogger::log("Warning: Could not open lane status file for writing",
+                           DebugLogger::LogLevel::WARNING);
             return;
         }
     }
 
-    std::ofstream file(statusPath, std::ios::app);
-    if (file.is_open()) {
-        file << laneId << laneNumber << ": " << vehicleCount << " vehicles"
-             << (isPriority ? " (PRIORITY)" : "") << std::endl;
-        file.close();
-    } else {
-        DebugLogger::log("Warning: Could not open lane status file for writing",
+    std::ostringstream line;
+    line << laneId << laneNumber << ": " << vehicleCount << " vehicles"
+         << (isPriority ? " (PRIORITY)" : "") << "\n";
+    io.append(statusFile, line.str());
+}
+
+void FileHandler::flushStatus() {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (!io.flush()) {
+        DebugLogger::log("Warning: Could not write lane status file: " + io.getLastError(),
                        DebugLogger::LogLevel::WARNING);
     }
 }
@@ -289,15 +310,15 @@ bool FileHandler::initializeFiles() {
         }
 
         // Create or clear lane status file
-        std::string statusPath = getLaneStatusFilePath();
-        std::ofstream statusFile(statusPath, std::ios::trunc);
-        if (!statusFile.is_open()) {
+        io.closeFile(statusFile);
+        statusFile = io.openForWrite(getLaneStatusFilePath(), true);
+        if (statusFile < 0) {
             DebugLogger::log("Error: Failed to create lane status file",
                            DebugLogger::LogLevel::ERROR);
             return false;
         }
-        statusFile << "=== Lane Status Log ===\n";
-        statusFile.close();
+        io.append(statusFile, "=== Lane Status Log ===\n");
+        io.flush();
 
         DebugLogger::log("All files initialized successfully");
         return true;
@@ -315,3 +336,123 @@ std::string FileHandler::getLaneFilePath(char laneId) const {
 std::string FileHandler::getLaneStatusFilePath() const {
     return dataPath + "/lane_status.txt";
 }
+
+bool FileHandler::startWatching(std::function<void()> onChange) {
+#ifdef __linux__
+    if (watcher.joinable()) {
+        return true;
+    }
+
+    watchFd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+    if (watchFd < 0) {
+        DebugLogger::log("inotify unavailable: " + std::string(std::strerror(errno)),
+                       DebugLogger::LogLevel::WARNING);
+        return false;
+    }
+
+    // The generator appends and closes; atomic writers rename into place
+    if (inotify_add_watch(watchFd, dataPath.c_str(), IN_CLOSE_WRITE | IN_MOVED_TO) < 0) {
+        DebugLogger::log("Cannot watch " + dataPath + ": " + std::strerror(errno),
+                       DebugLogger::LogLevel::WARNING);
+        close(watchFd);
+        watchFd = -1;
+        return false;
+    }
+
+    stopFd = eventfd(0, EFD_CLOEXEC);
+    if (stopFd < 0) {
+        close(watchFd);
+        watchFd = -1;
+        return false;
+    }
+
+    // Files may have been written before the watch existed
+    changed = true;
+    changeCallback = onChange;
+    watcher = std::thread(&FileHandler::watchLoop, this);
+    ThreadRoles::assign(watcher, ThreadRoles::Role::INGEST, "ingest");
+
+    DebugLogger::log("Watching lane files in " + dataPath);
+    return true;
+#else
+    (void)onChange;
+    return false;
+#endif
+}
+
+void FileHandler::stopWatching() {
+#ifdef __linux__
+    if (!watcher.joinable()) {
+        return;
+    }
+
+    uint64_t one = 1;
+    if (write(stopFd, &one, sizeof(one)) != sizeof(one)) {
+        DebugLogger::log("Failed to signal the lane file watcher", DebugLogger::LogLevel::ERROR);
+    }
+    ThreadRoles::release(watcher);
+    watcher.join();
+
+    close(watchFd);
+    close(stopFd);
+    watchFd = -1;
+    stopFd = -1;
+    changeCallback = nullptr;
+#endif
+}
+
+bool FileHandler::hasChanges() const {
+    // Without a watch every check may find new vehicles
+    return !watcher.joinable() || changed.load();
+}
+
+bool FileHandler::takeChanges() {
+    return !watcher.joinable() || changed.exchange(false);
+}
+
+void FileHandler::watchLoop() {
+#ifdef __linux__
+    alignas(struct inotify_event) char buffer[4096];
+
+    while (true) {
+        struct pollfd fds[2] = {{watchFd, POLLIN, 0}, {stopFd, POLLIN, 0}};
+        if (poll(fds, 2, -1) < 0) {
+            if (errno == EINTR) continue;
+            DebugLogger::log("Lane file watch failed: " + std::string(std::strerror(errno)),
+                           DebugLogger::LogLevel::ERROR);
+            changed = true;
+            return;
+        }
+        if (fds[1].revents) {
+            return;
+        }
+
+        // Only the lane files carry arrivals; the status file is ours
+        bool laneFileWritten = false;
+        ssize_t length;
+        while ((length = read(watchFd, buffer, sizeof(buffer))) > 0) {
+            for (char* p = buffer; p < buffer + length; ) {
+                const struct inotify_event* event = reinterpret_cast<const struct inotify_event*>(p);
+                if (event->mask & IN_Q_OVERFLOW) {
+                    laneFileWritten = true;
+                } else if (event->len > 0) {
+                    std::string name(event->name);
+                    for (char laneId : {'A', 'B', 'C', 'D'}) {
+                        if (name == std::string("lane") + laneId + ".txt") {
+                            laneFileWritten = true;
+                        }
+                    }
+                }
+                p += sizeof(struct inotify_event) + event->len;
+            }
+        }
+
+        if (laneFileWritten) {
+            changed = true;
+            if (changeCallback) {
+                changeCallback();
+            }
+        }
+    }
+#endif
+}
@@ -0,0 +1,197 @@
+// FILE: src/managers/LiveStatus.cpp
+#include "managers/LiveStatus.h"
+#include "managers/TrafficManager.h"
+#include <chrono>
+#include <cstring>
+#include <new>
+#include <thread>
+#include <unistd.h>
+
+static_assert(sizeof(LiveStatus::Header) == 128, "Header is part of the shared memory layout");
+static_assert(sizeof(LiveStatus::Metrics) == 64, "Metrics is part of the shared memory layout");
+static_assert(sizeof(LiveStatus::JunctionStatus) == 16, "JunctionStatus is part of the shared memory layout");
+static_assert(sizeof(LiveStatus::LaneStatus) == 16, "LaneStatus is part of the shared memory layout");
+static_assert(std::atomic<uint64_t>::is_always_lock_free, "The seqlock must work across processes");
+
+namespace {
+
+// Reader spins this many times on a busy region before yielding the CPU
+const int SPINS_BEFORE_YIELD = 64;
+
+} // namespace
+
+LiveStatus::LiveStatus()
+    : header(nullptr),
+      writer(false),
+      retries(0),
+      percentileCount(0) {}
+
+size_t LiveStatus::payloadBytes(uint32_t junctionCount, uint32_t laneCount) {
+    return sizeof(Metrics) + junctionCount * sizeof(JunctionStatus) + laneCount * sizeof(LaneStatus);
+}
+
+bool LiveStatus::create(const std::string& name, const TrafficManager& manager) {
+    close();
+
+    const RoadNetwork& network = manager.getNetwork();
+    uint32_t junctionCount = static_cast<uint32_t>(network.getJunctionCount());
+    uint32_t laneCount = static_cast<uint32_t>(network.getLaneCount());
+    size_t bytes = sizeof(Header) + payloadBytes(junctionCount, laneCount);
+    if (!region.create(name, bytes)) {
+        lastError = region.getLastError();
+        return false;
+    }
+
+    header = new (region.data()) Header();
+    header->magic = MAGIC;
+    header->version = VERSION;
+    header->junctionCount = junctionCount;
+    header->laneCount = laneCount;
+    header->regionBytes = bytes;
+    header->writerPid = static_cast<uint64_t>(getpid());
+    header->sequence.store(0, std::memory_order_relaxed);
+    writer = true;
+
+    staging.assign(payloadBytes(junctionCount, laneCount), 0);
+    percentileCount = 0;
+    publish(manager);
+    return true;
+}
+
+void LiveStatus::close() {
+    region.close();
+    header = nullptr;
+    writer = false;
+}
+
+void LiveStatus::publish(const TrafficManager& manager) {
+    if (!writer) {
+        return;
+    }
+
+    // Build the snapshot outside the seqlock so readers retry only while
+    // it is copied in. Metrics and lights from last time stay in staging
+    // and are overwritten field by field.
+    const RoadNetwork& network = manager.getNetwork();
+    Metrics& metrics = *reinterpret_cast<Metrics*>(staging.data());
+    JunctionStatus* junctions = reinterpret_cast<JunctionStatus*>(staging.data() + sizeof(Metrics));
+    LaneStatus* lanes = reinterpret_cast<LaneStatus*>(junctions + header->junctionCount);
+
+    uint64_t now = manager.getSimulationTime();
+    uint32_t lightClock = static_cast<uint32_t>(now);
+    for (uint32_t j = 0; j < header->junctionCount; j++) {
+        const TrafficLight* light = manager.getTrafficLight(j);
+        JunctionStatus& junction = junctions[j];
+        junction.light = static_cast<uint8_t>(light->getCurrentState());
+        junction.nextLight = static_cast<uint8_t>(light->getNextState());
+        junction.priorityMode = light->isInPriorityMode() ? 1 : 0;
+        junction.owned = manager.ownsJunction(j) ? 1 : 0;
+        junction.phaseElapsedMs = lightClock - light->getLastStateChangeTime();
+        junction.earliestChangeMs = light->getTimeToNextChange(lightClock);
+        junction.vehicles = 0;
+    }
+
+    uint32_t queued = 0;
+    const std::vector<Lane*>& managerLanes = manager.getLanes();
+    for (uint32_t i = 0; i < header->laneCount; i++) {
+        const Lane* lane = managerLanes[i];
+        const RoadNetwork::LaneInfo& info = network.getLane(i);
+        LaneStatus& status = lanes[i];
+        status.road = info.road;
+        status.laneNumber = static_cast<uint8_t>(info.laneNumber);
+        status.flags = 0;
+        if (lane->isPriorityLane()) {
+            status.flags |= LANE_PRIORITY;
+            if (lane->getPriority() > 0) {
+                status.flags |= LANE_PRIORITIZED;
+            }
+        }
+        status.junction = info.junction;
+        status.vehicles = static_cast<uint32_t>(lane->getVehicleCount());
+        status.priority = lane->getPriority();
+        junctions[info.junction].vehicles += status.vehicles;
+        if (junctions[info.junction].owned) {
+            queued += status.vehicles;
+        }
+    }
+
+    metrics.tick++;
+    metrics.simulationTimeMs = now;
+    metrics.exited = manager.getExitedCount();
+    metrics.vehicles = static_cast<uint32_t>(manager.getVehicleCount());
+    metrics.queued = queued;
+
+    // Percentiles walk the histogram; only when there are new delays
+    const LatencyHistogram& delays = manager.getDelayHistogram();
+    if (delays.getCount() != percentileCount) {
+        percentileCount = delays.getCount();
+        metrics.delayP50Ms = static_cast<uint32_t>(delays.getPercentile(0.50));
+        metrics.delayP90Ms = static_cast<uint32_t>(delays.getPercentile(0.90));
+        metrics.delayP99Ms = static_cast<uint32_t>(delays.getPercentile(0.99));
+        metrics.delayMaxMs = static_cast<uint32_t>(delays.getMax());
+    }
+
+    EmissionsBatch::Totals emissions = manager.getEmissionTotals();
+    metrics.co2Kg = static_cast<float>(emissions.co2G / 1000.0);
+    metrics.fuelLitres = static_cast<float>(emissions.fuelMl / 1000.0);
+    metrics.publishedNanos = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count());
+
+    // Only this process writes, so the sequence can be read relaxed
+    uint64_t sequence = header->sequence.load(std::memory_order_relaxed);
+    header->sequence.store(sequence + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    std::memcpy(payload(), staging.data(), staging.size());
+    header->sequence.store(sequence + 2, std::memory_order_release);
+}
+
+bool LiveStatus::open(const std::string& name) {
+    close();
+
+    if (!region.open(name, true)) {
+        lastError = region.getLastError();
+        return false;
+    }
+
+    Header* mapped = static_cast<Header*>(region.data());
+    if (region.size() < sizeof(Header) || mapped->magic != MAGIC || mapped->version != VERSION ||
+        mapped->regionBytes != region.size() ||
+        region.size() != sizeof(Header) + payloadBytes(mapped->junctionCount, mapped->laneCount)) {
+        lastError = name + " is not a live status region (or an unsupported version)";
+        region.close();
+        return false;
+    }
+    header = mapped;
+    return true;
+}
+
+bool LiveStatus::read(Snapshot& snapshot, int attempts) const {
+    retries = 0;
+    if (!header) {
+        return false;
+    }
+
+    snapshot.junctions.resize(header->junctionCount);
+    snapshot.lanes.resize(header->laneCount);
+    const char* junctions = payload() + sizeof(Metrics);
+    const char* lanes = junctions + header->junctionCount * sizeof(JunctionStatus);
+
+    for (int attempt = 0; attempt < attempts; attempt++) {
+        uint64_t before = header->sequence.load(std::memory_order_acquire);
+        if (!(before & 1)) {
+            std::memcpy(&snapshot.metrics, payload(), sizeof(Metrics));
+            std::memcpy(snapshot.junctions.data(), junctions, snapshot.junctions.size() * sizeof(JunctionStatus));
+            std::memcpy(snapshot.lanes.data(), lanes, snapshot.lanes.size() * sizeof(LaneStatus));
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if (header->sequence.load(std::memory_order_relaxed) == before) {
+                return true;
+            }
+        }
+
+        retries++;
+        if (attempt % SPINS_BEFORE_YIELD == SPINS_BEFORE_YIELD - 1) {
+            std::this_thread::yield();
+        }
+    }
+    return false;
+}
@@ -0,0 +1,462 @@
+// FILE: src/managers/PartitionCluster.cpp
+#include "managers/PartitionCluster.h"
+#include "managers/TrafficManager.h"
+#include "core/RoadNetwork.h"
+#include "utils/DebugLogger.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <limits>
+#include <new>
+#include <sstream>
+#include <signal.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+PartitionCluster::PartitionCluster(const Options& opts)
+    : options(opts),
+      control(nullptr) {}
+
+PartitionCluster::~PartitionCluster() {
+    // Don't leave workers behind if the coordinator bails out early
+    for (pid_t pid : workerPids) {
+        if (pid > 0) {
+            kill(pid, SIGTERM);
+            waitpid(pid, nullptr, 0);
+        }
+    }
+}
+
+std::string PartitionCluster::checkpointPath(uint32_t index, uint32_t step) const {
+    std::ostringstream oss;
+    oss << options.checkpointDir << "/partition" << index << "-" << step
+        << (chainStart(step) == step ? ".ckpt" : ".delta");
+    return oss.str();
+}
+
+uint32_t PartitionCluster::chainStart(uint32_t step) const {
+    // Checkpoints are taken at steps 1, 1 + interval, ...
+    uint32_t span = options.checkpointInterval * options.baseInterval;
+    return step == 0 ? 0 : (step - 1) / span * span + 1;
+}
+
+bool PartitionCluster::restoreCheckpoint(TrafficManager& manager, uint32_t index, uint32_t step) const {
+    uint32_t start = chainStart(step);
+    if (!manager.loadCheckpoint(checkpointPath(index, start))) {
+        return false;
+    }
+    for (uint32_t s = start + options.checkpointInterval; s <= step; s += options.checkpointInterval) {
+        if (!manager.applyDeltaCheckpoint(checkpointPath(index, s))) {
+            return false;
+        }
+    }
+    return true;
+}
+
+void PartitionCluster::removeChain(uint32_t index, uint32_t start) const {
+    uint32_t span = options.checkpointInterval * options.baseInterval;
+    for (uint32_t s = start; s < start + span; s += options.checkpointInterval) {
+        std::remove(checkpointPath(index, s).c_str());
+    }
+}
+
+bool PartitionCluster::createRegion() {
+    uint32_t parts = options.partitions;
+    size_t ringBytes = SpscRing<TransferRecord>::bytesFor(options.ringCapacity);
+    size_t controlBytes = (sizeof(Control) + 63) & ~static_cast<size_t>(63);
+
+    std::ostringstream name;
+    name << "/tjsim-" << getpid();
+    if (!region.create(name.str(), controlBytes + parts * parts * ringBytes)) {
+        std::cerr << "Failed to create shared memory: " << region.getLastError() << std::endl;
+        return false;
+    }
+
+    char* base = static_cast<char*>(region.data());
+    control = new (base) Control();
+    control->step.store(0);
+    control->epoch.store(0);
+    control->rollbackStep.store(0);
+    control->stop.store(0);
+
+    // One ring per ordered pair; the diagonal is unused but keeps indexing simple
+    rings.resize(parts * parts);
+    for (size_t r = 0; r < rings.size(); r++) {
+        rings[r].attach(base + controlBytes + r * ringBytes, options.ringCapacity, true);
+    }
+
+    return true;
+}
+
+bool PartitionCluster::spawnWorker(uint32_t index, bool restore) {
+    WorkerSlot& slot = control->workers[index];
+    slot.ready.store(0);
+
+    // Buffered log lines would otherwise be written by both processes
+    DebugLogger::flush();
+    pid_t pid = fork();
+    if (pid < 0) {
+        std::cerr << "fork failed for partition " << index << std::endl;
+        return false;
+    }
+    if (pid == 0) {
+        runWorker(index, restore);
+    }
+
+    workerPids[index] = pid;
+    return true;
+}
+
+void PartitionCluster::runWorker(uint32_t index, bool restore) {
+    // The console belongs to the coordinator; each worker logs to its own file
+    if (!std::freopen("/dev/null", "w", stdout)) {
+        _exit(2);
+    }
+    DebugLogger::initializeAfterFork("traffic_simulator.partition" + std::to_string(index) + ".log");
+
+    TrafficManager manager;
+    if (!manager.initialize(options.networkPath)) {
+        _exit(2);
+    }
+
+    const RoadNetwork& network = manager.getNetwork();
+    std::vector<uint32_t> bounds = network.partitionJunctions(options.partitions);
+    manager.setPartition(bounds[index], bounds[index + 1]);
+    if (!options.tracePath.empty() && manager.ownsJunction(network.getEntryJunction()) &&
+        !manager.loadArrivalTrace(options.tracePath, options.replaySpeed)) {
+        _exit(2);
+    }
+    manager.start();
+
+    // Partition owning each junction
+    std::vector<uint32_t> owner(network.getJunctionCount());
+    for (uint32_t p = 0; p < options.partitions; p++) {
+        for (uint32_t j = bounds[p]; j < bounds[p + 1]; j++) {
+            owner[j] = p;
+        }
+    }
+
+    WorkerSlot& slot = control->workers[index];
+    uint32_t epoch = restore ? std::numeric_limits<uint32_t>::max() : control->epoch.load();
+    uint32_t lastStep = 0;
+
+    // False after a failed save until the next base: deltas after the gap
+    // can't be restored, so they aren't offered for rollback
+    bool chainComplete = false;
+
+    slot.doneStep.store(0);
+    slot.epoch.store(control->epoch.load());
+    slot.ready.store(1);
+
+    while (!control->stop.load()) {
+        // Roll back to the agreed checkpoint after another worker died
+        uint32_t currentEpoch = control->epoch.load();
+        if (currentEpoch != epoch) {
+            uint32_t rollback = control->rollbackStep.load();
+            if (!restoreCheckpoint(manager, index, rollback)) {
+                DebugLogger::flush();
+                _exit(3);
+            }
+            chainComplete = true;
+            lastStep = rollback - 1;
+            slot.doneStep.store(lastStep);
+            slot.epoch.store(currentEpoch);
+            epoch = currentEpoch;
+            continue;
+        }
+
+        // Wait at the step barrier
+        if (control->step.load() <= lastStep) {
+            usleep(20);
+            continue;
+        }
+        uint32_t step = lastStep + 1;
+
+        // Take vehicles other partitions handed over during earlier steps
+        TransferRecord record;
+        for (uint32_t from = 0; from < options.partitions; from++) {
+            if (from == index) continue;
+            SpscRing<TransferRecord>& ring = rings[from * options.partitions + index];
+            while (ring.peek(record) && record.step < step) {
+                ring.pop(record);
+
+                TrafficManager::VehicleTransfer transfer;
+                transfer.arrivalTime = record.arrivalTime;
+                transfer.laneIndex = record.laneIndex;
+                transfer.routeTarget = record.routeTarget;
+                transfer.vehicleId.assign(record.vehicleId, record.idLength);
+                transfer.destination = static_cast<Destination>(record.destination);
+                transfer.isEmergency = record.isEmergency != 0;
+                manager.acceptTransfer(transfer);
+                slot.received.fetch_add(1);
+            }
+        }
+
+        // Checkpoint at the start of the step. The coordinator may roll back
+        // to the previous checkpoint as well, so its chain is kept until the
+        // next base replaces it.
+        if ((step - 1) % options.checkpointInterval == 0) {
+            bool base = chainStart(step) == step;
+            std::string path = checkpointPath(index, step);
+            bool saved = base ? manager.saveCheckpoint(path) : manager.saveDeltaCheckpoint(path);
+            chainComplete = saved && (base || chainComplete);
+            if (chainComplete) {
+                slot.checkpointStep.store(step);
+            }
+            uint32_t span = options.checkpointInterval * options.baseInterval;
+            if (base && step > 2 * span) {
+                removeChain(index, step - 2 * span);
+            }
+        }
+
+        if (static_cast<int>(index) == options.crashPartition && step == options.crashStep && !restore) {
+            std::abort();
+        }
+
+        manager.update(options.stepMs);
+
+        // Hand vehicles leaving the partition to their new owners. Those that
+        // don't fit in a full ring go back to the manager, whose checkpoints
+        // keep them until they are sent.
+        std::vector<TrafficManager::VehicleTransfer> unsent;
+        for (const auto& transfer : manager.takeOutgoingTransfers()) {
+            TransferRecord out;
+            std::memset(&out, 0, sizeof(out));
+            out.step = step;
+            out.laneIndex = transfer.laneIndex;
+            out.routeTarget = transfer.routeTarget;
+            out.destination = static_cast<uint8_t>(transfer.destination);
+            out.isEmergency = transfer.isEmergency ? 1 : 0;
+            out.idLength = static_cast<uint8_t>(std::min<size_t>(transfer.vehicleId.size(), sizeof(out.vehicleId)));
+            out.arrivalTime = transfer.arrivalTime;
+            std::memcpy(out.vehicleId, transfer.vehicleId.data(), out.idLength);
+
+            uint32_t to = owner[network.getLane(transfer.laneIndex).junction];
+            if (rings[index * options.partitions + to].push(out)) {
+                slot.sent.fetch_add(1);
+            } else {
+                unsent.push_back(transfer);
+            }
+        }
+        manager.returnOutgoingTransfers(unsent);
+
+        slot.vehicles.store(manager.getVehicleCount());
+        slot.exited.store(manager.getExitedCount());
+        slot.doneStep.store(step);
+        lastStep = step;
+    }
+
+    DebugLogger::flush();
+    std::fflush(nullptr);
+    _exit(0);
+}
+
+int PartitionCluster::checkCrashes() {
+    int status = 0;
+    pid_t pid;
+    while ((pid = waitpid(-1, &status, WNOHANG)) > 0) {
+        for (uint32_t i = 0; i < workerPids.size(); i++) {
+            if (workerPids[i] == pid) {
+                workerPids[i] = -1;
+                std::cerr << "Partition " << i << " (pid " << pid << ") died"
+                          << (WIFSIGNALED(status) ? " from signal " + std::to_string(WTERMSIG(status))
+                                                  : " with status " + std::to_string(WEXITSTATUS(status)))
+                          << std::endl;
+                return static_cast<int>(i);
+            }
+        }
+    }
+    return -1;
+}
+
+uint32_t PartitionCluster::recover(uint32_t crashed) {
+    uint32_t parts = options.partitions;
+    uint32_t current = control->step.load();
+
+    // Let the survivors finish the current step so every ring is idle
+    for (;;) {
+        bool idle = true;
+        for (uint32_t i = 0; i < parts; i++) {
+            if (i != crashed && control->workers[i].doneStep.load() < current) idle = false;
+        }
+        if (idle) break;
+        if (checkCrashes() >= 0) {
+            std::cerr << "Another partition died during recovery" << std::endl;
+            return 0;
+        }
+        usleep(50);
+    }
+
+    // Newest checkpoint every partition has
+    uint32_t rollback = std::numeric_limits<uint32_t>::max();
+    for (uint32_t i = 0; i < parts; i++) {
+        rollback = std::min(rollback, control->workers[i].checkpointStep.load());
+    }
+    if (rollback == 0) {
+        std::cerr << "No checkpoint to recover from" << std::endl;
+        return 0;
+    }
+
+    // Hold everyone before the rollback step and discard in-flight transfers;
+    // they are re-sent when the steps are replayed
+    control->step.store(rollback - 1);
+    for (auto& ring : rings) {
+        ring.reset();
+    }
+    control->rollbackStep.store(rollback);
+    uint32_t epoch = control->epoch.load() + 1;
+    control->epoch.store(epoch);
+
+    if (!spawnWorker(crashed, true)) {
+        return 0;
+    }
+
+    // Wait for every partition to reload its checkpoint
+    for (;;) {
+        bool restored = true;
+        for (uint32_t i = 0; i < parts; i++) {
+            if (control->workers[i].epoch.load() != epoch) restored = false;
+        }
+        if (restored) break;
+        if (checkCrashes() >= 0) {
+            std::cerr << "A partition died while restoring" << std::endl;
+            return 0;
+        }
+        usleep(50);
+    }
+
+    std::cout << "Recovered partition " << crashed << ": resumed all partitions from step "
+              << rollback << " (lost " << current - rollback << " steps)" << std::endl;
+    return rollback;
+}
+
+void PartitionCluster::report(uint32_t step, double elapsedSeconds) const {
+    uint64_t vehicles = 0, exited = 0, sent = 0, received = 0;
+    for (uint32_t i = 0; i < options.partitions; i++) {
+        const WorkerSlot& slot = control->workers[i];
+        vehicles += slot.vehicles.load();
+        exited += slot.exited.load();
+        sent += slot.sent.load();
+        received += slot.received.load();
+    }
+
+    std::cout << "step " << step << ": " << vehicles << " vehicles, " << exited << " exited, "
+              << sent << " sent / " << received << " received across partitions, "
+              << (elapsedSeconds > 0.0 ? step / elapsedSeconds : 0.0) << " steps/s" << std::endl;
+}
+
+int PartitionCluster::run() {
+    // Clamp the partition count to the network size
+    RoadNetwork network;
+    if (options.networkPath.empty()) {
+        network.buildDefault();
+    } else if (!network.loadFromFile(options.networkPath)) {
+        std::cerr << "Failed to load network: " << network.getLastError() << std::endl;
+        return 1;
+    }
+    options.partitions = std::max<uint32_t>(1, std::min<uint32_t>(
+        std::min<uint32_t>(options.partitions, MAX_PARTITIONS), static_cast<uint32_t>(network.getJunctionCount())));
+    options.checkpointInterval = std::max<uint32_t>(1, options.checkpointInterval);
+    options.baseInterval = std::max<uint32_t>(1, options.baseInterval);
+
+    if (!createRegion()) {
+        return 1;
+    }
+
+    std::vector<uint32_t> bounds = network.partitionJunctions(options.partitions);
+    std::cout << "Running " << network.getJunctionCount() << " junctions as " << options.partitions
+              << " partitions:";
+    for (uint32_t p = 0; p < options.partitions; p++) {
+        std::cout << " [" << bounds[p] << "," << bounds[p + 1] << ")";
+    }
+    std::cout << std::endl;
+
+    // Flush before forking so buffered output isn't duplicated
+    std::cout.flush();
+    workerPids.assign(options.partitions, -1);
+    for (uint32_t i = 0; i < options.partitions; i++) {
+        if (!spawnWorker(i, false)) {
+            return 1;
+        }
+    }
+
+    // Wait for every worker to finish loading
+    for (uint32_t i = 0; i < options.partitions; i++) {
+        while (!control->workers[i].ready.load()) {
+            if (checkCrashes() >= 0) {
+                std::cerr << "A partition failed to start" << std::endl;
+                return 1;
+            }
+            usleep(100);
+        }
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    auto elapsed = [&]() {
+        return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    };
+
+    uint32_t step = 1;
+    while (step <= options.steps) {
+        control->step.store(step);
+
+        // Step barrier: every partition has finished this step
+        bool rolledBack = false;
+        for (;;) {
+            bool done = true;
+            for (uint32_t i = 0; i < options.partitions; i++) {
+                if (control->workers[i].doneStep.load() < step) done = false;
+            }
+            if (done) break;
+
+            int crashed = checkCrashes();
+            if (crashed >= 0) {
+                step = recover(static_cast<uint32_t>(crashed));
+                if (step == 0) {
+                    return 1;
+                }
+                rolledBack = true;
+                break;
+            }
+            usleep(20);
+        }
+        if (rolledBack) {
+            continue;
+        }
+
+        if (options.reportInterval > 0 && step % options.reportInterval == 0) {
+            report(step, elapsed());
+        }
+        step++;
+    }
+
+    // Shut the workers down
+    control->stop.store(1);
+    for (pid_t& pid : workerPids) {
+        if (pid > 0) {
+            waitpid(pid, nullptr, 0);
+            pid = -1;
+        }
+    }
+
+    report(options.steps, elapsed());
+
+    // Remove the remaining checkpoints: the chains of the last checkpoint
+    // and of the one before it
+    if (options.steps > 0) {
+        uint32_t interval = options.checkpointInterval;
+        uint32_t span = interval * options.baseInterval;
+        uint32_t last = chainStart((options.steps - 1) / interval * interval + 1);
+        for (uint32_t i = 0; i < options.partitions; i++) {
+            removeChain(i, last);
+            if (last > span) {
+                removeChain(i, last - span);
+            }
+        }
+    }
+
+    return 0;
+}
@@ -0,0 +1,415 @@
+// FILE: src/managers/SimServer.cpp
+#include "managers/SimServer.h"
+#include "managers/TrafficManager.h"
+#include "utils/DebugLogger.h"
+#include <algorithm>
+#include <chrono>
+#include <cerrno>
+#include <cmath>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <random>
+#include <fcntl.h>
+#include <poll.h>
+#include <signal.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+static_assert(sizeof(SimServer::JobRecord) == 256, "JobRecord is part of the wire format");
+static_assert(sizeof(SimServer::ResultRecord) == 72, "ResultRecord is part of the wire format");
+
+namespace {
+
+// Written by the signal handler to wake the accept loop
+int signalPipe[2] = {-1, -1};
+
+void onSignal(int) {
+    char byte = 1;
+    ssize_t ignored = write(signalPipe[1], &byte, 1);
+    (void)ignored;
+}
+
+bool writeFull(int fd, const void* data, size_t size) {
+    const char* p = static_cast<const char*>(data);
+    while (size > 0) {
+        ssize_t n = send(fd, p, size, MSG_NOSIGNAL);
+        if (n < 0 && errno == EINTR) continue;
+        if (n <= 0) return false;
+        p += n;
+        size -= static_cast<size_t>(n);
+    }
+    return true;
+}
+
+bool makeAddress(const std::string& path, sockaddr_un& address) {
+    if (path.size() >= sizeof(address.sun_path)) {
+        return false;
+    }
+    std::memset(&address, 0, sizeof(address));
+    address.sun_family = AF_UNIX;
+    std::memcpy(address.sun_path, path.c_str(), path.size() + 1);
+    return true;
+}
+
+} // namespace
+
+SimServer::Connection::~Connection() {
+    close(fd);
+}
+
+SimServer::SimServer(const Options& opts)
+    : options(opts),
+      listenFd(-1),
+      stopping(false),
+      jobsDone(0) {}
+
+SimServer::~SimServer() {
+    if (listenFd >= 0) {
+        close(listenFd);
+        unlink(options.socketPath.c_str());
+    }
+}
+
+int SimServer::connectTo(const std::string& socketPath) {
+    sockaddr_un address;
+    if (!makeAddress(socketPath, address)) {
+        return -1;
+    }
+
+    int fd = socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    if (fd < 0) {
+        return -1;
+    }
+    if (connect(fd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) < 0) {
+        close(fd);
+        return -1;
+    }
+    return fd;
+}
+
+int SimServer::run() {
+    if (options.logging) {
+        DebugLogger::initialize("simserver.log");
+    } else {
+        DebugLogger::setEnabled(false);
+    }
+
+    sockaddr_un address;
+    if (!makeAddress(options.socketPath, address)) {
+        std::cerr << "Socket path too long: " << options.socketPath << std::endl;
+        return 1;
+    }
+
+    listenFd = socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    if (listenFd < 0) {
+        std::cerr << "socket failed: " << std::strerror(errno) << std::endl;
+        return 1;
+    }
+
+    // A socket file left by a server that didn't shut down cleanly
+    unlink(options.socketPath.c_str());
+    if (bind(listenFd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) < 0 ||
+        listen(listenFd, 64) < 0) {
+        std::cerr << "Cannot listen on " << options.socketPath << ": " << std::strerror(errno) << std::endl;
+        close(listenFd);
+        listenFd = -1;
+        return 1;
+    }
+
+    if (pipe2(signalPipe, O_CLOEXEC) < 0) {
+        std::cerr << "pipe failed: " << std::strerror(errno) << std::endl;
+        return 1;
+    }
+    signal(SIGINT, onSignal);
+    signal(SIGTERM, onSignal);
+    signal(SIGPIPE, SIG_IGN);
+
+    if (!options.cacheDir.empty()) {
+        if (!cache.open(options.cacheDir, options.cacheBytes)) {
+            std::cerr << cache.getLastError() << std::endl;
+            return 1;
+        }
+        std::cout << "Result cache " << options.cacheDir << ": " << cache.getEntryCount()
+                  << " entries, " << cache.getTotalBytes() << " bytes" << std::endl;
+    }
+
+    unsigned workerCount = options.workers > 0 ? options.workers : std::thread::hardware_concurrency();
+    workerCount = std::max(1u, workerCount);
+    for (unsigned i = 0; i < workerCount; i++) {
+        workers.emplace_back(&SimServer::workerLoop, this);
+    }
+
+    std::cout << "simserver listening on " << options.socketPath << " with " << workerCount
+              << " workers" << std::endl;
+
+    // One thread multiplexes accepting and reading; workers write results
+    std::vector<std::shared_ptr<Connection>> connections;
+    std::vector<pollfd> fds;
+    while (true) {
+        fds.assign({{listenFd, POLLIN, 0}, {signalPipe[0], POLLIN, 0}});
+        for (const auto& connection : connections) {
+            fds.push_back({connection->fd, POLLIN, 0});
+        }
+
+        if (poll(fds.data(), fds.size(), -1) < 0) {
+            if (errno == EINTR) continue;
+            break;
+        }
+        if (fds[1].revents) {
+            break;
+        }
+
+        // Read before accepting so indices still match the poll set
+        size_t kept = 0;
+        for (size_t i = 0; i < connections.size(); i++) {
+            if (!fds[i + 2].revents || readJobs(connections[i])) {
+                connections[kept++] = connections[i];
+            }
+        }
+        connections.resize(kept);
+
+        if (fds[0].revents) {
+            int fd = accept4(listenFd, nullptr, nullptr, SOCK_CLOEXEC);
+            if (fd >= 0) {
+                connections.push_back(std::make_shared<Connection>(fd));
+            }
+        }
+    }
+
+    // Drop queued jobs and let running ones finish
+    {
+        std::lock_guard<std::mutex> lock(queueMutex);
+        stopping = true;
+        jobs.clear();
+    }
+    queueReady.notify_all();
+    for (auto& worker : workers) {
+        worker.join();
+    }
+    connections.clear();
+
+    close(signalPipe[0]);
+    close(signalPipe[1]);
+
+    std::cout << "simserver stopped after " << jobsDone.load() << " jobs";
+    if (cache.isOpen()) {
+        std::cout << " (" << cache.getHits() << " cache hits, " << cache.getMisses() << " misses)";
+    }
+    std::cout << std::endl;
+    return 0;
+}
+
+bool SimServer::readJobs(const std::shared_ptr<Connection>& connection) {
+    char* buffer = reinterpret_cast<char*>(&connection->partial);
+
+    // Non-blocking reads only: workers write results on the same socket in
+    // blocking mode
+    while (true) {
+        ssize_t n = recv(connection->fd, buffer + connection->partialBytes,
+                         sizeof(JobRecord) - connection->partialBytes, MSG_DONTWAIT);
+        if (n < 0 && errno == EINTR) {
+            continue;
+        }
+        if (n < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) {
+            return true;
+        }
+        if (n <= 0) {
+            return false;
+        }
+
+        connection->partialBytes += static_cast<size_t>(n);
+        if (connection->partialBytes < sizeof(JobRecord)) {
+            continue;
+        }
+        connection->partialBytes = 0;
+
+        // A bad magic means the stream is out of step; answer once and hang up
+        if (connection->partial.magic != JOB_MAGIC) {
+            ResultRecord result = {};
+            result.jobId = connection->partial.jobId;
+            result.status = STATUS_BAD_JOB;
+            std::lock_guard<std::mutex> lock(connection->writeMutex);
+            writeFull(connection->fd, &result, sizeof(result));
+            return false;
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(queueMutex);
+            jobs.push_back(Job{connection->partial, connection});
+        }
+        queueReady.notify_one();
+    }
+}
+
+void SimServer::workerLoop() {
+    // Managers this worker has loaded, by network file ("" = standard junction)
+    std::map<std::string, TrafficManager*> managers;
+    managerFor("", managers);
+    for (const auto& path : options.warmNetworks) {
+        if (!managerFor(path, managers)) {
+            std::cerr << "Failed to warm network " << path << std::endl;
+        }
+    }
+
+    while (true) {
+        Job job;
+        {
+            std::unique_lock<std::mutex> lock(queueMutex);
+            queueReady.wait(lock, [this] { return stopping || !jobs.empty(); });
+            if (stopping) break;
+            job = std::move(jobs.front());
+            jobs.pop_front();
+        }
+
+        ResultRecord result = runJob(job.record, managers);
+        jobsDone++;
+
+        std::lock_guard<std::mutex> lock(job.connection->writeMutex);
+        writeFull(job.connection->fd, &result, sizeof(result));
+    }
+
+    for (auto& entry : managers) {
+        delete entry.second;
+    }
+}
+
+TrafficManager* SimServer::managerFor(const std::string& networkPath,
+                                      std::map<std::string, TrafficManager*>& managers) {
+    auto it = managers.find(networkPath);
+    if (it != managers.end()) {
+        return it->second;
+    }
+
+    TrafficManager* manager = new TrafficManager();
+    if (!manager->initialize(networkPath, false)) {
+        delete manager;
+        return nullptr;
+    }
+    manager->start();
+    managers[networkPath] = manager;
+    return manager;
+}
+
+SimServer::ResultRecord SimServer::runJob(const JobRecord& job, std::map<std::string, TrafficManager*>& managers) {
+    auto start = std::chrono::steady_clock::now();
+
+    ResultRecord result = {};
+    result.jobId = job.jobId;
+
+    if (job.stepMs == 0 || !std::isfinite(job.ratePerMinute) || job.ratePerMinute < 0.0f) {
+        result.status = STATUS_BAD_JOB;
+        return result;
+    }
+
+    std::string networkPath(job.networkPath, strnlen(job.networkPath, MAX_NETWORK_PATH));
+
+    uint64_t key = cache.isOpen() ? cacheKey(job, networkPath) : 0;
+    if (key != 0 && cache.lookup(key, &result, sizeof(result))) {
+        result.jobId = job.jobId;
+        result.flags |= RESULT_CACHED;
+        result.wallMicros = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(
+            std::chrono::steady_clock::now() - start).count());
+        return result;
+    }
+
+    TrafficManager* manager = managerFor(networkPath, managers);
+    if (!manager) {
+        result.status = STATUS_NETWORK;
+        return result;
+    }
+
+    manager->reset();
+    manager->setFixedPointKinematics((job.flags & FLAG_FIXED_POINT) != 0);
+
+    // Same lane and direction mix as traffic_generator --trace
+    std::mt19937 gen(job.seed);
+    std::uniform_int_distribution<int> roadDist(0, 3);
+    std::discrete_distribution<int> laneDist({0.0, 0.6, 0.4});   // Lanes 1, 2, 3
+    std::bernoulli_distribution straightDist(0.6);                 // L2: 60% straight
+    std::bernoulli_distribution priorityBias(0.1);                 // Bias toward A2
+    std::bernoulli_distribution emergencyDist(0.002);
+
+    const double rate = job.ratePerMinute / 60000.0;   // Arrivals per ms
+    std::exponential_distribution<double> gapDist(rate > 0.0 ? rate : 1.0);
+    double nextArrival = rate > 0.0 ? gapDist(gen) : static_cast<double>(job.durationMs);
+    uint32_t vehicleId = 1;
+
+    Lane* priorityLane = manager->getPriorityLane();
+    uint64_t steps = 0;
+    double queuedSum = 0.0;
+    double priorityQueuedSum = 0.0;
+    for (uint64_t time = 0; time < job.durationMs; time += job.stepMs) {
+        // Arrivals due during this step
+        double stepEnd = static_cast<double>(time + job.stepMs);
+        while (nextArrival < stepEnd && nextArrival < job.durationMs) {
+            char road = static_cast<char>('A' + roadDist(gen));
+            int laneNumber = laneDist(gen) + 1;
+            bool isEmergency = emergencyDist(gen);
+            if (priorityBias(gen)) {
+                road = 'A';
+                laneNumber = 2;
+            }
+            Destination destination = laneNumber == 3 || !straightDist(gen) ? Destination::LEFT
+                                                                             : Destination::STRAIGHT;
+
+            if (manager->addArrival(vehicleId++, road, laneNumber, destination, isEmergency)) {
+                result.arrivals++;
+            }
+            nextArrival += gapDist(gen);
+        }
+
+        manager->update(job.stepMs);
+
+        size_t vehicles = manager->getVehicleCount();
+        result.maxQueued = std::max(result.maxQueued, static_cast<uint32_t>(vehicles));
+        queuedSum += static_cast<double>(vehicles);
+        if (priorityLane) {
+            priorityQueuedSum += priorityLane->getVehicleCount();
+        }
+        steps++;
+    }
+
+    result.status = STATUS_OK;
+    result.simulatedMs = manager->getSimulationTime();
+    result.exited = manager->getExitedCount();
+    result.remaining = static_cast<uint32_t>(manager->getVehicleCount());
+    result.meanQueued = steps > 0 ? static_cast<float>(queuedSum / steps) : 0.0f;
+    result.meanPriorityQueued = steps > 0 ? static_cast<float>(priorityQueuedSum / steps) : 0.0f;
+    result.steps = static_cast<uint32_t>(steps);
+    EmissionsBatch::Totals emissions = manager->getEmissionTotals();
+    result.fuelLitres = static_cast<float>(emissions.fuelMl / 1000.0);
+    result.co2Kg = static_cast<float>(emissions.co2G / 1000.0);
+    result.wallMicros = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now() - start).count());
+
+    if (key != 0 && !cache.store(key, &result, sizeof(result))) {
+        DebugLogger::log(cache.getLastError(), DebugLogger::LogLevel::ERROR);
+    }
+    return result;
+}
+
+uint64_t SimServer::cacheKey(const JobRecord& job, const std::string& networkPath) {
+    uint64_t buildId = ResultCache::buildId();
+    uint64_t hash = ResultCache::hashBytes(&buildId, sizeof(buildId));
+
+    // Hash the network by content so an edited file never hits old results
+    if (!networkPath.empty()) {
+        std::ifstream file(networkPath, std::ios::binary);
+        if (!file.is_open()) {
+            return 0;
+        }
+        std::string contents((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+        hash = ResultCache::hashBytes(contents.data(), contents.size(), hash);
+    }
+
+    // Field by field: jobId and reserved bytes don't affect the result
+    hash = ResultCache::hashBytes(&job.seed, sizeof(job.seed), hash);
+    hash = ResultCache::hashBytes(&job.durationMs, sizeof(job.durationMs), hash);
+    hash = ResultCache::hashBytes(&job.stepMs, sizeof(job.stepMs), hash);
+    hash = ResultCache::hashBytes(&job.ratePerMinute, sizeof(job.ratePerMinute), hash);
+    hash = ResultCache::hashBytes(&job.flags, sizeof(job.flags), hash);
+    return hash != 0 ? hash : 1;
+}
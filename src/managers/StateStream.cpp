@@ -0,0 +1,715 @@
+// FILE: src/managers/StateStream.cpp
+#include "managers/StateStream.h"
+#include "managers/TrafficManager.h"
+#include "utils/ThreadRoles.h"
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+namespace {
+
+const char TCP_PREFIX[] = "tcp:";
+
+// Larger frames are taken as a corrupt stream
+const uint32_t MAX_FRAME_BYTES = 64u << 20;
+
+void putU32(std::string& out, uint32_t value) {
+    for (int i = 0; i < 4; i++) {
+        out.push_back(static_cast<char>((value >> (8 * i)) & 0xFF));
+    }
+}
+
+void putVarint(std::string& out, uint64_t value) {
+    while (value >= 0x80) {
+        out.push_back(static_cast<char>((value & 0x7F) | 0x80));
+        value >>= 7;
+    }
+    out.push_back(static_cast<char>(value));
+}
+
+void putZigzag(std::string& out, int64_t value) {
+    putVarint(out, (static_cast<uint64_t>(value) << 1) ^ static_cast<uint64_t>(value >> 63));
+}
+
+uint32_t readU32(const uint8_t* data) {
+    return static_cast<uint32_t>(data[0]) | static_cast<uint32_t>(data[1]) << 8 |
+           static_cast<uint32_t>(data[2]) << 16 | static_cast<uint32_t>(data[3]) << 24;
+}
+
+// Bounds-checked reads from a frame payload; ok turns false at the first
+// read past the end or overlong varint
+struct Reader {
+    const uint8_t* p;
+    const uint8_t* end;
+    bool ok;
+
+    uint8_t byte() {
+        if (p >= end) {
+            ok = false;
+            return 0;
+        }
+        return *p++;
+    }
+
+    uint64_t varint() {
+        uint64_t value = 0;
+        for (int shift = 0; shift < 64; shift += 7) {
+            uint8_t b = byte();
+            value |= static_cast<uint64_t>(b & 0x7F) << shift;
+            if (!(b & 0x80)) {
+                return value;
+            }
+        }
+        ok = false;
+        return 0;
+    }
+
+    int64_t zigzag() {
+        uint64_t value = varint();
+        return static_cast<int64_t>(value >> 1) ^ -static_cast<int64_t>(value & 1);
+    }
+};
+
+int32_t quantize(float pixels) {
+    return static_cast<int32_t>(std::lround(pixels * static_cast<float>(StateStream::UNITS_PER_PIXEL)));
+}
+
+// Frame header: length placeholder, type, sequence, time and lights
+void beginFrame(std::string& out, uint8_t type, uint64_t sequence, uint64_t time,
+                const std::vector<uint8_t>& lights) {
+    out.assign(4, '\0');
+    out.push_back(static_cast<char>(type));
+    putVarint(out, sequence);
+    putVarint(out, time);
+    putVarint(out, lights.size());
+    out.append(reinterpret_cast<const char*>(lights.data()), lights.size());
+}
+
+void endFrame(std::string& out) {
+    uint32_t length = static_cast<uint32_t>(out.size() - 4);
+    for (int i = 0; i < 4; i++) {
+        out[i] = static_cast<char>((length >> (8 * i)) & 0xFF);
+    }
+}
+
+bool parseTcpPort(const std::string& address, uint16_t& port) {
+    if (address.compare(0, sizeof(TCP_PREFIX) - 1, TCP_PREFIX) != 0) {
+        return false;
+    }
+    port = static_cast<uint16_t>(std::atoi(address.c_str() + sizeof(TCP_PREFIX) - 1));
+    return true;
+}
+
+bool makeUnixAddress(const std::string& path, sockaddr_un& address) {
+    if (path.empty() || path.size() >= sizeof(address.sun_path)) {
+        return false;
+    }
+    std::memset(&address, 0, sizeof(address));
+    address.sun_family = AF_UNIX;
+    std::memcpy(address.sun_path, path.c_str(), path.size() + 1);
+    return true;
+}
+
+sockaddr_in makeLoopbackAddress(uint16_t port) {
+    sockaddr_in address;
+    std::memset(&address, 0, sizeof(address));
+    address.sin_family = AF_INET;
+    address.sin_port = htons(port);
+    address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    return address;
+}
+
+} // namespace
+
+StateStream::StateStream() : StateStream(Options()) {}
+
+StateStream::StateStream(const Options& opts)
+    : options(opts),
+      listenFd(-1),
+      wakePipe{-1, -1},
+      hasPending(false),
+      stopping(false),
+      sequence(0),
+      subscriberCount(0),
+      published(0),
+      frames(0),
+      keyframes(0),
+      bytesSent(0),
+      deltasDropped(0),
+      publishNanos(0) {
+    options.keyframeInterval = std::max(1u, options.keyframeInterval);
+}
+
+StateStream::~StateStream() {
+    close();
+}
+
+bool StateStream::open(const std::string& address) {
+    if (isOpen()) {
+        lastError = "State stream already open";
+        return false;
+    }
+
+    uint16_t port = 0;
+    bool tcp = parseTcpPort(address, port);
+    sockaddr_un unixAddress;
+    sockaddr_in tcpAddress = makeLoopbackAddress(port);
+    if (!tcp && !makeUnixAddress(address, unixAddress)) {
+        lastError = "Bad state stream address: " + address;
+        return false;
+    }
+
+    int fd = socket(tcp ? AF_INET : AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC | SOCK_NONBLOCK, 0);
+    if (fd < 0) {
+        lastError = std::string("socket failed: ") + std::strerror(errno);
+        return false;
+    }
+
+    int bound;
+    if (tcp) {
+        int reuse = 1;
+        setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof(reuse));
+        bound = bind(fd, reinterpret_cast<sockaddr*>(&tcpAddress), sizeof(tcpAddress));
+    } else {
+        // A socket file left by a run that didn't shut down cleanly
+        unlink(address.c_str());
+        bound = bind(fd, reinterpret_cast<sockaddr*>(&unixAddress), sizeof(unixAddress));
+    }
+    if (bound < 0 || listen(fd, 16) < 0) {
+        lastError = "Cannot listen on " + address + ": " + std::strerror(errno);
+        ::close(fd);
+        return false;
+    }
+
+    if (pipe2(wakePipe, O_CLOEXEC | O_NONBLOCK) < 0) {
+        lastError = std::string("pipe failed: ") + std::strerror(errno);
+        ::close(fd);
+        return false;
+    }
+
+    listenFd = fd;
+    socketPath = tcp ? "" : address;
+    stopping = false;
+    hasPending = false;
+    sequence = 0;
+    thread = std::thread(&StateStream::run, this);
+    ThreadRoles::assign(thread, ThreadRoles::Role::IO, "stream");
+    return true;
+}
+
+void StateStream::close() {
+    if (!isOpen()) {
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(pendingMutex);
+        stopping = true;
+    }
+    wake();
+    ThreadRoles::release(thread);
+    thread.join();
+
+    for (Subscriber& subscriber : subscribers) {
+        ::close(subscriber.fd);
+    }
+    subscribers.clear();
+    subscriberCount.store(0, std::memory_order_relaxed);
+
+    ::close(listenFd);
+    ::close(wakePipe[0]);
+    ::close(wakePipe[1]);
+    listenFd = -1;
+    wakePipe[0] = wakePipe[1] = -1;
+    if (!socketPath.empty()) {
+        unlink(socketPath.c_str());
+    }
+}
+
+void StateStream::publish(const TrafficManager& manager) {
+    if (!isOpen() || subscriberCount.load(std::memory_order_relaxed) == 0) {
+        return;
+    }
+    auto start = std::chrono::steady_clock::now();
+
+    const RoadNetwork& network = manager.getNetwork();
+    staging.time = manager.getSimulationTime();
+    staging.lights.resize(network.getJunctionCount());
+    for (size_t j = 0; j < staging.lights.size(); j++) {
+        staging.lights[j] = static_cast<uint8_t>(manager.getTrafficLight(j)->getCurrentState());
+    }
+
+    staging.vehicles.clear();
+    const std::vector<Lane*>& lanes = manager.getLanes();
+    for (size_t i = 0; i < lanes.size(); i++) {
+        if (!manager.ownsJunction(network.getLane(i).junction)) {
+            continue;
+        }
+        for (Vehicle* vehicle : lanes[i]->getVehicles()) {
+            if (!vehicle) {
+                continue;
+            }
+            uint8_t attributes = static_cast<uint8_t>(vehicle->getDestination()) & ATTR_DESTINATION;
+            if (vehicle->isEmergencyVehicle()) {
+                attributes |= ATTR_EMERGENCY;
+            }
+            staging.vehicles.push_back({vehicle->getSerial(), quantize(vehicle->getTurnPosX()),
+                                        quantize(vehicle->getTurnPosY()), static_cast<uint32_t>(i), attributes});
+        }
+    }
+
+    // Replace a step the stream thread hasn't taken yet; it was woken for
+    // that one already
+    bool wasPending;
+    {
+        std::lock_guard<std::mutex> lock(pendingMutex);
+        std::swap(pending, staging);
+        wasPending = hasPending;
+        hasPending = true;
+    }
+    if (!wasPending) {
+        wake();
+    }
+
+    published.fetch_add(1, std::memory_order_relaxed);
+    publishNanos.fetch_add(static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                               std::chrono::steady_clock::now() - start).count()),
+                           std::memory_order_relaxed);
+}
+
+StateStream::Stats StateStream::getStats() const {
+    Stats stats;
+    stats.published = published.load(std::memory_order_relaxed);
+    stats.frames = frames.load(std::memory_order_relaxed);
+    stats.keyframes = keyframes.load(std::memory_order_relaxed);
+    stats.bytesSent = bytesSent.load(std::memory_order_relaxed);
+    stats.deltasDropped = deltasDropped.load(std::memory_order_relaxed);
+    stats.subscribers = subscriberCount.load(std::memory_order_relaxed);
+    stats.publishNanos = publishNanos.load(std::memory_order_relaxed);
+    return stats;
+}
+
+std::string StateStream::summary() const {
+    Stats stats = getStats();
+    char text[256];
+    std::snprintf(text, sizeof(text),
+                  "%llu frames (%llu keyframes) from %llu steps, %.1f KB sent, %llu dropped for slow "
+                  "subscribers, publish %.1f us/step",
+                  static_cast<unsigned long long>(stats.frames), static_cast<unsigned long long>(stats.keyframes),
+                  static_cast<unsigned long long>(stats.published), static_cast<double>(stats.bytesSent) / 1024.0,
+                  static_cast<unsigned long long>(stats.deltasDropped),
+                  stats.published > 0 ? static_cast<double>(stats.publishNanos) / 1000.0 / stats.published : 0.0);
+    return text;
+}
+
+int StateStream::connectTo(const std::string& address) {
+    uint16_t port = 0;
+    bool tcp = parseTcpPort(address, port);
+    sockaddr_un unixAddress;
+    sockaddr_in tcpAddress = makeLoopbackAddress(port);
+    if (!tcp && !makeUnixAddress(address, unixAddress)) {
+        return -1;
+    }
+
+    int fd = socket(tcp ? AF_INET : AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    if (fd < 0) {
+        return -1;
+    }
+    int connected = tcp ? connect(fd, reinterpret_cast<sockaddr*>(&tcpAddress), sizeof(tcpAddress))
+                        : connect(fd, reinterpret_cast<sockaddr*>(&unixAddress), sizeof(unixAddress));
+    if (connected < 0) {
+        ::close(fd);
+        return -1;
+    }
+    return fd;
+}
+
+void StateStream::wake() {
+    char byte = 1;
+    ssize_t ignored = write(wakePipe[1], &byte, 1);
+    (void)ignored;
+}
+
+void StateStream::run() {
+    Step step;
+    std::vector<pollfd> fds;
+    while (true) {
+        fds.assign({{wakePipe[0], POLLIN, 0}, {listenFd, POLLIN, 0}});
+        for (const Subscriber& subscriber : subscribers) {
+            short events = subscriber.queue.empty() ? POLLIN : POLLIN | POLLOUT;
+            fds.push_back({subscriber.fd, events, 0});
+        }
+
+        if (poll(fds.data(), fds.size(), -1) < 0) {
+            if (errno == EINTR) continue;
+            break;
+        }
+
+        // Subscribers first so indices still match the poll set. They
+        // aren't expected to send anything: reading only detects a close.
+        size_t kept = 0;
+        for (size_t i = 0; i < subscribers.size(); i++) {
+            Subscriber& subscriber = subscribers[i];
+            short revents = fds[i + 2].revents;
+            bool alive = !(revents & (POLLERR | POLLHUP | POLLNVAL));
+            if (alive && (revents & POLLIN)) {
+                char discard[256];
+                ssize_t n = recv(subscriber.fd, discard, sizeof(discard), MSG_DONTWAIT);
+                alive = n > 0 || (n < 0 && (errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR));
+            }
+            if (alive && (revents & POLLOUT)) {
+                alive = flush(subscriber);
+            }
+            if (!alive) {
+                ::close(subscriber.fd);
+                continue;
+            }
+            if (kept != i) {
+                subscribers[kept] = std::move(subscriber);
+            }
+            kept++;
+        }
+        subscribers.resize(kept, Subscriber(-1));
+
+        if (fds[1].revents & POLLIN) {
+            int fd;
+            while ((fd = accept4(listenFd, nullptr, nullptr, SOCK_CLOEXEC | SOCK_NONBLOCK)) >= 0) {
+                std::string header;
+                putU32(header, MAGIC);
+                putU32(header, VERSION);
+                putU32(header, UNITS_PER_PIXEL);
+                subscribers.emplace_back(fd);
+                subscribers.back().queuedBytes = header.size();
+                subscribers.back().queue.push_back(std::make_shared<const std::string>(std::move(header)));
+            }
+        }
+        subscriberCount.store(subscribers.size(), std::memory_order_relaxed);
+
+        if (fds[0].revents & POLLIN) {
+            char drain[64];
+            while (read(wakePipe[0], drain, sizeof(drain)) > 0) {}
+
+            bool haveStep = false;
+            {
+                std::lock_guard<std::mutex> lock(pendingMutex);
+                if (stopping) {
+                    break;
+                }
+                if (hasPending) {
+                    std::swap(step, pending);
+                    hasPending = false;
+                    haveStep = true;
+                }
+            }
+            if (haveStep) {
+                encodeStep(step);
+            }
+        }
+    }
+}
+
+void StateStream::encodeStep(Step& step) {
+    std::sort(step.vehicles.begin(), step.vehicles.end());
+    sequence++;
+
+    // Keyframes go to everyone periodically, and otherwise only to
+    // subscribers waiting for one that have caught up
+    bool periodic = (sequence - 1) % options.keyframeInterval == 0;
+    bool wantKeyframe = periodic;
+    bool wantDelta = false;
+    for (const Subscriber& subscriber : subscribers) {
+        if (subscriber.live) {
+            wantDelta = true;
+        } else if (subscriber.queue.size() <= 1) {
+            wantKeyframe = true;
+        }
+    }
+    wantDelta = wantDelta && !periodic;
+
+    std::shared_ptr<std::string> keyframe;
+    std::shared_ptr<std::string> delta;
+    if (wantKeyframe) {
+        keyframe = std::make_shared<std::string>();
+        encodeKeyframe(step, sequence, *keyframe);
+        keyframes.fetch_add(1, std::memory_order_relaxed);
+    }
+    if (wantDelta) {
+        delta = std::make_shared<std::string>();
+        encodeDelta(last, step, sequence, *delta);
+    }
+    frames.fetch_add(1, std::memory_order_relaxed);
+
+    size_t kept = 0;
+    for (size_t i = 0; i < subscribers.size(); i++) {
+        Subscriber& subscriber = subscribers[i];
+        if (periodic || !subscriber.live) {
+            if (keyframe) {
+                enqueue(subscriber, keyframe, true);
+            }
+        } else {
+            enqueue(subscriber, delta, false);
+        }
+        if (!flush(subscriber)) {
+            ::close(subscriber.fd);
+            continue;
+        }
+        if (kept != i) {
+            subscribers[kept] = std::move(subscriber);
+        }
+        kept++;
+    }
+    subscribers.resize(kept, Subscriber(-1));
+    subscriberCount.store(subscribers.size(), std::memory_order_relaxed);
+
+    std::swap(last, step);
+}
+
+void StateStream::encodeKeyframe(const Step& step, uint64_t sequence, std::string& out) {
+    beginFrame(out, FRAME_KEY, sequence, step.time, step.lights);
+    putVarint(out, step.vehicles.size());
+    uint32_t previousId = 0;
+    for (const VehicleState& vehicle : step.vehicles) {
+        putVarint(out, (static_cast<uint64_t>(vehicle.id - previousId) << 1) | 1);
+        putZigzag(out, vehicle.x);
+        putZigzag(out, vehicle.y);
+        putVarint(out, vehicle.lane);
+        out.push_back(static_cast<char>(vehicle.attributes));
+        previousId = vehicle.id;
+    }
+    endFrame(out);
+}
+
+void StateStream::encodeDelta(const Step& previous, const Step& step, uint64_t sequence, std::string& out) {
+    beginFrame(out, FRAME_DELTA, sequence, step.time, step.lights);
+
+    // Both lists are sorted by ID: walk them together. The counts go in
+    // front of the entries, so those are written to scratch strings first.
+    std::string& entries = deltaEntries;
+    std::string& removed = deltaRemoved;
+    entries.clear();
+    removed.clear();
+    size_t changedCount = 0;
+    size_t removedCount = 0;
+    uint32_t previousId = 0;
+    uint32_t previousRemovedId = 0;
+
+    auto a = previous.vehicles.begin();
+    for (const VehicleState& vehicle : step.vehicles) {
+        for (; a != previous.vehicles.end() && a->id < vehicle.id; ++a) {
+            putVarint(removed, a->id - previousRemovedId);
+            previousRemovedId = a->id;
+            removedCount++;
+        }
+
+        bool known = a != previous.vehicles.end() && a->id == vehicle.id &&
+                     a->lane == vehicle.lane && a->attributes == vehicle.attributes;
+        if (known && a->x == vehicle.x && a->y == vehicle.y) {
+            ++a;
+            continue;
+        }
+
+        putVarint(entries, (static_cast<uint64_t>(vehicle.id - previousId) << 1) | (known ? 0 : 1));
+        if (known) {
+            putZigzag(entries, static_cast<int64_t>(vehicle.x) - a->x);
+            putZigzag(entries, static_cast<int64_t>(vehicle.y) - a->y);
+        } else {
+            putZigzag(entries, vehicle.x);
+            putZigzag(entries, vehicle.y);
+            putVarint(entries, vehicle.lane);
+            entries.push_back(static_cast<char>(vehicle.attributes));
+        }
+        if (a != previous.vehicles.end() && a->id == vehicle.id) {
+            ++a;
+        }
+        previousId = vehicle.id;
+        changedCount++;
+    }
+    for (; a != previous.vehicles.end(); ++a) {
+        putVarint(removed, a->id - previousRemovedId);
+        previousRemovedId = a->id;
+        removedCount++;
+    }
+
+    putVarint(out, changedCount);
+    out += entries;
+    putVarint(out, removedCount);
+    out += removed;
+    endFrame(out);
+}
+
+void StateStream::enqueue(Subscriber& subscriber, const std::shared_ptr<const std::string>& frame, bool isKeyframe) {
+    if (subscriber.live && subscriber.queuedBytes + frame->size() > options.maxQueuedBytes) {
+        // Too far behind: drop what it hasn't started reading and wait for
+        // a keyframe
+        size_t keep = subscriber.sentOfFront > 0 ? 1 : 0;
+        uint64_t dropped = 1;
+        while (subscriber.queue.size() > keep) {
+            subscriber.queuedBytes -= subscriber.queue.back()->size();
+            subscriber.queue.pop_back();
+            dropped++;
+        }
+        subscriber.live = false;
+        deltasDropped.fetch_add(dropped, std::memory_order_relaxed);
+    }
+
+    // A subscriber waiting for a keyframe takes one once only a partly
+    // sent frame (or the stream header) is ahead of it
+    if (!subscriber.live && (!isKeyframe || subscriber.queue.size() > 1)) {
+        return;
+    }
+
+    subscriber.queue.push_back(frame);
+    subscriber.queuedBytes += frame->size();
+    subscriber.live = true;
+}
+
+bool StateStream::flush(Subscriber& subscriber) {
+    while (!subscriber.queue.empty()) {
+        const std::string& front = *subscriber.queue.front();
+        ssize_t n = send(subscriber.fd, front.data() + subscriber.sentOfFront, front.size() - subscriber.sentOfFront,
+                         MSG_NOSIGNAL | MSG_DONTWAIT);
+        if (n < 0) {
+            if (errno == EINTR) continue;
+            return errno == EAGAIN || errno == EWOULDBLOCK;
+        }
+        subscriber.sentOfFront += static_cast<size_t>(n);
+        subscriber.queuedBytes -= static_cast<size_t>(n);
+        bytesSent.fetch_add(static_cast<uint64_t>(n), std::memory_order_relaxed);
+        if (subscriber.sentOfFront == front.size()) {
+            subscriber.queue.pop_front();
+            subscriber.sentOfFront = 0;
+        }
+    }
+    return true;
+}
+
+StateStreamDecoder::StateStreamDecoder()
+    : haveHeader(false),
+      synced(false),
+      simulationTime(0),
+      sequence(0),
+      frameCount(0),
+      keyframeCount(0),
+      skippedFrames(0) {}
+
+bool StateStreamDecoder::feed(const char* data, size_t size) {
+    buffer.append(data, size);
+    const uint8_t* bytes = reinterpret_cast<const uint8_t*>(buffer.data());
+    size_t used = 0;
+
+    if (!haveHeader) {
+        if (buffer.size() < 12) {
+            return true;
+        }
+        if (readU32(bytes) != StateStream::MAGIC || readU32(bytes + 4) != StateStream::VERSION ||
+            readU32(bytes + 8) != StateStream::UNITS_PER_PIXEL) {
+            lastError = "Not a state stream (or an unsupported version)";
+            return false;
+        }
+        haveHeader = true;
+        used = 12;
+    }
+
+    while (buffer.size() - used >= 4) {
+        uint32_t length = readU32(bytes + used);
+        if (length > MAX_FRAME_BYTES) {
+            lastError = "Frame too large";
+            return false;
+        }
+        if (buffer.size() - used - 4 < length) {
+            break;
+        }
+        if (!applyFrame(bytes + used + 4, length)) {
+            return false;
+        }
+        used += 4 + length;
+    }
+    buffer.erase(0, used);
+    return true;
+}
+
+bool StateStreamDecoder::applyFrame(const uint8_t* data, size_t size) {
+    Reader in{data, data + size, true};
+    uint8_t type = in.byte();
+    uint64_t frameSequence = in.varint();
+    uint64_t time = in.varint();
+    uint64_t lightCount = in.varint();
+    if (!in.ok || lightCount > size) {
+        lastError = "Truncated frame header";
+        return false;
+    }
+
+    if (type == StateStream::FRAME_KEY) {
+        if (synced && frameSequence > sequence + 1) {
+            skippedFrames += frameSequence - sequence - 1;
+        }
+        vehicles.clear();
+        keyframeCount++;
+        synced = true;
+    } else if (type == StateStream::FRAME_DELTA) {
+        if (!synced || frameSequence != sequence + 1) {
+            lastError = "Delta frame out of sequence";
+            return false;
+        }
+    } else {
+        lastError = "Unknown frame type";
+        return false;
+    }
+
+    lights.resize(lightCount);
+    for (uint64_t i = 0; i < lightCount; i++) {
+        lights[i] = in.byte();
+    }
+
+    uint64_t count = in.varint();
+    uint32_t id = 0;
+    for (uint64_t i = 0; i < count && in.ok; i++) {
+        uint64_t gapAndNew = in.varint();
+        id += static_cast<uint32_t>(gapAndNew >> 1);
+        int64_t x = in.zigzag();
+        int64_t y = in.zigzag();
+        if (gapAndNew & 1) {
+            Vehicle& vehicle = vehicles[id];
+            vehicle.x = static_cast<int32_t>(x);
+            vehicle.y = static_cast<int32_t>(y);
+            vehicle.lane = static_cast<uint32_t>(in.varint());
+            vehicle.attributes = in.byte();
+        } else {
+            auto it = vehicles.find(id);
+            if (it == vehicles.end()) {
+                lastError = "Delta moves an unknown vehicle";
+                return false;
+            }
+            it->second.x += static_cast<int32_t>(x);
+            it->second.y += static_cast<int32_t>(y);
+        }
+    }
+
+    if (type == StateStream::FRAME_DELTA) {
+        uint64_t removedCount = in.varint();
+        id = 0;
+        for (uint64_t i = 0; i < removedCount && in.ok; i++) {
+            id += static_cast<uint32_t>(in.varint());
+            vehicles.erase(id);
+        }
+    }
+
+    if (!in.ok || in.p != in.end) {
+        lastError = "Malformed frame";
+        return false;
+    }
+    simulationTime = time;
+    sequence = frameSequence;
+    frameCount++;
+    return true;
+}
@@ -3,15 +3,175 @@
 #include "utils/DebugLogger.h"
 #include <sstream>
 #include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <limits>
+#include <new>
+#include <set>
+#include <thread>
+#include <tuple>
 #include <wchar.h>
 #include "core/Constants.h"
 
+namespace {
+
+// Road whose lanes have green in a light state (' ' for ALL_RED)
+char greenRoadFor(TrafficLight::State state) {
+    switch (state) {
+        case TrafficLight::State::A_GREEN: return 'A';
+        case TrafficLight::State::B_GREEN: return 'B';
+        case TrafficLight::State::C_GREEN: return 'C';
+        case TrafficLight::State::D_GREEN: return 'D';
+        default: return ' ';
+    }
+}
+
+const char CHECKPOINT_MAGIC[4] = {'T', 'J', 'C', 'K'};
+const uint32_t CHECKPOINT_VERSION = 4;
+
+// Delta checkpoints (saveDeltaCheckpoint)
+const char DELTA_CHECKPOINT_MAGIC[4] = {'T', 'J', 'C', 'D'};
+const uint32_t DELTA_CHECKPOINT_VERSION = 5;
+
+// One vehicle in a checkpoint file
+struct CheckpointVehicle {
+    uint64_t arrivalTime;   // Link arrival time, 0 for queued vehicles
+    uint32_t laneIndex;
+    uint32_t routeTarget;
+    uint8_t destination;
+    uint8_t isEmergency;
+    uint16_t idLength;      // Followed by the id bytes
+};
+
+void writeVehicle(std::ofstream& file, const CheckpointVehicle& record, const std::string& id) {
+    file.write(reinterpret_cast<const char*>(&record), sizeof(record));
+    file.write(id.data(), record.idLength);
+}
+
+bool readVehicle(std::ifstream& file, CheckpointVehicle& record, std::string& id) {
+    if (!file.read(reinterpret_cast<char*>(&record), sizeof(record))) return false;
+    id.resize(record.idLength);
+    return static_cast<bool>(file.read(&id[0], record.idLength));
+}
+
+// Follows the id of a queued vehicle
+struct CheckpointMotion {
+    uint64_t queuedAt;
+    Vehicle::Motion motion;
+    uint32_t reserved;
+};
+
+// One link cost in a checkpoint
+struct CheckpointLinkCost {
+    uint32_t link;
+    float cost;
+};
+
+CheckpointMotion getCheckpointMotion(const Vehicle& vehicle) {
+    CheckpointMotion motion = CheckpointMotion();
+    motion.queuedAt = vehicle.getQueuedAt();
+    motion.motion = vehicle.getMotion();
+    return motion;
+}
+
+// A vehicle that moved on its path in a delta, in a lane whose queue
+// didn't change: its place in the queue and where it is now
+struct CheckpointMove {
+    uint32_t position;
+    Vehicle::Motion motion;
+};
+
+void writeQueued(std::ofstream& file, const Vehicle& vehicle, uint32_t laneIndex) {
+    CheckpointVehicle record;
+    record.arrivalTime = 0;
+    record.laneIndex = laneIndex;
+    record.routeTarget = vehicle.getRouteTarget();
+    record.destination = static_cast<uint8_t>(vehicle.getDestination());
+    record.isEmergency = vehicle.isEmergencyVehicle() ? 1 : 0;
+    record.idLength = static_cast<uint16_t>(vehicle.getId().size());
+    writeVehicle(file, record, vehicle.getId());
+
+    CheckpointMotion motion = getCheckpointMotion(vehicle);
+    file.write(reinterpret_cast<const char*>(&motion), sizeof(motion));
+}
+
+bool readQueued(std::ifstream& file, CheckpointVehicle& record, std::string& id, CheckpointMotion& motion) {
+    return readVehicle(file, record, id) && file.read(reinterpret_cast<char*>(&motion), sizeof(motion));
+}
+
+void writeTransfer(std::ofstream& file, const TrafficManager::VehicleTransfer& transfer) {
+    CheckpointVehicle record;
+    record.arrivalTime = transfer.arrivalTime;
+    record.laneIndex = transfer.laneIndex;
+    record.routeTarget = transfer.routeTarget;
+    record.destination = static_cast<uint8_t>(transfer.destination);
+    record.isEmergency = transfer.isEmergency ? 1 : 0;
+    record.idLength = static_cast<uint16_t>(transfer.vehicleId.size());
+    writeVehicle(file, record, transfer.vehicleId);
+}
+
+// Queued vehicle from a record, where it was on its approach
+Vehicle* restoreVehicle(const CheckpointVehicle& record, const std::string& id, const Lane& lane,
+                        const CheckpointMotion& motion) {
+    Vehicle* vehicle = new Vehicle(id, lane.getLaneId(), lane.getLaneNumber(), record.isEmergency != 0);
+    vehicle->setDestination(static_cast<Destination>(record.destination));
+    vehicle->setRouteTarget(record.routeTarget);
+    vehicle->setQueuedAt(motion.queuedAt);
+    vehicle->setMotion(motion.motion);
+    return vehicle;
+}
+
+bool readLinkCosts(std::ifstream& file, uint32_t count, std::vector<std::pair<uint32_t, float>>& costs) {
+    for (uint32_t i = 0; i < count; i++) {
+        CheckpointLinkCost cost;
+        if (!file.read(reinterpret_cast<char*>(&cost), sizeof(cost))) return false;
+        costs.push_back({cost.link, cost.cost});
+    }
+    return true;
+}
+
+TrafficManager::VehicleTransfer restoreTransfer(const CheckpointVehicle& record, const std::string& id) {
+    TrafficManager::VehicleTransfer transfer;
+    transfer.arrivalTime = record.arrivalTime;
+    transfer.laneIndex = record.laneIndex;
+    transfer.routeTarget = record.routeTarget;
+    transfer.vehicleId = id;
+    transfer.destination = static_cast<Destination>(record.destination);
+    transfer.isEmergency = record.isEmergency != 0;
+    return transfer;
+}
+
+} // namespace
+
 TrafficManager::TrafficManager()
-    : trafficLight(nullptr),
+    : laneBlock(nullptr),
+      hilbertOrder(true),
+      checkpointTime(0),
+      transitRewrite(false),
+      partitionFirst(0),
+      partitionLast(0),
+      exitedCount(0),
+      emissionsAccounting(true),
+      emissionsSample(false),
+      emissionsSteps(0),
+      emissionsElapsed(0),
+      workerPool(nullptr),
+      fixedPointKinematics(false),
       fileHandler(nullptr),
+      running(false),
       lastFileCheckTime(0),
+      lastStatusTime(0),
+      lastDebugTime(0),
       lastPriorityUpdateTime(0),
-      running(false) {
+      simulationTime(0),
+      lastRouteUpdateTime(0),
+      arrivalTrace(nullptr),
+      traceCursor(0),
+      traceStartTime(0),
+      replaySpeed(1.0) {
 
     DebugLogger::log("TrafficManager created");
 }
@@ -19,52 +179,160 @@ TrafficManager::TrafficManager()
 TrafficManager::~TrafficManager() {
     // Clean up resources
     for (auto* lane : lanes) {
-        delete lane;
+        lane->~Lane();
     }
+    ::operator delete(laneBlock);
+    laneBlock = nullptr;
     lanes.clear();
+    junctionLanes.clear();
+    standardJunctions.clear();
+    standardIndex.clear();
 
-    if (trafficLight) {
-        delete trafficLight;
-        trafficLight = nullptr;
+    for (auto* light : trafficLights) {
+        delete light;
     }
+    trafficLights.clear();
 
     if (fileHandler) {
         delete fileHandler;
         fileHandler = nullptr;
     }
 
+    if (workerPool) {
+        delete workerPool;
+        workerPool = nullptr;
+    }
+
+    if (arrivalTrace) {
+        delete arrivalTrace;
+        arrivalTrace = nullptr;
+    }
+
     DebugLogger::log("TrafficManager destroyed");
 }
 
-bool TrafficManager::initialize() {
+bool TrafficManager::initialize(const std::string& networkPath, bool useLaneFiles) {
     // Create file handler with consistent path
-    fileHandler = new FileHandler(Constants::DATA_PATH);
-    if (!fileHandler->initializeFiles()) {
-        DebugLogger::log("Failed to initialize lane files", DebugLogger::LogLevel::ERROR);
+    if (useLaneFiles) {
+        fileHandler = new FileHandler(Constants::DATA_PATH);
+        if (!fileHandler->initializeFiles()) {
+            DebugLogger::log("Failed to initialize lane files", DebugLogger::LogLevel::ERROR);
+            return false;
+        }
+    }
+
+    // Load the road network, or fall back to the single four-way junction
+    if (networkPath.empty()) {
+        network.buildDefault();
+    } else if (!network.loadFromFile(networkPath, hilbertOrder)) {
         return false;
     }
 
-    // Create lanes for each road and lane number
-    for (char road : {'A', 'B', 'C', 'D'}) {
-        for (int laneNum = 1; laneNum <= 3; laneNum++) {
-            Lane* lane = new Lane(road, laneNum);
-            lanes.push_back(lane);
+    // Precompute next-hop routes between all junctions. Without a worker
+    // pool yet, a temporary one spreads the build over the hardware threads.
+    if (workerPool) {
+        routing.build(network);
+    } else {
+        ThreadPool buildPool(std::max(1u, std::thread::hardware_concurrency()));
+        routing.setThreadPool(&buildPool);
+        routing.build(network);
+        routing.setThreadPool(nullptr);
+    }
 
-            // Add to priority queue with initial priority
-            lanePriorityQueue.enqueue(lane, lane->getPriority());
+    // Create one lane object per network lane, in lane table order
+    laneBlock = static_cast<Lane*>(::operator new(sizeof(Lane) * network.getLaneCount()));
+    lanes.reserve(network.getLaneCount());
+    junctionLanes.resize(network.getJunctionCount());
+    junctionLaneIndices.resize(network.getJunctionCount());
+    for (size_t i = 0; i < network.getLaneCount(); i++) {
+        const RoadNetwork::LaneInfo& info = network.getLane(i);
+        Lane* lane = new (laneBlock + i) Lane(info.road, info.laneNumber);
+        lanes.push_back(lane);
+        junctionLanes[info.junction].push_back(lane);
+        junctionLaneIndices[info.junction].push_back(static_cast<uint32_t>(i));
+
+        // Add to priority queue with initial priority
+        lanePriorityQueue.enqueue(lane, lane->getPriority());
+    }
+    emissionTotals.assign(lanes.size() * 3, EmissionsBatch::Totals());
+    phaseAnalytics.assign(network.getJunctionCount(), PhaseAnalytics());
+    movedLanes.assign(lanes.size(), 0);
+
+    // Standard four-way junctions run on the fixed-topology kernel
+    standardIndex.assign(network.getJunctionCount(), RoadNetwork::INVALID_INDEX);
+    for (size_t j = 0; j < network.getJunctionCount(); j++) {
+        const RoadNetwork::Junction& junction = network.getJunction(j);
+        StandardJunction kernel;
+        if (junction.approachCount == 4 && junction.lanesPerApproach == 3 &&
+            kernel.bind(junctionLanes[j])) {
+            standardIndex[j] = static_cast<uint32_t>(standardJunctions.size());
+            standardJunctions.push_back(kernel);
         }
     }
 
-    // Create traffic light
-    trafficLight = new TrafficLight();
+    // Create a traffic light for each junction
+    for (size_t j = 0; j < network.getJunctionCount(); j++) {
+        trafficLights.push_back(new TrafficLight());
+        trafficLights.back()->restart(0);
+    }
+
+    // Own the whole network until told otherwise
+    partitionFirst = 0;
+    partitionLast = static_cast<uint32_t>(network.getJunctionCount());
 
     std::ostringstream oss;
-    oss << "TrafficManager initialized with " << lanes.size() << " lanes";
+    oss << "TrafficManager initialized with " << network.getJunctionCount() << " junctions and "
+        << lanes.size() << " lanes";
     DebugLogger::log(oss.str());
 
     return true;
 }
 
+void TrafficManager::reset() {
+    for (auto* lane : lanes) {
+        while (!lane->isEmpty()) {
+            delete lane->dequeue();
+        }
+        // Leaves priority mode now that the lane is empty
+        lane->updatePriority();
+    }
+    inTransit.clear();
+    outbox.clear();
+    checkpointLaneVersions.clear();
+    movedLanes.assign(lanes.size(), 0);
+    checkpointLights.clear();
+    checkpointLinkCosts.clear();
+    transitAdded.clear();
+    transitRemoved.clear();
+    exitedCount = 0;
+    delayHistogram.clear();
+    emissionTotals.assign(lanes.size() * 3, EmissionsBatch::Totals());
+    emissionsBatch.clear();
+    emissionsSteps = 0;
+    emissionsElapsed = 0;
+    for (auto& analytics : phaseAnalytics) {
+        analytics.reset();
+    }
+
+    simulationTime = 0;
+    lastRouteUpdateTime = 0;
+    lastPriorityUpdateTime = 0;
+    traceCursor = arrivalTrace ? arrivalTrace->seek(traceStartTime) : 0;
+
+    for (auto* light : trafficLights) {
+        light->restart(0);
+    }
+
+    // Congestion re-routing changed some link costs: rebuild from the base
+    // costs so results don't depend on earlier scenarios
+    for (uint32_t l = 0; l < network.getLinkCount(); l++) {
+        if (routing.getLinkCost(l) != network.getLink(l).length / Constants::LINK_SPEED) {
+            routing.build(network);
+            break;
+        }
+    }
+}
+
 void TrafficManager::start() {
     running = true;
     DebugLogger::log("TrafficManager started");
@@ -72,18 +340,42 @@ void TrafficManager::start() {
 
 void TrafficManager::stop() {
     running = false;
+    if (fileHandler) {
+        fileHandler->stopWatching();
+    }
     DebugLogger::log("TrafficManager stopped");
 }
 
 void TrafficManager::update(uint32_t delta) {
     if (!running) return;
 
+    // Routes a restored checkpoint chain changed, recomputed once for the chain
+    if (routing.hasStaleRoutes()) {
+        routing.recomputeStale();
+    }
+
     uint32_t currentTime = SDL_GetTicks();
+    simulationTime += delta;
 
-    // Check for new vehicles more frequently (every 200ms)
-    if (currentTime - lastFileCheckTime >= 200) {
-        readVehicles();
-        lastFileCheckTime = currentTime;
+    // Arrivals come from the trace when replaying, otherwise from the lane files.
+    // Only the partition owning the entry junction takes them.
+    if (ownsJunction(network.getEntryJunction())) {
+        if (arrivalTrace) {
+            replayArrivals();
+        }
+        // Check for new vehicles more frequently (every 200ms)
+        else if (fileHandler && currentTime - lastFileCheckTime >= 200) {
+            readVehicles();
+            lastFileCheckTime = currentTime;
+        }
+    }
+
+    // Nothing queued or in transit: only the lights move. Priorities still
+    // run so a priority lane that emptied in one step is released.
+    if (getVehicleCount() == 0) {
+        updatePriorities();
+        updateLights(delta);
+        return;
     }
 
     // CRITICAL: Update lane priorities FIRST - this must happen before traffic light updates
@@ -95,13 +387,19 @@ void TrafficManager::update(uint32_t delta) {
     // Check for vehicles leaving the simulation
     checkVehicleBoundaries();
 
-    // Update traffic light - AFTER priorities have been updated
-    if (trafficLight) {
-        trafficLight->update(lanes);
+    // Vehicles arriving over links from neighbouring junctions
+    deliverTransfers();
+
+    // Re-route around congestion periodically
+    if (simulationTime - lastRouteUpdateTime >= Constants::ROUTE_UPDATE_INTERVAL) {
+        updateRouteCosts();
+        lastRouteUpdateTime = simulationTime;
     }
 
+    // Update traffic lights - AFTER priorities have been updated
+    updateLights(delta);
+
     // Debug log current state
-    static uint32_t lastDebugTime = 0;
     if (currentTime - lastDebugTime > 2000) {  // Every 2 seconds
         Lane* priorityLane = findLane('A', 2);
         if (priorityLane) {
@@ -111,7 +409,7 @@ void TrafficManager::update(uint32_t delta) {
         }
 
         // Log traffic light state
-        if (trafficLight) {
+        if (TrafficLight* trafficLight = getTrafficLight()) {
             std::string stateStr;
             switch (trafficLight->getCurrentState()) {
                 case TrafficLight::State::ALL_RED: stateStr = "ALL_RED"; break;
@@ -127,6 +425,73 @@ void TrafficManager::update(uint32_t delta) {
     }
 }
 
+void TrafficManager::updateLights(uint32_t delta) {
+    // Lights run on simulation time so headless runs can step faster than real time
+    for (uint32_t j = partitionFirst; j < partitionLast; j++) {
+        TrafficLight::State stepState = trafficLights[j]->getCurrentState();
+        uint32_t kernel = standardIndex[j];
+        if (kernel != RoadNetwork::INVALID_INDEX) {
+            standardJunctions[kernel].updateLight(*trafficLights[j], static_cast<uint32_t>(simulationTime));
+        } else {
+            trafficLights[j]->update(junctionLanes[j], static_cast<uint32_t>(simulationTime));
+        }
+
+        if (phaseAnalytics[j].step(stepState, trafficLights[j]->getCurrentState(), delta, simulationTime,
+                                   junctionLanes[j]) &&
+            j == network.getEntryJunction()) {
+            const PhaseAnalytics::Summary& cycle = phaseAnalytics[j].getLastCycle();
+            PhaseAnalytics::Figures green = cycle.getGreen();
+            char line[200];
+            std::snprintf(line, sizeof(line),
+                          "Cycle %llu: %.1f s, green used %.1f of %.1f s (%.0f%% wasted), %llu discharged "
+                          "(%.2f per green s), residual %.1f per green, ALL_RED %.0f%%",
+                          static_cast<unsigned long long>(phaseAnalytics[j].getTotals().cycles),
+                          cycle.totalMs / 1000.0, green.getUsedMs() / 1000.0, green.greenMs / 1000.0,
+                          green.getWastedShare() * 100.0, static_cast<unsigned long long>(green.discharged),
+                          green.getDischargeRate(), green.getMeanResidual(), cycle.getAllRedShare() * 100.0);
+            DebugLogger::log(line);
+        }
+    }
+}
+
+bool TrafficManager::isIdle() const {
+    if (getVehicleCount() > 0) {
+        return false;
+    }
+
+    // Lane file writes not read yet (always true while the files are polled)
+    if (ownsJunction(network.getEntryJunction()) && !arrivalTrace && fileHandler &&
+        fileHandler->hasChanges()) {
+        return false;
+    }
+
+    return true;
+}
+
+uint32_t TrafficManager::getIdleTimeout() const {
+    uint32_t timeout = std::numeric_limits<uint32_t>::max();
+
+    for (uint32_t j = partitionFirst; j < partitionLast; j++) {
+        timeout = std::min(timeout, trafficLights[j]->getTimeToNextChange(static_cast<uint32_t>(simulationTime)));
+    }
+
+    // Next replayed arrival, converted from trace time
+    if (arrivalTrace && ownsJunction(network.getEntryJunction()) && traceCursor < arrivalTrace->size()) {
+        double traceTime = traceStartTime + static_cast<double>(simulationTime) * replaySpeed;
+        double wait = (arrivalTrace->records()[traceCursor].timeMs - traceTime) / replaySpeed;
+        if (wait <= 0.0) {
+            return 0;
+        }
+        timeout = static_cast<uint32_t>(std::min<double>(timeout, std::ceil(wait)));
+    }
+
+    return timeout;
+}
+
+bool TrafficManager::watchLaneFiles(std::function<void()> onChange) {
+    return fileHandler && fileHandler->startWatching(onChange);
+}
+
 void TrafficManager::readVehicles() {
     if (!fileHandler) {
         DebugLogger::log("FileHandler not initialized", DebugLogger::LogLevel::ERROR);
@@ -141,8 +506,11 @@ void TrafficManager::readVehicles() {
         }
     }
 
-    // Read new vehicles from files
-    std::vector<Vehicle*> newVehicles = fileHandler->readVehiclesFromFiles();
+    // Read new vehicles from files, unless the watch saw no writes
+    std::vector<Vehicle*> newVehicles;
+    if (fileHandler->takeChanges()) {
+        newVehicles = fileHandler->readVehiclesFromFiles();
+    }
 
     if (!newVehicles.empty()) {
         std::ostringstream oss;
@@ -156,7 +524,6 @@ void TrafficManager::readVehicles() {
     }
 
     // Write status to file periodically for monitoring
-    static uint32_t lastStatusTime = 0;
     uint32_t currentTime = SDL_GetTicks();
 
     if (currentTime - lastStatusTime >= 5000) { // Every 5 seconds
@@ -170,15 +537,89 @@ void TrafficManager::readVehicles() {
                 );
             }
         }
+        fileHandler->flushStatus();
         lastStatusTime = currentTime;
     }
 }
 
+bool TrafficManager::loadArrivalTrace(const std::string& path, double speed, int startHour) {
+    ArrivalTrace* trace = new ArrivalTrace();
+    if (!trace->open(path)) {
+        DebugLogger::log("Failed to load arrival trace: " + trace->getLastError(),
+                         DebugLogger::LogLevel::ERROR);
+        delete trace;
+        return false;
+    }
+
+    // Hours past the end would also overflow the millisecond start time
+    if (startHour < 0 || static_cast<uint32_t>(startHour) >= trace->getHourCount()) {
+        DebugLogger::log("Start hour " + std::to_string(startHour) + " is outside the " +
+                         std::to_string(trace->getHourCount()) + "h trace " + path,
+                         DebugLogger::LogLevel::ERROR);
+        delete trace;
+        return false;
+    }
+
+    if (arrivalTrace) {
+        delete arrivalTrace;
+    }
+    arrivalTrace = trace;
+
+    // Seek with the hour index and replay relative to the current simulation time
+    traceStartTime = static_cast<uint32_t>(startHour) * ArrivalTrace::MS_PER_HOUR;
+    traceCursor = arrivalTrace->seek(traceStartTime);
+    replaySpeed = speed > 0.0 ? speed : 1.0;
+    simulationTime = 0;
+
+    std::ostringstream oss;
+    oss << "Replaying " << arrivalTrace->size() << " arrivals from " << path
+        << " (" << arrivalTrace->getDuration() / ArrivalTrace::MS_PER_HOUR << "h, speed x"
+        << replaySpeed << ", starting at hour " << startHour << ")";
+    DebugLogger::log(oss.str());
+
+    return true;
+}
+
+void TrafficManager::replayArrivals() {
+    const ArrivalTrace::Record* records = arrivalTrace->records();
+    size_t count = arrivalTrace->size();
+
+    // Trace time reached so far
+    double traceTime = traceStartTime + static_cast<double>(simulationTime) * replaySpeed;
+
+    while (traceCursor < count && records[traceCursor].timeMs <= traceTime) {
+        const ArrivalTrace::Record& record = records[traceCursor++];
+        if (record.destination > static_cast<uint8_t>(Destination::RIGHT)) continue;
+
+        addArrival(record.vehicleId, static_cast<char>(record.road), record.laneNumber,
+                   static_cast<Destination>(record.destination),
+                   (record.flags & ArrivalTrace::FLAG_EMERGENCY) != 0);
+    }
+}
+
+bool TrafficManager::addArrival(uint32_t vehicleId, char road, int laneNumber, Destination destination,
+                                bool isEmergency) {
+    // Lane 1 only carries traffic leaving the junction
+    if (laneNumber < 2 || !findLane(road, laneNumber)) {
+        return false;
+    }
+
+    // Same id format as the lane files so vehicles behave identically
+    std::string id = "V" + std::to_string(vehicleId) + "_L" + std::to_string(laneNumber) +
+                     (destination == Destination::LEFT ? "_LEFT" : "_STRAIGHT");
+
+    Vehicle* vehicle = new Vehicle(id, road, laneNumber, isEmergency);
+    vehicle->setDestination(destination);
+    addVehicle(vehicle);
+    return true;
+}
+
 void TrafficManager::addVehicle(Vehicle* vehicle) {
     if (!vehicle) return;
 
     Lane* targetLane = findLane(vehicle->getLane(), vehicle->getLaneNumber());
     if (targetLane) {
+        vehicle->setQueuedAt(simulationTime);
         targetLane->enqueue(vehicle);
 
         // Log the action
@@ -195,50 +636,53 @@ void TrafficManager::addVehicle(Vehicle* vehicle) {
 
 
 void TrafficManager::updatePriorities() {
-    // CRITICAL: First retrieve the priority lane (A2)
-    Lane* priorityLane = nullptr;
-    for (auto* lane : lanes) {
-        if (lane->getLaneId() == 'A' && lane->getLaneNumber() == 2) {
-            priorityLane = lane;
-            break;
+    for (uint32_t j = partitionFirst; j < partitionLast; j++) {
+        // CRITICAL: First retrieve the priority lane (A2) of this junction
+        uint32_t kernel = standardIndex[j];
+        Lane* priorityLane = kernel != RoadNetwork::INVALID_INDEX
+            ? standardJunctions[kernel].priorityLane()
+            : findLane(j, 'A', 2);
+        if (!priorityLane) {
+            if (j == network.getEntryJunction()) {
+                DebugLogger::log("ERROR: Priority lane A2 not found!", DebugLogger::LogLevel::ERROR);
+            }
+            continue;
         }
-    }
 
-    if (!priorityLane) {
-        DebugLogger::log("ERROR: Priority lane A2 not found!", DebugLogger::LogLevel::ERROR);
-        return;
-    }
+        TrafficLight* trafficLight = trafficLights[j];
 
-    // CRITICAL: Check if priority condition is met (>10 vehicles in A2)
-    int vehicleCount = priorityLane->getVehicleCount();
-    int oldPriority = priorityLane->getPriority();
+        // CRITICAL: Check if priority condition is met (>10 vehicles in A2)
+        int vehicleCount = priorityLane->getVehicleCount();
+        int oldPriority = priorityLane->getPriority();
 
-    // PRIORITY CONDITION: A2 lane has more than 10 vehicles
-    if (vehicleCount > Constants::PRIORITY_THRESHOLD_HIGH && oldPriority == 0) {
-        // Activate priority mode
-        priorityLane->updatePriority();  // This will set priority to 100
+        // PRIORITY CONDITION: A2 lane has more than 10 vehicles
+        if (vehicleCount > Constants::PRIORITY_THRESHOLD_HIGH && oldPriority == 0) {
+            // Activate priority mode
+            priorityLane->updatePriority();  // This will set priority to 100
 
-        DebugLogger::log("*** PRIORITY MODE ACTIVATED: A2 has " + std::to_string(vehicleCount) +
-                      " vehicles (>10) ***", DebugLogger::LogLevel::INFO);
+            DebugLogger::log("*** PRIORITY MODE ACTIVATED: A2 has " + std::to_string(vehicleCount) +
+                          " vehicles (>10) ***", DebugLogger::LogLevel::INFO);
 
-        // CRITICAL: Force traffic light to A green if not already
-        if (trafficLight && trafficLight->getCurrentState() != TrafficLight::State::A_GREEN) {
-            // Set next state to ALL_RED (transitional state)
-            trafficLight->setNextState(TrafficLight::State::ALL_RED);
-            DebugLogger::log("Forcing light transition to ALL_RED then A_GREEN due to priority mode");
+            // CRITICAL: Force traffic light to A green if not already
+            if (trafficLight->getCurrentState() != TrafficLight::State::A_GREEN) {
+                // Set next state to ALL_RED (transitional state)
+                trafficLight->setNextState(TrafficLight::State::ALL_RED);
+                DebugLogger::log("Forcing light transition to ALL_RED then A_GREEN due to priority mode");
+            }
         }
-    }
-    // Check if we should exit priority mode (<5 vehicles)
-    else if (vehicleCount < Constants::PRIORITY_THRESHOLD_LOW && oldPriority > 0) {
-        // Deactivate priority mode
-        priorityLane->updatePriority();  // This will reset priority to 0
+        // Check if we should exit priority mode (<5 vehicles)
+        else if (vehicleCount < Constants::PRIORITY_THRESHOLD_LOW && oldPriority > 0) {
+            // Deactivate priority mode
+            priorityLane->updatePriority();  // This will reset priority to 0
 
-        DebugLogger::log("*** PRIORITY MODE DEACTIVATED: A2 now has " + std::to_string(vehicleCount) +
-                      " vehicles (<5) ***", DebugLogger::LogLevel::INFO);
+            DebugLogger::log("*** PRIORITY MODE DEACTIVATED: A2 now has " + std::to_string(vehicleCount) +
+                          " vehicles (<5) ***", DebugLogger::LogLevel::INFO);
+        }
     }
 
-    // CRITICAL: Also log current lane state
+    // CRITICAL: Also log current lane state (nothing to log when empty)
     std::ostringstream oss;
+    bool anyQueued = false;
     oss << "Lane Status: ";
     for (auto* lane : lanes) {
         if (lane->getVehicleCount() > 0) {
@@ -246,58 +690,303 @@ void TrafficManager::updatePriorities() {
             if (lane->getPriority() > 0) {
                 oss << "(PRIORITY) ";
             }
+            anyQueued = true;
         }
     }
-    DebugLogger::log(oss.str(), DebugLogger::LogLevel::DEBUG);
+    if (anyQueued) {
+        DebugLogger::log(oss.str(), DebugLogger::LogLevel::DEBUG);
+    }
 }
 
 
+void TrafficManager::setWorkerThreads(size_t threads) {
+    if (workerPool) {
+        delete workerPool;
+        workerPool = nullptr;
+    }
+
+    if (threads > 1) {
+        workerPool = new ThreadPool(threads);
+    }
+
+    // Congestion re-routing recomputes on the same workers
+    routing.setThreadPool(workerPool);
+
+    DebugLogger::log("Vehicle updates on " + std::to_string(threads > 1 ? threads : 1) + " thread(s)");
+}
+
 void TrafficManager::processVehicles(uint32_t delta) {
-    // Determine which road has green light
-    char greenRoad = ' ';
-    if (trafficLight) {
-        auto state = trafficLight->getCurrentState();
-        if (state == TrafficLight::State::A_GREEN) greenRoad = 'A';
-        else if (state == TrafficLight::State::B_GREEN) greenRoad = 'B';
-        else if (state == TrafficLight::State::C_GREEN) greenRoad = 'C';
-        else if (state == TrafficLight::State::D_GREEN) greenRoad = 'D';
+    // Every SAMPLE_STEPS steps, one emissions batch entry per queue entry
+    // of the owned lanes, filled by the step loops
+    emissionsSample = false;
+    if (emissionsAccounting) {
+        emissionsElapsed += delta;
+        emissionsSample = ++emissionsSteps >= EmissionsBatch::SAMPLE_STEPS;
+    }
+    if (emissionsSample) {
+        size_t entries = 0;
+        for (uint32_t j = partitionFirst; j < partitionLast; j++) {
+            for (auto* lane : junctionLanes[j]) {
+                entries += lane->getVehicles().size();
+            }
+        }
+        emissionsBatch.begin(entries);
     }
 
-    // CRITICAL: Process each lane independently with special rules
-    for (auto* lane : lanes) {
-        bool isGreenLight = false;
+    if (fixedPointKinematics) {
+        stepVehicles<FixedKinematics>(delta);
+    } else {
+        stepVehicles<FloatKinematics>(delta);
+    }
+
+    if (emissionsSample) {
+        emissionsBatch.run(emissionsElapsed, emissionTotals);
+        emissionsSteps = 0;
+        emissionsElapsed = 0;
+    }
+
+    logLaneMovement();
+}
 
-        // RULE 1: If this is lane's road has green light, it can move
-        if (lane->getLaneId() == greenRoad) {
-            isGreenLight = true;
+template<typename Kinematics>
+void TrafficManager::stepVehicles(uint32_t delta) {
+    if (workerPool) {
+        stepVehiclesParallel<Kinematics>(delta);
+        return;
+    }
+
+    size_t entry = 0;
+    for (uint32_t j = partitionFirst; j < partitionLast; j++) {
+        auto state = trafficLights[j]->getCurrentState();
+        const std::vector<uint32_t>& laneIndices = junctionLaneIndices[j];
+
+        // Standard junctions: movement rules come from the kernel's tables
+        uint32_t kernel = standardIndex[j];
+        if (kernel != RoadNetwork::INVALID_INDEX) {
+            if (emissionsSample) {
+                standardJunctions[kernel].moveVehicles<Kinematics>(delta, state, [&](int s, Vehicle* vehicle) {
+                    recordEmissions(entry++, vehicle, laneIndices[s]);
+                    noteMotion(vehicle, laneIndices[s]);
+                });
+            } else {
+                standardJunctions[kernel].moveVehicles<Kinematics>(delta, state, [&](int s, Vehicle* vehicle) {
+                    noteMotion(vehicle, laneIndices[s]);
+                });
+            }
+            continue;
         }
-        // RULE 2: Lane 3 (free lane) can ALWAYS move regardless of traffic light
-        else if (lane->getLaneNumber() == 3) {
-            isGreenLight = true;  // FREE LANE ALWAYS HAS GREEN LIGHT
+
+        // Determine which road has green light at this junction
+        char greenRoad = greenRoadFor(state);
+
+        // CRITICAL: Process each lane independently with special rules
+        for (size_t s = 0; s < junctionLanes[j].size(); s++) {
+            Lane* lane = junctionLanes[j][s];
+            bool isGreenLight = false;
+
+            // RULE 1: If this is lane's road has green light, it can move
+            if (lane->getLaneId() == greenRoad) {
+                isGreenLight = true;
+            }
+            // RULE 2: Lane 3 (free lane) can ALWAYS move regardless of traffic light
+            else if (lane->getLaneNumber() == 3) {
+                isGreenLight = true;  // FREE LANE ALWAYS HAS GREEN LIGHT
+            }
+
+            // Get all vehicles in this lane
+            const auto& vehicles = lane->getVehicles();
+
+            // Update each vehicle
+            for (size_t queuePos = 0; queuePos < vehicles.size(); queuePos++) {
+                Vehicle* vehicle = vehicles[queuePos];
+                if (vehicle) {
+                    // CRITICAL: Update vehicle with correct light status
+                    vehicle->setQueuePosition(static_cast<int>(queuePos));
+                    vehicle->step<Kinematics>(delta, isGreenLight);
+                    noteMotion(vehicle, laneIndices[s]);
+                }
+                if (emissionsSample) {
+                    recordEmissions(entry++, vehicle, laneIndices[s]);
+                }
+            }
         }
+    }
+}
 
-        // Get all vehicles in this lane
-        const auto& vehicles = lane->getVehicles();
-        int queuePos = 0;
+template<typename Kinematics>
+void TrafficManager::stepVehiclesParallel(uint32_t delta) {
+    // Cut every lane into chunks. A vehicle's step only reads its own state
+    // and its queue position, which is fixed by the queue order at the start
+    // of the step, so chunks can run on any thread in any order and the result
+    // is the same for every thread count.
+    vehicleChunks.clear();
+    size_t entry = 0;
+    for (uint32_t j = partitionFirst; j < partitionLast; j++) {
+        auto state = trafficLights[j]->getCurrentState();
+        char greenRoad = greenRoadFor(state);
+        uint32_t kernel = standardIndex[j];
+
+        const std::vector<Lane*>& laneList = junctionLanes[j];
+        for (size_t s = 0; s < laneList.size(); s++) {
+            Lane* lane = laneList[s];
+            bool isGreenLight = kernel != RoadNetwork::INVALID_INDEX
+                ? StandardJunction::isMoving(state, static_cast<int>(s))
+                : (lane->getLaneId() == greenRoad || lane->getLaneNumber() == 3);
+
+            size_t count = lane->getVehicles().size();
+            for (size_t begin = 0; begin < count; begin += Constants::VEHICLE_CHUNK) {
+                size_t end = std::min(count, begin + static_cast<size_t>(Constants::VEHICLE_CHUNK));
+                vehicleChunks.push_back({lane, begin, end, isGreenLight, false, junctionLaneIndices[j][s], entry});
+                entry += end - begin;
+            }
+        }
+    }
 
-        // Update each vehicle
-        for (auto* vehicle : vehicles) {
+    workerPool->parallelFor(vehicleChunks.size(), [this, delta](size_t c) {
+        VehicleChunk& chunk = vehicleChunks[c];
+        const auto& vehicles = chunk.lane->getVehicles();
+        for (size_t queuePos = chunk.begin; queuePos < chunk.end; queuePos++) {
+            Vehicle* vehicle = vehicles[queuePos];
             if (vehicle) {
-                // CRITICAL: Update vehicle with correct light status
-                vehicle->update(delta, isGreenLight, 0.0f);
-                queuePos++;
+                vehicle->setQueuePosition(static_cast<int>(queuePos));
+                vehicle->step<Kinematics>(delta, chunk.isGreenLight);
+                chunk.moved = chunk.moved || vehicle->hasMotionChanged();
+            }
+            if (emissionsSample) {
+                recordEmissions(chunk.entry + queuePos - chunk.begin, vehicle, chunk.laneIndex);
             }
         }
+    });
+
+    // Chunks of one lane may have run on different threads
+    for (const auto& chunk : vehicleChunks) {
+        if (chunk.moved) {
+            movedLanes[chunk.laneIndex] = 1;
+        }
+    }
+}
+
+EmissionsBatch::Totals TrafficManager::getEmissionTotals() const {
+    EmissionsBatch::Totals total = EmissionsBatch::Totals();
+    for (const auto& totals : emissionTotals) {
+        total.add(totals);
+    }
+    return total;
+}
+
+const EmissionsBatch::Totals& TrafficManager::getEmissionTotals(uint32_t lane, Destination destination) const {
+    return emissionTotals[lane * 3 + static_cast<uint32_t>(destination)];
+}
+
+std::string TrafficManager::getEmissionsSummary() const {
+    static const char* const TURNS[3] = {"straight", "left", "right"};
+    const bool multiJunction = network.getJunctionCount() > 1;
+
+    char line[160];
+    std::ostringstream summary;
+    std::snprintf(line, sizeof(line), "%-14s %10s %10s %10s %10s %10s\n",
+                  "movement", "fuel L", "CO2 kg", "energy MJ", "distance km", "veh-hours");
+    summary << line;
+
+    auto row = [&](const std::string& name, const EmissionsBatch::Totals& totals) {
+        std::snprintf(line, sizeof(line), "%-14s %10.3f %10.3f %10.3f %10.3f %10.3f\n", name.c_str(),
+                      totals.fuelMl / 1000.0, totals.co2G / 1000.0, totals.energyKj / 1000.0,
+                      totals.distanceM / 1000.0, totals.vehicleSeconds / 3600.0);
+        summary << line;
+    };
+
+    for (uint32_t l = 0; l < lanes.size(); l++) {
+        for (uint32_t d = 0; d < 3; d++) {
+            const EmissionsBatch::Totals& totals = emissionTotals[l * 3 + d];
+            if (totals.vehicleSeconds <= 0.0) {
+                continue;
+            }
+            std::string name = lanes[l]->getName() + " " + TURNS[d];
+            if (multiJunction) {
+                name = "J" + std::to_string(network.getLane(l).junction) + " " + name;
+            }
+            row(name, totals);
+        }
+    }
+    row("total", getEmissionTotals());
+    return summary.str();
+}
+
+PhaseAnalytics::Summary TrafficManager::getPhaseTotals() const {
+    PhaseAnalytics::Summary total = PhaseAnalytics::Summary();
+    for (uint32_t j = partitionFirst; j < partitionLast; j++) {
+        total.add(phaseAnalytics[j].getTotals());
+    }
+    return total;
+}
+
+std::string TrafficManager::getPhaseReport() const {
+    char line[160];
+    std::ostringstream report;
+    std::snprintf(line, sizeof(line), "%-8s %9s %9s %9s %11s %9s %7s\n",
+                  "phase", "green s", "used s", "wasted %", "veh/green s", "residual", "greens");
+    report << line;
+
+    auto row = [&](const std::string& name, const PhaseAnalytics::Figures& figures) {
+        std::snprintf(line, sizeof(line), "%-8s %9.1f %9.1f %9.1f %11.2f %9.2f %7llu\n", name.c_str(),
+                      figures.greenMs / 1000.0, figures.getUsedMs() / 1000.0, figures.getWastedShare() * 100.0,
+                      figures.getDischargeRate(), figures.getMeanResidual(),
+                      static_cast<unsigned long long>(figures.greens));
+        report << line;
+    };
+
+    PhaseAnalytics::Summary totals = getPhaseTotals();
+    for (int p = 0; p < PhaseAnalytics::PHASE_COUNT; p++) {
+        row(std::string(1, static_cast<char>('A' + p)) + " green", totals.phases[p]);
+    }
+    row("all", totals.getGreen());
+    std::snprintf(line, sizeof(line), "ALL_RED %.1f%% of %.1f s, %llu cycles\n", totals.getAllRedShare() * 100.0,
+                  totals.totalMs / 1000.0, static_cast<unsigned long long>(totals.cycles));
+    report << line;
+
+    // The entry junction's recent cycles
+    uint32_t entry = network.getEntryJunction();
+    if (!ownsJunction(entry) || phaseAnalytics[entry].getRecentCycles().empty()) {
+        return report.str();
+    }
+    const auto& cycles = phaseAnalytics[entry].getRecentCycles();
+    std::snprintf(line, sizeof(line), "Last cycles at J%u:\n%9s %9s %9s %9s %11s %9s %9s\n", entry,
+                  "start s", "length s", "green s", "wasted %", "veh/green s", "residual", "ALL_RED %");
+    report << line;
+    for (size_t c = cycles.size() > 10 ? cycles.size() - 10 : 0; c < cycles.size(); c++) {
+        PhaseAnalytics::Figures green = cycles[c].getGreen();
+        std::snprintf(line, sizeof(line), "%9.1f %9.1f %9.1f %9.1f %11.2f %9.2f %9.1f\n",
+                      cycles[c].startMs / 1000.0, cycles[c].totalMs / 1000.0, green.greenMs / 1000.0,
+                      green.getWastedShare() * 100.0, green.getDischargeRate(), green.getMeanResidual(),
+                      cycles[c].getAllRedShare() * 100.0);
+        report << line;
+    }
+    return report.str();
+}
+
+void TrafficManager::logLaneMovement() {
+    uint32_t j = network.getEntryJunction();
+    if (!ownsJunction(j)) {
+        return;
+    }
+
+    auto state = trafficLights[j]->getCurrentState();
+    for (auto* lane : junctionLanes[j]) {
+        const auto& vehicles = lane->getVehicles();
+        if (vehicles.empty()) {
+            continue;
+        }
 
         // For priority lane A2, log movement status
-        if (lane->getLaneId() == 'A' && lane->getLaneNumber() == 2 && !vehicles.empty()) {
+        if (lane->getLaneId() == 'A' && lane->getLaneNumber() == 2) {
+            bool isGreenLight = state == TrafficLight::State::A_GREEN;
             DebugLogger::log("A2 (Priority): " + std::to_string(vehicles.size()) +
                           " vehicles, GreenLight=" + std::to_string(isGreenLight),
                           DebugLogger::LogLevel::DEBUG);
         }
 
         // For free lanes, verify they're moving
-        if (lane->getLaneNumber() == 3 && !vehicles.empty()) {
+        if (lane->getLaneNumber() == 3) {
             DebugLogger::log(lane->getName() + " (Free lane): " +
                           std::to_string(vehicles.size()) + " vehicles, GreenLight=true",
                           DebugLogger::LogLevel::DEBUG);
@@ -306,46 +995,798 @@ void TrafficManager::processVehicles(uint32_t delta) {
 }
 
 void TrafficManager::checkVehicleBoundaries() {
+    for (uint32_t j = partitionFirst; j < partitionLast; j++) {
+        for (auto* lane : junctionLanes[j]) {
+            // Check each vehicle
+            while (!lane->isEmpty()) {
+                Vehicle* vehicle = lane->peek();
+
+                if (vehicle && vehicle->hasExited()) {
+                    // Remove the vehicle from the queue
+                    Vehicle* removedVehicle = lane->dequeue();
+                    phaseAnalytics[j].onExit(*lane);
+                    delayHistogram.record(simulationTime - std::min(simulationTime, removedVehicle->getQueuedAt()));
+                    emissionsBatch.settle(removedVehicle);
+
+                    // Pass it on to the next junction if the exit road is linked
+                    if (forwardVehicle(j, removedVehicle)) {
+                        delete removedVehicle;
+                        continue;
+                    }
+
+                    exitedCount++;
+
+                    // Log vehicle exit with lane info
+                    std::ostringstream oss;
+                    oss << "Vehicle " << removedVehicle->getId() << " exited the simulation from lane "
+                        << removedVehicle->getLane() << removedVehicle->getLaneNumber();
+                    if (emissionsAccounting) {
+                        oss << " (fuel " << removedVehicle->getEnergy().fuelMl << " mL, CO2 "
+                            << removedVehicle->getEnergy().co2G << " g)";
+                    }
+                    DebugLogger::log(oss.str());
+
+                    // Delete the vehicle
+                    delete removedVehicle;
+                } else {
+                    // If the first vehicle hasn't exited, the rest haven't either
+                    break;
+                }
+            }
+        }
+    }
+}
+
+bool TrafficManager::forwardVehicle(uint32_t junction, Vehicle* vehicle) {
+    // Vehicles without a target get one derived from their id
+    uint32_t target = vehicle->getRouteTarget();
+    if (target >= network.getJunctionCount()) {
+        target = static_cast<uint32_t>(std::hash<std::string>()(vehicle->getId()) % network.getJunctionCount());
+    }
+
+    // Vehicles leave the network once they have crossed their target junction
+    if (target == junction) {
+        return false;
+    }
+
+    // After leaving the junction the vehicle's lane is the exit road
+    uint32_t linkIndex = network.exitLink(junction, vehicle->getLane());
+    if (linkIndex == RoadNetwork::INVALID_INDEX) {
+        return false;
+    }
+
+    const RoadNetwork::Link& link = network.getLink(linkIndex);
+    const RoadNetwork::Junction& next = network.getJunction(link.toJunction);
+
+    // Routing decision for the next junction: one table lookup for the exit
+    // road, then pick the approach lane that turns onto it. Vehicles that reach
+    // their target, or where the turn isn't allowed, continue straight.
+    int laneNumber = 2;
+    Destination destination = Destination::STRAIGHT;
+    char exitRoad = routing.nextRoad(link.toJunction, target);
+    if (exitRoad != '\0' && next.approachCount == 4 &&
+        StandardJunction::approachFor(link.entryRoad, exitRoad, laneNumber, destination)) {
+        uint32_t lane = network.laneIndex(link.toJunction, link.entryRoad, laneNumber);
+        uint8_t move = destination == Destination::STRAIGHT ? RoadNetwork::MOVE_STRAIGHT : RoadNetwork::MOVE_LEFT;
+        if (lane == RoadNetwork::INVALID_INDEX || !(network.getLane(lane).movements & move)) {
+            laneNumber = 2;
+            destination = Destination::STRAIGHT;
+        }
+    }
+
+    uint32_t targetLane = network.laneIndex(link.toJunction, link.entryRoad, laneNumber);
+    if (targetLane == RoadNetwork::INVALID_INDEX) {
+        return false;
+    }
+
+    VehicleTransfer transfer;
+    transfer.arrivalTime = simulationTime +
+        static_cast<uint64_t>(link.length / Constants::LINK_SPEED * 1000.0f);
+    transfer.laneIndex = targetLane;
+    transfer.routeTarget = target;
+    transfer.vehicleId = vehicle->getId();
+    transfer.destination = destination;
+    transfer.isEmergency = vehicle->isEmergencyVehicle();
+
+    // Another partition simulates the downstream junction
+    if (!ownsJunction(link.toJunction)) {
+        outbox.push_back(transfer);
+        return true;
+    }
+
+    pushTransit(transfer);
+    return true;
+}
+
+void TrafficManager::deliverTransfers() {
+    while (!inTransit.empty() && inTransit.front().arrivalTime <= simulationTime) {
+        std::pop_heap(inTransit.begin(), inTransit.end(), std::greater<VehicleTransfer>());
+        VehicleTransfer transfer = inTransit.back();
+        inTransit.pop_back();
+        logTransitRemoved(transfer);
+
+        Lane* lane = lanes[transfer.laneIndex];
+        Vehicle* vehicle = new Vehicle(transfer.vehicleId, lane->getLaneId(),
+                                       lane->getLaneNumber(), transfer.isEmergency);
+        vehicle->setDestination(transfer.destination);
+        vehicle->setRouteTarget(transfer.routeTarget);
+        vehicle->setQueuedAt(simulationTime);
+        lane->enqueue(vehicle);
+    }
+}
+
+void TrafficManager::setPartition(uint32_t first, uint32_t last) {
+    partitionFirst = std::min<uint32_t>(first, static_cast<uint32_t>(network.getJunctionCount()));
+    partitionLast = std::min<uint32_t>(std::max(first, last), static_cast<uint32_t>(network.getJunctionCount()));
+
+    std::ostringstream oss;
+    oss << "TrafficManager owns junctions [" << partitionFirst << ", " << partitionLast << ")";
+    DebugLogger::log(oss.str());
+}
+
+std::vector<TrafficManager::VehicleTransfer> TrafficManager::takeOutgoingTransfers() {
+    std::vector<VehicleTransfer> transfers;
+    transfers.swap(outbox);
+    return transfers;
+}
+
+void TrafficManager::returnOutgoingTransfers(const std::vector<VehicleTransfer>& transfers) {
+    outbox.insert(outbox.begin(), transfers.begin(), transfers.end());
+}
+
+void TrafficManager::acceptTransfer(const VehicleTransfer& transfer) {
+    if (transfer.laneIndex >= lanes.size() || !ownsJunction(network.getLane(transfer.laneIndex).junction)) {
+        DebugLogger::log("Dropped transfer of " + transfer.vehicleId + " to a lane outside this partition",
+                         DebugLogger::LogLevel::ERROR);
+        return;
+    }
+
+    pushTransit(transfer);
+}
+
+void TrafficManager::pushTransit(const VehicleTransfer& transfer) {
+    inTransit.push_back(transfer);
+    std::push_heap(inTransit.begin(), inTransit.end(), std::greater<VehicleTransfer>());
+    if (!checkpointLaneVersions.empty() && !transitRewrite) {
+        transitAdded.push_back(transfer);
+    }
+}
+
+void TrafficManager::logTransitRemoved(const VehicleTransfer& transfer) {
+    if (checkpointLaneVersions.empty() || transitRewrite) {
+        return;
+    }
+    transitRemoved.push_back(transfer);
+
+    // Past this point writing the links out whole is smaller than the log
+    if (transitAdded.size() + transitRemoved.size() > inTransit.size() + 64) {
+        transitAdded.clear();
+        transitRemoved.clear();
+        transitRewrite = true;
+    }
+}
+
+size_t TrafficManager::getVehicleCount() const {
+    size_t count = inTransit.size() + outbox.size();
+    for (uint32_t j = partitionFirst; j < partitionLast; j++) {
+        for (auto* lane : junctionLanes[j]) {
+            count += lane->getVehicleCount();
+        }
+    }
+    return count;
+}
+
+bool TrafficManager::saveCheckpoint(const std::string& path) const {
+    // Write to a temporary file first so a crash never leaves a torn checkpoint
+    std::string tempPath = path + ".tmp";
+    std::ofstream file(tempPath, std::ios::binary | std::ios::trunc);
+    if (!file.is_open()) {
+        DebugLogger::log("Could not write checkpoint " + path, DebugLogger::LogLevel::ERROR);
+        return false;
+    }
+
+    uint64_t queued = 0;
+    for (uint32_t j = partitionFirst; j < partitionLast; j++) {
+        for (auto* lane : junctionLanes[j]) {
+            queued += lane->getVehicleCount();
+        }
+    }
+    uint64_t transit = inTransit.size();
+    uint64_t outgoing = outbox.size();
+    uint32_t laneCount = static_cast<uint32_t>(lanes.size());
+    uint32_t lightCount = partitionLast - partitionFirst;
+    uint64_t cursor = traceCursor;
+    uint32_t linkCount = static_cast<uint32_t>(network.getLinkCount());
+
+    file.write(CHECKPOINT_MAGIC, 4);
+    file.write(reinterpret_cast<const char*>(&CHECKPOINT_VERSION), sizeof(CHECKPOINT_VERSION));
+    file.write(reinterpret_cast<const char*>(&laneCount), sizeof(laneCount));
+    file.write(reinterpret_cast<const char*>(&simulationTime), sizeof(simulationTime));
+    file.write(reinterpret_cast<const char*>(&exitedCount), sizeof(exitedCount));
+    file.write(reinterpret_cast<const char*>(&queued), sizeof(queued));
+    file.write(reinterpret_cast<const char*>(&transit), sizeof(transit));
+    file.write(reinterpret_cast<const char*>(&outgoing), sizeof(outgoing));
+    file.write(reinterpret_cast<const char*>(&lightCount), sizeof(lightCount));
+    file.write(reinterpret_cast<const char*>(&cursor), sizeof(cursor));
+    file.write(reinterpret_cast<const char*>(&lastRouteUpdateTime), sizeof(lastRouteUpdateTime));
+    file.write(reinterpret_cast<const char*>(&linkCount), sizeof(linkCount));
+
+    // Queued vehicles, front of each lane first
+    for (uint32_t j = partitionFirst; j < partitionLast; j++) {
+        uint32_t firstLane = network.getJunction(j).firstLane;
+        for (size_t i = 0; i < junctionLanes[j].size(); i++) {
+            for (auto* vehicle : junctionLanes[j][i]->getVehicles()) {
+                writeQueued(file, *vehicle, firstLane + static_cast<uint32_t>(i));
+            }
+        }
+    }
+
+    // Vehicles still on links, then those waiting to be handed over
+    for (const auto& transfer : inTransit) {
+        writeTransfer(file, transfer);
+    }
+    for (const auto& transfer : outbox) {
+        writeTransfer(file, transfer);
+    }
+
+    // Light controllers of owned junctions
+    for (uint32_t j = partitionFirst; j < partitionLast; j++) {
+        LightCheckpoint light = getLightCheckpoint(j);
+        file.write(reinterpret_cast<const char*>(&j), sizeof(j));
+        file.write(reinterpret_cast<const char*>(&light), sizeof(light));
+    }
+
+    // Link costs as congestion re-routing left them
+    for (uint32_t l = 0; l < linkCount; l++) {
+        CheckpointLinkCost cost = {l, routing.getLinkCost(l)};
+        file.write(reinterpret_cast<const char*>(&cost), sizeof(cost));
+    }
+
+    file.close();
+    if (!file || std::rename(tempPath.c_str(), path.c_str()) != 0) {
+        DebugLogger::log("Could not write checkpoint " + path, DebugLogger::LogLevel::ERROR);
+        return false;
+    }
+
+    markCheckpoint();
+    return true;
+}
+
+bool TrafficManager::loadCheckpoint(const std::string& path) {
+    std::ifstream file(path, std::ios::binary);
+    if (!file.is_open()) {
+        DebugLogger::log("Could not open checkpoint " + path, DebugLogger::LogLevel::ERROR);
+        return false;
+    }
+
+    char magic[4];
+    uint32_t version = 0;
+    uint32_t laneCount = 0, lightCount = 0, linkCount = 0;
+    uint64_t savedTime = 0, savedExited = 0, queued = 0, transit = 0, outgoing = 0, cursor = 0, routeTime = 0;
+    file.read(magic, 4);
+    file.read(reinterpret_cast<char*>(&version), sizeof(version));
+    file.read(reinterpret_cast<char*>(&laneCount), sizeof(laneCount));
+    file.read(reinterpret_cast<char*>(&savedTime), sizeof(savedTime));
+    file.read(reinterpret_cast<char*>(&savedExited), sizeof(savedExited));
+    file.read(reinterpret_cast<char*>(&queued), sizeof(queued));
+    file.read(reinterpret_cast<char*>(&transit), sizeof(transit));
+    file.read(reinterpret_cast<char*>(&outgoing), sizeof(outgoing));
+    file.read(reinterpret_cast<char*>(&lightCount), sizeof(lightCount));
+    file.read(reinterpret_cast<char*>(&cursor), sizeof(cursor));
+    file.read(reinterpret_cast<char*>(&routeTime), sizeof(routeTime));
+    file.read(reinterpret_cast<char*>(&linkCount), sizeof(linkCount));
+
+    if (!file || std::memcmp(magic, CHECKPOINT_MAGIC, 4) != 0 || version != CHECKPOINT_VERSION ||
+        laneCount != lanes.size()) {
+        DebugLogger::log("Checkpoint " + path + " does not match this network", DebugLogger::LogLevel::ERROR);
+        return false;
+    }
+
+    // Drop the current state, and with it the delta baseline until the
+    // restore is complete
     for (auto* lane : lanes) {
-        // Check each vehicle
         while (!lane->isEmpty()) {
-            Vehicle* vehicle = lane->peek();
+            delete lane->dequeue();
+        }
+    }
+    inTransit.clear();
+    outbox.clear();
+    checkpointLaneVersions.clear();
+
+    CheckpointVehicle record;
+    CheckpointMotion motion;
+    std::string id;
+    for (uint64_t i = 0; i < queued + transit + outgoing; i++) {
+        bool read = i < queued ? readQueued(file, record, id, motion) : readVehicle(file, record, id);
+        if (!read || record.laneIndex >= lanes.size()) {
+            DebugLogger::log("Truncated checkpoint " + path, DebugLogger::LogLevel::ERROR);
+            return false;
+        }
 
-            if (vehicle && vehicle->hasExited()) {
-                // Remove the vehicle from the queue
-                Vehicle* removedVehicle = lane->dequeue();
+        if (i < queued) {
+            lanes[record.laneIndex]->enqueue(restoreVehicle(record, id, *lanes[record.laneIndex], motion));
+        } else if (i < queued + transit) {
+            inTransit.push_back(restoreTransfer(record, id));
+        } else {
+            outbox.push_back(restoreTransfer(record, id));
+        }
+    }
+    std::make_heap(inTransit.begin(), inTransit.end(), std::greater<VehicleTransfer>());
 
-                // Log vehicle exit with lane info
-                std::ostringstream oss;
-                oss << "Vehicle " << removedVehicle->getId() << " exited the simulation from lane "
-                    << removedVehicle->getLane() << removedVehicle->getLaneNumber();
-                DebugLogger::log(oss.str());
+    // Lights the checkpoint doesn't cover start a fresh cycle
+    for (auto* light : trafficLights) {
+        light->restart(static_cast<uint32_t>(savedTime));
+    }
+    for (uint32_t i = 0; i < lightCount; i++) {
+        uint32_t junction = 0;
+        LightCheckpoint light;
+        file.read(reinterpret_cast<char*>(&junction), sizeof(junction));
+        file.read(reinterpret_cast<char*>(&light), sizeof(light));
+        if (!file || junction >= trafficLights.size()) {
+            DebugLogger::log("Truncated checkpoint " + path, DebugLogger::LogLevel::ERROR);
+            return false;
+        }
+        restoreLight(junction, light);
+    }
 
-                // Delete the vehicle
-                delete removedVehicle;
-            } else {
-                // If the first vehicle hasn't exited, the rest haven't either
-                break;
+    std::vector<std::pair<uint32_t, float>> costs;
+    if (!readLinkCosts(file, linkCount, costs)) {
+        DebugLogger::log("Truncated checkpoint " + path, DebugLogger::LogLevel::ERROR);
+        return false;
+    }
+    restoreLinkCosts(costs);
+
+    simulationTime = savedTime;
+    lastRouteUpdateTime = routeTime;
+    exitedCount = savedExited;
+    if (arrivalTrace) {
+        traceCursor = static_cast<size_t>(std::min<uint64_t>(cursor, arrivalTrace->size()));
+    }
+    markCheckpoint();
+
+    std::ostringstream oss;
+    oss << "Restored checkpoint " << path << ": " << queued << " queued, " << transit << " in transit, "
+        << outgoing << " outgoing";
+    DebugLogger::log(oss.str());
+
+    return true;
+}
+
+bool TrafficManager::saveDeltaCheckpoint(const std::string& path) const {
+    if (checkpointLaneVersions.empty()) {
+        DebugLogger::log("Delta checkpoint " + path + " has no checkpoint to follow; save a full one first",
+                         DebugLogger::LogLevel::ERROR);
+        return false;
+    }
+
+    std::string tempPath = path + ".tmp";
+    std::ofstream file(tempPath, std::ios::binary | std::ios::trunc);
+    if (!file.is_open()) {
+        DebugLogger::log("Could not write checkpoint " + path, DebugLogger::LogLevel::ERROR);
+        return false;
+    }
+
+    // Owned lanes whose queue changed since the baseline go out whole.
+    // In the others only the vehicles that moved are written.
+    std::vector<uint32_t> changedLanes;
+    std::vector<uint32_t> movedLaneList;
+    std::vector<uint32_t> ownedLanes;
+    size_t queued = 0, changedVehicles = 0;
+    for (uint32_t j = partitionFirst; j < partitionLast; j++) {
+        uint32_t firstLane = network.getJunction(j).firstLane;
+        for (size_t i = 0; i < junctionLanes[j].size(); i++) {
+            uint32_t laneIndex = firstLane + static_cast<uint32_t>(i);
+            size_t count = static_cast<size_t>(lanes[laneIndex]->getVehicleCount());
+            ownedLanes.push_back(laneIndex);
+            queued += count;
+            if (lanes[laneIndex]->getVersion() != checkpointLaneVersions[laneIndex]) {
+                changedLanes.push_back(laneIndex);
+                changedVehicles += count;
+            } else if (movedLanes[laneIndex]) {
+                movedLaneList.push_back(laneIndex);
+            }
+        }
+    }
+
+    // When nearly everything changed, a delta carrying every lane and the
+    // links whole is no bigger than a full checkpoint
+    size_t logged = transitRewrite ? inTransit.size() : transitAdded.size() + transitRemoved.size();
+    if (changedVehicles + logged > queued + inTransit.size()) {
+        changedLanes.swap(ownedLanes);
+        movedLaneList.clear();
+        transitRewrite = true;
+    }
+
+    // Owned lights whose controller changed since the baseline
+    std::vector<uint32_t> changedLights;
+    for (uint32_t j = partitionFirst; j < partitionLast; j++) {
+        if (getLightCheckpoint(j) != checkpointLights[j]) {
+            changedLights.push_back(j);
+        }
+    }
+
+    // Links re-routing changed the cost of since the baseline
+    std::vector<uint32_t> changedLinks;
+    for (uint32_t l = 0; l < network.getLinkCount(); l++) {
+        if (routing.getLinkCost(l) != checkpointLinkCosts[l]) {
+            changedLinks.push_back(l);
+        }
+    }
+
+    // Links go out whole once their log has been dropped
+    const std::vector<VehicleTransfer>& added = transitRewrite ? inTransit : transitAdded;
+    uint32_t laneCount = static_cast<uint32_t>(lanes.size());
+    uint32_t changed = static_cast<uint32_t>(changedLanes.size());
+    uint32_t moved = static_cast<uint32_t>(movedLaneList.size());
+    uint8_t rewrite = transitRewrite ? 1 : 0;
+    uint64_t addedCount = added.size();
+    uint64_t removedCount = transitRewrite ? 0 : transitRemoved.size();
+    uint64_t outgoing = outbox.size();
+    uint32_t lightCount = static_cast<uint32_t>(changedLights.size());
+    uint64_t cursor = traceCursor;
+    uint32_t linkCount = static_cast<uint32_t>(changedLinks.size());
+
+    file.write(DELTA_CHECKPOINT_MAGIC, 4);
+    file.write(reinterpret_cast<const char*>(&DELTA_CHECKPOINT_VERSION), sizeof(DELTA_CHECKPOINT_VERSION));
+    file.write(reinterpret_cast<const char*>(&laneCount), sizeof(laneCount));
+    file.write(reinterpret_cast<const char*>(&checkpointTime), sizeof(checkpointTime));
+    file.write(reinterpret_cast<const char*>(&simulationTime), sizeof(simulationTime));
+    file.write(reinterpret_cast<const char*>(&exitedCount), sizeof(exitedCount));
+    file.write(reinterpret_cast<const char*>(&changed), sizeof(changed));
+    file.write(reinterpret_cast<const char*>(&moved), sizeof(moved));
+    file.write(reinterpret_cast<const char*>(&rewrite), sizeof(rewrite));
+    file.write(reinterpret_cast<const char*>(&addedCount), sizeof(addedCount));
+    file.write(reinterpret_cast<const char*>(&removedCount), sizeof(removedCount));
+    file.write(reinterpret_cast<const char*>(&outgoing), sizeof(outgoing));
+    file.write(reinterpret_cast<const char*>(&lightCount), sizeof(lightCount));
+    file.write(reinterpret_cast<const char*>(&cursor), sizeof(cursor));
+    file.write(reinterpret_cast<const char*>(&lastRouteUpdateTime), sizeof(lastRouteUpdateTime));
+    file.write(reinterpret_cast<const char*>(&linkCount), sizeof(linkCount));
+
+    // Each changed lane whole: index, vehicle count, vehicles front first
+    for (uint32_t laneIndex : changedLanes) {
+        uint32_t count = static_cast<uint32_t>(lanes[laneIndex]->getVehicleCount());
+        file.write(reinterpret_cast<const char*>(&laneIndex), sizeof(laneIndex));
+        file.write(reinterpret_cast<const char*>(&count), sizeof(count));
+        for (auto* vehicle : lanes[laneIndex]->getVehicles()) {
+            writeQueued(file, *vehicle, laneIndex);
+        }
+    }
+
+    // Lanes with vehicles that moved up: index, count, then each vehicle's
+    // place in the queue and motion
+    std::vector<CheckpointMove> moves;
+    for (uint32_t laneIndex : movedLaneList) {
+        moves.clear();
+        const auto& vehicles = lanes[laneIndex]->getVehicles();
+        for (size_t v = 0; v < vehicles.size(); v++) {
+            if (vehicles[v]->hasMotionChanged()) {
+                moves.push_back({static_cast<uint32_t>(v), vehicles[v]->getMotion()});
             }
         }
+        uint32_t count = static_cast<uint32_t>(moves.size());
+        file.write(reinterpret_cast<const char*>(&laneIndex), sizeof(laneIndex));
+        file.write(reinterpret_cast<const char*>(&count), sizeof(count));
+        file.write(reinterpret_cast<const char*>(moves.data()), count * sizeof(CheckpointMove));
+    }
+
+    for (const auto& transfer : added) {
+        writeTransfer(file, transfer);
+    }
+    if (!transitRewrite) {
+        for (const auto& transfer : transitRemoved) {
+            writeTransfer(file, transfer);
+        }
+    }
+
+    // Undelivered outgoing transfers are few and short-lived: always whole
+    for (const auto& transfer : outbox) {
+        writeTransfer(file, transfer);
     }
+
+    for (uint32_t junction : changedLights) {
+        LightCheckpoint light = getLightCheckpoint(junction);
+        file.write(reinterpret_cast<const char*>(&junction), sizeof(junction));
+        file.write(reinterpret_cast<const char*>(&light), sizeof(light));
+    }
+
+    for (uint32_t l : changedLinks) {
+        CheckpointLinkCost cost = {l, routing.getLinkCost(l)};
+        file.write(reinterpret_cast<const char*>(&cost), sizeof(cost));
+    }
+
+    file.close();
+    if (!file || std::rename(tempPath.c_str(), path.c_str()) != 0) {
+        DebugLogger::log("Could not write checkpoint " + path, DebugLogger::LogLevel::ERROR);
+        return false;
+    }
+
+    markCheckpoint();
+    return true;
 }
 
-Lane* TrafficManager::findLane(char laneId, int laneNumber) const {
-    for (auto* lane : lanes) {
-        if (lane->getLaneId() == laneId && lane->getLaneNumber() == laneNumber) {
-            return lane;
+bool TrafficManager::applyDeltaCheckpoint(const std::string& path) {
+    std::ifstream file(path, std::ios::binary);
+    if (!file.is_open()) {
+        DebugLogger::log("Could not open checkpoint " + path, DebugLogger::LogLevel::ERROR);
+        return false;
+    }
+
+    char magic[4];
+    uint32_t version = 0;
+    uint32_t laneCount = 0;
+    uint64_t previousTime = 0, savedTime = 0, savedExited = 0, addedCount = 0, removedCount = 0;
+    uint64_t outgoing = 0, cursor = 0, routeTime = 0;
+    uint32_t changed = 0, moved = 0, lightCount = 0, linkCount = 0;
+    uint8_t rewrite = 0;
+    file.read(magic, 4);
+    file.read(reinterpret_cast<char*>(&version), sizeof(version));
+    file.read(reinterpret_cast<char*>(&laneCount), sizeof(laneCount));
+    file.read(reinterpret_cast<char*>(&previousTime), sizeof(previousTime));
+    file.read(reinterpret_cast<char*>(&savedTime), sizeof(savedTime));
+    file.read(reinterpret_cast<char*>(&savedExited), sizeof(savedExited));
+    file.read(reinterpret_cast<char*>(&changed), sizeof(changed));
+    file.read(reinterpret_cast<char*>(&moved), sizeof(moved));
+    file.read(reinterpret_cast<char*>(&rewrite), sizeof(rewrite));
+    file.read(reinterpret_cast<char*>(&addedCount), sizeof(addedCount));
+    file.read(reinterpret_cast<char*>(&removedCount), sizeof(removedCount));
+    file.read(reinterpret_cast<char*>(&outgoing), sizeof(outgoing));
+    file.read(reinterpret_cast<char*>(&lightCount), sizeof(lightCount));
+    file.read(reinterpret_cast<char*>(&cursor), sizeof(cursor));
+    file.read(reinterpret_cast<char*>(&routeTime), sizeof(routeTime));
+    file.read(reinterpret_cast<char*>(&linkCount), sizeof(linkCount));
+
+    if (!file || std::memcmp(magic, DELTA_CHECKPOINT_MAGIC, 4) != 0 || version != DELTA_CHECKPOINT_VERSION ||
+        laneCount != lanes.size()) {
+        DebugLogger::log("Checkpoint " + path + " does not match this network", DebugLogger::LogLevel::ERROR);
+        return false;
+    }
+    if (checkpointLaneVersions.empty() || previousTime != checkpointTime) {
+        DebugLogger::log("Delta checkpoint " + path + " does not follow the restored state",
+                         DebugLogger::LogLevel::ERROR);
+        return false;
+    }
+
+    // A delta that fails half way leaves nothing for later deltas to follow
+    checkpointLaneVersions.clear();
+
+    CheckpointVehicle record;
+    CheckpointMotion motion;
+    std::string id;
+    for (uint32_t c = 0; c < changed; c++) {
+        uint32_t laneIndex = 0, count = 0;
+        file.read(reinterpret_cast<char*>(&laneIndex), sizeof(laneIndex));
+        file.read(reinterpret_cast<char*>(&count), sizeof(count));
+        if (!file || laneIndex >= lanes.size()) {
+            DebugLogger::log("Truncated checkpoint " + path, DebugLogger::LogLevel::ERROR);
+            return false;
+        }
+
+        Lane* lane = lanes[laneIndex];
+        while (!lane->isEmpty()) {
+            delete lane->dequeue();
+        }
+        for (uint32_t v = 0; v < count; v++) {
+            if (!readQueued(file, record, id, motion)) {
+                DebugLogger::log("Truncated checkpoint " + path, DebugLogger::LogLevel::ERROR);
+                return false;
+            }
+            lane->enqueue(restoreVehicle(record, id, *lane, motion));
+        }
+    }
+
+    // The queues of these lanes are as the baseline left them
+    uint64_t movedVehicles = 0;
+    for (uint32_t m = 0; m < moved; m++) {
+        uint32_t laneIndex = 0, count = 0;
+        file.read(reinterpret_cast<char*>(&laneIndex), sizeof(laneIndex));
+        file.read(reinterpret_cast<char*>(&count), sizeof(count));
+        if (!file || laneIndex >= lanes.size()) {
+            DebugLogger::log("Truncated checkpoint " + path, DebugLogger::LogLevel::ERROR);
+            return false;
+        }
+
+        const auto& vehicles = lanes[laneIndex]->getVehicles();
+        for (uint32_t v = 0; v < count; v++) {
+            CheckpointMove move;
+            if (!file.read(reinterpret_cast<char*>(&move), sizeof(move)) || move.position >= vehicles.size()) {
+                DebugLogger::log("Truncated checkpoint " + path, DebugLogger::LogLevel::ERROR);
+                return false;
+            }
+            vehicles[move.position]->setMotion(move.motion);
         }
+        movedVehicles += count;
+    }
+
+    // Transfers onto links, then the ones that came off them. Removals
+    // match the whole transfer, so a vehicle that left a link and went
+    // onto another within the delta keeps its new one.
+    if (rewrite) {
+        inTransit.clear();
+    }
+    std::set<std::tuple<std::string, uint64_t, uint32_t>> removed;
+    for (uint64_t i = 0; i < addedCount + removedCount; i++) {
+        if (!readVehicle(file, record, id) || record.laneIndex >= lanes.size()) {
+            DebugLogger::log("Truncated checkpoint " + path, DebugLogger::LogLevel::ERROR);
+            return false;
+        }
+        if (i < addedCount) {
+            inTransit.push_back(restoreTransfer(record, id));
+        } else {
+            removed.emplace(id, record.arrivalTime, record.laneIndex);
+        }
+    }
+    if (!removed.empty()) {
+        inTransit.erase(std::remove_if(inTransit.begin(), inTransit.end(), [&](const VehicleTransfer& transfer) {
+            return removed.erase(std::make_tuple(transfer.vehicleId, transfer.arrivalTime, transfer.laneIndex)) > 0;
+        }), inTransit.end());
+    }
+    std::make_heap(inTransit.begin(), inTransit.end(), std::greater<VehicleTransfer>());
+
+    outbox.clear();
+    for (uint64_t i = 0; i < outgoing; i++) {
+        if (!readVehicle(file, record, id) || record.laneIndex >= lanes.size()) {
+            DebugLogger::log("Truncated checkpoint " + path, DebugLogger::LogLevel::ERROR);
+            return false;
+        }
+        outbox.push_back(restoreTransfer(record, id));
+    }
+
+    for (uint32_t i = 0; i < lightCount; i++) {
+        uint32_t junction = 0;
+        LightCheckpoint light;
+        file.read(reinterpret_cast<char*>(&junction), sizeof(junction));
+        file.read(reinterpret_cast<char*>(&light), sizeof(light));
+        if (!file || junction >= trafficLights.size()) {
+            DebugLogger::log("Truncated checkpoint " + path, DebugLogger::LogLevel::ERROR);
+            return false;
+        }
+        restoreLight(junction, light);
+    }
+
+    std::vector<std::pair<uint32_t, float>> costs;
+    if (!readLinkCosts(file, linkCount, costs)) {
+        DebugLogger::log("Truncated checkpoint " + path, DebugLogger::LogLevel::ERROR);
+        return false;
+    }
+    restoreLinkCosts(costs);
+
+    simulationTime = savedTime;
+    lastRouteUpdateTime = routeTime;
+    exitedCount = savedExited;
+    if (arrivalTrace) {
+        traceCursor = static_cast<size_t>(std::min<uint64_t>(cursor, arrivalTrace->size()));
+    }
+    markCheckpoint();
+
+    std::ostringstream oss;
+    oss << "Applied delta checkpoint " << path << ": " << changed << " lanes, " << movedVehicles
+        << " vehicles moved in " << moved << " lanes, " << addedCount << " onto links"
+        << (rewrite ? " (rewritten)" : "") << ", " << removedCount << " off links, " << outgoing << " outgoing, "
+        << lightCount << " lights, " << linkCount << " link costs";
+    DebugLogger::log(oss.str());
+
+    return true;
+}
+
+void TrafficManager::markCheckpoint() const {
+    checkpointLaneVersions.resize(lanes.size());
+    for (size_t i = 0; i < lanes.size(); i++) {
+        checkpointLaneVersions[i] = lanes[i]->getVersion();
+    }
+    for (size_t i = 0; i < lanes.size(); i++) {
+        if (movedLanes[i]) {
+            for (auto* vehicle : lanes[i]->getVehicles()) {
+                vehicle->clearMotionChanged();
+            }
+            movedLanes[i] = 0;
+        }
+    }
+    checkpointLights.resize(trafficLights.size());
+    for (uint32_t j = 0; j < trafficLights.size(); j++) {
+        checkpointLights[j] = getLightCheckpoint(j);
+    }
+    checkpointLinkCosts.resize(network.getLinkCount());
+    for (uint32_t l = 0; l < network.getLinkCount(); l++) {
+        checkpointLinkCosts[l] = routing.getLinkCost(l);
+    }
+    checkpointTime = simulationTime;
+    transitAdded.clear();
+    transitRemoved.clear();
+    transitRewrite = false;
+}
+
+TrafficManager::LightCheckpoint TrafficManager::getLightCheckpoint(uint32_t junction) const {
+    LightCheckpoint checkpoint;
+    checkpoint.light = trafficLights[junction]->getSnapshot();
+    Lane* priorityLane = findLane(junction, 'A', 2);
+    checkpoint.lanePriority = priorityLane ? priorityLane->getPriority() : 0;
+    return checkpoint;
+}
+
+void TrafficManager::restoreLight(uint32_t junction, const LightCheckpoint& checkpoint) {
+    trafficLights[junction]->restore(checkpoint.light);
+    if (Lane* priorityLane = findLane(junction, 'A', 2)) {
+        priorityLane->setPriority(checkpoint.lanePriority);
+    }
+}
+
+void TrafficManager::restoreLinkCosts(const std::vector<std::pair<uint32_t, float>>& costs) {
+    std::vector<std::pair<uint32_t, float>> changes;
+    for (const auto& cost : costs) {
+        if (cost.first < network.getLinkCount() && routing.getLinkCost(cost.first) != cost.second) {
+            changes.push_back(cost);
+        }
+    }
+    if (!changes.empty()) {
+        routing.deferLinkCosts(changes);
     }
-    return nullptr;
+}
+
+void TrafficManager::updateRouteCosts() {
+    std::vector<std::pair<uint32_t, float>> changes;
+
+    for (uint32_t l = 0; l < network.getLinkCount(); l++) {
+        const RoadNetwork::Link& link = network.getLink(l);
+        const RoadNetwork::Junction& to = network.getJunction(link.toJunction);
+
+        // Queues of other partitions are not visible here
+        if (!ownsJunction(link.toJunction)) {
+            continue;
+        }
+
+        // Vehicles already queued on the road this link feeds into
+        int queued = 0;
+        for (int laneNumber = 1; laneNumber <= to.lanesPerApproach; laneNumber++) {
+            queued += lanes[network.laneIndex(link.toJunction, link.entryRoad, laneNumber)]->getVehicleCount();
+        }
+
+        float cost = link.length / Constants::LINK_SPEED + queued * Constants::QUEUE_DELAY_PER_VEHICLE;
+        float current = routing.getLinkCost(l);
+
+        // Ignore small changes so routes don't flap
+        if (std::fabs(cost - current) > 0.1f * current) {
+            changes.push_back({l, cost});
+        }
+    }
+
+    if (!changes.empty()) {
+        size_t recomputed = routing.updateLinkCosts(changes);
+
+        std::ostringstream oss;
+        oss << "Updated " << changes.size() << " link costs, recomputed routes to "
+            << recomputed << " destinations";
+        DebugLogger::log(oss.str(), DebugLogger::LogLevel::DEBUG);
+    }
+}
+
+Lane* TrafficManager::findLane(char laneId, int laneNumber) const {
+    return findLane(network.getEntryJunction(), laneId, laneNumber);
+}
+
+Lane* TrafficManager::findLane(uint32_t junction, char laneId, int laneNumber) const {
+    uint32_t index = network.laneIndex(junction, laneId, laneNumber);
+    return index != RoadNetwork::INVALID_INDEX ? lanes[index] : nullptr;
 }
 
 const std::vector<Lane*>& TrafficManager::getLanes() const {
     return lanes;
 }
 
+const std::vector<Lane*>& TrafficManager::getJunctionLanes(size_t junction) const {
+    return junctionLanes[junction];
+}
+
+Lane* TrafficManager::getLane(uint32_t index) const {
+    return index < lanes.size() ? lanes[index] : nullptr;
+}
+
 TrafficLight* TrafficManager::getTrafficLight() const {
-    return trafficLight;
+    return getTrafficLight(network.getEntryJunction());
+}
+
+TrafficLight* TrafficManager::getTrafficLight(size_t junction) const {
+    return junction < trafficLights.size() ? trafficLights[junction] : nullptr;
 }
 
 bool TrafficManager::isLanePrioritized(char laneId, int laneNumber) const {
@@ -376,7 +1817,7 @@ std::string TrafficManager::getStatistics() const {
     stats << "Total Vehicles: " << totalVehicles << "\n";
 
     // Add traffic light status
-    if (trafficLight) {
+    if (TrafficLight* trafficLight = getTrafficLight()) {
         stats << "Traffic Light: ";
         switch (trafficLight->getCurrentState()) {
             case TrafficLight::State::ALL_RED: stats << "ALL RED"; break;
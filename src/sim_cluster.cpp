@@ -0,0 +1,74 @@
+// FILE: src/sim_cluster.cpp
+// Runs a road network as several cooperating simulator processes that
+// exchange vehicles through shared memory. See PartitionCluster.
+#include "managers/PartitionCluster.h"
+#include <cstdlib>
+#include <iostream>
+#include <string>
+
+namespace {
+
+void printUsage() {
+    std::cout << "Usage: sim_cluster --network <file> [options]\n"
+              << "  --replay <trace>       Replay an arrival trace at the entry junction\n"
+              << "  --speed X              Trace replay speed (default 1)\n"
+              << "  --partitions N         Worker processes (default 2)\n"
+              << "  --steps N              Steps to run (default 1000)\n"
+              << "  --step-ms N            Simulated milliseconds per step (default 16)\n"
+              << "  --checkpoint-every N   Steps between checkpoints (default 100)\n"
+              << "  --base-every N         Checkpoints per full one; deltas in between (default 10)\n"
+              << "  --checkpoint-dir DIR   Where checkpoints are written (default .)\n"
+              << "  --ring-capacity N      Transfers buffered per partition pair (default 4096)\n"
+              << "  --report-every N       Steps between metric reports (default 100)\n"
+              << "  --crash P:S            Kill partition P at step S to exercise recovery\n";
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    PartitionCluster::Options options;
+
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        bool hasValue = i + 1 < argc;
+
+        if (arg == "--network" && hasValue) {
+            options.networkPath = argv[++i];
+        } else if (arg == "--replay" && hasValue) {
+            options.tracePath = argv[++i];
+        } else if (arg == "--speed" && hasValue) {
+            options.replaySpeed = std::atof(argv[++i]);
+        } else if (arg == "--partitions" && hasValue) {
+            options.partitions = static_cast<uint32_t>(std::atoi(argv[++i]));
+        } else if (arg == "--steps" && hasValue) {
+            options.steps = static_cast<uint32_t>(std::atoi(argv[++i]));
+        } else if (arg == "--step-ms" && hasValue) {
+            options.stepMs = static_cast<uint32_t>(std::atoi(argv[++i]));
+        } else if (arg == "--checkpoint-every" && hasValue) {
+            options.checkpointInterval = static_cast<uint32_t>(std::atoi(argv[++i]));
+        } else if (arg == "--base-every" && hasValue) {
+            options.baseInterval = static_cast<uint32_t>(std::atoi(argv[++i]));
+        } else if (arg == "--checkpoint-dir" && hasValue) {
+            options.checkpointDir = argv[++i];
+        } else if (arg == "--ring-capacity" && hasValue) {
+            options.ringCapacity = static_cast<uint32_t>(std::atoi(argv[++i]));
+        } else if (arg == "--report-every" && hasValue) {
+            options.reportInterval = static_cast<uint32_t>(std::atoi(argv[++i]));
+        } else if (arg == "--crash" && hasValue) {
+            std::string value = argv[++i];
+            size_t colon = value.find(':');
+            if (colon == std::string::npos) {
+                printUsage();
+                return 1;
+            }
+            options.crashPartition = std::atoi(value.substr(0, colon).c_str());
+            options.crashStep = static_cast<uint32_t>(std::atoi(value.substr(colon + 1).c_str()));
+        } else {
+            printUsage();
+            return arg == "--help" ? 0 : 1;
+        }
+    }
+
+    PartitionCluster cluster(options);
+    return cluster.run();
+}
@@ -0,0 +1,111 @@
+// FILE: src/sim_status.cpp
+// Reads the live status a simulator publishes in shared memory
+// (console_simulator --status-shm) and prints headline figures, lights and
+// phase timers, and the lanes that have vehicles, as lane_status.txt did.
+// Reading takes no locks and no system calls; see LiveStatus.
+//
+//   sim_status [--name <region>] [--watch SECONDS]
+#include "managers/LiveStatus.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <signal.h>
+
+namespace {
+
+const char* const LIGHT_NAMES[] = {"ALL_RED", "A_GREEN", "B_GREEN", "C_GREEN", "D_GREEN"};
+
+// Junction lines are listed for small networks, otherwise only busy ones
+const uint32_t LIST_ALL_JUNCTIONS = 16;
+
+volatile sig_atomic_t stopRequested = 0;
+
+void onStop(int) {
+    stopRequested = 1;
+}
+
+const char* lightName(uint8_t state) {
+    return state < sizeof(LIGHT_NAMES) / sizeof(LIGHT_NAMES[0]) ? LIGHT_NAMES[state] : "?";
+}
+
+void print(const LiveStatus::Snapshot& snapshot, uint64_t retries) {
+    const LiveStatus::Metrics& m = snapshot.metrics;
+    uint64_t now = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count());
+    double ageMs = now > m.publishedNanos ? static_cast<double>(now - m.publishedNanos) / 1e6 : 0.0;
+
+    std::printf("t=%.1fs  tick %llu  age %.3f ms  (%llu retries)\n", static_cast<double>(m.simulationTimeMs) / 1000.0,
+                static_cast<unsigned long long>(m.tick), ageMs, static_cast<unsigned long long>(retries));
+    std::printf("vehicles %u (queued %u)  exited %llu  delay p50 %.1fs p90 %.1fs p99 %.1fs max %.1fs  "
+                "fuel %.1f L  CO2 %.1f kg\n",
+                m.vehicles, m.queued, static_cast<unsigned long long>(m.exited), m.delayP50Ms / 1000.0,
+                m.delayP90Ms / 1000.0, m.delayP99Ms / 1000.0, m.delayMaxMs / 1000.0, m.fuelLitres, m.co2Kg);
+
+    bool listAll = snapshot.junctions.size() <= LIST_ALL_JUNCTIONS;
+    for (size_t j = 0; j < snapshot.junctions.size(); j++) {
+        const LiveStatus::JunctionStatus& junction = snapshot.junctions[j];
+        if (!junction.owned || (!listAll && junction.vehicles == 0)) {
+            continue;
+        }
+        std::printf("J%-4zu %-7s -> %-7s  phase %5.1fs  change in >= %4.1fs  %4u vehicles%s\n", j,
+                    lightName(junction.light), lightName(junction.nextLight), junction.phaseElapsedMs / 1000.0,
+                    junction.earliestChangeMs / 1000.0, junction.vehicles,
+                    junction.priorityMode ? "  [priority mode]" : "");
+        for (const LiveStatus::LaneStatus& lane : snapshot.lanes) {
+            if (lane.junction != j || lane.vehicles == 0) {
+                continue;
+            }
+            std::printf("      %c%u  %4u vehicles  priority %d%s\n", lane.road, lane.laneNumber, lane.vehicles,
+                        lane.priority, (lane.flags & LiveStatus::LANE_PRIORITIZED) ? "  PRIORITIZED" : "");
+        }
+    }
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    std::string name = "/traffic_status";
+    double watchSeconds = 0.0;
+
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        bool hasValue = i + 1 < argc;
+
+        if (arg == "--name" && hasValue) {
+            name = argv[++i];
+        } else if (arg == "--watch" && hasValue) {
+            watchSeconds = std::max(0.01, std::atof(argv[++i]));
+        } else {
+            std::cout << "Usage: sim_status [--name <region>] [--watch SECONDS]" << std::endl;
+            return arg == "--help" ? 0 : 1;
+        }
+    }
+
+    LiveStatus status;
+    if (!status.open(name)) {
+        std::cerr << status.getLastError() << std::endl;
+        return 1;
+    }
+
+    signal(SIGINT, onStop);
+    signal(SIGTERM, onStop);
+
+    LiveStatus::Snapshot snapshot;
+    do {
+        if (!status.read(snapshot)) {
+            std::cerr << "The writer kept " << name << " busy; it may have died while updating it" << std::endl;
+            return 1;
+        }
+        print(snapshot, status.getRetries());
+        if (watchSeconds > 0.0) {
+            std::printf("\n");
+            std::fflush(stdout);
+            std::this_thread::sleep_for(std::chrono::duration<double>(watchSeconds));
+        }
+    } while (watchSeconds > 0.0 && !stopRequested);
+    return 0;
+}
@@ -0,0 +1,390 @@
+// FILE: src/simserver.cpp
+// Resident simulation server: runs scenario jobs sent over a Unix domain
+// socket on a pool of pre-loaded simulators. With --submit it acts as a
+// client that sends a seed sweep and prints the results, optionally
+// replicating only until the estimate has converged. See SimServer.
+#include "managers/SimServer.h"
+#include "utils/RunningStats.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <iterator>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <sys/socket.h>
+#include <unistd.h>
+
+namespace {
+
+// Per-job figure an adaptive sweep estimates
+struct Metric {
+    const char* name;
+    double (*extract)(const SimServer::ResultRecord&);
+    bool higherIsBetter;
+
+    bool better(double a, double b) const { return higherIsBetter ? a > b : a < b; }
+};
+
+const Metric METRICS[] = {
+    {"al2-queued", [](const SimServer::ResultRecord& r) { return double(r.meanPriorityQueued); }, false},
+    {"mean-queued", [](const SimServer::ResultRecord& r) { return double(r.meanQueued); }, false},
+    {"max-queued", [](const SimServer::ResultRecord& r) { return double(r.maxQueued); }, false},
+    {"exited", [](const SimServer::ResultRecord& r) { return double(r.exited); }, true},
+};
+
+struct SweepOptions {
+    Metric metric = METRICS[0];
+    double halfWidth = 0.0;          // Target; 0 runs a fixed --submit count
+    bool relative = false;           // halfWidth is a fraction of the mean
+    double confidence = 0.95;
+    uint32_t minReplications = 5;
+    uint32_t maxReplications = 0;    // The --submit count
+    uint32_t window = 8;             // Jobs in flight per configuration
+    bool screen = false;
+    uint32_t firstSeed = 1;
+};
+
+// One arrival rate being replicated
+struct Config {
+    enum State { RUNNING, CONVERGED, DROPPED, FAILED };
+
+    float rate = 0.0f;
+    RunningStats stats;
+    State state = RUNNING;
+    uint32_t submitted = 0;
+    uint32_t inFlight = 0;
+    float droppedFor = 0.0f;         // Rate that beat it (DROPPED)
+};
+
+bool sendJob(int fd, const SimServer::JobRecord& job) {
+    return send(fd, &job, sizeof(job), MSG_NOSIGNAL) == static_cast<ssize_t>(sizeof(job));
+}
+
+bool receiveResult(int fd, SimServer::ResultRecord& result) {
+    return recv(fd, &result, sizeof(result), MSG_WAITALL) == static_cast<ssize_t>(sizeof(result));
+}
+
+void printUsage() {
+    std::cout << "Usage: simserver [options]\n"
+              << "  --socket PATH          Unix socket to listen on (default simserver.sock)\n"
+              << "  --workers N            Worker threads (default: hardware threads)\n"
+              << "  --warm FILE            Pre-load a network file on every worker (repeatable)\n"
+              << "  --log                  Write simserver.log (off by default)\n"
+              << "  --cache DIR            Reuse results of identical jobs from DIR\n"
+              << "  --cache-mb N           Result cache size bound (default 256)\n"
+              << "\n"
+              << "Client mode: simserver --submit N [options]\n"
+              << "  --seed S               First seed; job i uses S + i (default 1)\n"
+              << "  --duration MS          Simulated time per job (default 600000)\n"
+              << "  --step-ms N            Simulated milliseconds per step (default 100)\n"
+              << "  --rate R               Arrivals per minute (default 30)\n"
+              << "  --network FILE         Network file (default: standard junction)\n"
+              << "  --fixed-point          Fixed-point kinematics\n"
+              << "\n"
+              << "Adaptive sweep: with a target, --submit N is the most replications per rate\n"
+              << "  --half-width H         Stop a rate once its confidence interval is +/- H\n"
+              << "  --rel-half-width F     ... or +/- F times its mean\n"
+              << "  --metric NAME          al2-queued (default), mean-queued, max-queued, exited\n"
+              << "  --confidence C         Confidence level (default 0.95)\n"
+              << "  --min-reps N           Replications before any stop (default 5)\n"
+              << "  --rates R1,R2,...      Arrival rates to compare (default --rate)\n"
+              << "  --screen               Drop rates clearly worse than the best\n"
+              << "  --window N             Jobs in flight per rate (default 8)\n";
+}
+
+// Send jobs seed..seed+count-1 and print one line per result
+int submit(const std::string& socketPath, uint32_t count, SimServer::JobRecord job) {
+    int fd = SimServer::connectTo(socketPath);
+    if (fd < 0) {
+        std::cerr << "Cannot connect to " << socketPath << ": " << std::strerror(errno) << std::endl;
+        return 1;
+    }
+
+    auto start = std::chrono::steady_clock::now();
+
+    uint32_t firstSeed = job.seed;
+    for (uint32_t i = 0; i < count; i++) {
+        job.jobId = i;
+        job.seed = firstSeed + i;
+        if (!sendJob(fd, job)) {
+            std::cerr << "Failed to send job " << i << std::endl;
+            close(fd);
+            return 1;
+        }
+    }
+
+    uint64_t workerMicros = 0;
+    int failed = 0;
+    for (uint32_t i = 0; i < count; i++) {
+        SimServer::ResultRecord result;
+        if (!receiveResult(fd, result)) {
+            std::cerr << "Connection closed after " << i << " results" << std::endl;
+            close(fd);
+            return 1;
+        }
+
+        if (result.status != SimServer::STATUS_OK) {
+            std::cout << "job " << result.jobId << " failed with status " << result.status << std::endl;
+            failed++;
+            continue;
+        }
+
+        workerMicros += result.wallMicros;
+        std::cout << "job " << result.jobId << " seed " << firstSeed + result.jobId
+                  << ": arrivals " << result.arrivals << ", exited " << result.exited
+                  << ", remaining " << result.remaining << ", max queued " << result.maxQueued
+                  << ", mean queued " << std::fixed << std::setprecision(2) << result.meanQueued
+                  << ", AL2 queued " << result.meanPriorityQueued
+                  << ", fuel " << result.fuelLitres << " L, CO2 " << result.co2Kg << " kg"
+                  << ", " << result.wallMicros / 1000.0 << " ms"
+                  << (result.flags & SimServer::RESULT_CACHED ? " (cached)" : "") << std::endl;
+    }
+    close(fd);
+
+    double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    std::cout << count << " jobs in " << std::setprecision(3) << elapsed << " s ("
+              << count / elapsed << " jobs/s, " << workerMicros / 1000.0 / count
+              << " ms worker time per job)" << std::endl;
+    return failed > 0 ? 1 : 0;
+}
+
+// Replicate each arrival rate with seeds seed, seed+1, ... (common random
+// numbers across rates) until its confidence interval is narrow enough, it
+// is clearly worse than the best rate, or it reaches maxReplications
+int submitAdaptive(const std::string& socketPath, const SweepOptions& sweep,
+                   const std::vector<float>& rates, SimServer::JobRecord job) {
+    const Metric& metric = sweep.metric;
+
+    int fd = SimServer::connectTo(socketPath);
+    if (fd < 0) {
+        std::cerr << "Cannot connect to " << socketPath << ": " << std::strerror(errno) << std::endl;
+        return 1;
+    }
+
+    auto start = std::chrono::steady_clock::now();
+
+    std::vector<Config> configs(rates.size());
+    for (size_t i = 0; i < rates.size(); i++) {
+        configs[i].rate = rates[i];
+    }
+
+    // Configuration of each job sent, by jobId
+    std::vector<size_t> owner;
+    uint64_t workerMicros = 0;
+    uint32_t outstanding = 0;
+    int failed = 0;
+
+    auto halfWidth = [&](const Config& config) { return config.stats.getHalfWidth(sweep.confidence); };
+    auto target = [&](const Config& config) {
+        return sweep.relative ? sweep.halfWidth * std::fabs(config.stats.getMean()) : sweep.halfWidth;
+    };
+
+    while (true) {
+        // Keep a window of jobs in flight for every configuration still running
+        for (size_t i = 0; i < configs.size(); i++) {
+            Config& config = configs[i];
+            while (config.state == Config::RUNNING && config.inFlight < sweep.window &&
+                   config.submitted < sweep.maxReplications) {
+                job.jobId = static_cast<uint32_t>(owner.size());
+                job.seed = sweep.firstSeed + config.submitted;
+                job.ratePerMinute = config.rate;
+                if (!sendJob(fd, job)) {
+                    std::cerr << "Failed to send job " << job.jobId << std::endl;
+                    close(fd);
+                    return 1;
+                }
+                owner.push_back(i);
+                config.submitted++;
+                config.inFlight++;
+                outstanding++;
+            }
+        }
+        if (outstanding == 0) {
+            break;
+        }
+
+        SimServer::ResultRecord result;
+        if (!receiveResult(fd, result) || result.jobId >= owner.size()) {
+            std::cerr << "Connection closed with " << outstanding << " jobs outstanding" << std::endl;
+            close(fd);
+            return 1;
+        }
+        outstanding--;
+
+        Config& config = configs[owner[result.jobId]];
+        config.inFlight--;
+        if (result.status != SimServer::STATUS_OK) {
+            std::cout << "job " << result.jobId << " failed with status " << result.status << std::endl;
+            config.state = Config::FAILED;
+            failed++;
+            continue;
+        }
+        workerMicros += result.wallMicros;
+
+        // Results still in flight when a configuration stops are kept: they
+        // are independent replications and only narrow the interval
+        config.stats.add(metric.extract(result));
+        if (config.state == Config::RUNNING && config.stats.getCount() >= sweep.minReplications &&
+            halfWidth(config) <= target(config)) {
+            config.state = Config::CONVERGED;
+        }
+
+        // Screening: drop configurations whose interval lies entirely on the
+        // wrong side of the best one's
+        if (!sweep.screen) {
+            continue;
+        }
+        const Config* best = nullptr;
+        for (const Config& other : configs) {
+            if (other.state == Config::FAILED || other.stats.getCount() < sweep.minReplications) continue;
+            if (!best || metric.better(other.stats.getMean(), best->stats.getMean())) {
+                best = &other;
+            }
+        }
+        for (Config& other : configs) {
+            if (!best || &other == best || other.state != Config::RUNNING ||
+                other.stats.getCount() < sweep.minReplications) {
+                continue;
+            }
+            double gap = std::fabs(other.stats.getMean() - best->stats.getMean());
+            if (gap > halfWidth(other) + halfWidth(*best)) {
+                other.state = Config::DROPPED;
+                other.droppedFor = best->rate;
+            }
+        }
+    }
+    close(fd);
+
+    uint64_t totalJobs = owner.size();
+    std::cout << std::fixed;
+    for (const Config& config : configs) {
+        std::cout << "rate " << std::setprecision(2) << config.rate << ": " << config.stats.getCount()
+                  << " replications, " << metric.name << " " << std::setprecision(4) << config.stats.getMean()
+                  << " +/- " << halfWidth(config) << " (" << std::setprecision(0) << sweep.confidence * 100
+                  << "%), ";
+        switch (config.state) {
+            case Config::CONVERGED: std::cout << "converged"; break;
+            case Config::DROPPED:
+                std::cout << "dropped, worse than rate " << std::setprecision(2) << config.droppedFor;
+                break;
+            case Config::FAILED: std::cout << "failed"; break;
+            default: std::cout << "not converged after " << sweep.maxReplications << " replications"; break;
+        }
+        std::cout << std::endl;
+    }
+
+    double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    uint64_t budget = static_cast<uint64_t>(sweep.maxReplications) * configs.size();
+    std::cout << totalJobs << " of " << budget << " jobs in " << std::setprecision(3) << elapsed << " s ("
+              << (totalJobs > 0 ? workerMicros / 1000.0 / totalJobs : 0.0) << " ms worker time per job)"
+              << std::endl;
+    return failed > 0 ? 1 : 0;
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    SimServer::Options options;
+    SweepOptions sweep;
+    std::vector<float> rates;
+    uint32_t submitCount = 0;
+
+    SimServer::JobRecord job = {};
+    job.magic = SimServer::JOB_MAGIC;
+    job.seed = 1;
+    job.durationMs = 600000;
+    job.stepMs = 100;
+    job.ratePerMinute = 30.0f;
+
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        bool hasValue = i + 1 < argc;
+
+        if (arg == "--socket" && hasValue) {
+            options.socketPath = argv[++i];
+        } else if (arg == "--workers" && hasValue) {
+            options.workers = static_cast<unsigned>(std::atoi(argv[++i]));
+        } else if (arg == "--warm" && hasValue) {
+            options.warmNetworks.push_back(argv[++i]);
+        } else if (arg == "--log") {
+            options.logging = true;
+        } else if (arg == "--cache" && hasValue) {
+            options.cacheDir = argv[++i];
+        } else if (arg == "--cache-mb" && hasValue) {
+            options.cacheBytes = std::strtoull(argv[++i], nullptr, 10) << 20;
+        } else if (arg == "--submit" && hasValue) {
+            submitCount = static_cast<uint32_t>(std::atoi(argv[++i]));
+        } else if (arg == "--seed" && hasValue) {
+            job.seed = static_cast<uint32_t>(std::strtoul(argv[++i], nullptr, 10));
+        } else if (arg == "--duration" && hasValue) {
+            job.durationMs = static_cast<uint32_t>(std::strtoul(argv[++i], nullptr, 10));
+        } else if (arg == "--step-ms" && hasValue) {
+            job.stepMs = static_cast<uint32_t>(std::atoi(argv[++i]));
+        } else if (arg == "--rate" && hasValue) {
+            job.ratePerMinute = static_cast<float>(std::atof(argv[++i]));
+        } else if (arg == "--network" && hasValue) {
+            std::string path = argv[++i];
+            if (path.size() >= SimServer::MAX_NETWORK_PATH) {
+                std::cerr << "Network path too long: " << path << std::endl;
+                return 1;
+            }
+            std::memcpy(job.networkPath, path.c_str(), path.size() + 1);
+        } else if (arg == "--fixed-point") {
+            job.flags |= SimServer::FLAG_FIXED_POINT;
+        } else if ((arg == "--half-width" || arg == "--rel-half-width") && hasValue) {
+            sweep.halfWidth = std::atof(argv[++i]);
+            sweep.relative = arg == "--rel-half-width";
+        } else if (arg == "--metric" && hasValue) {
+            std::string name = argv[++i];
+            auto it = std::find_if(std::begin(METRICS), std::end(METRICS),
+                                   [&](const Metric& m) { return name == m.name; });
+            if (it == std::end(METRICS)) {
+                std::cerr << "Unknown metric: " << name << std::endl;
+                return 1;
+            }
+            sweep.metric = *it;
+        } else if (arg == "--confidence" && hasValue) {
+            sweep.confidence = std::atof(argv[++i]);
+        } else if (arg == "--min-reps" && hasValue) {
+            sweep.minReplications = static_cast<uint32_t>(std::atoi(argv[++i]));
+        } else if (arg == "--rates" && hasValue) {
+            std::stringstream list(argv[++i]);
+            std::string item;
+            while (std::getline(list, item, ',')) {
+                rates.push_back(static_cast<float>(std::atof(item.c_str())));
+            }
+        } else if (arg == "--screen") {
+            sweep.screen = true;
+        } else if (arg == "--window" && hasValue) {
+            sweep.window = std::max(1, std::atoi(argv[++i]));
+        } else {
+            printUsage();
+            return arg == "--help" ? 0 : 1;
+        }
+    }
+
+    if (submitCount > 0 && sweep.halfWidth > 0.0) {
+        if (sweep.confidence <= 0.0 || sweep.confidence >= 1.0) {
+            std::cerr << "Confidence must be between 0 and 1" << std::endl;
+            return 1;
+        }
+        if (rates.empty()) {
+            rates.push_back(job.ratePerMinute);
+        }
+        sweep.maxReplications = submitCount;
+        sweep.minReplications = std::max(2u, std::min(sweep.minReplications, submitCount));
+        sweep.firstSeed = job.seed;
+        return submitAdaptive(options.socketPath, sweep, rates, job);
+    }
+    if (submitCount > 0) {
+        return submit(options.socketPath, submitCount, job);
+    }
+
+    SimServer server(options);
+    return server.run();
+}
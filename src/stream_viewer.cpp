@@ -0,0 +1,151 @@
+// FILE: src/stream_viewer.cpp
+// Subscriber for a simulator's live state stream (console_simulator
+// --stream): decodes the frames and prints a line a second with the frame
+// and keyframe rates, vehicle count and bandwidth. --record saves the raw
+// stream for later decoding; --slow sleeps between reads to see how a
+// viewer that can't keep up is dropped to keyframes. See StateStream.
+//
+//   stream_viewer <address> [--seconds S] [--slow MS] [--record <file>]
+#include "managers/StateStream.h"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <signal.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+namespace {
+
+volatile sig_atomic_t stopRequested = 0;
+
+void onStop(int) {
+    stopRequested = 1;
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    std::string address;
+    double seconds = 0.0;
+    int slowMs = 0;
+    std::string recordPath;
+
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        bool hasValue = i + 1 < argc;
+
+        if (arg == "--seconds" && hasValue) {
+            seconds = std::atof(argv[++i]);
+        } else if (arg == "--slow" && hasValue) {
+            slowMs = std::max(0, std::atoi(argv[++i]));
+        } else if (arg == "--record" && hasValue) {
+            recordPath = argv[++i];
+        } else if (address.empty() && arg.compare(0, 2, "--") != 0) {
+            address = arg;
+        } else {
+            address.clear();
+            break;
+        }
+    }
+    if (address.empty()) {
+        std::cout << "Usage: stream_viewer <socket path | tcp:PORT> [--seconds S] [--slow MS] [--record <file>]"
+                  << std::endl;
+        return 1;
+    }
+
+    int fd = StateStream::connectTo(address);
+    if (fd < 0) {
+        std::cerr << "Cannot connect to " << address << ": " << std::strerror(errno) << std::endl;
+        return 1;
+    }
+
+    FILE* record = nullptr;
+    if (!recordPath.empty()) {
+        record = std::fopen(recordPath.c_str(), "wb");
+        if (!record) {
+            std::cerr << "Cannot write " << recordPath << std::endl;
+            close(fd);
+            return 1;
+        }
+    }
+
+    signal(SIGINT, onStop);
+    signal(SIGTERM, onStop);
+
+    // A small receive buffer makes a slow viewer fall behind sooner
+    if (slowMs > 0) {
+        int size = 16 * 1024;
+        setsockopt(fd, SOL_SOCKET, SO_RCVBUF, &size, sizeof(size));
+    }
+
+    using Clock = std::chrono::steady_clock;
+    StateStreamDecoder decoder;
+    auto start = Clock::now();
+    auto lineStart = start;
+    uint64_t lineBytes = 0;
+    uint64_t lineFrames = 0;
+    uint64_t lineKeyframes = 0;
+    uint64_t totalBytes = 0;
+    int status = 0;
+    char buffer[64 * 1024];
+
+    while (!stopRequested) {
+        ssize_t n = recv(fd, buffer, sizeof(buffer), 0);
+        if (n < 0 && errno == EINTR) continue;
+        if (n <= 0) {
+            std::cout << "Stream closed" << std::endl;
+            break;
+        }
+        if (record) {
+            std::fwrite(buffer, 1, static_cast<size_t>(n), record);
+        }
+        if (!decoder.feed(buffer, static_cast<size_t>(n))) {
+            std::cerr << "Bad stream: " << decoder.getLastError() << std::endl;
+            status = 1;
+            break;
+        }
+        lineBytes += static_cast<uint64_t>(n);
+        totalBytes += static_cast<uint64_t>(n);
+
+        auto now = Clock::now();
+        double lineSeconds = std::chrono::duration<double>(now - lineStart).count();
+        if (lineSeconds >= 1.0) {
+            uint64_t frames = decoder.getFrameCount() - lineFrames;
+            uint64_t keyframes = decoder.getKeyframeCount() - lineKeyframes;
+            std::printf("t=%7.1fs  seq %-8llu %6zu vehicles  %5.1f frames/s (%llu keyframes)  %8.1f KB/s  "
+                        "%llu skipped\n",
+                        static_cast<double>(decoder.getSimulationTime()) / 1000.0,
+                        static_cast<unsigned long long>(decoder.getSequence()), decoder.getVehicles().size(),
+                        static_cast<double>(frames) / lineSeconds, static_cast<unsigned long long>(keyframes),
+                        static_cast<double>(lineBytes) / 1024.0 / lineSeconds,
+                        static_cast<unsigned long long>(decoder.getSkippedFrames()));
+            std::fflush(stdout);
+            lineStart = now;
+            lineBytes = 0;
+            lineFrames = decoder.getFrameCount();
+            lineKeyframes = decoder.getKeyframeCount();
+        }
+
+        if (seconds > 0.0 && std::chrono::duration<double>(now - start).count() >= seconds) {
+            break;
+        }
+        if (slowMs > 0) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(slowMs));
+        }
+    }
+
+    std::printf("%llu frames (%llu keyframes, %llu skipped), %.1f KB\n",
+                static_cast<unsigned long long>(decoder.getFrameCount()),
+                static_cast<unsigned long long>(decoder.getKeyframeCount()),
+                static_cast<unsigned long long>(decoder.getSkippedFrames()),
+                static_cast<double>(totalBytes) / 1024.0);
+    if (record) {
+        std::fclose(record);
+    }
+    close(fd);
+    return status;
+}
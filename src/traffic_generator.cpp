@@ -13,6 +13,12 @@
 #include <atomic>
 #include <csignal>
 #include <map>
+#include <cmath>
+#include <cstring>
+#include <cstdlib>
+#include <algorithm>
+
+#include "utils/ArrivalTrace.h"
 
 // Include Windows-specific headers if on Windows
 #ifdef _WIN32
@@ -274,7 +280,128 @@ void display_lane_stats() {
     std::cout << "└────────────────────────────────────┘\033[0m\n";
 }
 
-int main() {
+// Relative arrival intensity for each hour of the day (morning and evening peaks)
+const double HOURLY_PROFILE[24] = {
+    0.2, 0.15, 0.1, 0.1, 0.2, 0.4, 0.8, 1.4, 1.6, 1.2, 1.0, 1.0,
+    1.1, 1.0, 1.0, 1.1, 1.3, 1.6, 1.5, 1.1, 0.8, 0.6, 0.4, 0.3
+};
+
+// Generate a whole arrival workload in one pass and write it as a binary trace.
+// Arrivals follow a Poisson process whose rate follows HOURLY_PROFILE, with the same
+// lane and direction mix as the live generator.
+int generate_trace(const std::string& path, int hours, uint32_t seed, double ratePerMinute) {
+    auto start = std::chrono::steady_clock::now();
+
+    std::mt19937 gen(seed);
+    std::uniform_int_distribution<int> roadDist(0, 3);
+    std::discrete_distribution<int> laneDist({0.0, 0.6, 0.4});   // Lanes 1, 2, 3
+    std::bernoulli_distribution straightDist(0.6);                 // L2: 60% straight
+    std::bernoulli_distribution priorityBias(0.1);                 // Bias toward A2
+    std::bernoulli_distribution emergencyDist(0.002);
+
+    const uint32_t durationMs = static_cast<uint32_t>(hours) * ArrivalTrace::MS_PER_HOUR;
+
+    std::vector<ArrivalTrace::Record> records;
+    records.reserve(static_cast<size_t>(ratePerMinute * 60.0 * hours * 1.2));
+
+    // Step through the day hour by hour; each hour is a homogeneous Poisson process
+    double timeMs = 0.0;
+    uint32_t vehicleId = 1;
+    for (int h = 0; h < hours; h++) {
+        double hourEnd = static_cast<double>(h + 1) * ArrivalTrace::MS_PER_HOUR;
+        double rate = ratePerMinute * HOURLY_PROFILE[h % 24] / 60000.0; // Arrivals per ms
+        if (rate <= 0.0) {
+            timeMs = hourEnd;
+            continue;
+        }
+
+        std::exponential_distribution<double> gapDist(rate);
+        while (true) {
+            double next = timeMs + gapDist(gen);
+            if (next >= hourEnd) {
+                timeMs = hourEnd;
+                break;
+            }
+            timeMs = next;
+
+            ArrivalTrace::Record record;
+            record.timeMs = static_cast<uint32_t>(timeMs);
+            record.vehicleId = vehicleId++;
+            record.road = static_cast<uint8_t>('A' + roadDist(gen));
+            record.laneNumber = static_cast<uint8_t>(laneDist(gen) + 1);
+            record.flags = emergencyDist(gen) ? ArrivalTrace::FLAG_EMERGENCY : 0;
+
+            if (priorityBias(gen)) {
+                record.road = 'A';
+                record.laneNumber = 2;
+            }
+
+            // Destination values match the simulator's Destination enum (STRAIGHT=0, LEFT=1)
+            if (record.laneNumber == 3) {
+                record.destination = 1;
+            } else {
+                record.destination = straightDist(gen) ? 0 : 1;
+            }
+
+            records.push_back(record);
+        }
+    }
+
+    ArrivalTrace trace;
+    if (!trace.write(path, records, durationMs)) {
+        console_log("ERROR: " + trace.getLastError(), "\033[1;31m");
+        return 1;
+    }
+
+    auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::steady_clock::now() - start).count();
+
+    console_log("✅ Wrote " + std::to_string(records.size()) + " arrivals (" +
+                std::to_string(hours) + "h) to " + path + " in " +
+                std::to_string(elapsed) + " ms", "\033[1;35m");
+    return 0;
+}
+
+void print_usage() {
+    std::cout << "Usage: traffic_generator [--trace <file> [--hours N] [--seed S] [--rate R]]\n"
+              << "  (no options)     Continuously append vehicles to the lane files\n"
+              << "  --trace <file>   Write a binary arrival trace for offline replay and exit\n"
+              << "  --hours N        Trace length in hours (default 24, at most "
+              << ArrivalTrace::MAX_HOURS << ")\n"
+              << "  --seed S         Random seed (default 1)\n"
+              << "  --rate R         Mean arrivals per minute at profile 1.0 (default 30)\n";
+}
+
+int main(int argc, char* argv[]) {
+    // Offline trace mode
+    std::string tracePath;
+    int traceHours = 24;
+    uint32_t traceSeed = 1;
+    double traceRate = 30.0;
+
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        bool hasValue = i + 1 < argc;
+
+        if (arg == "--trace" && hasValue) {
+            tracePath = argv[++i];
+        } else if (arg == "--hours" && hasValue) {
+            traceHours = std::max(1, std::min(std::atoi(argv[++i]), static_cast<int>(ArrivalTrace::MAX_HOURS)));
+        } else if (arg == "--seed" && hasValue) {
+            traceSeed = static_cast<uint32_t>(std::strtoul(argv[++i], nullptr, 10));
+        } else if (arg == "--rate" && hasValue) {
+            traceRate = std::max(0.0, std::atof(argv[++i]));
+        } else {
+            print_usage();
+            return arg == "--help" ? 0 : 1;
+        }
+    }
+
+    if (!tracePath.empty()) {
+        setupConsole();
+        return generate_trace(tracePath, traceHours, traceSeed, traceRate);
+    }
+
     try {
         // Set up signal handler for clean termination
         std::signal(SIGINT, signalHandler);
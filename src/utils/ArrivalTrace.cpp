@@ -0,0 +1,206 @@
+// FILE: src/utils/ArrivalTrace.cpp
+#include "utils/ArrivalTrace.h"
+#include "utils/AsyncFileIO.h"
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+
+#ifdef _WIN32
+#define ARRIVAL_TRACE_NO_MMAP
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+ArrivalTrace::ArrivalTrace()
+    : mapped(false),
+      recordData(nullptr),
+      hourIndex(nullptr),
+      recordCount(0),
+      durationMs(0),
+      hourCount(0),
+      mapBase(nullptr),
+      mapLength(0) {}
+
+ArrivalTrace::~ArrivalTrace() {
+    close();
+}
+
+bool ArrivalTrace::write(const std::string& path, const std::vector<Record>& records, uint32_t duration) {
+    // Records must already be in time order so replay can stream them
+    for (size_t i = 1; i < records.size(); i++) {
+        if (records[i].timeMs < records[i - 1].timeMs) {
+            lastError = "Records are not sorted by time";
+            return false;
+        }
+    }
+
+    uint32_t hours = static_cast<uint32_t>(
+        std::max<uint64_t>(1, (static_cast<uint64_t>(duration) + MS_PER_HOUR - 1) / MS_PER_HOUR));
+
+    // Build the per-hour seek index (first record at or after each hour boundary)
+    std::vector<uint64_t> index(hours + 1);
+    size_t cursor = 0;
+    for (uint32_t h = 0; h <= hours; h++) {
+        uint64_t boundary = static_cast<uint64_t>(h) * MS_PER_HOUR;
+        while (cursor < records.size() && records[cursor].timeMs < boundary) {
+            cursor++;
+        }
+        index[h] = cursor;
+    }
+
+    Header header;
+    std::memcpy(header.magic, "TJTR", 4);
+    header.version = FORMAT_VERSION;
+    header.recordCount = records.size();
+    header.durationMs = duration;
+    header.hourCount = hours;
+    header.indexOffset = sizeof(Header) + records.size() * sizeof(Record);
+
+    // Header, records and index go out as one batch
+    AsyncFileIO io;
+    int file = io.openForWrite(path, true);
+    if (file < 0) {
+        lastError = "Could not open " + path + " for writing";
+        return false;
+    }
+
+    io.append(file, &header, sizeof(header));
+    if (!records.empty()) {
+        io.append(file, records.data(), records.size() * sizeof(Record));
+    }
+    io.append(file, index.data(), index.size() * sizeof(uint64_t));
+
+    if (!io.flush()) {
+        lastError = "Write failed for " + path + ": " + io.getLastError();
+        return false;
+    }
+
+    return true;
+}
+
+bool ArrivalTrace::open(const std::string& path) {
+    close();
+
+    const char* base = nullptr;
+    size_t length = 0;
+
+#ifdef ARRIVAL_TRACE_NO_MMAP
+    // Fallback: read the whole file in one go
+    std::ifstream file(path, std::ios::binary | std::ios::ate);
+    if (!file.is_open()) {
+        lastError = "Could not open " + path;
+        return false;
+    }
+    length = static_cast<size_t>(file.tellg());
+    fallbackBuffer.resize(length);
+    file.seekg(0);
+    file.read(fallbackBuffer.data(), length);
+    base = fallbackBuffer.data();
+#else
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        lastError = "Could not open " + path;
+        return false;
+    }
+
+    struct stat st;
+    if (fstat(fd, &st) != 0 || st.st_size < static_cast<off_t>(sizeof(Header))) {
+        ::close(fd);
+        lastError = "Trace file too small: " + path;
+        return false;
+    }
+    length = static_cast<size_t>(st.st_size);
+
+    void* addr = mmap(nullptr, length, PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);
+    if (addr == MAP_FAILED) {
+        lastError = "mmap failed for " + path;
+        return false;
+    }
+
+    // Replay reads front to back
+    madvise(addr, length, MADV_SEQUENTIAL);
+
+    mapBase = addr;
+    mapLength = length;
+    base = static_cast<const char*>(addr);
+#endif
+
+    // Validate header
+    Header header;
+    if (length < sizeof(Header)) {
+        lastError = "Trace file too small: " + path;
+        close();
+        return false;
+    }
+    std::memcpy(&header, base, sizeof(Header));
+
+    if (std::memcmp(header.magic, "TJTR", 4) != 0 || header.version != FORMAT_VERSION) {
+        lastError = "Not a version " + std::to_string(FORMAT_VERSION) + " arrival trace: " + path;
+        close();
+        return false;
+    }
+
+    uint64_t expected = header.indexOffset + (static_cast<uint64_t>(header.hourCount) + 1) * sizeof(uint64_t);
+    if (header.recordCount > length / sizeof(Record) ||
+        header.indexOffset != sizeof(Header) + header.recordCount * sizeof(Record) || expected > length) {
+        lastError = "Truncated arrival trace: " + path;
+        close();
+        return false;
+    }
+
+    // seek() indexes records through the hour index, so every entry must
+    // stay inside the records and never go backwards
+    const uint64_t* index = reinterpret_cast<const uint64_t*>(base + header.indexOffset);
+    for (uint32_t h = 0; h <= header.hourCount; h++) {
+        if (index[h] > header.recordCount || (h > 0 && index[h] < index[h - 1])) {
+            lastError = "Corrupt hour index in arrival trace: " + path;
+            close();
+            return false;
+        }
+    }
+
+    recordData = reinterpret_cast<const Record*>(base + sizeof(Header));
+    hourIndex = index;
+    recordCount = header.recordCount;
+    durationMs = header.durationMs;
+    hourCount = header.hourCount;
+    mapped = true;
+
+    return true;
+}
+
+void ArrivalTrace::close() {
+#ifndef ARRIVAL_TRACE_NO_MMAP
+    if (mapBase) {
+        munmap(mapBase, mapLength);
+    }
+#endif
+    fallbackBuffer.clear();
+    mapBase = nullptr;
+    mapLength = 0;
+    mapped = false;
+    recordData = nullptr;
+    hourIndex = nullptr;
+    recordCount = 0;
+    durationMs = 0;
+    hourCount = 0;
+}
+
+size_t ArrivalTrace::seek(uint32_t timeMs) const {
+    if (!mapped || recordCount == 0) {
+        return 0;
+    }
+
+    // Narrow to one hour with the index, then binary search inside it
+    uint32_t hour = std::min(timeMs / MS_PER_HOUR, hourCount);
+    const Record* first = recordData + hourIndex[hour];
+    const Record* last = recordData + (hour < hourCount ? hourIndex[hour + 1] : recordCount);
+
+    const Record* it = std::lower_bound(first, last, timeMs,
+                                        [](const Record& r, uint32_t t) { return r.timeMs < t; });
+    return static_cast<size_t>(it - recordData);
+}
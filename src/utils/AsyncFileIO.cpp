@@ -0,0 +1,568 @@
+// FILE: src/utils/AsyncFileIO.cpp
+#include "utils/AsyncFileIO.h"
+#include "utils/ThreadPool.h"
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <sys/stat.h>
+
+#ifdef _WIN32
+#include <io.h>
+#else
+#include <unistd.h>
+#endif
+
+#if defined(__linux__) && defined(__has_include)
+#if __has_include(<linux/io_uring.h>)
+#include <linux/io_uring.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#if defined(__NR_io_uring_setup) && defined(__NR_io_uring_enter)
+#define ASYNC_FILE_IO_URING 1
+#endif
+#endif
+#endif
+
+namespace {
+
+// Threads for the fallback backend, counting the caller
+const size_t POOL_THREADS = 4;
+
+// Largest single read or write; longer operations continue where they stop
+const size_t MAX_IO_BYTES = 1u << 30;
+
+using Clock = std::chrono::steady_clock;
+
+uint64_t microsSince(Clock::time_point start) {
+    return static_cast<uint64_t>(
+        std::chrono::duration_cast<std::chrono::microseconds>(Clock::now() - start).count());
+}
+
+#ifdef _WIN32
+// No positioned I/O; each file's operations run on one thread, so a seek
+// and the transfer after it stay together
+long long positionedWrite(int fd, const char* data, size_t length, uint64_t offset) {
+    if (_lseeki64(fd, static_cast<long long>(offset), SEEK_SET) < 0) return -1;
+    return _write(fd, data, static_cast<unsigned>(std::min(length, MAX_IO_BYTES)));
+}
+
+long long positionedRead(int fd, char* data, size_t length, uint64_t offset) {
+    if (_lseeki64(fd, static_cast<long long>(offset), SEEK_SET) < 0) return -1;
+    return _read(fd, data, static_cast<unsigned>(std::min(length, MAX_IO_BYTES)));
+}
+
+int openFile(const std::string& path, bool write, bool truncate) {
+    int flags = _O_BINARY | (write ? _O_WRONLY | _O_CREAT : _O_RDONLY);
+    if (truncate) flags |= _O_TRUNC;
+    return _open(path.c_str(), flags, _S_IREAD | _S_IWRITE);
+}
+
+long long fileSize(int fd) {
+    return _lseeki64(fd, 0, SEEK_END);
+}
+
+void closeFd(int fd) {
+    _close(fd);
+}
+#else
+long long positionedWrite(int fd, const char* data, size_t length, uint64_t offset) {
+    return pwrite(fd, data, std::min(length, MAX_IO_BYTES), static_cast<off_t>(offset));
+}
+
+long long positionedRead(int fd, char* data, size_t length, uint64_t offset) {
+    return pread(fd, data, std::min(length, MAX_IO_BYTES), static_cast<off_t>(offset));
+}
+
+int openFile(const std::string& path, bool write, bool truncate) {
+    int flags = O_CLOEXEC | (write ? O_WRONLY | O_CREAT : O_RDONLY);
+    if (truncate) flags |= O_TRUNC;
+    return ::open(path.c_str(), flags, 0644);
+}
+
+long long fileSize(int fd) {
+    struct stat st;
+    return fstat(fd, &st) == 0 ? static_cast<long long>(st.st_size) : -1;
+}
+
+void closeFd(int fd) {
+    ::close(fd);
+}
+#endif
+
+#ifdef ASYNC_FILE_IO_URING
+int ringSetup(unsigned entries, io_uring_params* params) {
+    return static_cast<int>(syscall(__NR_io_uring_setup, entries, params));
+}
+
+int ringEnter(int fd, unsigned toSubmit, unsigned minComplete, unsigned flags) {
+    return static_cast<int>(syscall(__NR_io_uring_enter, fd, toSubmit, minComplete, flags, nullptr, 0));
+}
+#endif
+
+} // namespace
+
+#ifdef ASYNC_FILE_IO_URING
+// Kernel-shared submission and completion rings
+struct AsyncFileIO::Ring {
+    int fd = -1;
+    unsigned entries = 0;
+
+    void* sqMap = MAP_FAILED;
+    size_t sqMapSize = 0;
+    void* cqMap = MAP_FAILED;       // Same as sqMap with IORING_FEAT_SINGLE_MMAP
+    size_t cqMapSize = 0;
+    io_uring_sqe* sqes = static_cast<io_uring_sqe*>(MAP_FAILED);
+    size_t sqesSize = 0;
+
+    unsigned* sqHead = nullptr;
+    unsigned* sqTail = nullptr;
+    unsigned sqMask = 0;
+    unsigned* sqArray = nullptr;
+    unsigned* cqHead = nullptr;
+    unsigned* cqTail = nullptr;
+    unsigned cqMask = 0;
+    io_uring_cqe* cqes = nullptr;
+};
+#else
+struct AsyncFileIO::Ring {};
+#endif
+
+AsyncFileIO::AsyncFileIO(Backend requested, unsigned queueDepth)
+    : backend(Backend::THREAD_POOL),
+      queueDepth(std::max(1u, queueDepth)),
+      ring(nullptr),
+      pool(nullptr),
+      pendingBytes(0) {
+    resetStats();
+
+    if (requested != Backend::THREAD_POOL && setupRing()) {
+        backend = Backend::IO_URING;
+    } else {
+        pool = new ThreadPool(POOL_THREADS, ThreadRoles::Role::IO);
+    }
+}
+
+AsyncFileIO::~AsyncFileIO() {
+    flush();
+    for (const File& file : files) {
+        if (file.fd >= 0) {
+            closeFd(file.fd);
+        }
+    }
+    destroyRing();
+    delete pool;
+}
+
+const char* AsyncFileIO::backendName(Backend backend) {
+    switch (backend) {
+        case Backend::AUTO: return "auto";
+        case Backend::IO_URING: return "io_uring";
+        case Backend::THREAD_POOL: return "thread pool";
+    }
+    return "?";
+}
+
+void AsyncFileIO::resetStats() {
+    stats.operations = 0;
+    stats.failures = 0;
+    stats.batches = 0;
+    stats.syscalls = 0;
+    stats.bytesWritten = 0;
+    stats.bytesRead = 0;
+    stats.latencyUs.clear();
+}
+
+int AsyncFileIO::openForWrite(const std::string& path, bool truncate) {
+    int fd = openFile(path, true, truncate);
+    if (fd < 0) {
+        lastError = "Could not open " + path + ": " + std::strerror(errno);
+        return -1;
+    }
+
+    long long size = truncate ? 0 : fileSize(fd);
+    if (size < 0) {
+        lastError = "Could not size " + path + ": " + std::strerror(errno);
+        closeFd(fd);
+        return -1;
+    }
+
+    // Take the slot of a closed file if there is one, so opening and
+    // closing files for the life of a process doesn't grow the table.
+    // Closing flushed its writes, so none still refer to it.
+    File opened = {fd, static_cast<uint64_t>(size)};
+    for (size_t handle = 0; handle < files.size(); handle++) {
+        if (files[handle].fd < 0) {
+            files[handle] = opened;
+            return static_cast<int>(handle);
+        }
+    }
+    files.push_back(opened);
+    return static_cast<int>(files.size() - 1);
+}
+
+void AsyncFileIO::closeFile(int handle) {
+    if (handle < 0 || handle >= static_cast<int>(files.size()) || files[handle].fd < 0) {
+        return;
+    }
+    flush();
+    closeFd(files[handle].fd);
+    files[handle].fd = -1;
+}
+
+void AsyncFileIO::append(int handle, std::string data) {
+    if (handle < 0 || handle >= static_cast<int>(files.size()) || files[handle].fd < 0 || data.empty()) {
+        return;
+    }
+    File& file = files[handle];
+    pendingBytes += data.size();
+    pending.push_back({handle, file.endOffset, std::move(data)});
+    file.endOffset += pending.back().data.size();
+}
+
+void AsyncFileIO::append(int handle, const void* data, size_t length) {
+    append(handle, std::string(static_cast<const char*>(data), length));
+}
+
+bool AsyncFileIO::flush() {
+    if (pending.empty()) {
+        return true;
+    }
+
+    std::vector<Operation> operations;
+    operations.reserve(pending.size());
+    for (PendingWrite& write : pending) {
+        operations.push_back({files[write.handle].fd, true, &write.data[0],
+                              write.data.size(), write.offset, 0, 0});
+    }
+
+    bool ok = runBatch(operations);
+    pending.clear();
+    pendingBytes = 0;
+    return ok;
+}
+
+bool AsyncFileIO::readFiles(const std::vector<std::string>& paths, std::vector<std::string>& contents) {
+    contents.assign(paths.size(), std::string());
+    bool ok = true;
+
+    std::vector<Operation> operations;
+    std::vector<size_t> owners;
+    for (size_t i = 0; i < paths.size(); i++) {
+        int fd = openFile(paths[i], false, false);
+        if (fd < 0) {
+            if (errno != ENOENT) {
+                lastError = "Could not open " + paths[i] + ": " + std::strerror(errno);
+                ok = false;
+            }
+            continue;
+        }
+
+        long long size = fileSize(fd);
+        if (size <= 0) {
+            closeFd(fd);
+            continue;
+        }
+        contents[i].resize(static_cast<size_t>(size));
+        operations.push_back({fd, false, &contents[i][0], static_cast<size_t>(size), 0, 0, 0});
+        owners.push_back(i);
+    }
+
+    if (!runBatch(operations)) {
+        ok = false;
+    }
+
+    for (size_t j = 0; j < operations.size(); j++) {
+        std::string& content = contents[owners[j]];
+        if (operations[j].error != 0) {
+            content.clear();
+        } else {
+            // The file may have shrunk since it was sized
+            content.resize(operations[j].length);
+        }
+        closeFd(operations[j].fd);
+    }
+    return ok;
+}
+
+bool AsyncFileIO::runBatch(std::vector<Operation>& operations) {
+    if (operations.empty()) {
+        return true;
+    }
+    stats.batches++;
+
+    Clock::time_point start = Clock::now();
+    bool ok = backend == Backend::IO_URING ? runRing(operations, start) : runPool(operations, start);
+
+    for (const Operation& operation : operations) {
+        if (operation.error != 0) {
+            lastError = std::string(operation.write ? "Write" : "Read") + " failed: " +
+                        std::strerror(operation.error);
+            break;
+        }
+    }
+    return ok;
+}
+
+void AsyncFileIO::complete(const Operation& operation, uint64_t latencyUs) {
+    if (operation.error != 0) {
+        stats.failures++;
+        return;
+    }
+    stats.operations++;
+    (operation.write ? stats.bytesWritten : stats.bytesRead) += operation.done;
+    stats.latencyUs.record(latencyUs);
+}
+
+bool AsyncFileIO::runPool(std::vector<Operation>& operations, Clock::time_point start) {
+    // One task per file, so each file sees its operations in queue order
+    std::vector<std::vector<size_t>> groups;
+    std::vector<int> groupFds;
+    for (size_t i = 0; i < operations.size(); i++) {
+        size_t g = std::find(groupFds.begin(), groupFds.end(), operations[i].fd) - groupFds.begin();
+        if (g == groupFds.size()) {
+            groupFds.push_back(operations[i].fd);
+            groups.emplace_back();
+        }
+        groups[g].push_back(i);
+    }
+
+    std::atomic<uint64_t> calls(0);
+    std::vector<uint64_t> latencies(operations.size(), 0);
+    pool->parallelFor(groups.size(), [&](size_t g) {
+        for (size_t i : groups[g]) {
+            Operation& operation = operations[i];
+            while (operation.done < operation.length) {
+                long long n = operation.write
+                    ? positionedWrite(operation.fd, operation.data + operation.done,
+                                      operation.length - operation.done, operation.offset + operation.done)
+                    : positionedRead(operation.fd, operation.data + operation.done,
+                                     operation.length - operation.done, operation.offset + operation.done);
+                calls.fetch_add(1, std::memory_order_relaxed);
+                if (n < 0) {
+                    if (errno == EINTR) continue;
+                    operation.error = errno;
+                    break;
+                }
+                if (n == 0) {
+                    // End of file for a read; a write that makes no progress failed
+                    if (operation.write) {
+                        operation.error = EIO;
+                    } else {
+                        operation.length = operation.done;
+                    }
+                    break;
+                }
+                operation.done += static_cast<size_t>(n);
+            }
+            latencies[i] = microsSince(start);
+        }
+    });
+
+    stats.syscalls += calls.load();
+    bool ok = true;
+    for (size_t i = 0; i < operations.size(); i++) {
+        complete(operations[i], latencies[i]);
+        ok = ok && operations[i].error == 0;
+    }
+    return ok;
+}
+
+#ifdef ASYNC_FILE_IO_URING
+
+bool AsyncFileIO::setupRing() {
+    io_uring_params params;
+    std::memset(&params, 0, sizeof(params));
+
+    int fd = ringSetup(queueDepth, &params);
+    if (fd < 0) {
+        lastError = std::string("io_uring unavailable: ") + std::strerror(errno);
+        return false;
+    }
+
+    // Plain READ/WRITE opcodes arrived with the current-position feature (5.6)
+    if (!(params.features & IORING_FEAT_RW_CUR_POS)) {
+        ::close(fd);
+        lastError = "io_uring unavailable: kernel lacks IORING_OP_READ/WRITE";
+        return false;
+    }
+
+    ring = new Ring();
+    ring->fd = fd;
+    ring->entries = params.sq_entries;
+    ring->sqMapSize = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+    ring->cqMapSize = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+    ring->sqesSize = params.sq_entries * sizeof(io_uring_sqe);
+
+    bool singleMap = (params.features & IORING_FEAT_SINGLE_MMAP) != 0;
+    if (singleMap) {
+        ring->sqMapSize = ring->cqMapSize = std::max(ring->sqMapSize, ring->cqMapSize);
+    }
+
+    ring->sqMap = mmap(nullptr, ring->sqMapSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+                       fd, IORING_OFF_SQ_RING);
+    if (ring->sqMap != MAP_FAILED) {
+        ring->cqMap = singleMap ? ring->sqMap
+                                : mmap(nullptr, ring->cqMapSize, PROT_READ | PROT_WRITE,
+                                       MAP_SHARED | MAP_POPULATE, fd, IORING_OFF_CQ_RING);
+    }
+    if (ring->cqMap != MAP_FAILED) {
+        ring->sqes = static_cast<io_uring_sqe*>(mmap(nullptr, ring->sqesSize, PROT_READ | PROT_WRITE,
+                                                     MAP_SHARED | MAP_POPULATE, fd, IORING_OFF_SQES));
+    }
+    if (ring->sqMap == MAP_FAILED || ring->cqMap == MAP_FAILED || ring->sqes == MAP_FAILED) {
+        lastError = std::string("io_uring ring mapping failed: ") + std::strerror(errno);
+        destroyRing();
+        return false;
+    }
+
+    char* sq = static_cast<char*>(ring->sqMap);
+    ring->sqHead = reinterpret_cast<unsigned*>(sq + params.sq_off.head);
+    ring->sqTail = reinterpret_cast<unsigned*>(sq + params.sq_off.tail);
+    ring->sqMask = *reinterpret_cast<unsigned*>(sq + params.sq_off.ring_mask);
+    ring->sqArray = reinterpret_cast<unsigned*>(sq + params.sq_off.array);
+
+    char* cq = static_cast<char*>(ring->cqMap);
+    ring->cqHead = reinterpret_cast<unsigned*>(cq + params.cq_off.head);
+    ring->cqTail = reinterpret_cast<unsigned*>(cq + params.cq_off.tail);
+    ring->cqMask = *reinterpret_cast<unsigned*>(cq + params.cq_off.ring_mask);
+    ring->cqes = reinterpret_cast<io_uring_cqe*>(cq + params.cq_off.cqes);
+    return true;
+}
+
+void AsyncFileIO::destroyRing() {
+    if (!ring) {
+        return;
+    }
+    if (ring->sqes != MAP_FAILED) {
+        munmap(ring->sqes, ring->sqesSize);
+    }
+    if (ring->cqMap != MAP_FAILED && ring->cqMap != ring->sqMap) {
+        munmap(ring->cqMap, ring->cqMapSize);
+    }
+    if (ring->sqMap != MAP_FAILED) {
+        munmap(ring->sqMap, ring->sqMapSize);
+    }
+    if (ring->fd >= 0) {
+        ::close(ring->fd);
+    }
+    delete ring;
+    ring = nullptr;
+}
+
+bool AsyncFileIO::runRing(std::vector<Operation>& operations, Clock::time_point start) {
+    bool ok = true;
+
+    // Operations still to submit; short transfers are queued again
+    std::vector<size_t> queue(operations.size());
+    for (size_t i = 0; i < queue.size(); i++) {
+        queue[i] = i;
+    }
+    size_t next = 0;
+    unsigned unsubmitted = 0;   // Written to the SQ, not yet taken by the kernel
+    unsigned inFlight = 0;
+
+    while (next < queue.size() || unsubmitted > 0 || inFlight > 0) {
+        // Fill the submission ring; in-flight entries never exceed its
+        // size, so the completion ring (twice as large) can't overflow
+        unsigned tail = *ring->sqTail;
+        while (next < queue.size() && unsubmitted + inFlight < ring->entries) {
+            size_t i = queue[next++];
+            Operation& operation = operations[i];
+            unsigned index = tail & ring->sqMask;
+
+            io_uring_sqe* sqe = &ring->sqes[index];
+            std::memset(sqe, 0, sizeof(*sqe));
+            sqe->opcode = operation.write ? IORING_OP_WRITE : IORING_OP_READ;
+            sqe->fd = operation.fd;
+            sqe->addr = reinterpret_cast<uint64_t>(operation.data + operation.done);
+            sqe->len = static_cast<uint32_t>(std::min(operation.length - operation.done, MAX_IO_BYTES));
+            sqe->off = operation.offset + operation.done;
+            sqe->user_data = i;
+
+            ring->sqArray[index] = index;
+            tail++;
+            unsubmitted++;
+        }
+        __atomic_store_n(ring->sqTail, tail, __ATOMIC_RELEASE);
+
+        // Submit and wait in the same call: for everything when nothing
+        // else is queued, otherwise until half the ring can be refilled
+        unsigned outstanding = unsubmitted + inFlight;
+        unsigned waitFor = next < queue.size() ? std::max(1u, std::min(outstanding, ring->entries / 2))
+                                               : outstanding;
+        int submitted = ringEnter(ring->fd, unsubmitted, waitFor, IORING_ENTER_GETEVENTS);
+        stats.syscalls++;
+        if (submitted < 0) {
+            if (errno != EINTR && errno != EAGAIN && errno != EBUSY) {
+                // The ring is unusable; nothing more will complete
+                int error = errno;
+                for (Operation& operation : operations) {
+                    if (operation.error == 0 && operation.done < operation.length) {
+                        operation.error = error;
+                    }
+                }
+                for (size_t j = next; j < queue.size(); j++) {
+                    complete(operations[queue[j]], microsSince(start));
+                }
+                return false;
+            }
+            submitted = 0;
+        }
+        unsubmitted -= static_cast<unsigned>(submitted);
+        inFlight += static_cast<unsigned>(submitted);
+
+        unsigned head = *ring->cqHead;
+        unsigned completed = __atomic_load_n(ring->cqTail, __ATOMIC_ACQUIRE);
+        while (head != completed) {
+            const io_uring_cqe* cqe = &ring->cqes[head & ring->cqMask];
+            size_t i = static_cast<size_t>(cqe->user_data);
+            int result = cqe->res;
+            head++;
+            inFlight--;
+
+            Operation& operation = operations[i];
+            if (result == -EINTR || result == -EAGAIN) {
+                queue.push_back(i);
+                continue;
+            }
+            if (result < 0) {
+                operation.error = -result;
+                ok = false;
+            } else if (result == 0 && operation.done < operation.length) {
+                // End of file for a read; a write that makes no progress failed
+                if (operation.write) {
+                    operation.error = EIO;
+                    ok = false;
+                } else {
+                    operation.length = operation.done;
+                }
+            } else {
+                operation.done += static_cast<size_t>(result);
+                if (operation.done < operation.length) {
+                    queue.push_back(i);
+                    continue;
+                }
+            }
+            complete(operation, microsSince(start));
+        }
+        __atomic_store_n(ring->cqHead, head, __ATOMIC_RELEASE);
+    }
+    return ok;
+}
+
+#else
+
+bool AsyncFileIO::setupRing() {
+    lastError = "io_uring unavailable: not a Linux build";
+    return false;
+}
+
+void AsyncFileIO::destroyRing() {}
+
+bool AsyncFileIO::runRing(std::vector<Operation>& operations, Clock::time_point start) {
+    return runPool(operations, start);
+}
+
+#endif
@@ -1,7 +1,9 @@
 #include "utils/DebugLogger.h"
+#include "utils/AsyncFileIO.h"
+#include "utils/ThreadRoles.h"
 #include <iostream>
-#include <fstream>
 #include <chrono>
+#include <cstdlib>
 #include <ctime>
 #include <iomanip>
 #include <sstream>
@@ -10,25 +12,85 @@
 std::string DebugLogger::logFilePath = "traffic_simulator.log";
 std::vector<std::string> DebugLogger::recentLogs;
 std::mutex DebugLogger::logMutex;
-bool DebugLogger::initialized = false;
+std::atomic<bool> DebugLogger::initialized(false);
+std::atomic<bool> DebugLogger::enabled(true);
+std::atomic<bool> DebugLogger::consoleEcho(true);
+std::mutex DebugLogger::ioMutex;
+AsyncFileIO* DebugLogger::io = nullptr;
+int DebugLogger::logFile = -1;
+std::string DebugLogger::buffer;
+std::chrono::steady_clock::time_point DebugLogger::lastFlush;
+std::thread DebugLogger::flusher;
+std::condition_variable DebugLogger::flushWake;
+bool DebugLogger::flusherRunning = false;
+bool DebugLogger::flushRequested = false;
+
+namespace {
+
+// Buffered log output is written once this much is queued...
+const size_t FLUSH_BYTES = 32 * 1024;
+
+// ...or this long after the previous write
+const std::chrono::milliseconds FLUSH_INTERVAL(100);
+
+void flushAtExit() {
+    DebugLogger::stopFlushThread();
+    DebugLogger::flush();
+}
+
+void registerExitHandler() {
+    static bool registered = false;
+    if (!registered) {
+        std::atexit(flushAtExit);
+        registered = true;
+    }
+}
+
+} // namespace
 
 void DebugLogger::initialize(const std::string& path) {
+    std::lock_guard<std::mutex> ioLock(ioMutex);
+    startLogging(path);
+}
+
+void DebugLogger::startLogging(const std::string& path) {
+    // Messages so far belong to the previous file
+    writeBuffer();
+
     std::lock_guard<std::mutex> lock(logMutex);
     logFilePath = path;
+    openLogFile("=== Traffic Simulator Log ===");
+    registerExitHandler();
+    initialized.store(true, std::memory_order_release);
+}
 
-    // Create/clear the log file
-    std::ofstream file(logFilePath, std::ios::trunc);
-    if (file.is_open()) {
-        file << "=== Traffic Simulator Log ===\n";
-        file.close();
-    }
+void DebugLogger::initializeAfterFork(const std::string& path) {
+    {
+        std::lock_guard<std::mutex> ioLock(ioMutex);
+        std::lock_guard<std::mutex> lock(logMutex);
 
-    initialized = true;
+        // Abandoned rather than deleted: tearing it down would wait on the
+        // parent's submissions and join threads this process doesn't have
+        io = nullptr;
+        logFile = -1;
+        buffer.clear();
+        flusherRunning = false;
+    }
+    initialize(path);
 }
 
 void DebugLogger::log(const std::string& message, LogLevel level) {
-    if (!initialized) {
-        initialize(); // Initialize with default path if not done already
+    if (!enabled.load(std::memory_order_relaxed)) {
+        return;
+    }
+
+    // Open the default file on first use. Threads can get here together,
+    // so check again once only one of them can open it.
+    if (!initialized.load(std::memory_order_acquire)) {
+        std::lock_guard<std::mutex> ioLock(ioMutex);
+        if (!initialized.load(std::memory_order_relaxed)) {
+            startLogging("traffic_simulator.log");
+        }
     }
 
     std::string levelStr;
@@ -40,23 +102,43 @@ void DebugLogger::log(const std::string& message, LogLevel level) {
         default:                levelStr = "INFO"; break;
     }
 
-    std::string timestamp = getTimestamp();
-    std::string formattedMessage = "[" + timestamp + "] [" + levelStr + "] " + message;
-
-    // Store in recent logs (limited to last 100)
+    bool flushNow = false;
     {
+        // One message at a time: callers may log from worker threads
         std::lock_guard<std::mutex> lock(logMutex);
+
+        std::string timestamp = getTimestamp();
+        std::string formattedMessage = "[" + timestamp + "] [" + levelStr + "] " + message;
+
+        // Store in recent logs (limited to last 100)
         recentLogs.push_back(formattedMessage);
         if (recentLogs.size() > 100) {
             recentLogs.erase(recentLogs.begin());
         }
-    }
 
-    // Write to file
-    writeToFile(formattedMessage);
+        // Queue for the file; errors go out at once in case the process
+        // dies next
+        buffer += formattedMessage;
+        buffer += '\n';
+        bool urgent = level == LogLevel::ERROR || buffer.size() >= FLUSH_BYTES;
+        if (flusherRunning) {
+            if (urgent) {
+                flushRequested = true;
+                flushWake.notify_one();
+            }
+        } else {
+            flushNow = urgent || std::chrono::steady_clock::now() - lastFlush >= FLUSH_INTERVAL;
+        }
+
+        // Also output to console
+        if (consoleEcho.load(std::memory_order_relaxed)) {
+            std::cout << formattedMessage << std::endl;
+        }
+    }
 
-    // Also output to console
-    std::cout << formattedMessage << std::endl;
+    if (flushNow) {
+        flush();
+    }
 }
 
 std::vector<std::string> DebugLogger::getRecentLogs(int count) {
@@ -77,27 +159,84 @@ std::vector<std::string> DebugLogger::getRecentLogs(int count) {
     );
 }
 
+size_t DebugLogger::getRecentLogCount() {
+    std::lock_guard<std::mutex> lock(logMutex);
+    return recentLogs.size();
+}
+
+size_t DebugLogger::getBufferedBytes() {
+    std::lock_guard<std::mutex> lock(logMutex);
+    return buffer.size();
+}
+
+void DebugLogger::setEnabled(bool on) {
+    enabled.store(on, std::memory_order_relaxed);
+}
+
+void DebugLogger::setConsoleEcho(bool echo) {
+    consoleEcho.store(echo, std::memory_order_relaxed);
+}
+
 void DebugLogger::clearLogs() {
+    std::lock_guard<std::mutex> ioLock(ioMutex);
     std::lock_guard<std::mutex> lock(logMutex);
     recentLogs.clear();
+    buffer.clear();
 
     // Clear the log file
-    std::ofstream file(logFilePath, std::ios::trunc);
-    if (file.is_open()) {
-        file << "=== Traffic Simulator Log (Cleared) ===\n";
-        file.close();
+    openLogFile("=== Traffic Simulator Log (Cleared) ===");
+}
+
+void DebugLogger::flush() {
+    std::lock_guard<std::mutex> ioLock(ioMutex);
+    writeBuffer();
+}
+
+void DebugLogger::startFlushThread() {
+    {
+        std::lock_guard<std::mutex> lock(logMutex);
+        if (flusherRunning) {
+            return;
+        }
+        flusherRunning = true;
+        flushRequested = false;
     }
+    registerExitHandler();
+    flusher = std::thread(&DebugLogger::flushLoop);
+    ThreadRoles::assign(flusher, ThreadRoles::Role::LOGGING, "log-flush");
+}
+
+void DebugLogger::stopFlushThread() {
+    {
+        std::lock_guard<std::mutex> lock(logMutex);
+        if (!flusherRunning) {
+            return;
+        }
+        flusherRunning = false;
+    }
+    flushWake.notify_one();
+    ThreadRoles::release(flusher);
+    flusher.join();
+    flush();
 }
 
 void DebugLogger::shutdown() {
-    std::lock_guard<std::mutex> lock(logMutex);
+    stopFlushThread();
 
-    if (!initialized) {
-        return;
+    std::lock_guard<std::mutex> ioLock(ioMutex);
+    {
+        std::lock_guard<std::mutex> lock(logMutex);
+        if (!initialized.load(std::memory_order_relaxed)) {
+            return;
+        }
+        buffer += "[" + getTimestamp() + "] [INFO] Logger shutdown\n";
+        initialized.store(false, std::memory_order_release);
     }
+    writeBuffer();
 
-    writeToFile("[" + getTimestamp() + "] [INFO] Logger shutdown");
-    initialized = false;
+    delete io;
+    io = nullptr;
+    logFile = -1;
 }
 
 std::string DebugLogger::getTimestamp() {
@@ -113,10 +252,43 @@ std::string DebugLogger::getTimestamp() {
     return ss.str();
 }
 
-void DebugLogger::writeToFile(const std::string& message) {
-    std::ofstream file(logFilePath, std::ios::app);
-    if (file.is_open()) {
-        file << message << std::endl;
-        file.close();
+void DebugLogger::openLogFile(const std::string& header) {
+    if (!io) {
+        io = new AsyncFileIO();
+    }
+    io->closeFile(logFile);
+
+    logFile = io->openForWrite(logFilePath, true);
+    if (logFile < 0) {
+        std::cerr << "Cannot write log file: " << io->getLastError() << std::endl;
+        return;
+    }
+    io->append(logFile, header + "\n");
+    io->flush();
+}
+
+void DebugLogger::writeBuffer() {
+    std::string text;
+    {
+        std::lock_guard<std::mutex> lock(logMutex);
+        text.swap(buffer);
+        lastFlush = std::chrono::steady_clock::now();
+    }
+
+    if (io && logFile >= 0 && !text.empty()) {
+        io->append(logFile, std::move(text));
+        io->flush();
+    }
+}
+
+void DebugLogger::flushLoop() {
+    std::unique_lock<std::mutex> lock(logMutex);
+    while (flusherRunning) {
+        flushWake.wait_for(lock, FLUSH_INTERVAL, [] { return !flusherRunning || flushRequested; });
+        flushRequested = false;
+
+        lock.unlock();
+        flush();
+        lock.lock();
     }
 }
@@ -0,0 +1,224 @@
+// FILE: src/utils/ResultCache.cpp
+#include "utils/ResultCache.h"
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <sstream>
+#include <thread>
+#include <vector>
+#include <unistd.h>
+
+namespace fs = std::filesystem;
+
+ResultCache::ResultCache()
+    : maxBytes(0),
+      totalBytes(0),
+      hits(0),
+      misses(0),
+      useCounter(0) {}
+
+uint64_t ResultCache::hashBytes(const void* data, size_t size, uint64_t hash) {
+    const unsigned char* bytes = static_cast<const unsigned char*>(data);
+    for (size_t i = 0; i < size; i++) {
+        hash = (hash ^ bytes[i]) * 1099511628211ULL;
+    }
+    return hash;
+}
+
+uint64_t ResultCache::buildId() {
+    static const uint64_t id = [] {
+        uint64_t hash = FNV_OFFSET;
+        std::ifstream exe("/proc/self/exe", std::ios::binary);
+        if (!exe.is_open()) {
+            const char stamp[] = __DATE__ " " __TIME__;
+            return hashBytes(stamp, sizeof(stamp));
+        }
+
+        std::vector<char> buffer(1 << 16);
+        while (exe.read(buffer.data(), buffer.size()) || exe.gcount() > 0) {
+            hash = hashBytes(buffer.data(), static_cast<size_t>(exe.gcount()), hash);
+        }
+        return hash;
+    }();
+    return id;
+}
+
+std::string ResultCache::entryPath(uint64_t key) const {
+    char name[32];
+    std::snprintf(name, sizeof(name), "%016llx.res", static_cast<unsigned long long>(key));
+    return directory + "/" + name;
+}
+
+bool ResultCache::open(const std::string& path, uint64_t limit) {
+    std::lock_guard<std::mutex> lock(mutex);
+
+    std::error_code error;
+    fs::create_directories(path, error);
+    if (!fs::is_directory(path, error)) {
+        lastError = "Cannot create cache directory " + path;
+        return false;
+    }
+
+    directory = path;
+    maxBytes = limit;
+    totalBytes = 0;
+    hits = 0;
+    misses = 0;
+    useCounter = 0;
+    entries.clear();
+    lru.clear();
+
+    // Rebuild the LRU order from modification times
+    struct Found {
+        fs::file_time_type time;
+        uint64_t key;
+        uint64_t bytes;
+    };
+    std::vector<Found> found;
+    for (const auto& item : fs::directory_iterator(directory, error)) {
+        std::string name = item.path().filename().string();
+        if (name.size() != 20 || name.compare(16, 4, ".res") != 0) {
+            continue;
+        }
+        char* end = nullptr;
+        uint64_t key = std::strtoull(name.substr(0, 16).c_str(), &end, 16);
+        if (!end || *end != '\0') {
+            continue;
+        }
+        found.push_back({item.last_write_time(error), key, item.file_size(error)});
+    }
+    std::sort(found.begin(), found.end(), [](const Found& a, const Found& b) { return a.time < b.time; });
+
+    for (const Found& entry : found) {
+        touch(entry.key, entry.bytes);
+    }
+
+    evict();
+    return true;
+}
+
+void ResultCache::touch(uint64_t key, uint64_t bytes) {
+    auto it = entries.find(key);
+    if (it != entries.end()) {
+        lru.erase(it->second.lastUse);
+        totalBytes -= it->second.bytes;
+    }
+
+    Entry& entry = entries[key];
+    entry.bytes = bytes;
+    entry.lastUse = ++useCounter;
+    lru[entry.lastUse] = key;
+    totalBytes += bytes;
+}
+
+void ResultCache::evict() {
+    while (totalBytes > maxBytes && !lru.empty()) {
+        auto oldest = lru.begin();
+        uint64_t key = oldest->second;
+        lru.erase(oldest);
+
+        auto it = entries.find(key);
+        totalBytes -= it->second.bytes;
+        entries.erase(it);
+        std::remove(entryPath(key).c_str());
+    }
+}
+
+bool ResultCache::lookup(uint64_t key, void* data, size_t size) {
+    if (!isOpen()) return false;
+
+    // Read without the lock; entries are replaced by rename, never rewritten
+    std::string path = entryPath(key);
+    std::ifstream file(path, std::ios::binary);
+    EntryHeader header;
+    bool found = file.is_open() &&
+                 file.read(reinterpret_cast<char*>(&header), sizeof(header)) &&
+                 std::memcmp(header.magic, "TJRC", 4) == 0 &&
+                 header.version == FORMAT_VERSION &&
+                 header.key == key &&
+                 header.size == size &&
+                 file.read(static_cast<char*>(data), size);
+
+    std::lock_guard<std::mutex> lock(mutex);
+    if (!found) {
+        misses++;
+        return false;
+    }
+
+    hits++;
+    touch(key, sizeof(header) + size);
+
+    // Persist recency for eviction after a restart
+    std::error_code error;
+    fs::last_write_time(path, fs::file_time_type::clock::now(), error);
+    return true;
+}
+
+bool ResultCache::store(uint64_t key, const void* data, size_t size) {
+    if (!isOpen()) return false;
+
+    EntryHeader header;
+    std::memcpy(header.magic, "TJRC", 4);
+    header.version = FORMAT_VERSION;
+    header.key = key;
+    header.size = static_cast<uint32_t>(size);
+    header.reserved = 0;
+
+    // Unique temporary name per process and thread, then an atomic rename
+    static std::atomic<uint64_t> tempCounter(0);
+    std::ostringstream temp;
+    temp << directory << "/." << std::hex << key << "." << getpid() << "."
+         << std::hash<std::thread::id>()(std::this_thread::get_id()) << "." << tempCounter++ << ".tmp";
+
+    {
+        std::ofstream file(temp.str(), std::ios::binary | std::ios::trunc);
+        if (!file.write(reinterpret_cast<const char*>(&header), sizeof(header)) ||
+            !file.write(static_cast<const char*>(data), size)) {
+            std::lock_guard<std::mutex> lock(mutex);
+            lastError = "Cannot write cache entry " + temp.str();
+            std::remove(temp.str().c_str());
+            return false;
+        }
+    }
+
+    if (std::rename(temp.str().c_str(), entryPath(key).c_str()) != 0) {
+        std::lock_guard<std::mutex> lock(mutex);
+        lastError = "Cannot rename cache entry into " + entryPath(key);
+        std::remove(temp.str().c_str());
+        return false;
+    }
+
+    std::lock_guard<std::mutex> lock(mutex);
+    touch(key, sizeof(header) + size);
+    evict();
+    return true;
+}
+
+uint64_t ResultCache::getHits() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return hits;
+}
+
+uint64_t ResultCache::getMisses() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return misses;
+}
+
+size_t ResultCache::getEntryCount() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return entries.size();
+}
+
+uint64_t ResultCache::getTotalBytes() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return totalBytes;
+}
+
+std::string ResultCache::getLastError() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return lastError;
+}
@@ -0,0 +1,95 @@
+// FILE: src/utils/SharedMemory.cpp
+#include "utils/SharedMemory.h"
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+SharedMemory::SharedMemory()
+    : address(nullptr),
+      length(0),
+      owner(false) {}
+
+SharedMemory::~SharedMemory() {
+    close();
+}
+
+bool SharedMemory::create(const std::string& regionName, size_t size) {
+    close();
+
+    // Remove a stale region left behind by a crashed run
+    shm_unlink(regionName.c_str());
+
+    int fd = shm_open(regionName.c_str(), O_CREAT | O_EXCL | O_RDWR, 0600);
+    if (fd < 0) {
+        lastError = "shm_open failed for " + regionName + ": " + std::strerror(errno);
+        return false;
+    }
+
+    if (ftruncate(fd, static_cast<off_t>(size)) != 0) {
+        lastError = "Could not size shared memory " + regionName + ": " + std::strerror(errno);
+        ::close(fd);
+        shm_unlink(regionName.c_str());
+        return false;
+    }
+
+    void* addr = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    ::close(fd);
+    if (addr == MAP_FAILED) {
+        lastError = "mmap failed for " + regionName + ": " + std::strerror(errno);
+        shm_unlink(regionName.c_str());
+        return false;
+    }
+
+    name = regionName;
+    address = addr;
+    length = size;
+    owner = true;
+    return true;
+}
+
+bool SharedMemory::open(const std::string& regionName, bool readOnly) {
+    close();
+
+    int fd = shm_open(regionName.c_str(), readOnly ? O_RDONLY : O_RDWR, 0600);
+    if (fd < 0) {
+        lastError = "shm_open failed for " + regionName + ": " + std::strerror(errno);
+        return false;
+    }
+
+    struct stat st;
+    if (fstat(fd, &st) != 0) {
+        lastError = "fstat failed for " + regionName + ": " + std::strerror(errno);
+        ::close(fd);
+        return false;
+    }
+
+    int protection = readOnly ? PROT_READ : PROT_READ | PROT_WRITE;
+    void* addr = mmap(nullptr, static_cast<size_t>(st.st_size), protection, MAP_SHARED, fd, 0);
+    ::close(fd);
+    if (addr == MAP_FAILED) {
+        lastError = "mmap failed for " + regionName + ": " + std::strerror(errno);
+        return false;
+    }
+
+    name = regionName;
+    address = addr;
+    length = static_cast<size_t>(st.st_size);
+    owner = false;
+    return true;
+}
+
+void SharedMemory::close() {
+    if (address) {
+        munmap(address, length);
+    }
+    if (owner) {
+        shm_unlink(name.c_str());
+    }
+    address = nullptr;
+    length = 0;
+    owner = false;
+    name.clear();
+}
@@ -0,0 +1,92 @@
+// FILE: src/utils/ThreadPool.cpp
+#include "utils/ThreadPool.h"
+
+ThreadPool::ThreadPool(size_t threads, ThreadRoles::Role role)
+    : currentTask(nullptr),
+      taskCount(0),
+      generation(0),
+      busyWorkers(0),
+      stopping(false),
+      nextIndex(0) {
+    for (size_t i = 1; i < threads; i++) {
+        workers.emplace_back(&ThreadPool::workerLoop, this);
+        ThreadRoles::assign(workers.back(), role, std::string(ThreadRoles::roleName(role)) + "-" + std::to_string(i));
+    }
+}
+
+ThreadPool::~ThreadPool() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    wake.notify_all();
+
+    for (auto& worker : workers) {
+        ThreadRoles::release(worker);
+        worker.join();
+    }
+}
+
+void ThreadPool::parallelFor(size_t count, const std::function<void(size_t)>& task) {
+    if (count == 0) {
+        return;
+    }
+
+    // Nothing to share the work with
+    if (workers.empty() || count == 1) {
+        for (size_t i = 0; i < count; i++) {
+            task(i);
+        }
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        currentTask = &task;
+        taskCount = count;
+        nextIndex.store(0, std::memory_order_relaxed);
+        busyWorkers = workers.size();
+        generation++;
+    }
+    wake.notify_all();
+
+    runTasks();
+
+    // Every worker has to check in before task goes out of scope
+    std::unique_lock<std::mutex> lock(mutex);
+    finished.wait(lock, [this] { return busyWorkers == 0; });
+    currentTask = nullptr;
+}
+
+void ThreadPool::workerLoop() {
+    uint64_t seenGeneration = 0;
+
+    while (true) {
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            wake.wait(lock, [&] { return stopping || generation != seenGeneration; });
+            if (stopping) {
+                return;
+            }
+            seenGeneration = generation;
+        }
+
+        runTasks();
+
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            busyWorkers--;
+        }
+        finished.notify_one();
+    }
+}
+
+void ThreadPool::runTasks() {
+    while (true) {
+        size_t i = nextIndex.fetch_add(1, std::memory_order_relaxed);
+        if (i >= taskCount) {
+            return;
+        }
+        (*currentTask)(i);
+    }
+}
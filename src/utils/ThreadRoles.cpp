@@ -0,0 +1,362 @@
+// FILE: src/utils/ThreadRoles.cpp
+#include "utils/ThreadRoles.h"
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <mutex>
+#include <sstream>
+
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+namespace {
+
+// One registered thread, as placed
+struct Entry {
+    std::thread::id id;
+    std::string name;
+    ThreadRoles::Role role;
+    std::vector<int> cpus;      // Affinity after placement (empty if unknown)
+    std::string policy;
+    int priority;
+    std::string note;           // Why a request wasn't applied
+};
+
+std::mutex registryMutex;
+ThreadRoles::Placement placements[ThreadRoles::ROLE_COUNT] = {
+    {{}, ThreadRoles::Policy::INHERIT, 0}, {{}, ThreadRoles::Policy::INHERIT, 0},
+    {{}, ThreadRoles::Policy::INHERIT, 0}, {{}, ThreadRoles::Policy::INHERIT, 0},
+    {{}, ThreadRoles::Policy::INHERIT, 0}, {{}, ThreadRoles::Policy::INHERIT, 0}
+};
+std::vector<Entry> entries;
+
+const char* const ROLE_KEYS[ThreadRoles::ROLE_COUNT] = {"sim", "worker", "render", "ingest", "log", "io"};
+
+std::vector<std::string> split(const std::string& text, const char* separators) {
+    std::vector<std::string> parts;
+    size_t start = 0;
+    while (start <= text.size()) {
+        size_t end = text.find_first_of(separators, start);
+        if (end == std::string::npos) end = text.size();
+        parts.push_back(text.substr(start, end - start));
+        start = end + 1;
+    }
+    return parts;
+}
+
+bool parseNumber(const std::string& text, int& value) {
+    if (text.empty() || text.size() > 6 || text.find_first_not_of("0123456789") != std::string::npos) {
+        return false;
+    }
+    value = std::atoi(text.c_str());
+    return true;
+}
+
+// "0,2-3" -> {0, 2, 3}; empty text is an empty list
+bool parseCpus(const std::string& text, std::vector<int>& cpus) {
+    cpus.clear();
+    if (text.empty()) {
+        return true;
+    }
+    for (const std::string& item : split(text, ",")) {
+        size_t dash = item.find('-');
+        int first = 0;
+        int last = 0;
+        if (dash == std::string::npos) {
+            if (!parseNumber(item, first)) return false;
+            last = first;
+        } else if (!parseNumber(item.substr(0, dash), first) || !parseNumber(item.substr(dash + 1), last) ||
+                   last < first) {
+            return false;
+        }
+        for (int cpu = first; cpu <= last; cpu++) {
+            cpus.push_back(cpu);
+        }
+    }
+    std::sort(cpus.begin(), cpus.end());
+    cpus.erase(std::unique(cpus.begin(), cpus.end()), cpus.end());
+    return true;
+}
+
+// {0, 2, 3} -> "0,2-3"
+std::string formatCpus(const std::vector<int>& cpus) {
+    if (cpus.empty()) {
+        return "-";
+    }
+    std::ostringstream out;
+    for (size_t i = 0; i < cpus.size(); ) {
+        size_t j = i;
+        while (j + 1 < cpus.size() && cpus[j + 1] == cpus[j] + 1) {
+            j++;
+        }
+        if (i > 0) out << ',';
+        out << cpus[i];
+        if (j > i) out << '-' << cpus[j];
+        i = j + 1;
+    }
+    return out.str();
+}
+
+bool parsePolicy(const std::string& text, ThreadRoles::Policy& policy) {
+    static const struct { const char* name; ThreadRoles::Policy policy; } names[] = {
+        {"other", ThreadRoles::Policy::OTHER}, {"batch", ThreadRoles::Policy::BATCH},
+        {"idle", ThreadRoles::Policy::IDLE}, {"fifo", ThreadRoles::Policy::FIFO},
+        {"rr", ThreadRoles::Policy::RR}
+    };
+    for (const auto& entry : names) {
+        if (text == entry.name) {
+            policy = entry.policy;
+            return true;
+        }
+    }
+    return false;
+}
+
+#ifdef __linux__
+const char* policyName(int policy) {
+    switch (policy) {
+        case SCHED_OTHER: return "SCHED_OTHER";
+        case SCHED_BATCH: return "SCHED_BATCH";
+        case SCHED_IDLE: return "SCHED_IDLE";
+        case SCHED_FIFO: return "SCHED_FIFO";
+        case SCHED_RR: return "SCHED_RR";
+    }
+    return "?";
+}
+
+int schedPolicy(ThreadRoles::Policy policy) {
+    switch (policy) {
+        case ThreadRoles::Policy::BATCH: return SCHED_BATCH;
+        case ThreadRoles::Policy::IDLE: return SCHED_IDLE;
+        case ThreadRoles::Policy::FIFO: return SCHED_FIFO;
+        case ThreadRoles::Policy::RR: return SCHED_RR;
+        default: return SCHED_OTHER;
+    }
+}
+
+// Apply a placement to a thread and fill in what it ended up with
+void place(pthread_t handle, const ThreadRoles::Placement& placement, Entry& entry) {
+    pthread_setname_np(handle, entry.name.substr(0, 15).c_str());
+
+    if (!placement.cpus.empty()) {
+        cpu_set_t set;
+        CPU_ZERO(&set);
+        for (int cpu : placement.cpus) {
+            if (cpu < CPU_SETSIZE) CPU_SET(cpu, &set);
+        }
+        int result = pthread_setaffinity_np(handle, sizeof(set), &set);
+        if (result != 0) {
+            entry.note += std::string("affinity refused: ") + std::strerror(result) + "; ";
+        }
+    }
+
+    if (placement.policy != ThreadRoles::Policy::INHERIT) {
+        int policy = schedPolicy(placement.policy);
+        sched_param param = {};
+        if (policy == SCHED_FIFO || policy == SCHED_RR) {
+            param.sched_priority = std::max(sched_get_priority_min(policy),
+                                            std::min(placement.priority, sched_get_priority_max(policy)));
+        }
+        int result = pthread_setschedparam(handle, policy, &param);
+        if (result != 0) {
+            entry.note += std::string(policyName(policy)) + " refused: " + std::strerror(result) + "; ";
+        }
+    }
+
+    cpu_set_t actual;
+    CPU_ZERO(&actual);
+    if (pthread_getaffinity_np(handle, sizeof(actual), &actual) == 0) {
+        for (int cpu = 0; cpu < CPU_SETSIZE; cpu++) {
+            if (CPU_ISSET(cpu, &actual)) entry.cpus.push_back(cpu);
+        }
+    }
+    int policy = SCHED_OTHER;
+    sched_param param = {};
+    if (pthread_getschedparam(handle, &policy, &param) == 0) {
+        entry.policy = policyName(policy);
+        entry.priority = param.sched_priority;
+    }
+
+    if (entry.note.size() >= 2) {
+        entry.note.resize(entry.note.size() - 2);
+    }
+}
+
+std::string isolatedCpus() {
+    std::ifstream file("/sys/devices/system/cpu/isolated");
+    std::string line;
+    if (!file.is_open()) {
+        return "unknown";
+    }
+    std::getline(file, line);
+    return line.empty() ? "none" : line;
+}
+#endif
+
+// Name and place a thread, then list it (replacing an earlier entry)
+void assignThread(std::thread::id id, ThreadRoles::Role role, const std::string& name, void* handle) {
+    Entry entry;
+    entry.id = id;
+    entry.name = name;
+    entry.role = role;
+    entry.policy = "-";
+    entry.priority = 0;
+#ifdef __linux__
+    place(*static_cast<pthread_t*>(handle), ThreadRoles::getPlacement(role), entry);
+#else
+    (void)handle;
+#endif
+
+    std::lock_guard<std::mutex> lock(registryMutex);
+    entries.erase(std::remove_if(entries.begin(), entries.end(),
+                                 [&](const Entry& other) { return other.id == id; }),
+                  entries.end());
+    entries.push_back(entry);
+}
+
+} // namespace
+
+const char* ThreadRoles::roleName(Role role) {
+    return ROLE_KEYS[static_cast<int>(role)];
+}
+
+bool ThreadRoles::configure(const std::string& spec, std::string& error) {
+    Placement parsed[ROLE_COUNT];
+    bool named[ROLE_COUNT] = {};
+
+    for (const std::string& item : split(spec, "; \t\n")) {
+        if (item.empty()) {
+            continue;
+        }
+        size_t equals = item.find('=');
+        if (equals == std::string::npos) {
+            error = "Expected role=cpus[:policy[:priority]] in '" + item + "'";
+            return false;
+        }
+
+        std::vector<std::string> fields = split(item.substr(equals + 1), ":");
+        Placement placement = {{}, Policy::INHERIT, 0};
+        if (fields.size() > 3 || !parseCpus(fields[0], placement.cpus)) {
+            error = "Bad CPU list in '" + item + "'";
+            return false;
+        }
+        if (fields.size() > 1 && !parsePolicy(fields[1], placement.policy)) {
+            error = "Unknown policy '" + fields[1] + "' (other, batch, idle, fifo or rr)";
+            return false;
+        }
+        bool realtime = placement.policy == Policy::FIFO || placement.policy == Policy::RR;
+        if (realtime) {
+            placement.priority = 1;
+        }
+        if (fields.size() > 2 && (!realtime || !parseNumber(fields[2], placement.priority) ||
+                                  placement.priority < 1 || placement.priority > 99)) {
+            error = "Priority in '" + item + "' needs fifo or rr and a value of 1-99";
+            return false;
+        }
+
+        for (const std::string& key : split(item.substr(0, equals), ",")) {
+            int role = static_cast<int>(std::find(ROLE_KEYS, ROLE_KEYS + ROLE_COUNT, key) - ROLE_KEYS);
+            if (role == ROLE_COUNT) {
+                error = "Unknown thread role '" + key + "' (sim, worker, render, ingest, log or io)";
+                return false;
+            }
+            parsed[role] = placement;
+            named[role] = true;
+        }
+    }
+
+    std::lock_guard<std::mutex> lock(registryMutex);
+    for (int role = 0; role < ROLE_COUNT; role++) {
+        if (named[role]) {
+            placements[role] = parsed[role];
+        }
+    }
+    return true;
+}
+
+bool ThreadRoles::configureFromEnvironment(std::string& error) {
+    const char* spec = std::getenv("TRAFFIC_THREAD_ROLES");
+    return !spec || configure(spec, error);
+}
+
+ThreadRoles::Placement ThreadRoles::getPlacement(Role role) {
+    std::lock_guard<std::mutex> lock(registryMutex);
+    return placements[static_cast<int>(role)];
+}
+
+void ThreadRoles::assign(std::thread& thread, Role role, const std::string& name) {
+#ifdef __linux__
+    pthread_t handle = thread.native_handle();
+    assignThread(thread.get_id(), role, name, &handle);
+#else
+    assignThread(thread.get_id(), role, name, nullptr);
+#endif
+}
+
+void ThreadRoles::assignCurrent(Role role, const std::string& name) {
+#ifdef __linux__
+    pthread_t handle = pthread_self();
+    assignThread(std::this_thread::get_id(), role, name, &handle);
+#else
+    assignThread(std::this_thread::get_id(), role, name, nullptr);
+#endif
+}
+
+void ThreadRoles::release(const std::thread& thread) {
+    std::thread::id id = thread.get_id();
+    std::lock_guard<std::mutex> lock(registryMutex);
+    entries.erase(std::remove_if(entries.begin(), entries.end(),
+                                 [&](const Entry& entry) { return entry.id == id; }),
+                  entries.end());
+}
+
+std::string ThreadRoles::report() {
+    std::lock_guard<std::mutex> lock(registryMutex);
+    std::ostringstream out;
+    char line[160];
+
+    out << "Thread placement: " << std::thread::hardware_concurrency() << " CPUs online";
+#ifdef __linux__
+    out << ", isolated: " << isolatedCpus();
+#endif
+    out << "\n";
+    std::snprintf(line, sizeof(line), "  %-15s %-7s %-12s %-12s %4s  %s\n",
+                  "thread", "role", "cpus", "policy", "prio", "note");
+    out << line;
+
+    std::vector<Entry> sorted = entries;
+    std::stable_sort(sorted.begin(), sorted.end(),
+                     [](const Entry& a, const Entry& b) { return a.role < b.role; });
+    for (const Entry& entry : sorted) {
+        std::snprintf(line, sizeof(line), "  %-15s %-7s %-12s %-12s %4d  %s\n",
+                      entry.name.c_str(), roleName(entry.role), formatCpus(entry.cpus).c_str(),
+                      entry.policy.c_str(), entry.priority, entry.note.c_str());
+        out << line;
+    }
+
+    // The point of placing the simulation thread is not sharing its CPUs
+    if (!placements[static_cast<int>(Role::SIMULATION)].cpus.empty()) {
+        for (const Entry& sim : entries) {
+            if (sim.role != Role::SIMULATION) continue;
+            for (const Entry& other : entries) {
+                if (other.role != Role::LOGGING && other.role != Role::INGEST &&
+                    other.role != Role::IO && other.role != Role::RENDER) {
+                    continue;
+                }
+                std::vector<int> shared;
+                std::set_intersection(sim.cpus.begin(), sim.cpus.end(), other.cpus.begin(), other.cpus.end(),
+                                      std::back_inserter(shared));
+                if (!shared.empty()) {
+                    out << "  warning: " << sim.name << " shares CPU " << formatCpus(shared)
+                        << " with " << other.name << " (" << roleName(other.role) << ")\n";
+                }
+            }
+        }
+    }
+    return out.str();
+}
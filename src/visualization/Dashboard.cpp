@@ -0,0 +1,184 @@
+// FILE: src/visualization/Dashboard.cpp
+#include "visualization/Dashboard.h"
+#include "visualization/TerminalScreen.h"
+#include "managers/TrafficManager.h"
+#include <algorithm>
+#include <cstdio>
+
+namespace {
+
+const int LABEL_WIDTH = 16;
+
+// Light state of the displayed junction as text
+const char* stateName(TrafficLight::State state) {
+    switch (state) {
+        case TrafficLight::State::ALL_RED: return "ALL RED";
+        case TrafficLight::State::A_GREEN: return "A GREEN";
+        case TrafficLight::State::B_GREEN: return "B GREEN";
+        case TrafficLight::State::C_GREEN: return "C GREEN";
+        case TrafficLight::State::D_GREEN: return "D GREEN";
+    }
+    return "?";
+}
+
+std::string format(const char* pattern, double value) {
+    char text[64];
+    std::snprintf(text, sizeof(text), pattern, value);
+    return text;
+}
+
+} // namespace
+
+Dashboard::Dashboard(const TrafficManager& manager, uint32_t windowSeconds)
+    : manager(manager),
+      windowSeconds(std::max<uint32_t>(1, windowSeconds)) {}
+
+std::string Dashboard::formatDelay(uint64_t ms) {
+    if (ms < 10000) {
+        return format("%.2fs", static_cast<double>(ms) / 1000.0);
+    }
+    return format("%.1fs", static_cast<double>(ms) / 1000.0);
+}
+
+std::string Dashboard::formatClock(uint64_t ms) {
+    char text[32];
+    std::snprintf(text, sizeof(text), "%02llu:%02llu:%02llu.%llu",
+                  static_cast<unsigned long long>(ms / 3600000),
+                  static_cast<unsigned long long>(ms / 60000 % 60),
+                  static_cast<unsigned long long>(ms / 1000 % 60),
+                  static_cast<unsigned long long>(ms / 100 % 10));
+    return text;
+}
+
+void Dashboard::takeSnapshots() {
+    uint64_t now = manager.getSimulationTime();
+
+    // After a reset or checkpoint restore the clock can go backwards
+    if (!snapshots.empty() && snapshots.back().time > now) {
+        snapshots.clear();
+    }
+
+    if (snapshots.empty() || now >= snapshots.back().time + 1000) {
+        snapshots.push_back({now, manager.getExitedCount(), manager.getDelayHistogram()});
+    }
+    while (snapshots.size() > 1 && snapshots.front().time + windowSeconds * 1000ULL < now) {
+        snapshots.pop_front();
+    }
+}
+
+void Dashboard::draw(TerminalScreen& screen, double outputBytesPerSecond, double refreshHz) {
+    takeSnapshots();
+    screen.clear();
+
+    const int width = screen.getWidth();
+    const int height = screen.getHeight();
+    const uint64_t now = manager.getSimulationTime();
+    int row = 0;
+
+    // Title bar
+    screen.fill(0, row, width, ' ', TerminalScreen::REVERSE);
+    screen.put(1, row, "Traffic Junction Simulator", TerminalScreen::REVERSE | TerminalScreen::BOLD);
+    std::string clock = "sim " + formatClock(now);
+    screen.put(width - static_cast<int>(clock.size()) - 1, row, clock, TerminalScreen::REVERSE);
+    row += 2;
+
+    // Light state, one colored letter per road
+    TrafficLight* light = manager.getTrafficLight();
+    if (light) {
+        int x = screen.put(1, row, "Light", TerminalScreen::BOLD);
+        x = screen.put(LABEL_WIDTH, row, stateName(light->getCurrentState())) + 2;
+        for (char road : {'A', 'B', 'C', 'D'}) {
+            bool green = light->isGreen(road);
+            x = screen.put(x, row, std::string(1, road),
+                           TerminalScreen::BOLD | (green ? TerminalScreen::GREEN : TerminalScreen::RED)) + 1;
+        }
+        uint32_t next = light->getTimeToNextChange(static_cast<uint32_t>(now));
+        screen.put(x + 1, row, "next change in " + formatDelay(next), TerminalScreen::DIM);
+    }
+    row++;
+
+    Lane* priorityLane = manager.getPriorityLane();
+    bool priorityMode = priorityLane && priorityLane->getPriority() > 0;
+    screen.put(1, row, "Priority", TerminalScreen::BOLD);
+    if (priorityMode) {
+        screen.put(LABEL_WIDTH, row, priorityLane->getName() + " served first (" +
+                   std::to_string(priorityLane->getVehicleCount()) + " queued)",
+                   TerminalScreen::YELLOW | TerminalScreen::BOLD);
+    } else {
+        screen.put(LABEL_WIDTH, row, "normal", TerminalScreen::DIM);
+    }
+    row += 2;
+
+    // Lane queues of the displayed junction, bars scaled to the longest
+    const std::vector<Lane*>& lanes = manager.getJunctionLanes(manager.getNetwork().getEntryJunction());
+    int longest = 10;
+    for (Lane* lane : lanes) {
+        longest = std::max(longest, lane->getVehicleCount());
+    }
+    const int barX = LABEL_WIDTH + 8;
+    const int barWidth = std::max(0, width - barX - 1);
+
+    screen.put(1, row, "Lane", TerminalScreen::BOLD);
+    screen.put(LABEL_WIDTH, row, "Queue", TerminalScreen::BOLD);
+    row++;
+    for (Lane* lane : lanes) {
+        if (row >= height - 6) break;
+
+        int count = lane->getVehicleCount();
+        uint8_t style = TerminalScreen::CYAN;
+        if (lane->getLaneNumber() == 1) {
+            style = TerminalScreen::DIM;
+        } else if (priorityMode && lane == priorityLane) {
+            style = TerminalScreen::YELLOW | TerminalScreen::BOLD;
+        } else if (light && light->isGreen(lane->getLaneId())) {
+            style = TerminalScreen::GREEN;
+        }
+
+        screen.put(1, row, lane->getName(), style);
+        std::string number = std::to_string(count);
+        screen.put(LABEL_WIDTH + 5 - static_cast<int>(number.size()), row, number);
+        int bar = static_cast<int>(static_cast<int64_t>(count) * barWidth / longest);
+        screen.fill(barX, row, bar, '#', style);
+        row++;
+    }
+    row++;
+
+    // Throughput and delays over the window and since start
+    const Snapshot& oldest = snapshots.front();
+    double windowMs = static_cast<double>(now - oldest.time);
+    uint64_t windowExited = manager.getExitedCount() - std::min(manager.getExitedCount(), oldest.exited);
+    std::string windowLabel = "last " + std::to_string(static_cast<int>(windowMs / 1000.0 + 0.5)) + "s";
+
+    screen.put(1, row, "Throughput", TerminalScreen::BOLD);
+    std::string throughput = windowMs > 0.0 ? format("%.1f veh/min", windowExited * 60000.0 / windowMs) : "-";
+    int x = screen.put(LABEL_WIDTH, row, throughput + " (" + windowLabel + ")");
+    screen.put(x + 3, row, "exited " + std::to_string(manager.getExitedCount()) +
+               "  in network " + std::to_string(manager.getVehicleCount()), TerminalScreen::DIM);
+    row++;
+
+    LatencyHistogram window = manager.getDelayHistogram();
+    window.subtract(oldest.delays);
+    const LatencyHistogram& total = manager.getDelayHistogram();
+    auto drawDelays = [&](const std::string& label, const LatencyHistogram& delays) {
+        screen.put(1, row, label, TerminalScreen::BOLD);
+        if (delays.getCount() == 0) {
+            screen.put(LABEL_WIDTH, row, "no vehicles", TerminalScreen::DIM);
+        } else {
+            int col = LABEL_WIDTH;
+            col = screen.put(col, row, "p50 " + formatDelay(delays.getPercentile(0.50))) + 2;
+            col = screen.put(col, row, "p90 " + formatDelay(delays.getPercentile(0.90))) + 2;
+            col = screen.put(col, row, "p99 " + formatDelay(delays.getPercentile(0.99)),
+                             TerminalScreen::YELLOW) + 2;
+            col = screen.put(col, row, "max " + formatDelay(delays.getMax())) + 2;
+            screen.put(col, row, "n=" + std::to_string(delays.getCount()), TerminalScreen::DIM);
+        }
+        row++;
+    };
+    drawDelays("Delay " + windowLabel, window);
+    drawDelays("Delay total", total);
+
+    // Footer
+    std::string footer = format("output %.1f KB/s", outputBytesPerSecond / 1024.0) +
+                         format("   refresh %.0f Hz", refreshHz) + "   Ctrl-C quits";
+    screen.put(1, height - 1, footer, TerminalScreen::DIM);
+}
@@ -0,0 +1,126 @@
+// FILE: src/visualization/NullRenderBackend.cpp
+#include "visualization/NullRenderBackend.h"
+
+NullRenderBackend::NullRenderBackend(uint32_t frameMs)
+    : frameMs(frameMs),
+      ticks(0),
+      drawColor(0x000000FF),
+      blendMode(SDL_BLENDMODE_NONE) {}
+
+NullRenderBackend::Texture* NullRenderBackend::lookup(TextureId texture) {
+    if (texture == 0 || texture > textures.size() || !textures[texture - 1].live) {
+        return nullptr;
+    }
+    return &textures[texture - 1];
+}
+
+void NullRenderBackend::setDrawColor(Uint8 r, Uint8 g, Uint8 b, Uint8 a) {
+    change(drawColor, (static_cast<uint32_t>(r) << 24) | (static_cast<uint32_t>(g) << 16) |
+                      (static_cast<uint32_t>(b) << 8) | a);
+}
+
+void NullRenderBackend::setDrawBlendMode(SDL_BlendMode mode) {
+    change(blendMode, mode);
+}
+
+void NullRenderBackend::clear() {
+    stats.clears++;
+}
+
+void NullRenderBackend::drawPoint(float, float) {
+    stats.points++;
+    stats.vertexBytes += 2 * sizeof(float);
+}
+
+void NullRenderBackend::drawLine(float, float, float, float) {
+    stats.lines++;
+    stats.vertexBytes += 4 * sizeof(float);
+}
+
+void NullRenderBackend::drawRect(const SDL_FRect*) {
+    stats.rects++;
+    stats.vertexBytes += sizeof(SDL_FRect);
+}
+
+void NullRenderBackend::fillRect(const SDL_FRect*) {
+    stats.fillRects++;
+    stats.vertexBytes += sizeof(SDL_FRect);
+}
+
+void NullRenderBackend::drawGeometry(TextureId, const SDL_Vertex*, int numVertices,
+                                     const int* indices, int numIndices) {
+    stats.geometryCalls++;
+    stats.triangles += static_cast<uint64_t>(indices ? numIndices : numVertices) / 3;
+    stats.vertexBytes += static_cast<uint64_t>(numVertices) * sizeof(SDL_Vertex);
+    if (indices) {
+        stats.vertexBytes += static_cast<uint64_t>(numIndices) * sizeof(int);
+    }
+}
+
+RenderBackend::TextureId NullRenderBackend::createTexture(int width, int height, const void*, int) {
+    if (width <= 0 || height <= 0) {
+        return 0;
+    }
+    textures.push_back({width, height, SDL_BLENDMODE_NONE, SDL_SCALEMODE_LINEAR, 0xFFFFFF, true});
+    stats.textureBytes += static_cast<uint64_t>(width) * height * 4;
+    return static_cast<TextureId>(textures.size());
+}
+
+void NullRenderBackend::destroyTexture(TextureId texture) {
+    Texture* entry = lookup(texture);
+    if (entry) {
+        entry->live = false;
+    }
+}
+
+void NullRenderBackend::setTextureBlendMode(TextureId texture, SDL_BlendMode mode) {
+    Texture* entry = lookup(texture);
+    if (entry) {
+        change(entry->blendMode, mode);
+    }
+}
+
+void NullRenderBackend::setTextureScaleMode(TextureId texture, SDL_ScaleMode mode) {
+    Texture* entry = lookup(texture);
+    if (entry) {
+        change(entry->scaleMode, mode);
+    }
+}
+
+void NullRenderBackend::setTextureColorMod(TextureId texture, Uint8 r, Uint8 g, Uint8 b) {
+    Texture* entry = lookup(texture);
+    if (entry) {
+        change(entry->colorMod, (static_cast<uint32_t>(r) << 16) | (static_cast<uint32_t>(g) << 8) | b);
+    }
+}
+
+bool NullRenderBackend::getTextureSize(TextureId texture, float* width, float* height) {
+    Texture* entry = lookup(texture);
+    if (!entry) {
+        return false;
+    }
+    if (width) *width = static_cast<float>(entry->width);
+    if (height) *height = static_cast<float>(entry->height);
+    return true;
+}
+
+void NullRenderBackend::drawTexture(TextureId, const SDL_FRect*, const SDL_FRect*) {
+    stats.textureDraws++;
+    stats.vertexBytes += 2 * sizeof(SDL_FRect);
+}
+
+void NullRenderBackend::drawTexture9Grid(TextureId, const SDL_FRect*, float, float, float, float,
+                                         float, const SDL_FRect*) {
+    // Nine quads once SDL splits it up
+    stats.textureDraws++;
+    stats.vertexBytes += 18 * sizeof(SDL_FRect);
+}
+
+void NullRenderBackend::present() {
+    stats.frames++;
+    ticks += frameMs;
+}
+
+uint64_t NullRenderBackend::getTicks() {
+    return ticks;
+}
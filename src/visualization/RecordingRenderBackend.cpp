@@ -0,0 +1,145 @@
+// FILE: src/visualization/RecordingRenderBackend.cpp
+#include "visualization/RecordingRenderBackend.h"
+#include <cstdio>
+
+RecordingRenderBackend::RecordingRenderBackend(std::ostream& out, uint32_t frameMs)
+    : NullRenderBackend(frameMs),
+      out(out) {}
+
+void RecordingRenderBackend::write(const char* name, std::initializer_list<double> values) {
+    out << name;
+    char number[32];
+    for (double value : values) {
+        std::snprintf(number, sizeof(number), " %g", value);
+        out << number;
+    }
+    out << '\n';
+}
+
+std::string RecordingRenderBackend::rectText(const SDL_FRect* rect) {
+    if (!rect) {
+        return "all";
+    }
+    char text[96];
+    std::snprintf(text, sizeof(text), "%g %g %g %g", rect->x, rect->y, rect->w, rect->h);
+    return text;
+}
+
+void RecordingRenderBackend::setDrawColor(Uint8 r, Uint8 g, Uint8 b, Uint8 a) {
+    NullRenderBackend::setDrawColor(r, g, b, a);
+    write("color", {static_cast<double>(r), static_cast<double>(g),
+                    static_cast<double>(b), static_cast<double>(a)});
+}
+
+void RecordingRenderBackend::setDrawBlendMode(SDL_BlendMode mode) {
+    NullRenderBackend::setDrawBlendMode(mode);
+    write("blend", {static_cast<double>(mode)});
+}
+
+void RecordingRenderBackend::clear() {
+    NullRenderBackend::clear();
+    write("clear", {});
+}
+
+void RecordingRenderBackend::drawPoint(float x, float y) {
+    NullRenderBackend::drawPoint(x, y);
+    write("point", {x, y});
+}
+
+void RecordingRenderBackend::drawLine(float x1, float y1, float x2, float y2) {
+    NullRenderBackend::drawLine(x1, y1, x2, y2);
+    write("line", {x1, y1, x2, y2});
+}
+
+void RecordingRenderBackend::drawRect(const SDL_FRect* rect) {
+    NullRenderBackend::drawRect(rect);
+    out << "rect " << rectText(rect) << '\n';
+}
+
+void RecordingRenderBackend::fillRect(const SDL_FRect* rect) {
+    NullRenderBackend::fillRect(rect);
+    out << "fill " << rectText(rect) << '\n';
+}
+
+void RecordingRenderBackend::drawGeometry(TextureId texture, const SDL_Vertex* vertices, int numVertices,
+                                          const int* indices, int numIndices) {
+    NullRenderBackend::drawGeometry(texture, vertices, numVertices, indices, numIndices);
+    write("geometry", {static_cast<double>(texture), static_cast<double>(numVertices),
+                       static_cast<double>(indices ? numIndices : 0)});
+    for (int i = 0; i < numVertices; i++) {
+        // Texture coordinates mean nothing (and are often unset) without a texture
+        const SDL_Vertex& v = vertices[i];
+        if (texture) {
+            write("  vertex", {v.position.x, v.position.y, v.color.r, v.color.g, v.color.b, v.color.a,
+                               v.tex_coord.x, v.tex_coord.y});
+        } else {
+            write("  vertex", {v.position.x, v.position.y, v.color.r, v.color.g, v.color.b, v.color.a});
+        }
+    }
+    if (indices) {
+        out << "  indices";
+        for (int i = 0; i < numIndices; i++) {
+            out << ' ' << indices[i];
+        }
+        out << '\n';
+    }
+}
+
+RenderBackend::TextureId RecordingRenderBackend::createTexture(int width, int height, const void* pixels, int pitch) {
+    TextureId texture = NullRenderBackend::createTexture(width, height, pixels, pitch);
+
+    // FNV-1a over the visible bytes of each row
+    uint64_t hash = 1469598103934665603ULL;
+    const unsigned char* rows = static_cast<const unsigned char*>(pixels);
+    for (int y = 0; rows && y < height; y++) {
+        for (int x = 0; x < width * 4; x++) {
+            hash = (hash ^ rows[static_cast<size_t>(y) * pitch + x]) * 1099511628211ULL;
+        }
+    }
+
+    char text[64];
+    std::snprintf(text, sizeof(text), " %016llx", static_cast<unsigned long long>(hash));
+    out << "texture " << texture << ' ' << width << ' ' << height << text << '\n';
+    return texture;
+}
+
+void RecordingRenderBackend::destroyTexture(TextureId texture) {
+    NullRenderBackend::destroyTexture(texture);
+    write("destroy", {static_cast<double>(texture)});
+}
+
+void RecordingRenderBackend::setTextureBlendMode(TextureId texture, SDL_BlendMode mode) {
+    NullRenderBackend::setTextureBlendMode(texture, mode);
+    write("texture-blend", {static_cast<double>(texture), static_cast<double>(mode)});
+}
+
+void RecordingRenderBackend::setTextureScaleMode(TextureId texture, SDL_ScaleMode mode) {
+    NullRenderBackend::setTextureScaleMode(texture, mode);
+    write("texture-scale", {static_cast<double>(texture), static_cast<double>(mode)});
+}
+
+void RecordingRenderBackend::setTextureColorMod(TextureId texture, Uint8 r, Uint8 g, Uint8 b) {
+    NullRenderBackend::setTextureColorMod(texture, r, g, b);
+    write("texture-color", {static_cast<double>(texture), static_cast<double>(r),
+                            static_cast<double>(g), static_cast<double>(b)});
+}
+
+void RecordingRenderBackend::drawTexture(TextureId texture, const SDL_FRect* source, const SDL_FRect* target) {
+    NullRenderBackend::drawTexture(texture, source, target);
+    out << "draw-texture " << texture << ' ' << rectText(source) << " -> " << rectText(target) << '\n';
+}
+
+void RecordingRenderBackend::drawTexture9Grid(TextureId texture, const SDL_FRect* source,
+                                              float left, float right, float top, float bottom,
+                                              float scale, const SDL_FRect* target) {
+    NullRenderBackend::drawTexture9Grid(texture, source, left, right, top, bottom, scale, target);
+    char borders[96];
+    std::snprintf(borders, sizeof(borders), "%g %g %g %g %g", left, right, top, bottom, scale);
+    out << "draw-9grid " << texture << ' ' << rectText(source) << ' ' << borders
+        << " -> " << rectText(target) << '\n';
+}
+
+void RecordingRenderBackend::present() {
+    NullRenderBackend::present();
+    out << "frame " << getStats().frames << '\n';
+}
@@ -1,5 +1,7 @@
 // FILE: src/visualization/Renderer.cpp
 #include "visualization/Renderer.h"
+#include "visualization/SdlRenderBackend.h"
+#include "core/GlowTextures.h"
 #include "core/Lane.h"
 #include "core/Vehicle.h"
 #include "core/TrafficLight.h"
@@ -16,8 +18,9 @@
 Renderer::Renderer()
     : window(nullptr),
       renderer(nullptr),
-      carTexture(nullptr),
-      surface(nullptr),
+      backend(nullptr),
+      ownsBackend(false),
+      carTexture(0),
       active(false),
       showDebugOverlay(true),
       frameRateLimit(60),
@@ -53,6 +56,8 @@ bool Renderer::initialize(int width, int height, const std::string& title) {
         DebugLogger::log("Failed to create renderer: " + std::string(SDL_GetError()), DebugLogger::LogLevel::ERROR);
         return false;
     }
+    backend = new SdlRenderBackend(renderer);
+    ownsBackend = true;
 
     // Load textures
     if (!loadTextures()) {
@@ -66,27 +71,36 @@ bool Renderer::initialize(int width, int height, const std::string& title) {
     return true;
 }
 
-bool Renderer::loadTextures() {
-    // Create a simple surface directly with a solid color to avoid SDL_MapRGB issues
-    surface = SDL_CreateSurface(20, 10, SDL_PIXELFORMAT_RGBA8888);
-    if (!surface) {
-        DebugLogger::log("Failed to create surface: " + std::string(SDL_GetError()), DebugLogger::LogLevel::ERROR);
+bool Renderer::initializeHeadless(int width, int height, RenderBackend* target) {
+    windowWidth = width;
+    windowHeight = height;
+    backend = target;
+    ownsBackend = false;
+
+    if (!loadTextures()) {
+        DebugLogger::log("Failed to load textures", DebugLogger::LogLevel::ERROR);
         return false;
     }
 
-    // Fill with blue color using a simpler approach
-    // Create a color value manually
-    Uint32 blueColor = 0x0000FFFF; // RGBA format: blue with full alpha
-
-    // Fill the entire surface with this color
-    SDL_FillSurfaceRect(surface, NULL, blueColor);
+    active = true;
+    return true;
+}
 
-    carTexture = SDL_CreateTextureFromSurface(renderer, surface);
-    SDL_DestroySurface(surface);
-    surface = nullptr;
+bool Renderer::loadTextures() {
+    // Solid blue car texture, RGBA byte order
+    const int CAR_WIDTH = 20;
+    const int CAR_HEIGHT = 10;
+    std::vector<Uint8> pixels(CAR_WIDTH * CAR_HEIGHT * 4);
+    for (size_t i = 0; i < pixels.size(); i += 4) {
+        pixels[i + 0] = 0;
+        pixels[i + 1] = 0;
+        pixels[i + 2] = 255;
+        pixels[i + 3] = 255;
+    }
 
+    carTexture = backend->createTexture(CAR_WIDTH, CAR_HEIGHT, pixels.data(), CAR_WIDTH * 4);
     if (!carTexture) {
-        DebugLogger::log("Failed to create car texture: " + std::string(SDL_GetError()), DebugLogger::LogLevel::ERROR);
+        DebugLogger::log("Failed to create car texture", DebugLogger::LogLevel::ERROR);
         return false;
     }
 
@@ -160,13 +174,13 @@ bool Renderer::processEvents() {
 }
 
 void Renderer::renderFrame() {
-    if (!active || !renderer || !trafficManager) {
+    if (!active || !backend || !trafficManager) {
         return;
     }
 
     // Clear screen
-    SDL_SetRenderDrawColor(renderer, 25, 25, 35, 255); // Dark blue-ish background
-    SDL_RenderClear(renderer);
+    backend->setDrawColor(25, 25, 35, 255); // Dark blue-ish background
+    backend->clear();
 
     // Draw roads and lanes
     drawRoadsAndLanes();
@@ -186,10 +200,10 @@ void Renderer::renderFrame() {
     }
 
     // Present render
-    SDL_RenderPresent(renderer);
+    backend->present();
 
     // Update frame time
-    lastFrameTime = SDL_GetTicks();
+    lastFrameTime = static_cast<uint32_t>(backend->getTicks());
 }
 
 void Renderer::drawRoadsAndLanes() {
@@ -200,43 +214,43 @@ void Renderer::drawRoadsAndLanes() {
 
     // ---------- STEP 1: BACKGROUND ----------
     // Draw dark background for the entire window
-    SDL_SetRenderDrawColor(renderer, 25, 25, 35, 255); // Dark blue-ish background
-    SDL_RenderClear(renderer);
+    backend->setDrawColor(25, 25, 35, 255); // Dark blue-ish background
+    backend->clear();
 
     // Draw city blocks in corners (buildings)
     drawCityBlocks();
 
     // ---------- STEP 2: DRAW BASE ROADS ----------
     // Draw horizontal road (dark asphalt)
-    SDL_SetRenderDrawColor(renderer, 40, 40, 45, 255); // Darker asphalt
+    backend->setDrawColor(40, 40, 45, 255); // Darker asphalt
     SDL_FRect horizontalRoad = {
         0, static_cast<float>(CENTER_Y - ROAD_WIDTH/2),
         static_cast<float>(windowWidth), static_cast<float>(ROAD_WIDTH)
     };
-    SDL_RenderFillRect(renderer, &horizontalRoad);
+    backend->fillRect(&horizontalRoad);
 
     // Draw vertical road (dark asphalt)
     SDL_FRect verticalRoad = {
         static_cast<float>(CENTER_X - ROAD_WIDTH/2), 0,
         static_cast<float>(ROAD_WIDTH), static_cast<float>(windowHeight)
     };
-    SDL_RenderFillRect(renderer, &verticalRoad);
+    backend->fillRect(&verticalRoad);
 
     // Draw intersection
-    SDL_SetRenderDrawColor(renderer, 35, 35, 40, 255);
+    backend->setDrawColor(35, 35, 40, 255);
     SDL_FRect intersection = {
         static_cast<float>(CENTER_X - ROAD_WIDTH/2),
         static_cast<float>(CENTER_Y - ROAD_WIDTH/2),
         static_cast<float>(ROAD_WIDTH),
         static_cast<float>(ROAD_WIDTH)
     };
-    SDL_RenderFillRect(renderer, &intersection);
+    backend->fillRect(&intersection);
 
     // Draw road texture (subtle pattern)
     drawRoadTexture();
 
     // ---------- STEP 3: DRAW LANES WITH GLOWING MARKERS ----------
-    SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_BLEND);
+    backend->setDrawBlendMode(SDL_BLENDMODE_BLEND);
 
     // Draw lane dividers with glow effect
     drawLaneDividers();
@@ -250,7 +264,7 @@ void Renderer::drawRoadsAndLanes() {
     // ---------- STEP 5: DRAW STOP LINES ----------
     drawStopLines();
 
-    SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_NONE);
+    backend->setDrawBlendMode(SDL_BLENDMODE_NONE);
 }
 
 void Renderer::drawCityBlocks() {
@@ -287,12 +301,12 @@ void Renderer::drawCityBlocks() {
 
             // Draw building
             SDL_Color color = buildingColors[colorDist(rng)];
-            SDL_SetRenderDrawColor(renderer, color.r, color.g, color.b, color.a);
+            backend->setDrawColor(color.r, color.g, color.b, color.a);
             SDL_FRect building = {
                 static_cast<float>(x), static_cast<float>(y),
                 static_cast<float>(width), static_cast<float>(height)
             };
-            SDL_RenderFillRect(renderer, &building);
+            backend->fillRect(&building);
 
             // Draw subtle window lights (some lit, some not)
             drawBuildingWindows(x, y, width, height);
@@ -312,12 +326,12 @@ void Renderer::drawCityBlocks() {
                 height = CENTER_Y - ROAD_WIDTH/2 - 20 - y;
 
             SDL_Color color = buildingColors[colorDist(rng)];
-            SDL_SetRenderDrawColor(renderer, color.r, color.g, color.b, color.a);
+            backend->setDrawColor(color.r, color.g, color.b, color.a);
             SDL_FRect building = {
                 static_cast<float>(x), static_cast<float>(y),
                 static_cast<float>(width), static_cast<float>(height)
             };
-            SDL_RenderFillRect(renderer, &building);
+            backend->fillRect(&building);
 
             drawBuildingWindows(x, y, width, height);
         }
@@ -335,12 +349,12 @@ void Renderer::drawCityBlocks() {
                 height = windowHeight - 20 - y;
 
             SDL_Color color = buildingColors[colorDist(rng)];
-            SDL_SetRenderDrawColor(renderer, color.r, color.g, color.b, color.a);
+            backend->setDrawColor(color.r, color.g, color.b, color.a);
             SDL_FRect building = {
                 static_cast<float>(x), static_cast<float>(y),
                 static_cast<float>(width), static_cast<float>(height)
             };
-            SDL_RenderFillRect(renderer, &building);
+            backend->fillRect(&building);
 
             drawBuildingWindows(x, y, width, height);
         }
@@ -358,12 +372,12 @@ void Renderer::drawCityBlocks() {
                 height = windowHeight - 20 - y;
 
             SDL_Color color = buildingColors[colorDist(rng)];
-            SDL_SetRenderDrawColor(renderer, color.r, color.g, color.b, color.a);
+            backend->setDrawColor(color.r, color.g, color.b, color.a);
             SDL_FRect building = {
                 static_cast<float>(x), static_cast<float>(y),
                 static_cast<float>(width), static_cast<float>(height)
             };
-            SDL_RenderFillRect(renderer, &building);
+            backend->fillRect(&building);
 
             drawBuildingWindows(x, y, width, height);
         }
@@ -381,17 +395,17 @@ void Renderer::drawBuildingWindows(int buildingX, int buildingY, int buildingWid
         for (int y = buildingY + windowMargin; y < buildingY + buildingHeight - windowMargin; y += windowMargin) {
             if (lightDist(rng) < 3) { // 30% chance of lit window
                 // Lit window (yellow-ish glow)
-                SDL_SetRenderDrawColor(renderer, 255, 240, 150, 200);
+                backend->setDrawColor(255, 240, 150, 200);
             } else {
                 // Dark window
-                SDL_SetRenderDrawColor(renderer, 60, 60, 75, 150);
+                backend->setDrawColor(60, 60, 75, 150);
             }
 
             SDL_FRect window = {
                 static_cast<float>(x), static_cast<float>(y),
                 static_cast<float>(windowSize), static_cast<float>(windowSize)
             };
-            SDL_RenderFillRect(renderer, &window);
+            backend->fillRect(&window);
         }
     }
 }
@@ -402,7 +416,7 @@ void Renderer::drawRoadTexture() {
     const int ROAD_WIDTH = Constants::ROAD_WIDTH;
 
     // Draw subtle dark pattern for road texture
-    SDL_SetRenderDrawColor(renderer, 35, 35, 40, 30); // Very subtle dark pattern
+    backend->setDrawColor(35, 35, 40, 30); // Very subtle dark pattern
 
     // Horizontal road texture
     for (int x = 0; x < windowWidth; x += 10) {
@@ -412,7 +426,7 @@ void Renderer::drawRoadTexture() {
                     static_cast<float>(x), static_cast<float>(y),
                     2.0f, 2.0f
                 };
-                SDL_RenderFillRect(renderer, &speck);
+                backend->fillRect(&speck);
             }
         }
     }
@@ -425,7 +439,7 @@ void Renderer::drawRoadTexture() {
                     static_cast<float>(x), static_cast<float>(y),
                     2.0f, 2.0f
                 };
-                SDL_RenderFillRect(renderer, &speck);
+                backend->fillRect(&speck);
             }
         }
     }
@@ -444,15 +458,15 @@ void Renderer::drawLaneDividers() {
         if (i == 1) {
             // Center yellow double line with glow effect
             // First, draw a subtle glow
-            SDL_SetRenderDrawColor(renderer, 255, 220, 100, 30); // Yellow glow
+            backend->setDrawColor(255, 220, 100, 30); // Yellow glow
             SDL_FRect yellowGlow = {
                 0, y - 4.0f,
                 static_cast<float>(windowWidth), 8.0f
             };
-            SDL_RenderFillRect(renderer, &yellowGlow);
+            backend->fillRect(&yellowGlow);
 
             // Then draw the actual double yellow line
-            SDL_SetRenderDrawColor(renderer, 255, 220, 0, 255); // Bright yellow
+            backend->setDrawColor(255, 220, 0, 255); // Bright yellow
             SDL_FRect yellowLine1 = {
                 0, y - 2.0f,
                 static_cast<float>(windowWidth), 1.5f
@@ -461,8 +475,8 @@ void Renderer::drawLaneDividers() {
                 0, y + 0.5f,
                 static_cast<float>(windowWidth), 1.5f
             };
-            SDL_RenderFillRect(renderer, &yellowLine1);
-            SDL_RenderFillRect(renderer, &yellowLine2);
+            backend->fillRect(&yellowLine1);
+            backend->fillRect(&yellowLine2);
         } else {
             // White dashed lines with subtle glow
             for (int x = 0; x < windowWidth; x += 40) {
@@ -471,20 +485,20 @@ void Renderer::drawLaneDividers() {
                     continue;
 
                 // Glow
-                SDL_SetRenderDrawColor(renderer, 220, 220, 255, 30); // White-blue glow
+                backend->setDrawColor(220, 220, 255, 30); // White-blue glow
                 SDL_FRect whiteGlow = {
                     static_cast<float>(x), y - 2.0f,
                     25.0f, 4.0f
                 };
-                SDL_RenderFillRect(renderer, &whiteGlow);
+                backend->fillRect(&whiteGlow);
 
                 // Actual line
-                SDL_SetRenderDrawColor(renderer, 220, 220, 255, 255); // Bright white-blue
+                backend->setDrawColor(220, 220, 255, 255); // Bright white-blue
                 SDL_FRect whiteLine = {
                     static_cast<float>(x), y - 0.75f,
                     25.0f, 1.5f
                 };
-                SDL_RenderFillRect(renderer, &whiteLine);
+                backend->fillRect(&whiteLine);
             }
         }
     }
@@ -495,15 +509,15 @@ void Renderer::drawLaneDividers() {
 
         if (i == 1) {
             // Center yellow double line with glow
-            SDL_SetRenderDrawColor(renderer, 255, 220, 100, 30); // Yellow glow
+            backend->setDrawColor(255, 220, 100, 30); // Yellow glow
             SDL_FRect yellowGlow = {
                 x - 4.0f, 0,
                 8.0f, static_cast<float>(windowHeight)
             };
-            SDL_RenderFillRect(renderer, &yellowGlow);
+            backend->fillRect(&yellowGlow);
 
             // Actual yellow lines
-            SDL_SetRenderDrawColor(renderer, 255, 220, 0, 255); // Bright yellow
+            backend->setDrawColor(255, 220, 0, 255); // Bright yellow
             SDL_FRect yellowLine1 = {
                 x - 2.0f, 0,
                 1.5f, static_cast<float>(windowHeight)
@@ -512,8 +526,8 @@ void Renderer::drawLaneDividers() {
                 x + 0.5f, 0,
                 1.5f, static_cast<float>(windowHeight)
             };
-            SDL_RenderFillRect(renderer, &yellowLine1);
-            SDL_RenderFillRect(renderer, &yellowLine2);
+            backend->fillRect(&yellowLine1);
+            backend->fillRect(&yellowLine2);
         } else {
             // White dashed lines with subtle glow
             for (int y = 0; y < windowHeight; y += 40) {
@@ -522,20 +536,20 @@ void Renderer::drawLaneDividers() {
                     continue;
 
                 // Glow
-                SDL_SetRenderDrawColor(renderer, 220, 220, 255, 30); // White-blue glow
+                backend->setDrawColor(220, 220, 255, 30); // White-blue glow
                 SDL_FRect whiteGlow = {
                     x - 2.0f, static_cast<float>(y),
                     4.0f, 25.0f
                 };
-                SDL_RenderFillRect(renderer, &whiteGlow);
+                backend->fillRect(&whiteGlow);
 
                 // Actual line
-                SDL_SetRenderDrawColor(renderer, 220, 220, 255, 255); // Bright white-blue
+                backend->setDrawColor(220, 220, 255, 255); // Bright white-blue
                 SDL_FRect whiteLine = {
                     x - 0.75f, static_cast<float>(y),
                     1.5f, 25.0f
                 };
-                SDL_RenderFillRect(renderer, &whiteLine);
+                backend->fillRect(&whiteLine);
             }
         }
     }
@@ -615,58 +629,13 @@ void Renderer::drawLaneMarker(int x, int y, const std::string& label, SDL_Color
     const int MARKER_HEIGHT = isVertical ? 20 : 30;
 
     // Draw hexagonal background
-    const int HEX_SIDES = 6;
     const float HEX_RADIUS = isVertical ? MARKER_WIDTH/2.0f + 2.0f : MARKER_HEIGHT/2.0f + 2.0f;
 
-    // Create polygon points for hexagon
-    SDL_FPoint hexPoints[HEX_SIDES + 1];
-    for (int i = 0; i < HEX_SIDES; i++) {
-        float angle = 2.0f * M_PI * static_cast<float>(i) / static_cast<float>(HEX_SIDES) - M_PI/2.0f;
-        hexPoints[i].x = static_cast<float>(x) + HEX_RADIUS * cosf(angle);
-        hexPoints[i].y = static_cast<float>(y) + HEX_RADIUS * sinf(angle);
-    }
-    // Close the polygon
-    hexPoints[HEX_SIDES] = hexPoints[0];
-
-    // Draw hexagon with glow effect
-    SDL_SetRenderDrawColor(renderer, color.r, color.g, color.b, 50); // Transparent glow
-    for (int i = 1; i <= 5; i++) {
-        float scale = 1.0f + static_cast<float>(i) * 0.08f;
-        SDL_FPoint scaledPoints[HEX_SIDES + 1];
-
-        for (int j = 0; j < HEX_SIDES + 1; j++) {
-            scaledPoints[j].x = static_cast<float>(x) + (hexPoints[j].x - static_cast<float>(x)) * scale;
-            scaledPoints[j].y = static_cast<float>(y) + (hexPoints[j].y - static_cast<float>(y)) * scale;
-        }
-
-        for (int j = 0; j < HEX_SIDES; j++) {
-            SDL_RenderLine(renderer,
-                          scaledPoints[j].x, scaledPoints[j].y,
-                          scaledPoints[j+1].x, scaledPoints[j+1].y);
-        }
-    }
-
-    // Fill hexagon background
-    SDL_SetRenderDrawColor(renderer, color.r/2, color.g/2, color.b/2, 200);
-    for (int i = 0; i < HEX_SIDES - 2; i++) {
-        SDL_RenderLine(renderer, hexPoints[0].x, hexPoints[0].y,
-                      hexPoints[i+1].x, hexPoints[i+1].y);
-        SDL_RenderLine(renderer, hexPoints[0].x, hexPoints[0].y,
-                      hexPoints[i+2].x, hexPoints[i+2].y);
-        SDL_RenderLine(renderer, hexPoints[i+1].x, hexPoints[i+1].y,
-                      hexPoints[i+2].x, hexPoints[i+2].y);
-    }
-
-    // Draw hexagon border
-    SDL_SetRenderDrawColor(renderer, color.r, color.g, color.b, 255);
-    for (int i = 0; i < HEX_SIDES; i++) {
-        SDL_RenderLine(renderer,
-                      hexPoints[i].x, hexPoints[i].y,
-                      hexPoints[i+1].x, hexPoints[i+1].y);
-    }
+    // Glow, half-bright fill and border in one baked texture
+    GlowTextures::forBackend(backend)->drawHexagon(x, y, HEX_RADIUS, color);
 
     // Draw label using simplified character drawing
-    SDL_SetRenderDrawColor(renderer, 255, 255, 255, 255);
+    backend->setDrawColor(255, 255, 255, 255);
 
     // Draw first character (A, B, C, or D)
     float charX = static_cast<float>(x) - 5.0f;
@@ -675,34 +644,34 @@ void Renderer::drawLaneMarker(int x, int y, const std::string& label, SDL_Color
     char firstChar = label[0];
     switch (firstChar) {
         case 'A':
-            SDL_RenderLine(renderer, charX, charY+8, charX+5, charY); // Left diagonal
-            SDL_RenderLine(renderer, charX+5, charY, charX+10, charY+8); // Right diagonal
-            SDL_RenderLine(renderer, charX+2, charY+5, charX+8, charY+5); // Middle bar
+            backend->drawLine(charX, charY+8, charX+5, charY); // Left diagonal
+            backend->drawLine(charX+5, charY, charX+10, charY+8); // Right diagonal
+            backend->drawLine(charX+2, charY+5, charX+8, charY+5); // Middle bar
             break;
         case 'B':
-            SDL_RenderLine(renderer, charX, charY, charX, charY+8); // Vertical
-            SDL_RenderLine(renderer, charX, charY, charX+7, charY); // Top
-            SDL_RenderLine(renderer, charX+7, charY, charX+9, charY+2); // Top curve
-            SDL_RenderLine(renderer, charX+9, charY+2, charX+7, charY+4); // Middle top
-            SDL_RenderLine(renderer, charX, charY+4, charX+7, charY+4); // Middle
-            SDL_RenderLine(renderer, charX+7, charY+4, charX+9, charY+6); // Middle bottom
-            SDL_RenderLine(renderer, charX+9, charY+6, charX+7, charY+8); // Bottom curve
-            SDL_RenderLine(renderer, charX+7, charY+8, charX, charY+8); // Bottom
+            backend->drawLine(charX, charY, charX, charY+8); // Vertical
+            backend->drawLine(charX, charY, charX+7, charY); // Top
+            backend->drawLine(charX+7, charY, charX+9, charY+2); // Top curve
+            backend->drawLine(charX+9, charY+2, charX+7, charY+4); // Middle top
+            backend->drawLine(charX, charY+4, charX+7, charY+4); // Middle
+            backend->drawLine(charX+7, charY+4, charX+9, charY+6); // Middle bottom
+            backend->drawLine(charX+9, charY+6, charX+7, charY+8); // Bottom curve
+            backend->drawLine(charX+7, charY+8, charX, charY+8); // Bottom
             break;
         case 'C':
-            SDL_RenderLine(renderer, charX+9, charY, charX+2, charY); // Top
-            SDL_RenderLine(renderer, charX+2, charY, charX, charY+2); // Top curve
-            SDL_RenderLine(renderer, charX, charY+2, charX, charY+6); // Left
-            SDL_RenderLine(renderer, charX, charY+6, charX+2, charY+8); // Bottom curve
-            SDL_RenderLine(renderer, charX+2, charY+8, charX+9, charY+8); // Bottom
+            backend->drawLine(charX+9, charY, charX+2, charY); // Top
+            backend->drawLine(charX+2, charY, charX, charY+2); // Top curve
+            backend->drawLine(charX, charY+2, charX, charY+6); // Left
+            backend->drawLine(charX, charY+6, charX+2, charY+8); // Bottom curve
+            backend->drawLine(charX+2, charY+8, charX+9, charY+8); // Bottom
             break;
         case 'D':
-            SDL_RenderLine(renderer, charX, charY, charX, charY+8); // Vertical
-            SDL_RenderLine(renderer, charX, charY, charX+7, charY); // Top
-            SDL_RenderLine(renderer, charX+7, charY, charX+9, charY+2); // Top curve
-            SDL_RenderLine(renderer, charX+9, charY+2, charX+9, charY+6); // Right
-            SDL_RenderLine(renderer, charX+9, charY+6, charX+7, charY+8); // Bottom curve
-            SDL_RenderLine(renderer, charX+7, charY+8, charX, charY+8); // Bottom
+            backend->drawLine(charX, charY, charX, charY+8); // Vertical
+            backend->drawLine(charX, charY, charX+7, charY); // Top
+            backend->drawLine(charX+7, charY, charX+9, charY+2); // Top curve
+            backend->drawLine(charX+9, charY+2, charX+9, charY+6); // Right
+            backend->drawLine(charX+9, charY+6, charX+7, charY+8); // Bottom curve
+            backend->drawLine(charX+7, charY+8, charX, charY+8); // Bottom
             break;
     }
 
@@ -713,25 +682,25 @@ void Renderer::drawLaneMarker(int x, int y, const std::string& label, SDL_Color
     char secondChar = label[1];
     switch (secondChar) {
         case '1':
-            SDL_RenderLine(renderer, charX+4, charY, charX+4, charY+8); // Vertical
-            SDL_RenderLine(renderer, charX+2, charY+2, charX+4, charY); // Top slant
-            SDL_RenderLine(renderer, charX+2, charY+8, charX+6, charY+8); // Base
+            backend->drawLine(charX+4, charY, charX+4, charY+8); // Vertical
+            backend->drawLine(charX+2, charY+2, charX+4, charY); // Top slant
+            backend->drawLine(charX+2, charY+8, charX+6, charY+8); // Base
             break;
         case '2':
-            SDL_RenderLine(renderer, charX+1, charY+1, charX+4, charY); // Top left curve
-            SDL_RenderLine(renderer, charX+4, charY, charX+6, charY+1); // Top right curve
-            SDL_RenderLine(renderer, charX+6, charY+1, charX+6, charY+3); // Upper right vertical
-            SDL_RenderLine(renderer, charX+6, charY+3, charX+1, charY+8); // Diagonal
-            SDL_RenderLine(renderer, charX+1, charY+8, charX+7, charY+8); // Bottom
+            backend->drawLine(charX+1, charY+1, charX+4, charY); // Top left curve
+            backend->drawLine(charX+4, charY, charX+6, charY+1); // Top right curve
+            backend->drawLine(charX+6, charY+1, charX+6, charY+3); // Upper right vertical
+            backend->drawLine(charX+6, charY+3, charX+1, charY+8); // Diagonal
+            backend->drawLine(charX+1, charY+8, charX+7, charY+8); // Bottom
             break;
         case '3':
-            SDL_RenderLine(renderer, charX+1, charY, charX+6, charY); // Top
-            SDL_RenderLine(renderer, charX+6, charY, charX+7, charY+2); // Top right curve
-            SDL_RenderLine(renderer, charX+7, charY+2, charX+5, charY+4); // Upper middle
-            SDL_RenderLine(renderer, charX+3, charY+4, charX+5, charY+4); // Middle
-            SDL_RenderLine(renderer, charX+5, charY+4, charX+7, charY+6); // Lower middle
-            SDL_RenderLine(renderer, charX+7, charY+6, charX+6, charY+8); // Bottom right curve
-            SDL_RenderLine(renderer, charX+6, charY+8, charX+1, charY+8); // Bottom
+            backend->drawLine(charX+1, charY, charX+6, charY); // Top
+            backend->drawLine(charX+6, charY, charX+7, charY+2); // Top right curve
+            backend->drawLine(charX+7, charY+2, charX+5, charY+4); // Upper middle
+            backend->drawLine(charX+3, charY+4, charX+5, charY+4); // Middle
+            backend->drawLine(charX+5, charY+4, charX+7, charY+6); // Lower middle
+            backend->drawLine(charX+7, charY+6, charX+6, charY+8); // Bottom right curve
+            backend->drawLine(charX+6, charY+8, charX+1, charY+8); // Bottom
             break;
     }
 }
@@ -742,7 +711,7 @@ void Renderer::drawCrosswalks() {
     const int ROAD_WIDTH = Constants::ROAD_WIDTH;
 
     // Modern zebra crossing style
-    SDL_SetRenderDrawColor(renderer, 240, 240, 255, 200); // Slight blue-white
+    backend->setDrawColor(240, 240, 255, 200); // Slight blue-white
 
     // North crosswalk
     for (int i = 0; i < 9; i++) {
@@ -751,17 +720,17 @@ void Renderer::drawCrosswalks() {
             static_cast<float>(CENTER_Y - ROAD_WIDTH/2 - 25),
             12.0f, 25.0f
         };
-        SDL_RenderFillRect(renderer, &stripe);
+        backend->fillRect(&stripe);
 
         // Add subtle glow
-        SDL_SetRenderDrawColor(renderer, 240, 240, 255, 30); // Transparent glow
+        backend->setDrawColor(240, 240, 255, 30); // Transparent glow
         SDL_FRect glow = {
             stripe.x - 2, stripe.y - 2,
             stripe.w + 4, stripe.h + 4
         };
-        SDL_RenderFillRect(renderer, &glow);
+        backend->fillRect(&glow);
 
-        SDL_SetRenderDrawColor(renderer, 240, 240, 255, 200); // Reset color
+        backend->setDrawColor(240, 240, 255, 200); // Reset color
     }
 
     // South crosswalk
@@ -771,17 +740,17 @@ void Renderer::drawCrosswalks() {
             static_cast<float>(CENTER_Y + ROAD_WIDTH/2),
             12.0f, 25.0f
         };
-        SDL_RenderFillRect(renderer, &stripe);
+        backend->fillRect(&stripe);
 
         // Add subtle glow
-        SDL_SetRenderDrawColor(renderer, 240, 240, 255, 30); // Transparent glow
+        backend->setDrawColor(240, 240, 255, 30); // Transparent glow
         SDL_FRect glow = {
             stripe.x - 2, stripe.y - 2,
             stripe.w + 4, stripe.h + 4
         };
-        SDL_RenderFillRect(renderer, &glow);
+        backend->fillRect(&glow);
 
-        SDL_SetRenderDrawColor(renderer, 240, 240, 255, 200); // Reset color
+        backend->setDrawColor(240, 240, 255, 200); // Reset color
     }
 
     // East crosswalk
@@ -791,17 +760,17 @@ void Renderer::drawCrosswalks() {
             static_cast<float>(CENTER_Y - ROAD_WIDTH/2 + 2 + i*18),
             25.0f, 12.0f
         };
-        SDL_RenderFillRect(renderer, &stripe);
+        backend->fillRect(&stripe);
 
         // Add subtle glow
-        SDL_SetRenderDrawColor(renderer, 240, 240, 255, 30); // Transparent glow
+        backend->setDrawColor(240, 240, 255, 30); // Transparent glow
         SDL_FRect glow = {
             stripe.x - 2, stripe.y - 2,
             stripe.w + 4, stripe.h + 4
         };
-        SDL_RenderFillRect(renderer, &glow);
+        backend->fillRect(&glow);
 
-        SDL_SetRenderDrawColor(renderer, 240, 240, 255, 200); // Reset color
+        backend->setDrawColor(240, 240, 255, 200); // Reset color
     }
 
     // West crosswalk
@@ -811,17 +780,17 @@ void Renderer::drawCrosswalks() {
             static_cast<float>(CENTER_Y - ROAD_WIDTH/2 + 2 + i*18),
             25.0f, 12.0f
         };
-        SDL_RenderFillRect(renderer, &stripe);
+        backend->fillRect(&stripe);
 
         // Add subtle glow
-        SDL_SetRenderDrawColor(renderer, 240, 240, 255, 30); // Transparent glow
+        backend->setDrawColor(240, 240, 255, 30); // Transparent glow
         SDL_FRect glow = {
             stripe.x - 2, stripe.y - 2,
             stripe.w + 4, stripe.h + 4
         };
-        SDL_RenderFillRect(renderer, &glow);
+        backend->fillRect(&glow);
 
-        SDL_SetRenderDrawColor(renderer, 240, 240, 255, 200); // Reset color
+        backend->setDrawColor(240, 240, 255, 200); // Reset color
     }
 }
 
@@ -831,7 +800,7 @@ void Renderer::drawStopLines() {
     const int ROAD_WIDTH = Constants::ROAD_WIDTH;
 
     // Draw stop lines with glow effect
-    SDL_SetRenderDrawColor(renderer, 240, 240, 255, 255); // Bright white-blue
+    backend->setDrawColor(240, 240, 255, 255); // Bright white-blue
 
     // Top stop line (A road)
     SDL_FRect topStop = {
@@ -840,69 +809,69 @@ void Renderer::drawStopLines() {
         static_cast<float>(ROAD_WIDTH),
         3.0f
     };
-    SDL_RenderFillRect(renderer, &topStop);
+    backend->fillRect(&topStop);
 
     // Add glow
-    SDL_SetRenderDrawColor(renderer, 240, 240, 255, 30); // Transparent glow
+    backend->setDrawColor(240, 240, 255, 30); // Transparent glow
     SDL_FRect topGlow = {
         topStop.x, topStop.y - 3,
         topStop.w, 9.0f
     };
-    SDL_RenderFillRect(renderer, &topGlow);
+    backend->fillRect(&topGlow);
 
     // Bottom stop line (C road)
-    SDL_SetRenderDrawColor(renderer, 240, 240, 255, 255);
+    backend->setDrawColor(240, 240, 255, 255);
     SDL_FRect bottomStop = {
         static_cast<float>(CENTER_X - ROAD_WIDTH/2),
         static_cast<float>(CENTER_Y + ROAD_WIDTH/2),
         static_cast<float>(ROAD_WIDTH),
         3.0f
     };
-    SDL_RenderFillRect(renderer, &bottomStop);
+    backend->fillRect(&bottomStop);
 
     // Add glow
-    SDL_SetRenderDrawColor(renderer, 240, 240, 255, 30);
+    backend->setDrawColor(240, 240, 255, 30);
     SDL_FRect bottomGlow = {
         bottomStop.x, bottomStop.y - 3,
         bottomStop.w, 9.0f
     };
-    SDL_RenderFillRect(renderer, &bottomGlow);
+    backend->fillRect(&bottomGlow);
 
     // Left stop line (D road)
-    SDL_SetRenderDrawColor(renderer, 240, 240, 255, 255);
+    backend->setDrawColor(240, 240, 255, 255);
     SDL_FRect leftStop = {
         static_cast<float>(CENTER_X - ROAD_WIDTH/2 - 3),
         static_cast<float>(CENTER_Y - ROAD_WIDTH/2),
         3.0f,
         static_cast<float>(ROAD_WIDTH)
     };
-    SDL_RenderFillRect(renderer, &leftStop);
+    backend->fillRect(&leftStop);
 
     // Add glow
-    SDL_SetRenderDrawColor(renderer, 240, 240, 255, 30);
+    backend->setDrawColor(240, 240, 255, 30);
     SDL_FRect leftGlow = {
         leftStop.x - 3, leftStop.y,
         9.0f, leftStop.h
     };
-    SDL_RenderFillRect(renderer, &leftGlow);
+    backend->fillRect(&leftGlow);
 
     // Right stop line (B road)
-    SDL_SetRenderDrawColor(renderer, 240, 240, 255, 255);
+    backend->setDrawColor(240, 240, 255, 255);
     SDL_FRect rightStop = {
         static_cast<float>(CENTER_X + ROAD_WIDTH/2),
         static_cast<float>(CENTER_Y - ROAD_WIDTH/2),
         3.0f,
         static_cast<float>(ROAD_WIDTH)
     };
-    SDL_RenderFillRect(renderer, &rightStop);
+    backend->fillRect(&rightStop);
 
     // Add glow
-    SDL_SetRenderDrawColor(renderer, 240, 240, 255, 30);
+    backend->setDrawColor(240, 240, 255, 30);
     SDL_FRect rightGlow = {
         rightStop.x - 3, rightStop.y,
         9.0f, rightStop.h
     };
-    SDL_RenderFillRect(renderer, &rightGlow);
+    backend->fillRect(&rightGlow);
 }
 
 void Renderer::drawLaneFlowArrow(int x, int y, Direction dir) {
@@ -911,7 +880,7 @@ void Renderer::drawLaneFlowArrow(int x, int y, Direction dir) {
     const float ARROW_WIDTH = 10.0f;
 
     // Glow effect (larger, transparent)
-    SDL_SetRenderDrawColor(renderer, 220, 220, 255, 50); // Light blue glow
+    backend->setDrawColor(220, 220, 255, 50); // Light blue glow
 
     // Determine arrow points based on direction
     SDL_FPoint points[7]; // Arrow polygon
@@ -977,11 +946,11 @@ void Renderer::drawLaneFlowArrow(int x, int y, Direction dir) {
         float nextScaledX = static_cast<float>(x) + (points[next].x - static_cast<float>(x)) * 1.2f;
         float nextScaledY = static_cast<float>(y) + (points[next].y - static_cast<float>(y)) * 1.2f;
 
-        SDL_RenderLine(renderer, scaledX, scaledY, nextScaledX, nextScaledY);
+        backend->drawLine(scaledX, scaledY, nextScaledX, nextScaledY);
     }
 
     // Draw the actual arrow
-    SDL_SetRenderDrawColor(renderer, 220, 220, 255, 200);
+    backend->setDrawColor(220, 220, 255, 200);
 
     // Create vertices for filled polygon with SDL_FColor for SDL3 compatibility
     SDL_Vertex vertices[7];
@@ -997,13 +966,13 @@ void Renderer::drawLaneFlowArrow(int x, int y, Direction dir) {
 
     // Draw the filled arrow
     int indices[] = {0, 1, 2, 0, 2, 3, 0, 3, 4, 0, 4, 5, 0, 5, 6};
-    SDL_RenderGeometry(renderer, NULL, vertices, 7, indices, 15);
+    backend->drawGeometry(0, vertices, 7, indices, 15);
 
     // Draw outline
-    SDL_SetRenderDrawColor(renderer, 255, 255, 255, 255);
+    backend->setDrawColor(255, 255, 255, 255);
     for (int i = 0; i < 7; i++) {
         int next = (i + 1) % 7;
-        SDL_RenderLine(renderer, points[i].x, points[i].y, points[next].x, points[next].y);
+        backend->drawLine(points[i].x, points[i].y, points[next].x, points[next].y);
     }
 }
 
@@ -1031,7 +1000,41 @@ void Renderer::drawLaneLabels() {
 
 
 void Renderer::cleanup() {
-    // Add cleanup code here
+    // Textures belong to the backend, which may belong to the SDL renderer
+    if (backend) {
+        GlowTextures::release(backend);
+        backend->destroyTexture(carTexture);
+        carTexture = 0;
+        if (ownsBackend) {
+            delete backend;
+        }
+        backend = nullptr;
+        ownsBackend = false;
+    }
+
+    if (renderer) {
+        SDL_DestroyRenderer(renderer);
+        renderer = nullptr;
+    }
+
+    if (window) {
+        SDL_DestroyWindow(window);
+        window = nullptr;
+    }
+
+    active = false;
+}
+
+void Renderer::setTrafficManager(TrafficManager* manager) {
+    trafficManager = manager;
+}
+
+bool Renderer::isActive() const {
+    return active;
+}
+
+void Renderer::setFrameRateLimit(int fps) {
+    frameRateLimit = fps;
 }
 
 void Renderer::toggleDebugOverlay() {
@@ -1058,56 +1061,42 @@ void Renderer::drawNeonSign(int x, int y, const std::string& text, SDL_Color col
     float signX = isHorizontal ? static_cast<float>(x - signWidth/2) : static_cast<float>(x - signHeight/2);
     float signY = isHorizontal ? static_cast<float>(y - signHeight/2) : static_cast<float>(y - signWidth/2);
 
-    // Draw outer glow
-    for (int i = 1; i <= 5; i++) {
-        SDL_SetRenderDrawColor(renderer, color.r, color.g, color.b, 255/(i*3));
-
-        if (isHorizontal) {
-            SDL_FRect glow = {
-                signX - static_cast<float>(i), signY - static_cast<float>(i),
-                static_cast<float>(signWidth + 2*i), static_cast<float>(signHeight + 2*i)
-            };
-            SDL_RenderRect(renderer, &glow);
-        } else {
-            // Rotated 90 degrees for vertical sign
-            SDL_FRect glow = {
-                signX - static_cast<float>(i), signY - static_cast<float>(i),
-                static_cast<float>(signHeight + 2*i), static_cast<float>(signWidth + 2*i)
-            };
-            SDL_RenderRect(renderer, &glow);
-        }
-    }
+    // Draw outer glow (rotated 90 degrees for a vertical sign)
+    SDL_FRect signRect = isHorizontal
+        ? SDL_FRect{signX, signY, static_cast<float>(signWidth), static_cast<float>(signHeight)}
+        : SDL_FRect{signX, signY, static_cast<float>(signHeight), static_cast<float>(signWidth)};
+    GlowTextures::forBackend(backend)->drawFrameGlow(signRect, color);
 
     // Draw sign background
-    SDL_SetRenderDrawColor(renderer, 20, 20, 30, 200);
+    backend->setDrawColor(20, 20, 30, 200);
     if (isHorizontal) {
         SDL_FRect signBg = {
             signX, signY,
             static_cast<float>(signWidth), static_cast<float>(signHeight)
         };
-        SDL_RenderFillRect(renderer, &signBg);
+        backend->fillRect(&signBg);
     } else {
         SDL_FRect signBg = {
             signX, signY,
             static_cast<float>(signHeight), static_cast<float>(signWidth)
         };
-        SDL_RenderFillRect(renderer, &signBg);
+        backend->fillRect(&signBg);
     }
 
     // Draw neon border
-    SDL_SetRenderDrawColor(renderer, color.r, color.g, color.b, 255);
+    backend->setDrawColor(color.r, color.g, color.b, 255);
     if (isHorizontal) {
         SDL_FRect signBorder = {
             signX, signY,
             static_cast<float>(signWidth), static_cast<float>(signHeight)
         };
-        SDL_RenderRect(renderer, &signBorder);
+        backend->drawRect(&signBorder);
     } else {
         SDL_FRect signBorder = {
             signX, signY,
             static_cast<float>(signHeight), static_cast<float>(signWidth)
         };
-        SDL_RenderRect(renderer, &signBorder);
+        backend->drawRect(&signBorder);
     }
 
     // Draw text character by character
@@ -1133,110 +1122,110 @@ void Renderer::drawNeonChar(float x, float y, char c, SDL_Color color, bool isVe
     const float CHAR_HEIGHT = 20.0f;
 
     // Simplified character drawing with neon effect
-    SDL_SetRenderDrawColor(renderer, color.r, color.g, color.b, 255);
+    backend->setDrawColor(color.r, color.g, color.b, 255);
 
     // Draw character glow
-    SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_BLEND);
+    backend->setDrawBlendMode(SDL_BLENDMODE_BLEND);
 
     // Draw different letters with neon style
     switch (c) {
         case 'A':
             // Main lines
-            SDL_RenderLine(renderer, x+CHAR_WIDTH/2, y, x, y+CHAR_HEIGHT); // Left diagonal
-            SDL_RenderLine(renderer, x+CHAR_WIDTH/2, y, x+CHAR_WIDTH, y+CHAR_HEIGHT); // Right diagonal
-            SDL_RenderLine(renderer, x+CHAR_WIDTH/4, y+CHAR_HEIGHT/2, x+3*CHAR_WIDTH/4, y+CHAR_HEIGHT/2); // Middle
+            backend->drawLine(x+CHAR_WIDTH/2, y, x, y+CHAR_HEIGHT); // Left diagonal
+            backend->drawLine(x+CHAR_WIDTH/2, y, x+CHAR_WIDTH, y+CHAR_HEIGHT); // Right diagonal
+            backend->drawLine(x+CHAR_WIDTH/4, y+CHAR_HEIGHT/2, x+3*CHAR_WIDTH/4, y+CHAR_HEIGHT/2); // Middle
             break;
 
         case 'B':
-            SDL_RenderLine(renderer, x, y, x, y+CHAR_HEIGHT); // Vertical
-            SDL_RenderLine(renderer, x, y, x+3*CHAR_WIDTH/4, y); // Top
-            SDL_RenderLine(renderer, x+3*CHAR_WIDTH/4, y, x+CHAR_WIDTH, y+CHAR_HEIGHT/4); // Top curve
-            SDL_RenderLine(renderer, x+CHAR_WIDTH, y+CHAR_HEIGHT/4, x+3*CHAR_WIDTH/4, y+CHAR_HEIGHT/2); // Middle top
-            SDL_RenderLine(renderer, x, y+CHAR_HEIGHT/2, x+3*CHAR_WIDTH/4, y+CHAR_HEIGHT/2); // Middle
-            SDL_RenderLine(renderer, x+3*CHAR_WIDTH/4, y+CHAR_HEIGHT/2, x+CHAR_WIDTH, y+3*CHAR_HEIGHT/4); // Middle bottom
-            SDL_RenderLine(renderer, x+CHAR_WIDTH, y+3*CHAR_HEIGHT/4, x+3*CHAR_WIDTH/4, y+CHAR_HEIGHT); // Bottom curve
-            SDL_RenderLine(renderer, x+3*CHAR_WIDTH/4, y+CHAR_HEIGHT, x, y+CHAR_HEIGHT); // Bottom
+            backend->drawLine(x, y, x, y+CHAR_HEIGHT); // Vertical
+            backend->drawLine(x, y, x+3*CHAR_WIDTH/4, y); // Top
+            backend->drawLine(x+3*CHAR_WIDTH/4, y, x+CHAR_WIDTH, y+CHAR_HEIGHT/4); // Top curve
+            backend->drawLine(x+CHAR_WIDTH, y+CHAR_HEIGHT/4, x+3*CHAR_WIDTH/4, y+CHAR_HEIGHT/2); // Middle top
+            backend->drawLine(x, y+CHAR_HEIGHT/2, x+3*CHAR_WIDTH/4, y+CHAR_HEIGHT/2); // Middle
+            backend->drawLine(x+3*CHAR_WIDTH/4, y+CHAR_HEIGHT/2, x+CHAR_WIDTH, y+3*CHAR_HEIGHT/4); // Middle bottom
+            backend->drawLine(x+CHAR_WIDTH, y+3*CHAR_HEIGHT/4, x+3*CHAR_WIDTH/4, y+CHAR_HEIGHT); // Bottom curve
+            backend->drawLine(x+3*CHAR_WIDTH/4, y+CHAR_HEIGHT, x, y+CHAR_HEIGHT); // Bottom
             break;
 
         case 'N':
-            SDL_RenderLine(renderer, x, y, x, y+CHAR_HEIGHT); // Left vertical
-            SDL_RenderLine(renderer, x, y, x+CHAR_WIDTH, y+CHAR_HEIGHT); // Diagonal
-            SDL_RenderLine(renderer, x+CHAR_WIDTH, y, x+CHAR_WIDTH, y+CHAR_HEIGHT); // Right vertical
+            backend->drawLine(x, y, x, y+CHAR_HEIGHT); // Left vertical
+            backend->drawLine(x, y, x+CHAR_WIDTH, y+CHAR_HEIGHT); // Diagonal
+            backend->drawLine(x+CHAR_WIDTH, y, x+CHAR_WIDTH, y+CHAR_HEIGHT); // Right vertical
             break;
 
         case 'O':
-            SDL_RenderLine(renderer, x+CHAR_WIDTH/4, y, x+3*CHAR_WIDTH/4, y); // Top
-            SDL_RenderLine(renderer, x+3*CHAR_WIDTH/4, y, x+CHAR_WIDTH, y+CHAR_HEIGHT/4); // Top right
-            SDL_RenderLine(renderer, x+CHAR_WIDTH, y+CHAR_HEIGHT/4, x+CHAR_WIDTH, y+3*CHAR_HEIGHT/4); // Right
-            SDL_RenderLine(renderer, x+CHAR_WIDTH, y+3*CHAR_HEIGHT/4, x+3*CHAR_WIDTH/4, y+CHAR_HEIGHT); // Bottom right
-            SDL_RenderLine(renderer, x+3*CHAR_WIDTH/4, y+CHAR_HEIGHT, x+CHAR_WIDTH/4, y+CHAR_HEIGHT); // Bottom
-            SDL_RenderLine(renderer, x+CHAR_WIDTH/4, y+CHAR_HEIGHT, x, y+3*CHAR_HEIGHT/4); // Bottom left
-            SDL_RenderLine(renderer, x, y+3*CHAR_HEIGHT/4, x, y+CHAR_HEIGHT/4); // Left
-            SDL_RenderLine(renderer, x, y+CHAR_HEIGHT/4, x+CHAR_WIDTH/4, y); // Top left
+            backend->drawLine(x+CHAR_WIDTH/4, y, x+3*CHAR_WIDTH/4, y); // Top
+            backend->drawLine(x+3*CHAR_WIDTH/4, y, x+CHAR_WIDTH, y+CHAR_HEIGHT/4); // Top right
+            backend->drawLine(x+CHAR_WIDTH, y+CHAR_HEIGHT/4, x+CHAR_WIDTH, y+3*CHAR_HEIGHT/4); // Right
+            backend->drawLine(x+CHAR_WIDTH, y+3*CHAR_HEIGHT/4, x+3*CHAR_WIDTH/4, y+CHAR_HEIGHT); // Bottom right
+            backend->drawLine(x+3*CHAR_WIDTH/4, y+CHAR_HEIGHT, x+CHAR_WIDTH/4, y+CHAR_HEIGHT); // Bottom
+            backend->drawLine(x+CHAR_WIDTH/4, y+CHAR_HEIGHT, x, y+3*CHAR_HEIGHT/4); // Bottom left
+            backend->drawLine(x, y+3*CHAR_HEIGHT/4, x, y+CHAR_HEIGHT/4); // Left
+            backend->drawLine(x, y+CHAR_HEIGHT/4, x+CHAR_WIDTH/4, y); // Top left
             break;
 
         case 'R':
-            SDL_RenderLine(renderer, x, y, x, y+CHAR_HEIGHT); // Vertical
-            SDL_RenderLine(renderer, x, y, x+3*CHAR_WIDTH/4, y); // Top
-            SDL_RenderLine(renderer, x+3*CHAR_WIDTH/4, y, x+CHAR_WIDTH, y+CHAR_HEIGHT/4); // Top curve
-            SDL_RenderLine(renderer, x+CHAR_WIDTH, y+CHAR_HEIGHT/4, x+3*CHAR_WIDTH/4, y+CHAR_HEIGHT/2); // Middle top
-            SDL_RenderLine(renderer, x, y+CHAR_HEIGHT/2, x+3*CHAR_WIDTH/4, y+CHAR_HEIGHT/2); // Middle
-            SDL_RenderLine(renderer, x+3*CHAR_WIDTH/4, y+CHAR_HEIGHT/2, x+CHAR_WIDTH, y+CHAR_HEIGHT); // Diagonal
+            backend->drawLine(x, y, x, y+CHAR_HEIGHT); // Vertical
+            backend->drawLine(x, y, x+3*CHAR_WIDTH/4, y); // Top
+            backend->drawLine(x+3*CHAR_WIDTH/4, y, x+CHAR_WIDTH, y+CHAR_HEIGHT/4); // Top curve
+            backend->drawLine(x+CHAR_WIDTH, y+CHAR_HEIGHT/4, x+3*CHAR_WIDTH/4, y+CHAR_HEIGHT/2); // Middle top
+            backend->drawLine(x, y+CHAR_HEIGHT/2, x+3*CHAR_WIDTH/4, y+CHAR_HEIGHT/2); // Middle
+            backend->drawLine(x+3*CHAR_WIDTH/4, y+CHAR_HEIGHT/2, x+CHAR_WIDTH, y+CHAR_HEIGHT); // Diagonal
             break;
 
         case 'T':
-            SDL_RenderLine(renderer, x, y, x+CHAR_WIDTH, y); // Top
-            SDL_RenderLine(renderer, x+CHAR_WIDTH/2, y, x+CHAR_WIDTH/2, y+CHAR_HEIGHT); // Vertical
+            backend->drawLine(x, y, x+CHAR_WIDTH, y); // Top
+            backend->drawLine(x+CHAR_WIDTH/2, y, x+CHAR_WIDTH/2, y+CHAR_HEIGHT); // Vertical
             break;
 
         case 'E':
-            SDL_RenderLine(renderer, x, y, x, y+CHAR_HEIGHT); // Vertical
-            SDL_RenderLine(renderer, x, y, x+CHAR_WIDTH, y); // Top
-            SDL_RenderLine(renderer, x, y+CHAR_HEIGHT/2, x+3*CHAR_WIDTH/4, y+CHAR_HEIGHT/2); // Middle
-            SDL_RenderLine(renderer, x, y+CHAR_HEIGHT, x+CHAR_WIDTH, y+CHAR_HEIGHT); // Bottom
+            backend->drawLine(x, y, x, y+CHAR_HEIGHT); // Vertical
+            backend->drawLine(x, y, x+CHAR_WIDTH, y); // Top
+            backend->drawLine(x, y+CHAR_HEIGHT/2, x+3*CHAR_WIDTH/4, y+CHAR_HEIGHT/2); // Middle
+            backend->drawLine(x, y+CHAR_HEIGHT, x+CHAR_WIDTH, y+CHAR_HEIGHT); // Bottom
             break;
 
         case 'S':
-            SDL_RenderLine(renderer, x+CHAR_WIDTH, y, x+CHAR_WIDTH/4, y); // Top
-            SDL_RenderLine(renderer, x+CHAR_WIDTH/4, y, x, y+CHAR_HEIGHT/4); // Top curve
-            SDL_RenderLine(renderer, x, y+CHAR_HEIGHT/4, x+CHAR_WIDTH/4, y+CHAR_HEIGHT/2); // Middle top
-            SDL_RenderLine(renderer, x+CHAR_WIDTH/4, y+CHAR_HEIGHT/2, x+3*CHAR_WIDTH/4, y+CHAR_HEIGHT/2); // Middle
-            SDL_RenderLine(renderer, x+3*CHAR_WIDTH/4, y+CHAR_HEIGHT/2, x+CHAR_WIDTH, y+3*CHAR_HEIGHT/4); // Middle bottom
-            SDL_RenderLine(renderer, x+CHAR_WIDTH, y+3*CHAR_HEIGHT/4, x+3*CHAR_WIDTH/4, y+CHAR_HEIGHT); // Bottom curve
-            SDL_RenderLine(renderer, x+3*CHAR_WIDTH/4, y+CHAR_HEIGHT, x, y+CHAR_HEIGHT); // Bottom
+            backend->drawLine(x+CHAR_WIDTH, y, x+CHAR_WIDTH/4, y); // Top
+            backend->drawLine(x+CHAR_WIDTH/4, y, x, y+CHAR_HEIGHT/4); // Top curve
+            backend->drawLine(x, y+CHAR_HEIGHT/4, x+CHAR_WIDTH/4, y+CHAR_HEIGHT/2); // Middle top
+            backend->drawLine(x+CHAR_WIDTH/4, y+CHAR_HEIGHT/2, x+3*CHAR_WIDTH/4, y+CHAR_HEIGHT/2); // Middle
+            backend->drawLine(x+3*CHAR_WIDTH/4, y+CHAR_HEIGHT/2, x+CHAR_WIDTH, y+3*CHAR_HEIGHT/4); // Middle bottom
+            backend->drawLine(x+CHAR_WIDTH, y+3*CHAR_HEIGHT/4, x+3*CHAR_WIDTH/4, y+CHAR_HEIGHT); // Bottom curve
+            backend->drawLine(x+3*CHAR_WIDTH/4, y+CHAR_HEIGHT, x, y+CHAR_HEIGHT); // Bottom
             break;
 
         case 'W':
-            SDL_RenderLine(renderer, x, y, x+CHAR_WIDTH/4, y+CHAR_HEIGHT); // Left diagonal
-            SDL_RenderLine(renderer, x+CHAR_WIDTH/4, y+CHAR_HEIGHT, x+CHAR_WIDTH/2, y+CHAR_HEIGHT/2); // Middle left
-            SDL_RenderLine(renderer, x+CHAR_WIDTH/2, y+CHAR_HEIGHT/2, x+3*CHAR_WIDTH/4, y+CHAR_HEIGHT); // Middle right
-            SDL_RenderLine(renderer, x+3*CHAR_WIDTH/4, y+CHAR_HEIGHT, x+CHAR_WIDTH, y); // Right diagonal
+            backend->drawLine(x, y, x+CHAR_WIDTH/4, y+CHAR_HEIGHT); // Left diagonal
+            backend->drawLine(x+CHAR_WIDTH/4, y+CHAR_HEIGHT, x+CHAR_WIDTH/2, y+CHAR_HEIGHT/2); // Middle left
+            backend->drawLine(x+CHAR_WIDTH/2, y+CHAR_HEIGHT/2, x+3*CHAR_WIDTH/4, y+CHAR_HEIGHT); // Middle right
+            backend->drawLine(x+3*CHAR_WIDTH/4, y+CHAR_HEIGHT, x+CHAR_WIDTH, y); // Right diagonal
             break;
 
         case 'H':
-            SDL_RenderLine(renderer, x, y, x, y+CHAR_HEIGHT); // Left vertical
-            SDL_RenderLine(renderer, x+CHAR_WIDTH, y, x+CHAR_WIDTH, y+CHAR_HEIGHT); // Right vertical
-            SDL_RenderLine(renderer, x, y+CHAR_HEIGHT/2, x+CHAR_WIDTH, y+CHAR_HEIGHT/2); // Middle
+            backend->drawLine(x, y, x, y+CHAR_HEIGHT); // Left vertical
+            backend->drawLine(x+CHAR_WIDTH, y, x+CHAR_WIDTH, y+CHAR_HEIGHT); // Right vertical
+            backend->drawLine(x, y+CHAR_HEIGHT/2, x+CHAR_WIDTH, y+CHAR_HEIGHT/2); // Middle
             break;
 
         // Add more characters as needed
         default:
             // For unknown characters, draw a rectangle
             SDL_FRect charRect = {x, y, CHAR_WIDTH, CHAR_HEIGHT};
-            SDL_RenderRect(renderer, &charRect);
+            backend->drawRect(&charRect);
     }
 
     // Draw glow effect
-    SDL_SetRenderDrawColor(renderer, color.r, color.g, color.b, 50);
+    backend->setDrawColor(color.r, color.g, color.b, 50);
     for (int i = 1; i <= 3; i++) {
         SDL_FRect glow = {
             x - static_cast<float>(i), y - static_cast<float>(i),
             CHAR_WIDTH + static_cast<float>(2*i), CHAR_HEIGHT + static_cast<float>(2*i)
         };
-        SDL_RenderRect(renderer, &glow);
+        backend->drawRect(&glow);
     }
 
-    SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_NONE);
+    backend->setDrawBlendMode(SDL_BLENDMODE_NONE);
 }
 
 
@@ -1252,7 +1241,7 @@ void Renderer::drawTrafficLights() {
     }
 
     // Draw traffic lights
-    trafficLight->render(renderer);
+    trafficLight->render(backend);
 }
 
 void Renderer::drawVehicles() {
@@ -1286,7 +1275,7 @@ void Renderer::renderModernVehicle(Vehicle* vehicle, int queuePos) {
     if (!vehicle) return;
 
     // Create default parameters for vehicle rendering
-    vehicle->render(renderer, carTexture, queuePos);
+    vehicle->render(backend, carTexture, queuePos);
 
     // Add additional modern effects
     float x = vehicle->getTurnPosX();
@@ -1455,88 +1444,25 @@ void Renderer::drawVehicleLights(float x, float y, int laneNumber, char laneChar
     }
 
     // Draw headlights (front lights) - white/yellow glow
-    SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_BLEND);
+    backend->setDrawBlendMode(SDL_BLENDMODE_BLEND);
 
-    // Inner bright glow
-    SDL_SetRenderDrawColor(renderer, 255, 255, 220, 200);
-    SDL_FRect headlight1 = {
-        frontX1 - LIGHT_RADIUS/2, frontY1 - LIGHT_RADIUS/2,
-        LIGHT_RADIUS, LIGHT_RADIUS
-    };
-    SDL_RenderFillRect(renderer, &headlight1);
-
-    SDL_FRect headlight2 = {
-        frontX2 - LIGHT_RADIUS/2, frontY2 - LIGHT_RADIUS/2,
-        LIGHT_RADIUS, LIGHT_RADIUS
-    };
-    SDL_RenderFillRect(renderer, &headlight2);
-
-    // Outer headlight glow
-    for (int i = 1; i <= 3; i++) {
-        SDL_SetRenderDrawColor(renderer, 255, 255, 220, 200/(i*2));
-
-        SDL_FRect headGlow1 = {
-            frontX1 - LIGHT_RADIUS/2 - static_cast<float>(i),
-            frontY1 - LIGHT_RADIUS/2 - static_cast<float>(i),
-            LIGHT_RADIUS + static_cast<float>(2*i),
-            LIGHT_RADIUS + static_cast<float>(2*i)
-        };
-        SDL_RenderFillRect(renderer, &headGlow1);
-
-        SDL_FRect headGlow2 = {
-            frontX2 - LIGHT_RADIUS/2 - static_cast<float>(i),
-            frontY2 - LIGHT_RADIUS/2 - static_cast<float>(i),
-            LIGHT_RADIUS + static_cast<float>(2*i),
-            LIGHT_RADIUS + static_cast<float>(2*i)
-        };
-        SDL_RenderFillRect(renderer, &headGlow2);
-    }
+    // Each light and its stepped glow is one baked quad
+    GlowTextures* glow = GlowTextures::forBackend(backend);
+    glow->drawVehicleLight(frontX1, frontY1, 3, {255, 255, 220, 200});
+    glow->drawVehicleLight(frontX2, frontY2, 3, {255, 255, 220, 200});
 
     // Draw taillights (back lights) - red glow
-    SDL_SetRenderDrawColor(renderer, 255, 60, 60, 200);
-    SDL_FRect taillight1 = {
-        backX1 - LIGHT_RADIUS/2, backY1 - LIGHT_RADIUS/2,
-        LIGHT_RADIUS, LIGHT_RADIUS
-    };
-    SDL_RenderFillRect(renderer, &taillight1);
-
-    SDL_FRect taillight2 = {
-        backX2 - LIGHT_RADIUS/2, backY2 - LIGHT_RADIUS/2,
-        LIGHT_RADIUS, LIGHT_RADIUS
-    };
-    SDL_RenderFillRect(renderer, &taillight2);
-
-    // Outer taillight glow
-    for (int i = 1; i <= 2; i++) {
-        SDL_SetRenderDrawColor(renderer, 255, 60, 60, 200/(i*2));
-
-        SDL_FRect tailGlow1 = {
-            backX1 - LIGHT_RADIUS/2 - static_cast<float>(i),
-            backY1 - LIGHT_RADIUS/2 - static_cast<float>(i),
-            LIGHT_RADIUS + static_cast<float>(2*i),
-            LIGHT_RADIUS + static_cast<float>(2*i)
-        };
-        SDL_RenderFillRect(renderer, &tailGlow1);
-
-        SDL_FRect tailGlow2 = {
-            backX2 - LIGHT_RADIUS/2 - static_cast<float>(i),
-            backY2 - LIGHT_RADIUS/2 - static_cast<float>(i),
-            LIGHT_RADIUS + static_cast<float>(2*i),
-            LIGHT_RADIUS + static_cast<float>(2*i)
-        };
-        SDL_RenderFillRect(renderer, &tailGlow2);
-    }
+    glow->drawVehicleLight(backX1, backY1, 2, {255, 60, 60, 200});
+    glow->drawVehicleLight(backX2, backY2, 2, {255, 60, 60, 200});
 
     // If vehicle is turning left, draw turn signal
     if (destination == Destination::LEFT) {
         // Determine blink timing using milliseconds
-        uint32_t time = SDL_GetTicks();
+        uint32_t time = static_cast<uint32_t>(backend->getTicks());
         bool blinkOn = (time / 500) % 2 == 0; // Blink every 500ms
 
         if (blinkOn) {
             // Left turn signal - amber/yellow glow
-            SDL_SetRenderDrawColor(renderer, 255, 180, 0, 200);
-
             // Position depends on heading direction
             float turnX, turnY;
             switch (heading) {
@@ -1558,37 +1484,20 @@ void Renderer::drawVehicleLights(float x, float y, int laneNumber, char laneChar
                     break;
             }
 
-            // Draw turn signal
-            SDL_FRect turnSignal = {
-                turnX - LIGHT_RADIUS/2, turnY - LIGHT_RADIUS/2,
-                LIGHT_RADIUS, LIGHT_RADIUS
-            };
-            SDL_RenderFillRect(renderer, &turnSignal);
-
-            // Outer turn signal glow
-            for (int i = 1; i <= 3; i++) {
-                SDL_SetRenderDrawColor(renderer, 255, 180, 0, 200/(i*2));
-
-                SDL_FRect turnGlow = {
-                    turnX - LIGHT_RADIUS/2 - static_cast<float>(i),
-                    turnY - LIGHT_RADIUS/2 - static_cast<float>(i),
-                    LIGHT_RADIUS + static_cast<float>(2*i),
-                    LIGHT_RADIUS + static_cast<float>(2*i)
-                };
-                SDL_RenderFillRect(renderer, &turnGlow);
-            }
+            // Draw turn signal with its glow
+            glow->drawVehicleLight(turnX, turnY, 3, {255, 180, 0, 200});
         }
     }
 
-    SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_NONE);
+    backend->setDrawBlendMode(SDL_BLENDMODE_NONE);
 }
 
 void Renderer::drawDebugOverlay() {
     // Draw a modern glass-style debug overlay
 
     // Draw semi-transparent glass panel with glow effect
-    SDL_SetRenderDrawColor(renderer, 20, 25, 40, 200); // Dark blue-ish background
-    SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_BLEND);
+    backend->setDrawColor(20, 25, 40, 200); // Dark blue-ish background
+    backend->setDrawBlendMode(SDL_BLENDMODE_BLEND);
 
     // Main panel
     SDL_FRect panelRect = {
@@ -1597,17 +1506,17 @@ void Renderer::drawDebugOverlay() {
         300.0f,
         180.0f
     };
-    SDL_RenderFillRect(renderer, &panelRect);
+    backend->fillRect(&panelRect);
 
     // Panel highlight (top-left edge glow)
-    SDL_SetRenderDrawColor(renderer, 100, 140, 200, 100);
+    backend->setDrawColor(100, 140, 200, 100);
     SDL_FRect highlight = {
         panelRect.x,
         panelRect.y,
         panelRect.w,
         2.0f
     };
-    SDL_RenderFillRect(renderer, &highlight);
+    backend->fillRect(&highlight);
 
     SDL_FRect highlightSide = {
         panelRect.x,
@@ -1615,17 +1524,17 @@ void Renderer::drawDebugOverlay() {
         2.0f,
         panelRect.h
     };
-    SDL_RenderFillRect(renderer, &highlightSide);
+    backend->fillRect(&highlightSide);
 
     // Panel shadow (bottom-right edge)
-    SDL_SetRenderDrawColor(renderer, 10, 15, 30, 150);
+    backend->setDrawColor(10, 15, 30, 150);
     SDL_FRect shadow = {
         panelRect.x,
         panelRect.y + panelRect.h - 2.0f,
         panelRect.w,
         2.0f
     };
-    SDL_RenderFillRect(renderer, &shadow);
+    backend->fillRect(&shadow);
 
     SDL_FRect shadowSide = {
         panelRect.x + panelRect.w - 2.0f,
@@ -1633,33 +1542,33 @@ void Renderer::drawDebugOverlay() {
         2.0f,
         panelRect.h
     };
-    SDL_RenderFillRect(renderer, &shadowSide);
+    backend->fillRect(&shadowSide);
 
     // Panel border with glow
-    SDL_SetRenderDrawColor(renderer, 100, 140, 200, 255);
-    SDL_RenderRect(renderer, &panelRect);
+    backend->setDrawColor(100, 140, 200, 255);
+    backend->drawRect(&panelRect);
 
     // Add outer glow effect
     for (int i = 1; i <= 3; i++) {
-        SDL_SetRenderDrawColor(renderer, 100, 140, 200, 100/i);
+        backend->setDrawColor(100, 140, 200, 100/i);
         SDL_FRect glowRect = {
             panelRect.x - static_cast<float>(i),
             panelRect.y - static_cast<float>(i),
             panelRect.w + static_cast<float>(2*i),
             panelRect.h + static_cast<float>(2*i)
         };
-        SDL_RenderRect(renderer, &glowRect);
+        backend->drawRect(&glowRect);
     }
 
     // Draw panel title
-    SDL_SetRenderDrawColor(renderer, 220, 240, 255, 255);
+    backend->setDrawColor(220, 240, 255, 255);
     drawNeonSign(windowWidth - 160, 20, "TRAFFIC STATS", {220, 240, 255, 255}, true);
 
     // Draw statistics
     drawStatistics();
 
     // Draw keyboard hint at bottom
-    SDL_SetRenderDrawColor(renderer, 180, 200, 255, 200);
+    backend->setDrawColor(180, 200, 255, 200);
     float keyX = windowWidth - 290;
     float keyY = panelRect.y + panelRect.h - 30;
 
@@ -1670,24 +1579,24 @@ void Renderer::drawDebugOverlay() {
         20.0f,
         20.0f
     };
-    SDL_RenderFillRect(renderer, &keyRect);
-    SDL_SetRenderDrawColor(renderer, 100, 140, 200, 255);
-    SDL_RenderRect(renderer, &keyRect);
+    backend->fillRect(&keyRect);
+    backend->setDrawColor(100, 140, 200, 255);
+    backend->drawRect(&keyRect);
 
     // Key letter
-    SDL_SetRenderDrawColor(renderer, 255, 255, 255, 255);
+    backend->setDrawColor(255, 255, 255, 255);
     // Draw 'D'
-    SDL_RenderLine(renderer, keyX + 5, keyY + 4, keyX + 5, keyY + 16); // Vertical
-    SDL_RenderLine(renderer, keyX + 5, keyY + 4, keyX + 12, keyY + 4); // Top
-    SDL_RenderLine(renderer, keyX + 12, keyY + 4, keyX + 15, keyY + 7); // Top curve
-    SDL_RenderLine(renderer, keyX + 15, keyY + 7, keyX + 15, keyY + 13); // Right
-    SDL_RenderLine(renderer, keyX + 15, keyY + 13, keyX + 12, keyY + 16); // Bottom curve
-    SDL_RenderLine(renderer, keyX + 12, keyY + 16, keyX + 5, keyY + 16); // Bottom
+    backend->drawLine(keyX + 5, keyY + 4, keyX + 5, keyY + 16); // Vertical
+    backend->drawLine(keyX + 5, keyY + 4, keyX + 12, keyY + 4); // Top
+    backend->drawLine(keyX + 12, keyY + 4, keyX + 15, keyY + 7); // Top curve
+    backend->drawLine(keyX + 15, keyY + 7, keyX + 15, keyY + 13); // Right
+    backend->drawLine(keyX + 15, keyY + 13, keyX + 12, keyY + 16); // Bottom curve
+    backend->drawLine(keyX + 12, keyY + 16, keyX + 5, keyY + 16); // Bottom
 
     // Key hint text
     drawText("Toggle debug overlay", keyX + 25, keyY + 3, {220, 240, 255, 255});
 
-    SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_NONE);
+    backend->setDrawBlendMode(SDL_BLENDMODE_NONE);
 }
 
 // Replace your entire drawStatistics() method with this implementation
@@ -1716,13 +1625,13 @@ void Renderer::drawStatistics() {
         }
         else if (line.find("A2") != std::string::npos) {
             // Priority lane A2 - orange with pulsing effect
-            uint32_t time = SDL_GetTicks();
+            uint32_t time = static_cast<uint32_t>(backend->getTicks());
             int pulse = static_cast<int>(30 * sin(time * 0.003) + 225);
             drawText(line, windowWidth - 290, y, {255, static_cast<Uint8>(pulse), 0, 255});
         }
         else if (line.find("PRIORITY") != std::string::npos) {
             // Priority mode active - flashing orange
-            uint32_t time = SDL_GetTicks();
+            uint32_t time = static_cast<uint32_t>(backend->getTicks());
             bool flash = (time / 500) % 2 == 0;
             SDL_Color color = flash ? SDL_Color{255, 180, 0, 255} : SDL_Color{255, 120, 0, 255};
             drawText(line, windowWidth - 290, y, color);
@@ -1767,7 +1676,7 @@ void Renderer::drawStatistics() {
 
         // Pulsing effect for green lights
         if (currentState != TrafficLight::State::ALL_RED) {
-            uint32_t time = SDL_GetTicks();
+            uint32_t time = static_cast<uint32_t>(backend->getTicks());
             int pulse = static_cast<int>(40 * sin(time * 0.005) + 215);
             stateColor.g = pulse;
         }
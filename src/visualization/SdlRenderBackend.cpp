@@ -0,0 +1,110 @@
+// FILE: src/visualization/SdlRenderBackend.cpp
+#include "visualization/SdlRenderBackend.h"
+#include "utils/DebugLogger.h"
+#include <string>
+
+SdlRenderBackend::SdlRenderBackend(SDL_Renderer* sdlRenderer)
+    : renderer(sdlRenderer) {}
+
+SdlRenderBackend::~SdlRenderBackend() {
+    for (SDL_Texture* texture : textures) {
+        if (texture) {
+            SDL_DestroyTexture(texture);
+        }
+    }
+}
+
+SDL_Texture* SdlRenderBackend::lookup(TextureId texture) const {
+    if (texture == 0 || texture > textures.size()) {
+        return nullptr;
+    }
+    return textures[texture - 1];
+}
+
+void SdlRenderBackend::setDrawColor(Uint8 r, Uint8 g, Uint8 b, Uint8 a) {
+    SDL_SetRenderDrawColor(renderer, r, g, b, a);
+}
+
+void SdlRenderBackend::setDrawBlendMode(SDL_BlendMode mode) {
+    SDL_SetRenderDrawBlendMode(renderer, mode);
+}
+
+void SdlRenderBackend::clear() {
+    SDL_RenderClear(renderer);
+}
+
+void SdlRenderBackend::drawPoint(float x, float y) {
+    SDL_RenderPoint(renderer, x, y);
+}
+
+void SdlRenderBackend::drawLine(float x1, float y1, float x2, float y2) {
+    SDL_RenderLine(renderer, x1, y1, x2, y2);
+}
+
+void SdlRenderBackend::drawRect(const SDL_FRect* rect) {
+    SDL_RenderRect(renderer, rect);
+}
+
+void SdlRenderBackend::fillRect(const SDL_FRect* rect) {
+    SDL_RenderFillRect(renderer, rect);
+}
+
+void SdlRenderBackend::drawGeometry(TextureId texture, const SDL_Vertex* vertices, int numVertices,
+                                    const int* indices, int numIndices) {
+    SDL_RenderGeometry(renderer, lookup(texture), vertices, numVertices, indices, numIndices);
+}
+
+RenderBackend::TextureId SdlRenderBackend::createTexture(int width, int height, const void* pixels, int pitch) {
+    SDL_Texture* texture = SDL_CreateTexture(renderer, SDL_PIXELFORMAT_RGBA32,
+                                             SDL_TEXTUREACCESS_STATIC, width, height);
+    if (!texture) {
+        DebugLogger::log("Failed to create texture: " + std::string(SDL_GetError()),
+                         DebugLogger::LogLevel::ERROR);
+        return 0;
+    }
+    SDL_UpdateTexture(texture, nullptr, pixels, pitch);
+    textures.push_back(texture);
+    return static_cast<TextureId>(textures.size());
+}
+
+void SdlRenderBackend::destroyTexture(TextureId texture) {
+    SDL_Texture* sdlTexture = lookup(texture);
+    if (sdlTexture) {
+        SDL_DestroyTexture(sdlTexture);
+        textures[texture - 1] = nullptr;
+    }
+}
+
+void SdlRenderBackend::setTextureBlendMode(TextureId texture, SDL_BlendMode mode) {
+    SDL_SetTextureBlendMode(lookup(texture), mode);
+}
+
+void SdlRenderBackend::setTextureScaleMode(TextureId texture, SDL_ScaleMode mode) {
+    SDL_SetTextureScaleMode(lookup(texture), mode);
+}
+
+void SdlRenderBackend::setTextureColorMod(TextureId texture, Uint8 r, Uint8 g, Uint8 b) {
+    SDL_SetTextureColorMod(lookup(texture), r, g, b);
+}
+
+bool SdlRenderBackend::getTextureSize(TextureId texture, float* width, float* height) {
+    return SDL_GetTextureSize(lookup(texture), width, height);
+}
+
+void SdlRenderBackend::drawTexture(TextureId texture, const SDL_FRect* source, const SDL_FRect* target) {
+    SDL_RenderTexture(renderer, lookup(texture), source, target);
+}
+
+void SdlRenderBackend::drawTexture9Grid(TextureId texture, const SDL_FRect* source,
+                                        float left, float right, float top, float bottom,
+                                        float scale, const SDL_FRect* target) {
+    SDL_RenderTexture9Grid(renderer, lookup(texture), source, left, right, top, bottom, scale, target);
+}
+
+void SdlRenderBackend::present() {
+    SDL_RenderPresent(renderer);
+}
+
+uint64_t SdlRenderBackend::getTicks() {
+    return SDL_GetTicks();
+}
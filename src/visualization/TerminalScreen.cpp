@@ -0,0 +1,124 @@
+// FILE: src/visualization/TerminalScreen.cpp
+#include "visualization/TerminalScreen.h"
+#include <algorithm>
+
+namespace {
+
+// Unchanged cells rewritten rather than jumped over; a cursor move is
+// "\x1b[row;colH", 6 to 10 bytes
+const int MAX_REWRITE_GAP = 4;
+
+} // namespace
+
+TerminalScreen::TerminalScreen()
+    : width(0),
+      height(0),
+      fullRedraw(true) {}
+
+void TerminalScreen::resize(int newWidth, int newHeight) {
+    width = std::max(0, newWidth);
+    height = std::max(0, newHeight);
+    back.assign(static_cast<size_t>(width) * height, Cell{' ', DEFAULT});
+    front = back;
+    fullRedraw = true;
+}
+
+void TerminalScreen::clear() {
+    std::fill(back.begin(), back.end(), Cell{' ', DEFAULT});
+}
+
+int TerminalScreen::put(int x, int y, const std::string& text, uint8_t style) {
+    if (y < 0 || y >= height) {
+        return x + static_cast<int>(text.size());
+    }
+    for (char c : text) {
+        if (x >= 0 && x < width) {
+            back[static_cast<size_t>(y) * width + x] = Cell{c, style};
+        }
+        x++;
+    }
+    return x;
+}
+
+void TerminalScreen::fill(int x, int y, int count, char c, uint8_t style) {
+    put(x, y, std::string(static_cast<size_t>(std::max(0, count)), c), style);
+}
+
+void TerminalScreen::invalidate() {
+    fullRedraw = true;
+}
+
+void TerminalScreen::appendStyle(std::string& out, uint8_t style) {
+    out += "\x1b[0";
+    if (style & BOLD) out += ";1";
+    if (style & DIM) out += ";2";
+    if (style & REVERSE) out += ";7";
+    uint8_t color = style & 0x0F;
+    if (color != DEFAULT) {
+        out += ";3";
+        out += static_cast<char>('0' + color);
+    }
+    out += 'm';
+}
+
+std::string TerminalScreen::flush() {
+    std::string out;
+
+    if (fullRedraw) {
+        // Clear, then write every non-blank cell
+        out += "\x1b[0m\x1b[2J";
+        std::fill(front.begin(), front.end(), Cell{' ', DEFAULT});
+        fullRedraw = false;
+    }
+
+    int cursorX = -1;
+    int cursorY = -1;
+    int currentStyle = -1;
+    for (int y = 0; y < height; y++) {
+        const Cell* backRow = &back[static_cast<size_t>(y) * width];
+        Cell* frontRow = &front[static_cast<size_t>(y) * width];
+
+        for (int x = 0; x < width; x++) {
+            if (backRow[x] == frontRow[x]) {
+                continue;
+            }
+
+            // Reach (x, y): rewrite a short unchanged gap in the current
+            // style, otherwise move the cursor
+            int gap = x - cursorX;
+            bool rewrite = cursorY == y && gap >= 0 && gap <= MAX_REWRITE_GAP;
+            for (int i = cursorX; rewrite && i < x; i++) {
+                rewrite = frontRow[i].style == currentStyle;
+            }
+            if (rewrite) {
+                for (int i = cursorX; i < x; i++) {
+                    out += frontRow[i].c;
+                }
+            } else {
+                out += "\x1b[" + std::to_string(y + 1) + ";" + std::to_string(x + 1) + "H";
+            }
+
+            if (backRow[x].style != currentStyle) {
+                appendStyle(out, backRow[x].style);
+                currentStyle = backRow[x].style;
+            }
+            out += backRow[x].c;
+            frontRow[x] = backRow[x];
+            cursorX = x + 1;
+            cursorY = y;
+        }
+    }
+
+    if (currentStyle > 0) {
+        out += "\x1b[0m";
+    }
+    return out;
+}
+
+std::string TerminalScreen::enterSequence() {
+    return "\x1b[?1049h\x1b[?25l\x1b[?7l";
+}
+
+std::string TerminalScreen::leaveSequence() {
+    return "\x1b[0m\x1b[?7h\x1b[?25h\x1b[?1049l";
+}